@@ -48,6 +48,7 @@ namespace MoriaMods
         ULONGLONG m_lastCharPoll{0};
         ULONGLONG m_lastStreamCheck{0};
         ULONGLONG m_lastRescanTime{0};
+        ULONGLONG m_lastOffsetCacheSave{0};
         ULONGLONG m_lastBubbleCheck{0};
         ULONGLONG m_lastServerFlySweep{0};
         ULONGLONG m_charLoadTime{0};
@@ -251,9 +252,12 @@ namespace MoriaMods
 
         static inline MoriaCppMod* s_instance{nullptr};
 
-        // Recipe unlock queue state (drained by main tick at UNLOCK_BATCH_SIZE/frame)
-        static constexpr int UNLOCK_BATCH_SIZE = 50;
-        std::vector<std::wstring> m_unlockQueue;
+        // Recipe unlock queue state (drained by main tick, batch sized by m_unlockPacer)
+        std::vector<FName> m_unlockQueue;
+        AdaptivePacer m_unlockPacer;             // budget: [Preferences] UnlockFrameBudgetMs
+        std::chrono::steady_clock::time_point m_unlockLastFrame{};
+        ULONGLONG m_unlockLastProgress{0};
+        HiddenPrefixIndex m_unlockHiddenNames;   // per-FName-index verdicts, valid for the process lifetime
         UObject*   m_unlockDiscoveryMgr{nullptr};
         UFunction* m_unlockDiscoverRecipeFn{nullptr};
         int m_unlockTotal{0};
@@ -322,7 +326,6 @@ namespace MoriaMods
         bool m_isTargetBuild{false};
         bool m_buildMenuWasOpen{false};
         bool m_deferHideAndRefresh{false};
-        int m_deferRemovalRebuild{0};  // 0=none, 2=hide, 1=rebuild
 
         bool m_showHotbar{true};
         bool m_gameHudVisible{true};
@@ -365,6 +368,14 @@ namespace MoriaMods
         UObject*  m_nbbCachedTexChromeMiddle{nullptr};
         UObject*  m_nbbCachedTexChromeBottom{nullptr};
         bool      m_nbbHudTexturesDumped{false};
+        // Shared glyph + recipe-icon atlas the NBB images sample from
+        // (moria_ui_atlas.inl). Sources are compared by pointer only, to
+        // find the rects that need redrawing.
+        UObject*              m_uiAtlasRT{nullptr};
+        AtlasLayout           m_uiAtlasLayout;
+        std::vector<UObject*> m_uiAtlasSources;
+        std::vector<AtlasItem> m_nbbAtlasItems;     // glyph rects + icon0..7
+        std::vector<UObject*>  m_nbbAtlasGlyphSrc;  // sources for the glyph rects
 
 
 
@@ -482,6 +493,29 @@ namespace MoriaMods
         UObject* m_ftRemovalHeader{nullptr};
         int m_ftLastRemovalCount{-1};
 
+        // Saved-removals list: a fixed pool of rows rebound to the visible
+        // window of m_ftRemovalGroups (see createFtRemovalList).
+        static constexpr int FT_REMOVAL_POOL = 14;           // 815 px viewport / 72 px rows, +2 partial
+        static constexpr float FT_REMOVAL_ROW_H = 72.0f;
+        static constexpr float FT_REMOVAL_LIST_TOP = 30.0f;  // "Saved removals" header above the list
+        struct FtRemovalRow
+        {
+            UObject* root{nullptr};      // SizeBox, FT_REMOVAL_ROW_H tall
+            UObject* icon{nullptr};
+            UObject* name{nullptr};
+            UObject* coords{nullptr};
+            UObject* infoSlot{nullptr};
+            int row{-1};                 // bound index into m_ftRemovalGroups.rows(), -1 = collapsed
+            uint64_t version{0};
+            int style{-1};
+        };
+        FtRemovalRow m_ftRemovalRows[FT_REMOVAL_POOL]{};
+        UObject* m_ftRemovalTopPad{nullptr};
+        UObject* m_ftRemovalBottomPad{nullptr};
+        RemovalGroupIndex m_ftRemovalGroups;
+        int m_ftRemovalFirst{-1};
+        uint64_t m_ftRemovalBoundVersion{0};
+
         static constexpr int MAX_GAME_MODS = 16;
         UObject* m_ftGameModCheckImages[MAX_GAME_MODS]{};
         std::vector<GameModEntry> m_ftGameModEntries;
@@ -531,6 +565,29 @@ namespace MoriaMods
         int32_t m_lastPickedUpCount{0};
         uint8_t m_lastItemHandle[20]{};
         RC::Unreal::FWeakObjectPtr m_lastItemInvComp;
+        // Item-id index over the local inventory, refreshed by the item-move hooks
+        InventoryIndex m_invIndex;
+        RC::Unreal::FWeakObjectPtr m_invIndexComp;
+        // Container-wide Remove Attributes: tint calls drained by drainStripQueue()
+        std::vector<int32_t> m_stripQueue;
+        AdaptivePacer m_stripPacer{PacerConfig{STRIP_FRAME_BUDGET_MS}};
+        std::chrono::steady_clock::time_point m_stripLastFrame{};
+        RC::Unreal::FWeakObjectPtr m_stripCraftComp;
+        uint8_t m_stripHandle[20]{};
+        int m_stripRunes{0};
+        int m_stripTints{0};
+        int m_stripTotal{0};
+        // Batched icon extraction into s_iconStore, drained by drainIconQueue()
+        struct IconJob
+        {
+            std::wstring textureName;
+            RC::Unreal::FWeakObjectPtr texture;
+        };
+        std::deque<IconJob> m_iconJobs;
+        AdaptivePacer m_iconPacer{PacerConfig{ICON_FRAME_BUDGET_MS, 1, ICON_BATCH, 1}};
+        std::chrono::steady_clock::time_point m_iconLastFrame{};
+        UObject* m_iconRT{nullptr};   // ICON_BATCH x 1 strip, reused across batches
+        int m_iconStored{0};
         bool m_trashCursorWasVisible{false};
 
         UObject* m_targetInfoWidget{nullptr};
@@ -564,11 +621,24 @@ namespace MoriaMods
         ULONGLONG m_auditClearTime{0};
         struct AuditLoc { float x, y, z; bool critical; };
         std::vector<AuditLoc> m_auditLocations;
-        std::vector<RC::Unreal::FWeakObjectPtr> m_auditSpawnedActors;
+        // Pooled audit markers: m_auditMarkers[i] belongs to m_auditPool slot i
+        struct AuditMarker { RC::Unreal::FWeakObjectPtr light; RC::Unreal::FWeakObjectPtr vfx; };
+        std::vector<AuditMarker> m_auditMarkers;
+        LruSlotPool m_auditPool{32};             // cap: [Preferences] AuditPoolSize
+        // Continuous stability monitor ([Preferences] StabilityMonitor)
+        bool m_stabMonitorEnabled{false};
+        StabilityMonitor m_stabMonitor;
+        std::vector<StabilityMonitor::Crossing> m_stabCrossings;
+        RC::Unreal::FWeakObjectPtr m_stabMonitorMgr;
+        ULONGLONG m_stabMonitorLastFind{0};
 
         #include "moria_placement.inl"
         #include "moria_quickbuild.inl"
 
+        #include "moria_icon_batch.inl"
+
+        #include "moria_ui_atlas.inl"
+
         #include "moria_widgets.inl"
 
         #include "moria_widget_harvest.inl"
@@ -603,6 +673,7 @@ namespace MoriaMods
 
             s_instance = nullptr;
 
+            saveOffsetCache();
             stopOverlay();
             if (s_config.removalCSInit)
             {
@@ -637,6 +708,7 @@ namespace MoriaMods
             loadConfig();
             VLOG(STR("[MoriaCppMod] Loaded v7.0.2 (workDir={})\n"),
                  utf8PathToWide(s_ue4ssWorkDir));
+            loadOffsetCache();
 
             // Startup diag: log resolved paths + GetFileAttributes result.
             // Mangled chars in the logged path indicate a wide-path conversion regression.
@@ -760,7 +832,7 @@ namespace MoriaMods
                 if (m_ftVisible) return;
                 m_showHotbar = !m_showHotbar;
                 s_overlay.visible = m_showHotbar && m_gameHudVisible;
-                s_overlay.needsUpdate = true;
+                s_overlay.requestUpdate();
                 showOnScreen(m_showHotbar ? Loc::get("msg.hotbar_overlay_on") : Loc::get("msg.hotbar_overlay_off"), 2.0f, 0.2f, 0.8f, 1.0f);
             });
 
@@ -857,7 +929,7 @@ namespace MoriaMods
                                 s_overlay.totalRotation = (s_overlay.totalRotation.load() + step) % 360;
                             else
                                 s_overlay.totalRotation = (s_overlay.totalRotation.load() - step + 360) % 360;
-                            s_overlay.needsUpdate = true;
+                            s_overlay.requestUpdate();
                         }
                     }
                 }
@@ -1361,7 +1433,7 @@ namespace MoriaMods
                         s_instance->m_gameHudVisible = false;
                         VLOG(STR("[MoriaCppMod] [HUD] Entered FreeCam - hiding toolbars\n"));
                         s_overlay.visible = false;
-                        s_overlay.needsUpdate = true;
+                        s_overlay.requestUpdate();
                     }
                     return;
                 }
@@ -1374,7 +1446,7 @@ namespace MoriaMods
                     VLOG(STR("[MoriaCppMod] [HUD] Exited FreeCam - restoring toolbars\n"));
                     if (s_instance->m_toolbarsVisible)
                     {
-                        if (s_instance->m_showHotbar) { s_overlay.visible = true; s_overlay.needsUpdate = true; }
+                        if (s_instance->m_showHotbar) { s_overlay.visible = true; s_overlay.requestUpdate(); }
                     }
                     return;
                 }
@@ -1472,7 +1544,7 @@ namespace MoriaMods
 
 
                 s_overlay.totalRotation = 0;
-                s_overlay.needsUpdate = true;
+                s_overlay.requestUpdate();
 
 
                 if (s_off_bLock == -2)
@@ -1899,10 +1971,13 @@ namespace MoriaMods
                 if (vk != 0)
                 {
                     bool nowDown = (GetAsyncKeyState(vk) & 0x8000) != 0;
-                    if (nowDown && !s_lastRemoveAttrsKey && !m_ftVisible && !modDown)
+                    // modifier + Remove Attributes strips the whole container
+                    bool containerWide = modDown && isModifierDown();
+                    if (nowDown && !s_lastRemoveAttrsKey && !m_ftVisible && (!modDown || containerWide))
                     {
-                        if (m_removeAttrsEnabled) removeItemAttributes();
-                        else showInfoMessage(Loc::get("msg.remove_attrs_disabled"));
+                        if (!m_removeAttrsEnabled) showInfoMessage(Loc::get("msg.remove_attrs_disabled"));
+                        else if (containerWide) stripContainerAttributes();
+                        else removeItemAttributes();
                     }
                     s_lastRemoveAttrsKey = nowDown;
                 }
@@ -2414,34 +2489,21 @@ namespace MoriaMods
                             int iconX0 = static_cast<int>(wLeft + (30.0f + 517.0f + 10.0f) * s2p);
                             int iconX1 = static_cast<int>(iconX0 + 64.0f * s2p);
 
-                            int entryStart = static_cast<int>(wTop + 40.0f * s2p + 30.0f * s2p);
-                            int entryH = static_cast<int>(72.0f * s2p);
+                            int entryStart = static_cast<int>(wTop + (40.0f + FT_REMOVAL_LIST_TOP) * s2p);
 
                             VLOG(STR("[MoriaCppMod] [Env] Click: cur=({},{}) iconX=[{},{}] entryStart={} count={}\n"),
                                  curX, curY, iconX0, iconX1, entryStart, s_config.removalCount.load());
 
-                            float scrollOff = 0.0f;
-                            if (m_ftScrollBox)
-                            {
-                                auto* getScrollFn = m_ftScrollBox->GetFunctionByNameInChain(STR("GetScrollOffset"));
-                                if (getScrollFn)
-                                {
-                                    int sz = getScrollFn->GetParmsSize();
-                                    std::vector<uint8_t> sp(sz, 0);
-                                    safeProcessEvent(m_ftScrollBox, getScrollFn, sp.data());
-                                    auto* pRV = findParam(getScrollFn, STR("ReturnValue"));
-                                    if (pRV && pRV->GetOffset_Internal() + (int)sizeof(float) <= sz)
-                                        scrollOff = *reinterpret_cast<float*>(sp.data() + pRV->GetOffset_Internal());
-                                }
-                            }
-
                             if (curX >= iconX0 && curX <= iconX1 && curY >= entryStart)
                             {
-                                int y = curY - entryStart + static_cast<int>(scrollOff * s2p);
-                                int entryIdx = y / entryH;
-                                int count = s_config.removalCount.load();
-                                if (entryIdx >= 0 && entryIdx < count)
+                                // Rows are uniform, so the list row under the cursor maps
+                                // straight to its entry; header rows have no icon.
+                                const auto& rows = m_ftRemovalGroups.rows();
+                                float y = static_cast<float>(curY - entryStart) / s2p + ftScrollOffset();
+                                int r = removalListRowAt(y, FT_REMOVAL_ROW_H, rows.size());
+                                if (r >= 0 && rows[r].kind == RemovalListRow::Kind::Entry)
                                 {
+                                    int entryIdx = static_cast<int>(rows[r].entry);
                                     s_config.pendingRemoveIndex = entryIdx;
                                     VLOG(STR("[MoriaCppMod] [Settings] Delete removal entry {} via icon click\n"), entryIdx);
                                 }
@@ -2489,7 +2551,7 @@ namespace MoriaMods
                                             if (visFn) { uint8_t vp[8]{}; vp[0] = m_ftGameModEntries[idx].enabled ? 0 : 2; safeProcessEvent(m_ftGameModCheckImages[idx], visFn, vp); }
                                         }
 
-                                        saveGameMods(m_ftGameModEntries);
+                                        onGameModToggled(idx);
                                         VLOG(STR("[MoriaCppMod] [Settings] Game Mod '{}' = {}\n"),
                                             std::wstring(m_ftGameModEntries[idx].name.begin(), m_ftGameModEntries[idx].name.end()),
                                             m_ftGameModEntries[idx].enabled ? 1 : 0);
@@ -2676,7 +2738,7 @@ namespace MoriaMods
                                 s_capturingBind = -1;
                                 saveConfig();
                                 updateFontTestKeyLabels();
-                                s_overlay.needsUpdate = true;
+                                s_overlay.requestUpdate();
                                 s_pendingKeyLabelRefresh = true;
                             }
                             break;
@@ -2689,11 +2751,7 @@ namespace MoriaMods
             {
 
                 if (m_ftVisible && m_ftSelectedTab == 2)
-                {
-                    int curCount = s_config.removalCount.load();
-                    if (curCount != m_ftLastRemovalCount)
-                        rebuildFtRemovalList();
-                }
+                    tickFtRemovalList();
 
                 }
 
@@ -2738,8 +2796,7 @@ namespace MoriaMods
                             }
                         }
                         rewriteSaveFile();
-                        buildRemovalEntries();
-                        if (m_ftVisible) m_deferRemovalRebuild = 2;
+                        buildRemovalEntries();   // the open list rebinds on the count change
                         VLOG(STR("[MoriaCppMod] Config UI: removed entry {} ({})\n"),
                                                         removeIdx,
                                                         std::wstring(toRemove.friendlyName));
@@ -2862,23 +2919,13 @@ namespace MoriaMods
                 refreshActionBar();
             }
 
-            if (m_deferRemovalRebuild == 2)
-            {
-                // close the F12 panel via toggle (deferred removal)
-                m_deferRemovalRebuild = 1;
-                if (m_ftVisible) toggleFontTestPanel(); // closes it
-            }
-            else if (m_deferRemovalRebuild == 1)
-            {
-                // reopen - toggle creates fresh panel with updated data
-                m_deferRemovalRebuild = 0;
-                if (!m_ftVisible) toggleFontTestPanel(); // reopens it
-            }
-
 
             placementTick();
             tickPitchRoll();
-            drainUnlockQueue();   // process 50 recipe-discovery calls per frame (no-op when queue empty)
+            drainUnlockQueue();   // recipe-discovery calls within the per-frame budget (no-op when queue empty)
+            drainStripQueue();    // container-wide Remove Attributes tint calls, paced the same way
+            drainIconQueue();     // batched recipe-icon extraction into the icon store
+            tickStabilityMonitor(); // sliced stability sampling when the continuous monitor is on
             refreshActiveBuffs(); // re-apply toggled-on buffs every 5s so they don't expire
             tickJoinWorldUI();    // consume pending show/hide flags for mod-owned Join World UI
             tickAdvancedJoinUI(); // consume pending show/hide flags for mod-owned Advanced Join Options UI
@@ -2996,6 +3043,9 @@ namespace MoriaMods
                     m_lastPickedUpCount = 0;
                     std::memset(m_lastItemHandle, 0, 20);
                     m_lastItemInvComp = RC::Unreal::FWeakObjectPtr{};
+                    m_invIndex.clear();
+                    m_invIndexComp = RC::Unreal::FWeakObjectPtr{};
+                    m_stripQueue.clear();
                     m_qbPhase = PlacePhase::Idle;
                     m_showSettleTime = 0;
                     m_offTraceResults = -1;
@@ -3020,6 +3070,7 @@ namespace MoriaMods
                         slot.hasHandle = false;
                     }
                     s_overlay.visible = false;
+                    s_overlay.requestUpdate();
                     m_initialReplayDone = false;
                     m_inventoryAuditDone = false;
                     m_definitionsApplied = false;
@@ -3053,7 +3104,6 @@ namespace MoriaMods
 
                     m_appliedRemovals.assign(m_appliedRemovals.size(), false);
                     m_deferHideAndRefresh = false;
-                    m_deferRemovalRebuild = 0;
                     m_gameHudVisible = true;
                     m_inFreeCam = false;
 
@@ -3075,9 +3125,7 @@ namespace MoriaMods
                     m_ftNoCollisionCheckImg = nullptr;
                     m_ftNoCollisionLabel = nullptr;
                     m_ftNoCollisionKeyLabel = nullptr;
-                    m_ftRemovalVBox = nullptr;
-                    m_ftRemovalHeader = nullptr;
-                    m_ftLastRemovalCount = -1;
+                    resetFtRemovalList();
                     for (auto& c : m_ftGameModCheckImages) c = nullptr;
                     m_ftGameModEntries.clear();
                     m_ftRenameWidget = nullptr;
@@ -3088,6 +3136,10 @@ namespace MoriaMods
                     m_trashDlgWidget = nullptr;
                     m_trashDlgVisible = false;
                     m_trashDlgOpenTick = 0;
+                    forgetWidgetPools();
+                    m_uiCalls.clear();
+                    m_uiProps.clear();
+                    m_iconRT = nullptr;   // render target goes with the world; recreated on the next batch
 
                     m_toolbarsVisible = false;
 
@@ -3113,6 +3165,7 @@ namespace MoriaMods
                     m_ebShowTick = 0;
 
                     clearStabilityHighlights();
+                    destroyAuditActors();
                 }
             }
 
@@ -3249,6 +3302,10 @@ namespace MoriaMods
                     }
                 }
             }
+
+            // Persist newly resolved layouts (no-op when nothing changed).
+            if (intervalElapsed(m_lastOffsetCacheSave, 30000))
+                saveOffsetCache();
         }
 
         // Update thread tick - called ~5ms on UE4SS's dedicated update thread.
@@ -1,298 +1,6 @@
 
 
 
-struct DefChange
-{
-    std::string item;
-    std::string property;
-    std::string value;
-};
-
-struct DefDelete
-{
-    std::string item;
-    std::string property;
-    std::string value;
-};
-
-struct DefAddRow
-{
-    std::string rowName;
-    std::string json;
-};
-
-struct DefMod
-{
-    std::string filePath;
-    std::vector<DefChange> changes;
-    std::vector<DefDelete> deletes;
-    std::vector<DefAddRow> addRows;
-};
-
-struct DefDefinition
-{
-    std::string title;
-    std::string author;
-    std::string description;
-    std::vector<DefMod> mods;
-};
-
-struct DefManifest
-{
-    std::string title;
-    std::string authors;
-    std::string description;
-    bool includeSecrets{false};
-    std::vector<std::string> defPaths;
-};
-
-
-static bool strEndsWithCI(const std::string& str, const std::string& suffix)
-{
-    if (suffix.size() > str.size()) return false;
-    return std::equal(suffix.rbegin(), suffix.rend(), str.rbegin(),
-        [](char a, char b) { return tolower(static_cast<unsigned char>(a)) == tolower(static_cast<unsigned char>(b)); });
-}
-
-
-struct XmlAttribute
-{
-    std::string name;
-    std::string value;
-};
-
-struct XmlElement
-{
-    std::string tag;
-    std::vector<XmlAttribute> attrs;
-    std::string text;
-    std::vector<XmlElement> children;
-    bool selfClosing{false};
-};
-
-static std::string xmlGetAttr(const XmlElement& elem, const std::string& name)
-{
-    for (auto& a : elem.attrs)
-        if (a.name == name) return a.value;
-    return "";
-}
-
-
-static size_t xmlSkipWS(const std::string& xml, size_t pos)
-{
-    while (pos < xml.size() && (xml[pos] == ' ' || xml[pos] == '\t' || xml[pos] == '\r' || xml[pos] == '\n'))
-        ++pos;
-    return pos;
-}
-
-
-static size_t xmlParseAttrValue(const std::string& xml, size_t pos, std::string& out)
-{
-    if (pos >= xml.size()) return pos;
-    char quote = xml[pos];
-    if (quote != '"' && quote != '\'') return pos;
-    ++pos;
-    size_t start = pos;
-    while (pos < xml.size() && xml[pos] != quote) ++pos;
-    out = xml.substr(start, pos - start);
-    if (pos < xml.size()) ++pos;
-
-    std::string decoded;
-    decoded.reserve(out.size());
-    for (size_t i = 0; i < out.size(); i++)
-    {
-        if (out[i] == '&')
-        {
-            size_t semi = out.find(';', i);
-            if (semi != std::string::npos)
-            {
-                std::string ent = out.substr(i + 1, semi - i - 1);
-                if (ent == "amp") { decoded += '&'; i = semi; continue; }
-                if (ent == "lt") { decoded += '<'; i = semi; continue; }
-                if (ent == "gt") { decoded += '>'; i = semi; continue; }
-                if (ent == "quot") { decoded += '"'; i = semi; continue; }
-                if (ent == "apos") { decoded += '\''; i = semi; continue; }
-            }
-        }
-        decoded += out[i];
-    }
-    out = decoded;
-    return pos;
-}
-
-
-static size_t xmlParseAttrs(const std::string& xml, size_t pos, std::vector<XmlAttribute>& attrs, bool& selfClose)
-{
-    selfClose = false;
-    while (pos < xml.size())
-    {
-        pos = xmlSkipWS(xml, pos);
-        if (pos >= xml.size()) break;
-        if (xml[pos] == '/')
-        {
-            selfClose = true;
-            ++pos;
-            pos = xmlSkipWS(xml, pos);
-            if (pos < xml.size() && xml[pos] == '>') ++pos;
-            return pos;
-        }
-        if (xml[pos] == '>')
-        {
-            ++pos;
-            return pos;
-        }
-
-        size_t nameStart = pos;
-        while (pos < xml.size() && xml[pos] != '=' && xml[pos] != ' ' && xml[pos] != '>' && xml[pos] != '/') ++pos;
-        std::string attrName = xml.substr(nameStart, pos - nameStart);
-        pos = xmlSkipWS(xml, pos);
-        if (pos < xml.size() && xml[pos] == '=')
-        {
-            ++pos;
-            pos = xmlSkipWS(xml, pos);
-            std::string attrVal;
-            pos = xmlParseAttrValue(xml, pos, attrVal);
-            attrs.push_back({attrName, attrVal});
-        }
-    }
-    return pos;
-}
-
-
-static size_t xmlParseElement(const std::string& xml, size_t pos, XmlElement& elem)
-{
-    pos = xmlSkipWS(xml, pos);
-    if (pos >= xml.size() || xml[pos] != '<') return pos;
-
-
-    if (pos + 1 < xml.size() && xml[pos + 1] == '?')
-    {
-        size_t end = xml.find("?>", pos);
-        if (end != std::string::npos) return end + 2;
-        return xml.size();
-    }
-    if (pos + 3 < xml.size() && xml.substr(pos, 4) == "<!--")
-    {
-        size_t end = xml.find("-->", pos);
-        if (end != std::string::npos) return end + 3;
-        return xml.size();
-    }
-
-    ++pos;
-
-    size_t tagStart = pos;
-    while (pos < xml.size() && xml[pos] != ' ' && xml[pos] != '>' && xml[pos] != '/' && xml[pos] != '\t' && xml[pos] != '\r' && xml[pos] != '\n') ++pos;
-    elem.tag = xml.substr(tagStart, pos - tagStart);
-
-
-    bool selfClose = false;
-    pos = xmlParseAttrs(xml, pos, elem.attrs, selfClose);
-    elem.selfClosing = selfClose;
-    if (selfClose) return pos;
-
-
-    std::string closeTag = "</" + elem.tag;
-    while (pos < xml.size())
-    {
-        pos = xmlSkipWS(xml, pos);
-        if (pos >= xml.size()) break;
-
-
-        if (pos + closeTag.size() < xml.size() && xml.substr(pos, closeTag.size()) == closeTag)
-        {
-            pos += closeTag.size();
-            pos = xmlSkipWS(xml, pos);
-            if (pos < xml.size() && xml[pos] == '>') ++pos;
-            return pos;
-        }
-
-        if (xml[pos] == '<')
-        {
-
-            if (pos + 8 < xml.size() && xml.substr(pos, 9) == "<![CDATA[")
-            {
-                size_t cdataStart = pos + 9;
-                size_t cdataEnd = xml.find("]]>", cdataStart);
-                if (cdataEnd != std::string::npos)
-                {
-                    elem.text += xml.substr(cdataStart, cdataEnd - cdataStart);
-                    pos = cdataEnd + 3;
-                }
-                else
-                    pos = xml.size();
-                continue;
-            }
-
-            if (pos + 3 < xml.size() && xml.substr(pos, 4) == "<!--")
-            {
-                size_t end = xml.find("-->", pos);
-                pos = (end != std::string::npos) ? end + 3 : xml.size();
-                continue;
-            }
-
-            if (pos + 1 < xml.size() && xml[pos + 1] == '?')
-            {
-                size_t end = xml.find("?>", pos);
-                pos = (end != std::string::npos) ? end + 2 : xml.size();
-                continue;
-            }
-
-            if (pos + 1 < xml.size() && xml[pos + 1] == '/')
-                break;
-
-            XmlElement child;
-            pos = xmlParseElement(xml, pos, child);
-            if (!child.tag.empty())
-                elem.children.push_back(std::move(child));
-        }
-        else
-        {
-
-            size_t textStart = pos;
-            while (pos < xml.size() && xml[pos] != '<') ++pos;
-            std::string text = xml.substr(textStart, pos - textStart);
-
-            size_t a = text.find_first_not_of(" \t\r\n");
-            size_t b = text.find_last_not_of(" \t\r\n");
-            if (a != std::string::npos)
-                elem.text += text.substr(a, b - a + 1);
-        }
-    }
-    return pos;
-}
-
-
-static XmlElement xmlParse(const std::string& xml)
-{
-    XmlElement root;
-    size_t pos = 0;
-    while (pos < xml.size())
-    {
-        pos = xmlSkipWS(xml, pos);
-        if (pos >= xml.size()) break;
-        if (xml[pos] != '<') { ++pos; continue; }
-
-
-        if (pos + 1 < xml.size() && xml[pos + 1] == '?')
-        {
-            size_t end = xml.find("?>", pos);
-            pos = (end != std::string::npos) ? end + 2 : xml.size();
-            continue;
-        }
-        if (pos + 3 < xml.size() && xml.substr(pos, 4) == "<!--")
-        {
-            size_t end = xml.find("-->", pos);
-            pos = (end != std::string::npos) ? end + 3 : xml.size();
-            continue;
-        }
-
-        pos = xmlParseElement(xml, pos, root);
-        if (!root.tag.empty()) break;
-    }
-    return root;
-}
-
-
 static std::vector<std::string> listFiles(const std::string& dir, const std::string& pattern = "*")
 {
     // Use wide Windows API. FindFirstFileA interprets the path as the active
@@ -335,147 +43,46 @@ static std::vector<std::string> listFiles(const std::string& dir, const std::str
 }
 
 
-static std::string readFileToString(const std::string& path)
+// Whole file into the arena; the XML tree and Def* structs view into it.
+static std::string_view readFileToArena(const std::string& path, std::pmr::memory_resource* mr)
 {
-    std::ifstream f = openInputFile(path, std::ios::binary);
-    if (!f.is_open()) return "";
-    std::ostringstream ss;
-    ss << f.rdbuf();
-    return ss.str();
+    std::ifstream f = openInputFile(path, std::ios::binary | std::ios::ate);
+    if (!f.is_open()) return {};
+    std::streamoff size = f.tellg();
+    if (size <= 0) return {};
+    f.seekg(0);
+    char* buf = static_cast<char*>(mr->allocate(static_cast<size_t>(size), 1));
+    f.read(buf, size);
+    return {buf, static_cast<size_t>(f.gcount())};
 }
 
 
 DefManifest parseManifest(const std::string& iniPath, const std::string& defBaseDir)
 {
-    DefManifest manifest;
     std::ifstream file = openInputFile(iniPath);
-    if (!file.is_open()) return manifest;
-
-    std::string section;
-    std::string line;
-    while (std::getline(file, line))
-    {
-        auto parsed = parseIniLine(line);
-        if (auto* sec = std::get_if<ParsedIniSection>(&parsed))
-        {
-            section = sec->name;
-        }
-        else if (auto* kv = std::get_if<ParsedIniKeyValue>(&parsed))
-        {
-            if (strEqualCI(section, "ModInfo"))
-            {
-                if (strEqualCI(kv->key, "Title")) manifest.title = kv->value;
-                else if (strEqualCI(kv->key, "Authors")) manifest.authors = kv->value;
-                else if (strEqualCI(kv->key, "Description")) manifest.description += kv->value + "\n";
-            }
-            else if (strEqualCI(section, "Paths"))
-            {
-
-
-                if (strEqualCI(kv->value, "true"))
-                {
-                    std::string key = kv->key;
-
-                    for (auto& c : key) { if (c == '|') c = '\\'; }
-
-                    if (strEndsWithCI(key, ".def"))
-                    {
-
-                        std::string fullPath = defBaseDir + "\\" + key;
-                        manifest.defPaths.push_back(fullPath);
-                    }
-
-                }
-            }
-            else if (strEqualCI(section, "Settings"))
-            {
-                if (strEqualCI(kv->key, "include_secrets"))
-                    manifest.includeSecrets = strEqualCI(kv->value, "true") || kv->value == "1";
-            }
-        }
-    }
-    return manifest;
+    if (!file.is_open()) return {};
+    return parseManifestStream(file, defBaseDir, '\\');
 }
 
 
-DefDefinition parseDef(const std::string& defPath)
+DefDefinition parseDef(const std::string& defPath, std::pmr::memory_resource* mr)
 {
-    DefDefinition def;
-    std::string xml = readFileToString(defPath);
+    std::string_view xml = readFileToArena(defPath, mr);
     if (xml.empty())
     {
         VLOG(STR("[MoriaCppMod] [Def] Failed to read: {}\n"), std::wstring(defPath.begin(), defPath.end()));
-        return def;
+        return DefDefinition(mr);
     }
 
-    XmlElement root = xmlParse(xml);
-
-
-    if (root.tag == "definition")
-    {
-        for (auto& child : root.children)
-        {
-            if (child.tag == "title") def.title = child.text;
-            else if (child.tag == "author") def.author = child.text;
-            else if (child.tag == "description") def.description = child.text;
-            else if (child.tag == "mod")
-            {
-                DefMod mod;
-                mod.filePath = xmlGetAttr(child, "file");
-                for (auto& op : child.children)
-                {
-                    if (op.tag == "change")
-                    {
-                        DefChange c;
-                        c.item = xmlGetAttr(op, "item");
-                        c.property = xmlGetAttr(op, "property");
-                        c.value = xmlGetAttr(op, "value");
-                        mod.changes.push_back(std::move(c));
-                    }
-                    else if (op.tag == "delete")
-                    {
-                        DefDelete d;
-                        d.item = xmlGetAttr(op, "item");
-                        d.property = xmlGetAttr(op, "property");
-                        d.value = xmlGetAttr(op, "value");
-                        mod.deletes.push_back(std::move(d));
-                    }
-                    else if (op.tag == "add_row")
-                    {
-                        DefAddRow ar;
-                        ar.rowName = xmlGetAttr(op, "name");
-                        ar.json = op.text;
-                        if (!ar.rowName.empty() && !ar.json.empty())
-                            mod.addRows.push_back(std::move(ar));
-                    }
-                }
-                def.mods.push_back(std::move(mod));
-            }
-        }
-    }
-    else if (root.tag == "manifest")
+    XmlElement root = xmlParse(xml, mr);
+    if (root.tag == "manifest")
     {
 
 
         VLOG(STR("[MoriaCppMod] [Def] Skipping manifest file (build-time only): {}\n"),
              std::wstring(defPath.begin(), defPath.end()));
     }
-
-    return def;
-}
-
-
-static std::string extractDataTableName(const std::string& filePath)
-{
-
-    size_t lastSlash = filePath.find_last_of("/\\");
-    std::string filename = (lastSlash != std::string::npos) ? filePath.substr(lastSlash + 1) : filePath;
-
-
-    if (strEndsWithCI(filename, ".json"))
-        filename = filename.substr(0, filename.size() - 5);
-
-    return filename;
+    return defFromXml(root, mr);
 }
 
 
@@ -485,7 +92,7 @@ struct ResolvedField
     FProperty* prop{nullptr};
 };
 
-ResolvedField resolveNestedProperty(uint8_t* rowData, UStruct* rowStruct, const std::string& propertyPath)
+ResolvedField resolveNestedProperty(uint8_t* rowData, UStruct* rowStruct, std::string_view propertyPath)
 {
     if (!rowData || !rowStruct || propertyPath.empty()) return {};
 
@@ -614,7 +221,7 @@ ResolvedField resolveNestedProperty(uint8_t* rowData, UStruct* rowStruct, const
 }
 
 
-bool writeValueToField(uint8_t* fieldData, FProperty* prop, const std::string& value)
+bool writeValueToField(uint8_t* fieldData, FProperty* prop, std::string_view value)
 {
     if (!fieldData || !prop) return false;
 
@@ -657,16 +264,16 @@ std::string readFieldAsString(uint8_t* fieldData, FProperty* prop)
 }
 
 
-bool removeGameplayTag(uint8_t* containerData, const std::string& tagName)
+// Index of tagName inside a TArray<FGameplayTag> container, or -1. Read-only;
+// shared by removeGameplayTag and the dry-run diff.
+int findGameplayTagIndex(uint8_t* containerData, std::string_view tagName)
 {
-    if (!containerData) return false;
-
+    if (!containerData) return -1;
 
     DataTableUtil::TArrayHeader hdr;
-    if (!isReadableMemory(containerData, 16)) return false;
+    if (!isReadableMemory(containerData, 16)) return -1;
     std::memcpy(&hdr, containerData, 16);
-    if (hdr.Num <= 0 || !hdr.Data) return false;
-
+    if (hdr.Num <= 0 || !hdr.Data) return -1;
 
     static constexpr int TAG_SIZE = 8;
     std::wstring wTagName(tagName.begin(), tagName.end());
@@ -676,104 +283,40 @@ bool removeGameplayTag(uint8_t* containerData, const std::string& tagName)
     {
         uint8_t* elem = hdr.Data + i * TAG_SIZE;
         if (!isReadableMemory(elem, TAG_SIZE)) continue;
-        if (std::memcmp(elem, &searchTag, TAG_SIZE) == 0)
-        {
-
-            int32_t lastIdx = hdr.Num - 1;
-            if (i < lastIdx)
-            {
-                uint8_t* lastElem = hdr.Data + lastIdx * TAG_SIZE;
-                std::memcpy(elem, lastElem, TAG_SIZE);
-            }
-
-            uint8_t* lastElem = hdr.Data + lastIdx * TAG_SIZE;
-            std::memset(lastElem, 0, TAG_SIZE);
-
-            int32_t newNum = hdr.Num - 1;
-            std::memcpy(containerData + 8, &newNum, 4);
-
-            VLOG(STR("[MoriaCppMod] [Def] Removed tag '{}' (slot {}, {} remaining)\n"),
-                 wTagName, i, newNum);
-            return true;
-        }
+        if (std::memcmp(elem, &searchTag, TAG_SIZE) == 0) return i;
     }
-
-    VLOG(STR("[MoriaCppMod] [Def] Tag '{}' not found in container\n"), wTagName);
-    return false;
+    return -1;
 }
 
 
-static std::string jsonExtractString(const std::string& json, size_t start, size_t end, const std::string& key)
+bool removeGameplayTag(uint8_t* containerData, std::string_view tagName)
 {
-    std::string needle = "\"" + key + "\"";
-    size_t pos = json.find(needle, start);
-    if (pos == std::string::npos || pos >= end) return "";
-    pos += needle.size();
-
-    while (pos < end && (json[pos] == ' ' || json[pos] == ':' || json[pos] == '\t')) ++pos;
-    if (pos >= end) return "";
+    static constexpr int TAG_SIZE = 8;
+    std::wstring wTagName(tagName.begin(), tagName.end());
 
-    if (json[pos] == '"')
+    int i = findGameplayTagIndex(containerData, tagName);
+    if (i < 0)
     {
-
-        ++pos;
-        size_t valEnd = pos;
-        while (valEnd < end && json[valEnd] != '"') {
-            if (json[valEnd] == '\\') valEnd++;
-            valEnd++;
-        }
-        return json.substr(pos, valEnd - pos);
-    }
-    else if (json[pos] == '{' || json[pos] == '[')
-    {
-
-        char open = json[pos], close = (open == '{') ? '}' : ']';
-        int depth = 1;
-        size_t blockStart = pos;
-        ++pos;
-        while (pos < end && depth > 0) {
-            if (json[pos] == '"') { ++pos; while (pos < end && json[pos] != '"') { if (json[pos] == '\\') ++pos; ++pos; } }
-            else if (json[pos] == open) depth++;
-            else if (json[pos] == close) depth--;
-            ++pos;
-        }
-        return json.substr(blockStart, pos - blockStart);
+        VLOG(STR("[MoriaCppMod] [Def] Tag '{}' not found in container\n"), wTagName);
+        return false;
     }
-    else
-    {
 
-        size_t valStart = pos;
-        while (pos < end && json[pos] != ',' && json[pos] != '}' && json[pos] != ']'
-               && json[pos] != '\r' && json[pos] != '\n') ++pos;
-        std::string val = json.substr(valStart, pos - valStart);
+    DataTableUtil::TArrayHeader hdr;
+    std::memcpy(&hdr, containerData, 16);
+    uint8_t* elem = hdr.Data + i * TAG_SIZE;
 
-        while (!val.empty() && (val.back() == ' ' || val.back() == '\t')) val.pop_back();
-        return val;
-    }
-}
+    int32_t lastIdx = hdr.Num - 1;
+    uint8_t* lastElem = hdr.Data + lastIdx * TAG_SIZE;
+    if (i < lastIdx)
+        std::memcpy(elem, lastElem, TAG_SIZE);
+    std::memset(lastElem, 0, TAG_SIZE);
 
+    int32_t newNum = hdr.Num - 1;
+    std::memcpy(containerData + 8, &newNum, 4);
 
-static std::vector<std::pair<size_t, size_t>> jsonArrayObjects(const std::string& json, size_t arrStart, size_t arrEnd)
-{
-    std::vector<std::pair<size_t, size_t>> objects;
-    size_t pos = arrStart;
-    while (pos < arrEnd)
-    {
-
-        while (pos < arrEnd && json[pos] != '{') ++pos;
-        if (pos >= arrEnd) break;
-        size_t objStart = pos;
-        int depth = 1;
-        ++pos;
-        while (pos < arrEnd && depth > 0) {
-            if (json[pos] == '"') { ++pos; while (pos < arrEnd && json[pos] != '"') { if (json[pos] == '\\') ++pos; ++pos; } }
-            else if (json[pos] == '{') depth++;
-            else if (json[pos] == '}') depth--;
-            ++pos;
-        }
-        objects.push_back({objStart, pos});
-    }
-    return objects;
+    VLOG(STR("[MoriaCppMod] [Def] Removed tag '{}' (slot {}, {} remaining)\n"),
+         wTagName, i, newNum);
+    return true;
 }
 
 
@@ -806,17 +349,16 @@ int64_t findEnumValueByName(UEnum* uenum, const std::string& val)
 }
 
 
-bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
-                               const std::string& json, size_t objStart, size_t objEnd)
+bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct, const JsonIndex& json, int obj)
 {
     if (!structData || !ustruct) return false;
 
-    std::string type = jsonExtractString(json, objStart, objEnd, "$type");
-    std::string name = jsonExtractString(json, objStart, objEnd, "Name");
+    std::string type = json.str(obj, "$type");
+    std::string name = json.str(obj, "Name");
     if (name.empty()) return false;
 
 
-    std::string isZero = jsonExtractString(json, objStart, objEnd, "IsZero");
+    std::string isZero = json.str(obj, "IsZero");
     if (isZero == "true") return false;
 
 
@@ -853,7 +395,7 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
 
     if (type.find("IntPropertyData") != std::string::npos)
     {
-        std::string val = jsonExtractString(json, objStart, objEnd, "Value");
+        std::string val = json.str(obj, "Value");
         if (val.empty()) return false;
         return writeValueToField(fieldData, prop, val);
     }
@@ -861,7 +403,7 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
 
     if (type.find("FloatPropertyData") != std::string::npos)
     {
-        std::string val = jsonExtractString(json, objStart, objEnd, "Value");
+        std::string val = json.str(obj, "Value");
         if (val.empty()) return false;
 
         if (val == "+0" || val == "+0.0") val = "0";
@@ -871,14 +413,14 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
 
     if (type.find("BoolPropertyData") != std::string::npos)
     {
-        std::string val = jsonExtractString(json, objStart, objEnd, "Value");
+        std::string val = json.str(obj, "Value");
         return writeValueToField(fieldData, prop, val);
     }
 
 
     if (type.find("BytePropertyData") != std::string::npos)
     {
-        std::string val = jsonExtractString(json, objStart, objEnd, "Value");
+        std::string val = json.str(obj, "Value");
         if (val.empty()) return false;
         return writeValueToField(fieldData, prop, val);
     }
@@ -886,7 +428,7 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
 
     if (type.find("NamePropertyData") != std::string::npos)
     {
-        std::string val = jsonExtractString(json, objStart, objEnd, "Value");
+        std::string val = json.str(obj, "Value");
         if (val.empty() || val == "null" || val == "None") return false;
         return writeValueToField(fieldData, prop, val);
     }
@@ -894,7 +436,7 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
 
     if (type.find("EnumPropertyData") != std::string::npos)
     {
-        std::string val = jsonExtractString(json, objStart, objEnd, "Value");
+        std::string val = json.str(obj, "Value");
         if (val.empty() || val == "null") return false;
 
 
@@ -966,13 +508,13 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
     {
 
 
-        std::string valueBlock = jsonExtractString(json, objStart, objEnd, "Value");
-        if (valueBlock.empty() || valueBlock == "null") return false;
+        int valueObj = json.member(obj, "Value");
+        if (valueObj == JsonIndex::npos || json.kind(valueObj) != JsonIndex::Kind::Object) return false;
 
 
-        std::string assetPath = jsonExtractString(valueBlock, 0, valueBlock.size(), "AssetPath");
-        if (assetPath.empty()) return false;
-        std::string assetName = jsonExtractString(assetPath, 0, assetPath.size(), "AssetName");
+        int assetPath = json.member(valueObj, "AssetPath");
+        if (assetPath == JsonIndex::npos) return false;
+        std::string assetName = json.str(assetPath, "AssetName");
         if (assetName.empty() || assetName == "null" || assetName == "None") return false;
 
 
@@ -998,9 +540,9 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
 
     if (type.find("StructPropertyData") != std::string::npos)
     {
-        std::string structType = jsonExtractString(json, objStart, objEnd, "StructType");
-        std::string valueBlock = jsonExtractString(json, objStart, objEnd, "Value");
-        if (valueBlock.empty() || valueBlock[0] != '[') return false;
+        std::string structType = json.str(obj, "StructType");
+        int valueArr = json.member(obj, "Value");
+        if (valueArr == JsonIndex::npos || json.kind(valueArr) != JsonIndex::Kind::Array) return false;
 
 
         auto* structProp = CastField<FStructProperty>(prop);
@@ -1011,27 +553,20 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
         if (structType == "GameplayTagContainer")
         {
 
-            auto innerObjects = jsonArrayObjects(valueBlock, 0, valueBlock.size());
-            for (auto& [iStart, iEnd] : innerObjects)
+            for (int inner : json.objects(valueArr))
             {
-                std::string iType = jsonExtractString(valueBlock, iStart, iEnd, "$type");
+                std::string iType = json.str(inner, "$type");
                 if (iType.find("GameplayTagContainerPropertyData") != std::string::npos)
                 {
-                    std::string tagsBlock = jsonExtractString(valueBlock, iStart, iEnd, "Value");
-                    if (tagsBlock.empty() || tagsBlock == "[]") break;
+                    int tagsArr = json.member(inner, "Value");
+                    if (tagsArr == JsonIndex::npos || json.kind(tagsArr) != JsonIndex::Kind::Array) break;
 
 
                     std::vector<std::string> tagNames;
-                    size_t tPos = 1;
-                    while (tPos < tagsBlock.size())
+                    for (int t = json.firstChild(tagsArr); t != JsonIndex::npos; t = json.next(t))
                     {
-                        while (tPos < tagsBlock.size() && tagsBlock[tPos] != '"' && tagsBlock[tPos] != ']') ++tPos;
-                        if (tPos >= tagsBlock.size() || tagsBlock[tPos] == ']') break;
-                        ++tPos;
-                        size_t tEnd = tPos;
-                        while (tEnd < tagsBlock.size() && tagsBlock[tEnd] != '"') ++tEnd;
-                        tagNames.push_back(tagsBlock.substr(tPos, tEnd - tPos));
-                        tPos = tEnd + 1;
+                        if (json.kind(t) == JsonIndex::Kind::String)
+                            tagNames.emplace_back(json.view(t));
                     }
 
                     if (!tagNames.empty())
@@ -1074,13 +609,12 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
 
         if (structType == "GameplayTag")
         {
-            auto innerObjects = jsonArrayObjects(valueBlock, 0, valueBlock.size());
-            for (auto& [iStart, iEnd] : innerObjects)
+            for (int inner : json.objects(valueArr))
             {
-                std::string iName = jsonExtractString(valueBlock, iStart, iEnd, "Name");
+                std::string iName = json.str(inner, "Name");
                 if (iName == "TagName")
                 {
-                    std::string tagVal = jsonExtractString(valueBlock, iStart, iEnd, "Value");
+                    std::string tagVal = json.str(inner, "Value");
                     if (!tagVal.empty() && tagVal != "null" && tagVal != "None")
                     {
 
@@ -1096,11 +630,8 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
         }
 
 
-        auto innerObjects = jsonArrayObjects(valueBlock, 0, valueBlock.size());
-        for (auto& [iStart, iEnd] : innerObjects)
-        {
-            writeJsonPropertyToField(fieldData, innerStruct, valueBlock, iStart, iEnd);
-        }
+        for (int inner : json.objects(valueArr))
+            writeJsonPropertyToField(fieldData, innerStruct, json, inner);
         return true;
     }
 
@@ -1125,12 +656,11 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
 
     if (type.find("ArrayPropertyData") != std::string::npos)
     {
-        std::string valueBlock = jsonExtractString(json, objStart, objEnd, "Value");
+        int valueArr = json.member(obj, "Value");
+        if (valueArr == JsonIndex::npos || json.firstChild(valueArr) == JsonIndex::npos) return false;
 
-        if (valueBlock.empty() || valueBlock == "[]") return false;
 
-
-        std::string arrayType = jsonExtractString(json, objStart, objEnd, "ArrayType");
+        std::string arrayType = json.str(obj, "ArrayType");
 
         auto* arrProp = CastField<FArrayProperty>(prop);
         if (!arrProp) return false;
@@ -1139,7 +669,7 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
         int elemSize = inner->GetSize();
         if (elemSize <= 0) return false;
 
-        auto elements = jsonArrayObjects(valueBlock, 0, valueBlock.size());
+        auto elements = json.objects(valueArr);
         if (elements.empty()) return false;
 
         int count = static_cast<int>(elements.size());
@@ -1159,26 +689,22 @@ bool writeJsonPropertyToField(uint8_t* structData, UStruct* ustruct,
         for (int i = 0; i < count; i++)
         {
             uint8_t* elemData = arrData + i * elemSize;
-            auto& [eStart, eEnd] = elements[i];
+            int elem = elements[i];
 
             if (innerStruct)
             {
 
-                std::string elemValue = jsonExtractString(valueBlock, eStart, eEnd, "Value");
-                if (!elemValue.empty() && elemValue[0] == '[')
+                int elemValue = json.member(elem, "Value");
+                if (elemValue != JsonIndex::npos && json.kind(elemValue) == JsonIndex::Kind::Array)
                 {
-                    auto innerProps = jsonArrayObjects(elemValue, 0, elemValue.size());
-                    for (auto& [ipStart, ipEnd] : innerProps)
-                    {
-                        writeJsonPropertyToField(elemData, innerStruct,
-                                                  elemValue, ipStart, ipEnd);
-                    }
+                    for (int innerProp : json.objects(elemValue))
+                        writeJsonPropertyToField(elemData, innerStruct, json, innerProp);
                 }
             }
             else
             {
 
-                std::string val = jsonExtractString(valueBlock, eStart, eEnd, "Value");
+                std::string val = json.str(elem, "Value");
                 if (!val.empty())
                     writeValueToField(elemData, inner, val);
             }
@@ -1353,7 +879,122 @@ void fixRowHandlePointers(DataTableUtil& dt, uint8_t* newRow)
 }
 
 
-int applyAddRow(DataTableUtil& dt, const DefAddRow& addRow)
+// Dry-run mode for definition packs (MoriaCppMod.ini [Preferences]
+// DefinitionsDryRun = off|json|csv). When set, loadAndApplyDefinitions resolves
+// every operation and reads the live value but writes nothing; the diff is
+// written once at the end instead of per-change readback logging.
+enum class DefDryRun { Off, Json, Csv };
+DefDryRun m_defDryRun{DefDryRun::Off};
+
+// Undo log for one definition pack: the live value of every field the pack
+// wrote, captured (ExportText) just before its first write. Lets a pack be
+// reverted at runtime without a restart. Rows added by add_row are listed but
+// stay in the table until restart — UDataTable has no safe runtime remove.
+struct DefUndoEntry
+{
+    std::string table;
+    std::wstring row;
+    std::string property;
+    std::wstring original;
+    bool raw{false};            // raw writeFloat/writeInt32 fallback: no FProperty
+    uint32_t rawOriginal{0};    // the 4 bytes it wrote over
+};
+
+struct DefPackUndo
+{
+    std::vector<DefUndoEntry> entries;
+    std::unordered_map<std::string, size_t> byField;   // defFieldKey -> entries index
+    std::vector<std::pair<std::string, std::wstring>> addedRows;
+};
+
+// Keyed by GameMods.ini pack name. Survives world reloads on purpose: a
+// re-apply after LoadMap must not overwrite the first captured original.
+std::unordered_map<std::string, DefPackUndo> m_defUndo;
+// Field key -> packs that wrote it, in apply order. Reverting a pack that is
+// not the last writer hands its original to the pack above instead of writing.
+std::unordered_map<std::string, std::vector<std::string>> m_defFieldWriters;
+
+static std::string defFieldKey(const std::string& table, const std::wstring& row, std::string_view property)
+{
+    return table + '\x1f' + wideToUtf8(row) + '\x1f' + std::string(property);
+}
+
+// Per-load state threaded through the apply* functions.
+struct DefApplyContext
+{
+    DefArena arena;                     // all parse-phase memory; declared first so it dies last
+    std::string pack;                   // GameMods.ini key of the pack being applied
+    std::string table;                  // DataTable name of the current <mod> block
+    bool dryRun{false};
+    std::vector<DefDiffEntry> diff;     // filled only when dryRun
+    DefPackUndo* undo{nullptr};         // undo log of `pack`; null in dry run
+
+    int manifests{0};
+    int addRows{0};
+    int changes{0};
+    int deletes{0};
+    int applied{0};
+    std::unordered_map<std::string, DataTableUtil> tables;
+    std::unordered_map<std::string, std::string> tablesWithAddRows;
+
+    void record(const char* op, std::string_view row, std::string_view property,
+                std::string oldValue, std::string_view newValue, const char* status)
+    {
+        diff.push_back({pack, op, table, std::string(row), std::string(property), std::move(oldValue),
+                        std::string(newValue), status});
+    }
+};
+
+
+std::wstring readFieldAsWide(uint8_t* fieldData, FProperty* prop)
+{
+    if (!fieldData || !prop) return L"";
+    try
+    {
+        FString outStr{};
+        prop->ExportText_Direct(outStr, fieldData, nullptr, nullptr, 0, nullptr);
+        const wchar_t* ws = *outStr;
+        return ws ? std::wstring(ws) : std::wstring();
+    }
+    catch (...) { return L""; }
+}
+
+// Record the pre-write value of a field for ctx.pack. Only the first write
+// per pack and field is kept, so re-applies never capture a modded value.
+// Returns the new entry, or null if this pack already captured the field.
+DefUndoEntry* beginUndo(DefApplyContext& ctx, const std::wstring& row, std::string_view property)
+{
+    std::string key = defFieldKey(ctx.table, row, property);
+    if (ctx.undo->byField.count(key)) return nullptr;
+    ctx.undo->byField[key] = ctx.undo->entries.size();
+    ctx.undo->entries.push_back({ctx.table, row, std::string(property), {}});
+
+    auto& writers = m_defFieldWriters[key];
+    if (std::find(writers.begin(), writers.end(), ctx.pack) == writers.end())
+        writers.push_back(ctx.pack);
+    return &ctx.undo->entries.back();
+}
+
+void captureUndo(DefApplyContext& ctx, const std::wstring& row, std::string_view property,
+                 uint8_t* fieldData, FProperty* prop)
+{
+    if (!ctx.undo || !fieldData || !prop) return;
+    if (DefUndoEntry* e = beginUndo(ctx, row, property)) e->original = readFieldAsWide(fieldData, prop);
+}
+
+// Same for the raw 4-byte fallback, which has no FProperty to export through.
+void captureRawUndo(DefApplyContext& ctx, const std::wstring& row, std::string_view property, const uint8_t* fieldData)
+{
+    if (!ctx.undo || !fieldData || !isReadableMemory(fieldData, 4)) return;
+    if (DefUndoEntry* e = beginUndo(ctx, row, property))
+    {
+        e->raw = true;
+        std::memcpy(&e->rawOriginal, fieldData, 4);
+    }
+}
+
+
+int applyAddRow(DataTableUtil& dt, const DefAddRow& addRow, DefApplyContext& ctx)
 {
     if (!dt.isBound() || !dt.rowStruct || dt.rowSize <= 0) return 0;
 
@@ -1362,11 +1003,35 @@ int applyAddRow(DataTableUtil& dt, const DefAddRow& addRow)
 
     if (dt.findRowData(wRowName.c_str()))
     {
+        if (ctx.dryRun)
+        {
+            ctx.record("add_row", addRow.rowName, "*", "<exists>", "", "exists");
+            return 0;
+        }
         VLOG(STR("[MoriaCppMod] [Def] add_row: '{}' already exists in '{}', skipping\n"),
              wRowName, dt.tableName);
         return 0;
     }
 
+    const JsonIndex& json = addRow.json;
+    if (!json.ok())
+    {
+        RC::Output::send<RC::LogLevel::Warning>(
+            STR("[MoriaCppMod] [Def] add_row: '{}' has malformed JSON near byte {}, skipping\n"),
+            wRowName, json.errorOffset());
+        if (ctx.dryRun) ctx.record("add_row", addRow.rowName, "*", "<absent>", "", "bad_json");
+        return 0;
+    }
+    int valueArr = json.member(json.root(), "Value");
+    bool hasValue = valueArr != JsonIndex::npos && json.kind(valueArr) == JsonIndex::Kind::Array;
+    if (ctx.dryRun)
+    {
+        size_t props = hasValue ? json.objects(valueArr).size() : 0;
+        ctx.record("add_row", addRow.rowName, "*", "<absent>",
+                   "<row: " + std::to_string(props) + " properties>", hasValue ? "ok" : "no_value_array");
+        return 1;
+    }
+
 
     uint8_t* rowData = dt.addRow(wRowName.c_str());
     if (!rowData)
@@ -1378,19 +1043,16 @@ int applyAddRow(DataTableUtil& dt, const DefAddRow& addRow)
     }
 
 
-    const std::string& json = addRow.json;
-    std::string valueBlock = jsonExtractString(json, 0, json.size(), "Value");
-    if (valueBlock.empty() || valueBlock[0] != '[')
+    if (!hasValue)
     {
         VLOG(STR("[MoriaCppMod] [Def] add_row: '{}' has no Value array\n"), wRowName);
         return 1;
     }
 
-    auto properties = jsonArrayObjects(valueBlock, 0, valueBlock.size());
     int propsWritten = 0;
-    for (auto& [pStart, pEnd] : properties)
+    for (int prop : json.objects(valueArr))
     {
-        if (writeJsonPropertyToField(rowData, dt.rowStruct, valueBlock, pStart, pEnd))
+        if (writeJsonPropertyToField(rowData, dt.rowStruct, json, prop))
             propsWritten++;
     }
 
@@ -1402,6 +1064,7 @@ int applyAddRow(DataTableUtil& dt, const DefAddRow& addRow)
 
 
     fixRowHandlePointers(dt, rowData);
+    if (ctx.undo) ctx.undo->addedRows.push_back({ctx.table, wRowName});
 
     if (s_verbose)
     {
@@ -1414,7 +1077,7 @@ int applyAddRow(DataTableUtil& dt, const DefAddRow& addRow)
 }
 
 
-int applyChange(DataTableUtil& dt, const DefChange& change)
+int applyChange(DataTableUtil& dt, const DefChange& change, DefApplyContext& ctx)
 {
     if (!dt.isBound()) return 0;
 
@@ -1423,6 +1086,14 @@ int applyChange(DataTableUtil& dt, const DefChange& change)
     bool isNone = strEqualCI(change.item, "NONE");
     int applied = 0;
 
+    // Dry run: record what the write would do and report it as applied only
+    // when the field resolved.
+    auto recordDry = [&](const wchar_t* rowName, std::string oldValue, const char* status) -> bool
+    {
+        ctx.record("change", wideToUtf8(rowName), change.property, std::move(oldValue), change.value, status);
+        return std::strcmp(status, "ok") == 0;
+    };
+
     auto applyToRow = [&](const wchar_t* rowName) -> bool
     {
         if (isSimple)
@@ -1430,10 +1101,10 @@ int applyChange(DataTableUtil& dt, const DefChange& change)
 
             std::wstring wProp(change.property.begin(), change.property.end());
             int off = dt.resolvePropertyOffset(wProp.c_str());
-            if (off < 0) return false;
+            if (off < 0) return ctx.dryRun ? recordDry(rowName, "", "property_missing") : false;
 
             uint8_t* rowData = dt.findRowData(rowName);
-            if (!rowData) return false;
+            if (!rowData) return ctx.dryRun ? recordDry(rowName, "", "row_missing") : false;
 
 
             FProperty* prop = nullptr;
@@ -1453,8 +1124,13 @@ int applyChange(DataTableUtil& dt, const DefChange& change)
                 }
             }
 
+            if (ctx.dryRun)
+                return prop ? recordDry(rowName, readFieldAsString(rowData + off, prop), "ok")
+                            : recordDry(rowName, "<raw>", "ok");
+
             if (prop)
             {
+                captureUndo(ctx, rowName, change.property, rowData + off, prop);
                 bool ok = writeValueToField(rowData + off, prop, change.value);
                 if (ok && s_verbose)
                 {
@@ -1469,14 +1145,15 @@ int applyChange(DataTableUtil& dt, const DefChange& change)
             }
 
 
+            captureRawUndo(ctx, rowName, change.property, rowData + off);
             if (change.value.find('.') != std::string::npos)
             {
-                try { return dt.writeFloat(rowName, wProp.c_str(), std::stof(change.value)); }
+                try { return dt.writeFloat(rowName, wProp.c_str(), std::stof(std::string(change.value))); }
                 catch (...) { return false; }
             }
             else
             {
-                try { return dt.writeInt32(rowName, wProp.c_str(), std::stoi(change.value)); }
+                try { return dt.writeInt32(rowName, wProp.c_str(), std::stoi(std::string(change.value))); }
                 catch (...) { return false; }
             }
         }
@@ -1484,11 +1161,15 @@ int applyChange(DataTableUtil& dt, const DefChange& change)
         {
 
             uint8_t* rowData = dt.findRowData(rowName);
-            if (!rowData || !dt.rowStruct) return false;
+            if (!rowData || !dt.rowStruct) return ctx.dryRun ? recordDry(rowName, "", "row_missing") : false;
 
             auto resolved = resolveNestedProperty(rowData, dt.rowStruct, change.property);
-            if (!resolved.data) return false;
+            if (!resolved.data) return ctx.dryRun ? recordDry(rowName, "", "property_missing") : false;
 
+            if (ctx.dryRun)
+                return recordDry(rowName, readFieldAsString(resolved.data, resolved.prop), "ok");
+
+            captureUndo(ctx, rowName, change.property, resolved.data, resolved.prop);
             bool ok = writeValueToField(resolved.data, resolved.prop, change.value);
             if (ok && s_verbose)
             {
@@ -1523,7 +1204,7 @@ int applyChange(DataTableUtil& dt, const DefChange& change)
     return applied;
 }
 
-int applyDelete(DataTableUtil& dt, const DefDelete& del)
+int applyDelete(DataTableUtil& dt, const DefDelete& del, DefApplyContext& ctx)
 {
     if (!dt.isBound()) return 0;
 
@@ -1531,10 +1212,34 @@ int applyDelete(DataTableUtil& dt, const DefDelete& del)
     std::wstring wProp(del.property.begin(), del.property.end());
 
     uint8_t* rowData = dt.findRowData(wItem.c_str());
-    if (!rowData) return 0;
+    if (!rowData)
+    {
+        if (ctx.dryRun) ctx.record("delete", del.item, del.property, "", "-" + std::string(del.value), "row_missing");
+        return 0;
+    }
 
     int off = dt.resolvePropertyOffset(wProp.c_str());
-    if (off < 0) return 0;
+    if (off < 0)
+    {
+        if (ctx.dryRun) ctx.record("delete", del.item, del.property, "", "-" + std::string(del.value), "property_missing");
+        return 0;
+    }
+
+    if (ctx.dryRun)
+    {
+        auto field = dt.locateFieldWithProp(wItem.c_str(), wProp.c_str());
+        std::string oldValue = field.prop ? readFieldAsString(rowData + off, field.prop) : "<raw>";
+        bool present = findGameplayTagIndex(rowData + off, del.value) >= 0;
+        ctx.record("delete", del.item, del.property, std::move(oldValue), "-" + std::string(del.value),
+                   present ? "ok" : "tag_missing");
+        return present ? 1 : 0;
+    }
+
+    if (ctx.undo && findGameplayTagIndex(rowData + off, del.value) >= 0)
+    {
+        auto field = dt.locateFieldWithProp(wItem.c_str(), wProp.c_str());
+        captureUndo(ctx, wItem, del.property, rowData + off, field.prop);
+    }
 
     bool ok = removeGameplayTag(rowData + off, del.value);
     if (ok && s_verbose)
@@ -1664,7 +1369,7 @@ void saveGameMods(const std::vector<GameModEntry>& entries)
     }
 
     file << "; Game Mods Configuration\n";
-    file << "; Managed by MoriaCppMod — changes take effect on next game launch\n\n";
+    file << "; Managed by MoriaCppMod — toggles apply in-world; rows added by a pack stay until restart\n\n";
     file << "[EnabledMods]\n";
     for (auto& e : entries)
         file << e.name << " = " << (e.enabled ? "true" : "false") << "\n";
@@ -1697,121 +1402,274 @@ static std::vector<std::string> readEnabledMods(const std::string& gameModsPath)
 }
 
 
-void loadAndApplyDefinitions()
+// Serialize the whole dry-run diff in memory and write it with a single
+// file write, next to GameMods.ini consumers in the mod folder.
+void writeDefinitionDiff(const std::vector<DefDiffEntry>& diff)
 {
+    bool csv = (m_defDryRun == DefDryRun::Csv);
+    std::string path = modPath(csv ? "Mods/MoriaCppMod/definitions_dryrun.csv"
+                                   : "Mods/MoriaCppMod/definitions_dryrun.json");
+    std::string body = csv ? formatDefDiffCsv(diff) : formatDefDiffJson(diff);
 
-    auto enabledMods = readEnabledMods(gameModsIniPath());
-    if (enabledMods.empty())
+    std::ofstream file = openOutputFile(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
     {
-        VLOG(STR("[MoriaCppMod] [Def] No mods enabled in Mods/GameMods.ini (or file not found)\n"));
+        RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Def] Failed to write dry-run diff to {}\n"),
+                                                utf8ToWide(path));
         return;
     }
+    file.write(body.data(), static_cast<std::streamsize>(body.size()));
+    RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Def] Dry-run diff ({} rows) written to {}\n"),
+                                            diff.size(), utf8ToWide(path));
+}
 
 
-    // v6.4.3 (hotfix) — wide API for Steam ™ path compatibility
-    WIN32_FIND_DATAW fd;
-    std::wstring testPathW = utf8PathToWide(definitionsDir() + "\\*");
-    HANDLE hTest = FindFirstFileW(testPathW.c_str(), &fd);
-    if (hTest == INVALID_HANDLE_VALUE)
+// Parse one pack's manifest and apply every .def it lists. Used by the
+// one-shot load and by the Game Mods toggle, so a toggle costs only that
+// pack's operations.
+bool applyDefinitionPack(const std::string& modName, DefApplyContext& ctx)
+{
+    std::string iniPath = definitionsDir() + "\\" + modName + ".ini";
+    std::ifstream testFile = openInputFile(iniPath);
+    if (!testFile.is_open())
     {
-        VLOG(STR("[MoriaCppMod] [Def] No definitions directory found at Mods/MoriaCppMod/definitions/\n"));
-        return;
+        RC::Output::send<RC::LogLevel::Warning>(
+            STR("[MoriaCppMod] [Def] Manifest '{}' not found at {}\n"),
+            std::wstring(modName.begin(), modName.end()),
+            std::wstring(iniPath.begin(), iniPath.end()));
+        return false;
     }
-    FindClose(hTest);
+    testFile.close();
 
-    RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Def] {} mods enabled in GameMods.ini\n"),
-        enabledMods.size());
-
-    int totalManifests = 0;
-    int totalAddRows = 0;
-    int totalChanges = 0;
-    int totalDeletes = 0;
-    int totalApplied = 0;
-    std::unordered_map<std::string, DataTableUtil> dynamicTables;
+    DefManifest manifest = parseManifest(iniPath, definitionsDir());
+    if (manifest.defPaths.empty())
+    {
+        VLOG(STR("[MoriaCppMod] [Def] Manifest '{}' has no .def paths, skipping\n"),
+             std::wstring(modName.begin(), modName.end()));
+        return false;
+    }
 
-    std::unordered_map<std::string, std::string> tablesWithAddRows;
+    ctx.manifests++;
+    ctx.pack = modName;
+    ctx.undo = ctx.dryRun ? nullptr : &m_defUndo[modName];
+    std::string displayName = manifest.title.empty() ? modName : manifest.title;
+    RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Def] Loading '{}' ({} defs)\n"),
+        std::wstring(displayName.begin(), displayName.end()),
+        manifest.defPaths.size());
 
-    for (auto& modName : enabledMods)
+    for (auto& defPath : manifest.defPaths)
     {
+        DefDefinition def = parseDef(defPath, ctx.arena.resource());
+        if (def.mods.empty()) continue;
 
-        std::string iniPath = definitionsDir() + "\\" + modName + ".ini";
-        std::ifstream testFile = openInputFile(iniPath);
-        if (!testFile.is_open())
+        for (auto& mod : def.mods)
         {
-            RC::Output::send<RC::LogLevel::Warning>(
-                STR("[MoriaCppMod] [Def] Manifest '{}' not found at {}\n"),
-                std::wstring(modName.begin(), modName.end()),
-                std::wstring(iniPath.begin(), iniPath.end()));
+            std::string dtName = extractDataTableName(mod.filePath);
+            if (dtName.empty())
+            {
+                VLOG(STR("[MoriaCppMod] [Def] Cannot extract DT name from '{}'\n"),
+                     std::wstring(mod.filePath.begin(), mod.filePath.end()));
+                continue;
+            }
+
+            ctx.table = dtName;
+            DataTableUtil& dt = getOrBindDataTable(dtName, ctx.tables);
+            if (!dt.isBound())
+            {
+                VLOG(STR("[MoriaCppMod] [Def] DataTable '{}' not found in game — skipping\n"),
+                     std::wstring(dtName.begin(), dtName.end()));
+                if (ctx.dryRun)
+                {
+                    for (auto& ar : mod.addRows) ctx.record("add_row", ar.rowName, "*", "", "", "table_missing");
+                    for (auto& del : mod.deletes) ctx.record("delete", del.item, del.property, "", "-" + std::string(del.value), "table_missing");
+                    for (auto& change : mod.changes) ctx.record("change", change.item, change.property, "", change.value, "table_missing");
+                }
+                continue;
+            }
+
+
+            for (auto& ar : mod.addRows)
+            {
+                ctx.addRows++;
+                ctx.applied += applyAddRow(dt, ar, ctx);
+
+                if (!ctx.dryRun && ctx.tablesWithAddRows.find(dtName) == ctx.tablesWithAddRows.end())
+                    ctx.tablesWithAddRows[dtName] = std::string(ar.rowName);
+            }
+
+
+            for (auto& del : mod.deletes)
+            {
+                ctx.deletes++;
+                ctx.applied += applyDelete(dt, del, ctx);
+            }
+
+
+            for (auto& change : mod.changes)
+            {
+                ctx.changes++;
+                ctx.applied += applyChange(dt, change, ctx);
+            }
+        }
+    }
+    return true;
+}
+
+
+// Undo one pack's writes in reverse order. When a later pack also wrote a
+// field, its captured original becomes ours and the live value is left alone.
+int revertDefinitionPack(const std::string& modName)
+{
+    auto it = m_defUndo.find(modName);
+    if (it == m_defUndo.end()) return 0;
+    DefPackUndo& undo = it->second;
+
+    std::unordered_map<std::string, DataTableUtil> tables;
+    int restored = 0, handedOff = 0;
+    for (size_t i = undo.entries.size(); i-- > 0;)
+    {
+        DefUndoEntry& e = undo.entries[i];
+        std::string key = defFieldKey(e.table, e.row, e.property);
+        auto& writers = m_defFieldWriters[key];
+        auto pos = std::find(writers.begin(), writers.end(), modName);
+        if (pos != writers.end() && pos + 1 != writers.end())
+        {
+            auto above = m_defUndo.find(*(pos + 1));
+            if (above != m_defUndo.end())
+            {
+                auto idx = above->second.byField.find(key);
+                if (idx != above->second.byField.end())
+                {
+                    DefUndoEntry& theirs = above->second.entries[idx->second];
+                    theirs.original = e.original;
+                    theirs.raw = e.raw;
+                    theirs.rawOriginal = e.rawOriginal;
+                }
+            }
+            writers.erase(pos);
+            handedOff++;
             continue;
         }
-        testFile.close();
+        if (pos != writers.end()) writers.erase(pos);
+        if (writers.empty()) m_defFieldWriters.erase(key);
 
-        DefManifest manifest = parseManifest(iniPath, definitionsDir());
-        if (manifest.defPaths.empty())
+        DataTableUtil& dt = getOrBindDataTable(e.table, tables);
+        if (!dt.isBound()) continue;
+        uint8_t* rowData = dt.findRowData(e.row.c_str());
+        if (!rowData || !dt.rowStruct) continue;
+
+        if (e.raw)
         {
-            VLOG(STR("[MoriaCppMod] [Def] Manifest '{}' has no .def paths, skipping\n"),
-                 std::wstring(modName.begin(), modName.end()));
+            std::wstring wProp(e.property.begin(), e.property.end());
+            int off = dt.resolvePropertyOffset(wProp.c_str());
+            if (off < 0 || !isReadableMemory(rowData + off, 4)) continue;
+            std::memcpy(rowData + off, &e.rawOriginal, 4);
+            restored++;
             continue;
         }
 
-        totalManifests++;
-        std::string displayName = manifest.title.empty() ? modName : manifest.title;
-        RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Def] Loading '{}' ({} defs)\n"),
-            std::wstring(displayName.begin(), displayName.end()),
-            manifest.defPaths.size());
+        ResolvedField field{};
+        if (e.property.find('.') == std::string::npos && e.property.find('[') == std::string::npos)
+        {
+            std::wstring wProp(e.property.begin(), e.property.end());
+            auto located = dt.locateFieldWithProp(e.row.c_str(), wProp.c_str());
+            if (located.data && located.prop) field = {located.data + located.off, located.prop};
+        }
+        else
+        {
+            field = resolveNestedProperty(rowData, dt.rowStruct, e.property);
+        }
+        if (!field.data || !field.prop) continue;
 
-        for (auto& defPath : manifest.defPaths)
+        bool ok = false;
+        try
         {
-            DefDefinition def = parseDef(defPath);
-            if (def.mods.empty()) continue;
+            if (e.original.empty()) { field.prop->ClearValue(field.data); ok = true; }
+            else ok = field.prop->ImportText_Direct(e.original.c_str(), field.data, nullptr, 0, nullptr) != nullptr;
+        }
+        catch (...) {}
+        if (ok) restored++;
+    }
 
-            for (auto& mod : def.mods)
-            {
-                std::string dtName = extractDataTableName(mod.filePath);
-                if (dtName.empty())
-                {
-                    VLOG(STR("[MoriaCppMod] [Def] Cannot extract DT name from '{}'\n"),
-                         std::wstring(mod.filePath.begin(), mod.filePath.end()));
-                    continue;
-                }
+    if (!undo.addedRows.empty())
+        RC::Output::send<RC::LogLevel::Warning>(
+            STR("[MoriaCppMod] [Def] '{}': {} added rows stay in place until restart\n"),
+            utf8ToWide(modName), undo.addedRows.size());
 
-                DataTableUtil& dt = getOrBindDataTable(dtName, dynamicTables);
-                if (!dt.isBound())
-                {
-                    VLOG(STR("[MoriaCppMod] [Def] DataTable '{}' not found in game — skipping\n"),
-                         std::wstring(dtName.begin(), dtName.end()));
-                    continue;
-                }
+    for (auto& [name, dt] : tables)
+        dt.unbind();
+    m_defUndo.erase(it);
 
+    RC::Output::send<RC::LogLevel::Warning>(
+        STR("[MoriaCppMod] [Def] Reverted '{}': {} fields restored, {} handed to later packs\n"),
+        utf8ToWide(modName), restored, handedOff);
+    return restored;
+}
 
-                for (auto& ar : mod.addRows)
-                {
-                    totalAddRows++;
-                    int ok = applyAddRow(dt, ar);
-                    totalApplied += ok;
 
-                    if (tablesWithAddRows.find(dtName) == tablesWithAddRows.end())
-                        tablesWithAddRows[dtName] = ar.rowName;
-                }
+// Game Mods tab toggle. Persists GameMods.ini and, once the load-time apply
+// has run, applies or reverts just the toggled pack.
+void onGameModToggled(int idx)
+{
+    if (idx < 0 || idx >= static_cast<int>(m_ftGameModEntries.size())) return;
+    saveGameMods(m_ftGameModEntries);
+    if (!m_definitionsApplied || m_defDryRun != DefDryRun::Off) return;
 
+    const GameModEntry& entry = m_ftGameModEntries[idx];
+    if (entry.enabled)
+    {
+        DefApplyContext ctx;
+        if (applyDefinitionPack(entry.name, ctx))
+        {
+            for (auto& [name, dt] : ctx.tables)
+                dt.unbind();
+            RC::Output::send<RC::LogLevel::Warning>(
+                STR("[MoriaCppMod] [Def] Applied '{}' at runtime: {} add_rows + {} changes + {} deletes = {} applied (arena {} KB)\n"),
+                utf8ToWide(entry.name), ctx.addRows, ctx.changes, ctx.deletes, ctx.applied, ctx.arena.peakBytes() / 1024);
+        }
+    }
+    else
+    {
+        revertDefinitionPack(entry.name);
+    }
+}
 
-                for (auto& del : mod.deletes)
-                {
-                    totalDeletes++;
-                    int n = applyDelete(dt, del);
-                    totalApplied += n;
-                }
 
+void loadAndApplyDefinitions()
+{
 
-                for (auto& change : mod.changes)
-                {
-                    totalChanges++;
-                    int n = applyChange(dt, change);
-                    totalApplied += n;
-                }
-            }
-        }
+    auto enabledMods = readEnabledMods(gameModsIniPath());
+    if (enabledMods.empty())
+    {
+        VLOG(STR("[MoriaCppMod] [Def] No mods enabled in Mods/GameMods.ini (or file not found)\n"));
+        return;
+    }
+
+
+    // v6.4.3 (hotfix) — wide API for Steam ™ path compatibility
+    WIN32_FIND_DATAW fd;
+    std::wstring testPathW = utf8PathToWide(definitionsDir() + "\\*");
+    HANDLE hTest = FindFirstFileW(testPathW.c_str(), &fd);
+    if (hTest == INVALID_HANDLE_VALUE)
+    {
+        VLOG(STR("[MoriaCppMod] [Def] No definitions directory found at Mods/MoriaCppMod/definitions/\n"));
+        return;
     }
+    FindClose(hTest);
+
+    RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Def] {} mods enabled in GameMods.ini\n"),
+        enabledMods.size());
+
+    DefApplyContext ctx;
+    ctx.dryRun = (m_defDryRun != DefDryRun::Off);
+    if (ctx.dryRun)
+        RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Def] DRY RUN — no DataTable will be modified\n"));
+
+    for (auto& modName : enabledMods)
+        applyDefinitionPack(modName, ctx);
+
+    auto& dynamicTables = ctx.tables;
+    auto& tablesWithAddRows = ctx.tablesWithAddRows;
 
 
     // The post-apply add-row verification dump below is a ~280-line
@@ -2124,7 +1982,20 @@ void loadAndApplyDefinitions()
     for (auto& [name, dt] : dynamicTables)
         dt.unbind();
 
+    if (ctx.dryRun)
+    {
+        writeDefinitionDiff(ctx.diff);
+        RC::Output::send<RC::LogLevel::Warning>(
+            STR("[MoriaCppMod] [Def] Dry run done: {} manifests, {} add_rows + {} changes + {} deletes = {} would apply ({} diff rows)\n"),
+            ctx.manifests, ctx.addRows, ctx.changes, ctx.deletes, ctx.applied, ctx.diff.size());
+        RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Def] Parse arena: peak {} KB, {} allocations\n"),
+            ctx.arena.peakBytes() / 1024, ctx.arena.allocations());
+        return;
+    }
+
     RC::Output::send<RC::LogLevel::Warning>(
         STR("[MoriaCppMod] [Def] Done: {} manifests, {} add_rows + {} changes + {} deletes = {} applied\n"),
-        totalManifests, totalAddRows, totalChanges, totalDeletes, totalApplied);
+        ctx.manifests, ctx.addRows, ctx.changes, ctx.deletes, ctx.applied);
+    RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Def] Parse arena: peak {} KB, {} allocations\n"),
+        ctx.arena.peakBytes() / 1024, ctx.arena.allocations());
 }
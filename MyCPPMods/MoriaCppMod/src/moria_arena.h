@@ -0,0 +1,82 @@
+
+
+
+#pragma once
+#ifndef MORIA_ARENA_H
+#define MORIA_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+
+namespace MoriaMods
+{
+
+    // memory_resource pass-through that counts what flows through it.
+    class CountingResource : public std::pmr::memory_resource
+    {
+      public:
+        explicit CountingResource(std::pmr::memory_resource* upstream) : m_upstream(upstream) {}
+
+        size_t allocations() const { return m_allocations; }
+        size_t liveBytes() const { return m_liveBytes; }
+        size_t peakBytes() const { return m_peakBytes; }
+
+      private:
+        std::pmr::memory_resource* m_upstream;
+        size_t m_allocations{0};
+        size_t m_liveBytes{0};
+        size_t m_peakBytes{0};
+
+        void* do_allocate(size_t bytes, size_t align) override
+        {
+            void* p = m_upstream->allocate(bytes, align);
+            m_allocations++;
+            m_liveBytes += bytes;
+            m_peakBytes = std::max(m_peakBytes, m_liveBytes);
+            return p;
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t align) override
+        {
+            m_upstream->deallocate(p, bytes, align);
+            m_liveBytes -= bytes;
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    // Monotonic arena for one definitions load. Everything the parse phase
+    // builds (file text, XML tree, Def* structs, add-row JSON indexes) is
+    // allocated here and dropped in one shot when the arena dies — nothing is
+    // freed piecemeal in between.
+    //
+    //   allocations() — requests served (strings, vectors, node arrays)
+    //   peakBytes()   — heap actually reserved from the system, in blocks
+    class DefArena
+    {
+      public:
+        static constexpr size_t INITIAL_BLOCK = 64 * 1024;
+
+        DefArena() = default;
+        DefArena(const DefArena&) = delete;
+        DefArena& operator=(const DefArena&) = delete;
+
+        std::pmr::memory_resource* resource() { return &m_front; }
+        size_t allocations() const { return m_front.allocations(); }
+        size_t peakBytes() const { return m_heap.peakBytes(); }
+
+        void release() { m_mono.release(); }
+
+      private:
+        CountingResource m_heap{std::pmr::new_delete_resource()};
+        std::pmr::monotonic_buffer_resource m_mono{INITIAL_BLOCK, &m_heap};
+        CountingResource m_front{&m_mono};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_ARENA_H
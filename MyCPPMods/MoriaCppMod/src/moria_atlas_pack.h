@@ -0,0 +1,150 @@
+
+
+
+#pragma once
+#ifndef MORIA_ATLAS_PACK_H
+#define MORIA_ATLAS_PACK_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Shelf packing of keyed icon rects into one power-of-two atlas, with the
+// UV box for each key's FSlateBrush.
+
+namespace MoriaMods
+{
+
+    struct AtlasItem
+    {
+        std::wstring key;
+        int w{0};
+        int h{0};
+
+        bool operator==(const AtlasItem& o) const { return w == o.w && h == o.h && key == o.key; }
+    };
+
+    struct AtlasSlot
+    {
+        int x{0}, y{0}, w{0}, h{0};
+        float u0{0}, v0{0}, u1{0}, v1{0};
+    };
+
+    class AtlasLayout
+    {
+      public:
+        // Smallest power-of-two atlas (by area, then squarest) that holds
+        // every item; !ok() if one does not fit within maxSide.
+        static AtlasLayout pack(std::vector<AtlasItem> items, int padding = 2, int maxSide = 2048)
+        {
+            AtlasLayout best;
+            best.m_items = items;
+            best.m_padding = padding;
+            if (items.empty()) return best;
+
+            // Tallest first (then widest, then key) so shelves waste little
+            // height and the result does not depend on request order.
+            std::vector<size_t> order(items.size());
+            std::iota(order.begin(), order.end(), size_t(0));
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                if (items[a].h != items[b].h) return items[a].h > items[b].h;
+                if (items[a].w != items[b].w) return items[a].w > items[b].w;
+                return items[a].key < items[b].key;
+            });
+
+            for (int side = 16; side <= maxSide; side *= 2)
+            {
+                std::vector<AtlasSlot> slots(items.size());
+                int usedH = 0;
+                if (!shelfPack(items, order, padding, side, maxSide, slots, usedH)) continue;
+                int h = 16;
+                while (h < usedH) h *= 2;
+                long long area = (long long)side * h;
+                long long bestArea = (long long)best.m_width * best.m_height;
+                if (best.m_width == 0 || area < bestArea ||
+                    (area == bestArea && std::abs(side - h) < std::abs(best.m_width - best.m_height)))
+                {
+                    best.m_width = side;
+                    best.m_height = h;
+                    best.m_slots = std::move(slots);
+                }
+            }
+            for (auto& s : best.m_slots)
+            {
+                s.u0 = float(s.x) / best.m_width;
+                s.v0 = float(s.y) / best.m_height;
+                s.u1 = float(s.x + s.w) / best.m_width;
+                s.v1 = float(s.y + s.h) / best.m_height;
+            }
+            return best;
+        }
+
+        bool ok() const { return !m_items.empty() && m_width > 0; }
+        int width() const { return m_width; }
+        int height() const { return m_height; }
+        int padding() const { return m_padding; }
+        size_t size() const { return m_items.size(); }
+
+        // Request order, parallel to slot(i).
+        const std::vector<AtlasItem>& items() const { return m_items; }
+        const AtlasSlot& slot(size_t i) const { return m_slots[i]; }
+
+        const AtlasSlot* find(std::wstring_view key) const
+        {
+            if (!ok()) return nullptr;
+            for (size_t i = 0; i < m_items.size(); i++)
+                if (m_items[i].key == key) return &m_slots[i];
+            return nullptr;
+        }
+
+        // Same keys and sizes in the same order: the existing atlas (and every
+        // brush UV pointing into it) can be redrawn in place.
+        bool sameItems(const std::vector<AtlasItem>& items) const { return ok() && items == m_items; }
+
+        // Share of the atlas covered by item pixels (gutters excluded).
+        float occupancy() const
+        {
+            if (!ok()) return 0.0f;
+            long long px = 0;
+            for (auto& it : m_items) px += (long long)it.w * it.h;
+            return float(px) / (float(m_width) * m_height);
+        }
+
+      private:
+        static bool shelfPack(const std::vector<AtlasItem>& items, const std::vector<size_t>& order, int pad, int width,
+                              int maxSide, std::vector<AtlasSlot>& slots, int& usedH)
+        {
+            int shelfX = 0, shelfY = 0, shelfH = 0;
+            for (size_t i : order)
+            {
+                int cw = items[i].w + pad * 2, ch = items[i].h + pad * 2;
+                if (items[i].w <= 0 || items[i].h <= 0 || cw > width) return false;
+                if (shelfX + cw > width)
+                {
+                    shelfY += shelfH;
+                    shelfX = 0;
+                    shelfH = 0;
+                }
+                if (shelfY + ch > maxSide) return false;
+                slots[i] = {shelfX + pad, shelfY + pad, items[i].w, items[i].h};
+                shelfX += cw;
+                shelfH = std::max(shelfH, ch);
+            }
+            usedH = shelfY + shelfH;
+            return true;
+        }
+
+        std::vector<AtlasItem> m_items;
+        std::vector<AtlasSlot> m_slots;
+        int m_width{0};
+        int m_height{0};
+        int m_padding{0};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_ATLAS_PACK_H
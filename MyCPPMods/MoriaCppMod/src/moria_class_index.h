@@ -0,0 +1,84 @@
+
+
+
+#pragma once
+#ifndef MORIA_CLASS_INDEX_H
+#define MORIA_CLASS_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Short-name -> class index over GUObjectArray that only scans slots added
+// since the last scan, remembering misses until the array grows.
+
+namespace MoriaMods
+{
+
+    template <typename ClassPtr>
+    class IncrementalClassIndex
+    {
+      public:
+        int32_t highWater() const { return m_highWater; }
+        size_t size() const { return m_byName.size(); }
+
+        // Visit slots [highWater, numElements). `probe(idx, add)` inspects
+        // one slot and calls add(shortName, cls) for each class to index.
+        // The first class seen under a name wins, as with the old full scan.
+        // Returns the number of classes added.
+        template <typename Probe>
+        int scanTo(int32_t numElements, Probe&& probe)
+        {
+            int added = 0;
+            auto add = [&](std::wstring_view name, ClassPtr cls) {
+                if (name.empty()) return;
+                if (m_byName.try_emplace(std::wstring(name), cls).second) added++;
+            };
+            for (int32_t i = m_highWater; i < numElements; i++)
+                probe(i, add);
+            if (numElements > m_highWater) m_highWater = numElements;
+            return added;
+        }
+
+        // Indexed class, or nullptr.
+        ClassPtr find(std::wstring_view name) const
+        {
+            auto it = m_byName.find(std::wstring(name));
+            return it != m_byName.end() ? it->second : ClassPtr{};
+        }
+
+        // Drop a stale entry (e.g. the class was garbage-collected).
+        void erase(std::wstring_view name) { m_byName.erase(std::wstring(name)); }
+
+        // Remember that `name` wasn't found with the array at its current
+        // high-water mark.
+        void recordMiss(std::wstring_view name) { m_misses[std::wstring(name)] = m_highWater; }
+
+        // True while `name` is a known miss and the array hasn't grown since.
+        bool knownMissing(std::wstring_view name, int32_t numElements) const
+        {
+            auto it = m_misses.find(std::wstring(name));
+            return it != m_misses.end() && numElements <= it->second;
+        }
+
+        // Rescan from slot 0 next time (keeps entries and misses). For slot
+        // reuse below the mark, which plain growth can't reveal.
+        void rewind() { m_highWater = 0; m_misses.clear(); }
+
+        void clear()
+        {
+            m_byName.clear();
+            m_misses.clear();
+            m_highWater = 0;
+        }
+
+      private:
+        std::unordered_map<std::wstring, ClassPtr> m_byName;
+        std::unordered_map<std::wstring, int32_t> m_misses;
+        int32_t m_highWater{0};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_CLASS_INDEX_H
@@ -6,13 +6,17 @@
 
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstring>
+#include <deque>
 #include <fstream>
 #include <format>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <unordered_map>
@@ -55,8 +59,29 @@
 #include <Unreal/Property/FObjectProperty.hpp>
 #include <Unreal/Property/FArrayProperty.hpp>
 #include <Unreal/UEnum.hpp>
+#include <Unreal/UObjectArray.hpp>
 
 #include "moria_testable.h"
+#include "moria_json.h"
+#include "moria_arena.h"
+#include "moria_defparse.h"
+#include "moria_class_index.h"
+#include "moria_name_filter.h"
+#include "moria_pacing.h"
+#include "moria_grid_cluster.h"
+#include "moria_stability_monitor.h"
+#include "moria_lru_pool.h"
+#include "moria_inventory_index.h"
+#include "moria_icon_cache.h"
+#include "moria_overlay_frame.h"
+#include "moria_compositor.h"
+#include "moria_overlay_paint.h"
+#include "moria_triple_buffer.h"
+#include "moria_atlas_pack.h"
+#include "moria_icon_store.h"
+#include "moria_removal_list.h"
+#include "moria_widget_pool.h"
+#include "moria_ui_tree.h"
 
 namespace MoriaMods
 {
@@ -191,6 +216,7 @@ namespace MoriaMods
     static constexpr int BRUSH_IMAGE_SIZE_X = 0x08;
     static constexpr int BRUSH_IMAGE_SIZE_Y = 0x0C;
     static constexpr int BRUSH_RESOURCE_OBJECT = 0x48;
+    static constexpr int BRUSH_UV_REGION = 0x58;        // FBox2D: Min, Max, bIsValid
     static constexpr int FONT_TYPEFACE_NAME = 0x40;
     static constexpr int FONT_SIZE = 0x48;
     static constexpr int FONT_STRUCT_SIZE = 0x58;
@@ -331,10 +357,10 @@ namespace MoriaMods
     struct OverlaySlot
     {
         std::wstring displayName;
-        std::wstring textureName;
-        std::shared_ptr<Gdiplus::Image> icon;
+        std::wstring textureName;   // icon resolved via s_iconCache at draw time
         bool used{false};
     };
+    using OverlaySlots = std::array<OverlaySlot, OVERLAY_BUILD_SLOTS>;
 
     struct OverlayState
     {
@@ -342,17 +368,31 @@ namespace MoriaMods
         HWND gameHwnd{nullptr};
         HANDLE thread{nullptr};
         std::atomic<bool> running{false};
-        std::atomic<bool> needsUpdate{true};
         std::atomic<bool> visible{true};
-        CRITICAL_SECTION slotCS;
-        OverlaySlot slots[OVERLAY_SLOTS]{};
-        std::atomic<bool> csInit{false};
+        HANDLE wakeEvent{nullptr};   // auto-reset; the overlay thread sleeps on it
+        OverlaySlots slots{};                  // game thread's working copy
+        TripleBuffer<OverlaySlots> published;  // lock-free hand-off to the overlay thread
         ULONG_PTR gdipToken{0};
         std::wstring iconFolder;
         std::atomic<int> rotationStep{5};
         std::atomic<int> totalRotation{0};
+        std::atomic<int> stabMarginal{-1};   // stability monitor counts; -1 = monitor off
+        std::atomic<int> stabCritical{-1};
+
+        // Any thread, after changing state the overlay shows: wakes the
+        // overlay thread for one frame. Repeated calls before it runs coalesce.
+        void requestUpdate()
+        {
+            if (wakeEvent) SetEvent(wakeEvent);
+        }
     };
     inline OverlayState s_overlay;
+    // Decoded overlay/quick-build icons, shared by texture name; filled by
+    // its own worker thread so neither the game nor overlay thread decodes.
+    inline IconCache<ArgbImage> s_iconCache{64};
+    // Extracted icons on disk (icons.pack + icons.manifest in iconFolder);
+    // written by the batched extractor, read by the icon worker.
+    inline IconStore s_iconStore;
 
     namespace Loc
     {
@@ -0,0 +1,565 @@
+
+
+
+#pragma once
+#ifndef MORIA_COMPOSITOR_H
+#define MORIA_COMPOSITOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Software ARGB32 compositor for the overlay. Pixels are premultiplied
+// 0xAARRGGBB (B,G,R,A in memory) - the layout of a 32 bpp DIB section and
+// of UpdateLayeredWindow's AC_SRC_ALPHA - so the Win32 side wraps its DIB
+// bits in a Surface and only presents the finished buffer.
+//
+// Primitives: rect fill (source-over or copy), rect stroke, anti-aliased
+// round rect / ellipse / ring (4x4 supersampling on edge pixels only),
+// polygon fill with exact horizontal coverage over 4 sub-scanlines
+// (non-zero winding, so edge quads union into strokes), bilinear image
+// blits and A8 mask blits for text. GlyphAtlas packs glyph masks from a
+// pluggable rasterizer (GDI+ in game, builtinGlyphs() here) into one page.
+//
+// Every primitive counts the pixels it writes (pixelsWritten()) so render
+// cost can be bounded in tests, not just timed.
+//
+// Pure (no Win32/GDI+): tested in tests/test_compositor.cpp, benchmarked by
+// tests/bench_overlay.cpp.
+
+namespace MoriaMods
+{
+
+    inline uint32_t div255(uint32_t x)
+    {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+    // Straight-alpha colour -> premultiplied pixel.
+    inline uint32_t premul(uint8_t a, uint8_t r, uint8_t g, uint8_t b)
+    {
+        return (uint32_t(a) << 24) | (div255(r * a) << 16) | (div255(g * a) << 8) | div255(b * a);
+    }
+
+    // All four channels of a premultiplied pixel times cov/255.
+    inline uint32_t scalePixel(uint32_t p, uint32_t cov)
+    {
+        uint32_t rb = (p & 0x00FF00FF) * cov;
+        uint32_t ag = ((p >> 8) & 0x00FF00FF) * cov;
+        rb = ((rb + 0x00800080 + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+        ag = (ag + 0x00800080 + ((ag >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+        return rb | ag;
+    }
+
+    // Porter-Duff source-over, both premultiplied; src scaled by coverage.
+    inline uint32_t blendOver(uint32_t dst, uint32_t src, uint32_t cov = 255)
+    {
+        if (cov < 255) src = scalePixel(src, cov);
+        uint32_t sa = src >> 24;
+        if (sa == 0) return dst;
+        if (sa == 255) return src;
+        return src + scalePixel(dst, 255 - sa);
+    }
+
+    struct ArgbImage
+    {
+        int width{0};
+        int height{0};
+        std::vector<uint32_t> pixels;   // premultiplied, row-major, no padding
+    };
+
+    struct PointF
+    {
+        float x, y;
+    };
+
+    enum class Blend : uint8_t { Over, Copy };
+
+    class Surface
+    {
+      public:
+        Surface() = default;
+        Surface(int w, int h) : m_own(size_t(std::max(w, 0)) * std::max(h, 0), 0), m_w(w), m_h(h), m_stride(w)
+        {
+            m_px = m_own.data();
+        }
+
+        // View over caller-owned memory (e.g. DIB bits); stride in pixels.
+        static Surface wrap(uint32_t* px, int w, int h, int stride)
+        {
+            Surface s;
+            s.m_px = px;
+            s.m_w = w;
+            s.m_h = h;
+            s.m_stride = stride;
+            return s;
+        }
+
+        Surface(const Surface&) = delete;
+        Surface& operator=(const Surface&) = delete;
+        Surface(Surface&&) = default;
+        Surface& operator=(Surface&&) = default;
+
+        int width() const { return m_w; }
+        int height() const { return m_h; }
+        int stride() const { return m_stride; }
+        uint32_t* data() { return m_px; }
+        const uint32_t* data() const { return m_px; }
+        uint32_t pixel(int x, int y) const { return m_px[size_t(y) * m_stride + x]; }
+        uint64_t pixelsWritten() const { return m_written; }
+        void resetStats() { m_written = 0; }
+
+        void clear(uint32_t c = 0)
+        {
+            for (int y = 0; y < m_h; y++) std::fill_n(row(y), m_w, c);
+            m_written += uint64_t(m_w) * m_h;
+        }
+
+        void fillRect(int x, int y, int w, int h, uint32_t c, Blend mode = Blend::Over)
+        {
+            int x0 = std::max(x, 0), y0 = std::max(y, 0);
+            int x1 = std::min(x + w, m_w), y1 = std::min(y + h, m_h);
+            if (x0 >= x1 || y0 >= y1) return;
+            for (int py = y0; py < y1; py++)
+            {
+                uint32_t* r = row(py);
+                if (mode == Blend::Copy || (c >> 24) == 255)
+                    std::fill(r + x0, r + x1, c);
+                else
+                    for (int px = x0; px < x1; px++) r[px] = blendOver(r[px], c);
+            }
+            m_written += uint64_t(x1 - x0) * (y1 - y0);
+        }
+
+        // Outline of the rectangle whose edges run through x, x+w, y, y+h
+        // with a `t` px pen centred on them (GDI+ DrawRectangle geometry).
+        void strokeRect(int x, int y, int w, int h, int t, uint32_t c)
+        {
+            int lo = t / 2, hi = t - 1 - lo;
+            int ox = x - lo, oy = y - lo, ow = w + t, oh = h + t;
+            int ix = x + hi + 1, iy = y + hi + 1, iw = w - t, ih = h - t;
+            if (iw <= 0 || ih <= 0)
+            {
+                fillRect(ox, oy, ow, oh, c);
+                return;
+            }
+            fillRect(ox, oy, ow, iy - oy, c);                          // top
+            fillRect(ox, iy + ih, ow, oy + oh - (iy + ih), c);         // bottom
+            fillRect(ox, iy, ix - ox, ih, c);                          // left
+            fillRect(ix + iw, iy, ox + ow - (ix + iw), ih, c);         // right
+        }
+
+        void fillRoundRect(float x, float y, float w, float h, float r, uint32_t c)
+        {
+            r = std::clamp(r, 0.0f, std::min(w, h) * 0.5f);
+            float cx0 = x + r, cx1 = x + w - r, cy0 = y + r, cy1 = y + h - r;
+            auto inside = [=](float sx, float sy) {
+                if (sx < x || sx > x + w || sy < y || sy > y + h) return false;
+                float dx = sx < cx0 ? cx0 - sx : (sx > cx1 ? sx - cx1 : 0.0f);
+                float dy = sy < cy0 ? cy0 - sy : (sy > cy1 ? sy - cy1 : 0.0f);
+                return dx * dx + dy * dy <= r * r;
+            };
+            coverageFill(x, y, x + w, y + h, c, inside, true);
+        }
+
+        void fillEllipse(float cx, float cy, float rx, float ry, uint32_t c)
+        {
+            if (rx <= 0 || ry <= 0) return;
+            auto inside = [=](float sx, float sy) {
+                float dx = (sx - cx) / rx, dy = (sy - cy) / ry;
+                return dx * dx + dy * dy <= 1.0f;
+            };
+            coverageFill(cx - rx, cy - ry, cx + rx, cy + ry, c, inside, true);
+        }
+
+        // Circle outline of pen width `t` centred on radius r.
+        void strokeEllipse(float cx, float cy, float r, float t, uint32_t c)
+        {
+            float rIn = std::max(r - t * 0.5f, 0.0f), rOut = r + t * 0.5f;
+            auto inside = [=](float sx, float sy) {
+                float d2 = (sx - cx) * (sx - cx) + (sy - cy) * (sy - cy);
+                return d2 >= rIn * rIn && d2 <= rOut * rOut;
+            };
+            coverageFill(cx - rOut, cy - rOut, cx + rOut, cy + rOut, c, inside, false);
+        }
+
+        void fillPolygon(const std::vector<PointF>& pts, uint32_t c) { fillContours({pts}, c); }
+
+        // Non-zero union of several closed contours.
+        void fillContours(const std::vector<std::vector<PointF>>& contours, uint32_t c)
+        {
+            constexpr int kSub = 4;
+            float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+            for (auto& ct : contours)
+                for (auto& p : ct)
+                {
+                    minX = std::min(minX, p.x); maxX = std::max(maxX, p.x);
+                    minY = std::min(minY, p.y); maxY = std::max(maxY, p.y);
+                }
+            int x0 = std::max(int(std::floor(minX)), 0), x1 = std::min(int(std::ceil(maxX)), m_w);
+            int y0 = std::max(int(std::floor(minY)), 0), y1 = std::min(int(std::ceil(maxY)), m_h);
+            if (x0 >= x1 || y0 >= y1) return;
+
+            std::vector<std::pair<PointF, PointF>> edges;
+            for (auto& ct : contours)
+                for (size_t i = 0, n = ct.size(); i < n; i++)
+                    if (ct[i].y != ct[(i + 1) % n].y) edges.push_back({ct[i], ct[(i + 1) % n]});
+
+            std::vector<float> acc(size_t(x1 - x0) + 1);
+            std::vector<std::pair<float, int>> xs;
+            for (int py = y0; py < y1; py++)
+            {
+                std::fill(acc.begin(), acc.end(), 0.0f);
+                for (int s = 0; s < kSub; s++)
+                {
+                    float sy = py + (s + 0.5f) / kSub;
+                    xs.clear();
+                    for (auto& [a, b] : edges)
+                    {
+                        if ((a.y <= sy) == (b.y <= sy)) continue;
+                        float t = (sy - a.y) / (b.y - a.y);
+                        xs.push_back({a.x + t * (b.x - a.x), b.y > a.y ? 1 : -1});
+                    }
+                    std::sort(xs.begin(), xs.end(), [](auto& p, auto& q) { return p.first < q.first; });
+                    int wind = 0;
+                    for (size_t k = 0; k + 1 < xs.size(); k++)
+                    {
+                        wind += xs[k].second;
+                        if (wind != 0) addSpan(acc, x0, x1, xs[k].first, xs[k + 1].first);
+                    }
+                }
+                uint32_t* r = row(py);
+                for (int px = x0; px < x1; px++)
+                {
+                    float a = acc[px - x0] / kSub;
+                    if (a <= 0.0f) continue;
+                    uint32_t cov = a >= 1.0f ? 255u : uint32_t(a * 255.0f + 0.5f);
+                    r[px] = blendOver(r[px], c, cov);
+                    m_written++;
+                }
+            }
+        }
+
+        // Open polyline edges as `t` px wide quads, unioned.
+        void strokePolygon(const std::vector<PointF>& pts, float t, uint32_t c)
+        {
+            std::vector<std::vector<PointF>> quads;
+            for (size_t i = 0, n = pts.size(); i < n; i++) quads.push_back(lineQuad(pts[i], pts[(i + 1) % n], t));
+            fillContours(quads, c);
+        }
+
+        void drawLine(PointF a, PointF b, float t, uint32_t c) { fillContours({lineQuad(a, b, t)}, c); }
+
+        // Bilinear scaled blit of a premultiplied image into [dx, dx+dw) x [dy, dy+dh).
+        void blitImage(const ArgbImage& img, int dx, int dy, int dw, int dh)
+        {
+            if (img.width <= 0 || img.height <= 0 || dw <= 0 || dh <= 0) return;
+            int x0 = std::max(dx, 0), y0 = std::max(dy, 0);
+            int x1 = std::min(dx + dw, m_w), y1 = std::min(dy + dh, m_h);
+            if (x0 >= x1 || y0 >= y1) return;
+            if (dw == img.width && dh == img.height)
+            {
+                for (int py = y0; py < y1; py++)
+                {
+                    const uint32_t* s = &img.pixels[size_t(py - dy) * img.width];
+                    uint32_t* r = row(py);
+                    for (int px = x0; px < x1; px++) r[px] = blendOver(r[px], s[px - dx]);
+                }
+                m_written += uint64_t(x1 - x0) * (y1 - y0);
+                return;
+            }
+            // 16.16 fixed point source coordinates of destination pixel centres.
+            int64_t stepX = (int64_t(img.width) << 16) / dw, stepY = (int64_t(img.height) << 16) / dh;
+            for (int py = y0; py < y1; py++)
+            {
+                int64_t fy = (py - dy) * stepY + stepY / 2 - 0x8000;
+                int sy = int(std::clamp<int64_t>(fy >> 16, 0, img.height - 1));
+                int sy1 = std::min(sy + 1, img.height - 1);
+                uint32_t wy = fy < 0 ? 0 : uint32_t((fy >> 8) & 0xFF);
+                const uint32_t* r0 = &img.pixels[size_t(sy) * img.width];
+                const uint32_t* r1 = &img.pixels[size_t(sy1) * img.width];
+                uint32_t* r = row(py);
+                for (int px = x0; px < x1; px++)
+                {
+                    int64_t fx = (px - dx) * stepX + stepX / 2 - 0x8000;
+                    int sx = int(std::clamp<int64_t>(fx >> 16, 0, img.width - 1));
+                    int sx1 = std::min(sx + 1, img.width - 1);
+                    uint32_t wx = fx < 0 ? 0 : uint32_t((fx >> 8) & 0xFF);
+                    uint32_t top = lerpPixel(r0[sx], r0[sx1], wx);
+                    uint32_t bot = lerpPixel(r1[sx], r1[sx1], wx);
+                    r[px] = blendOver(r[px], lerpPixel(top, bot, wy));
+                }
+            }
+            m_written += uint64_t(x1 - x0) * (y1 - y0);
+        }
+
+        // A8 coverage mask tinted with premultiplied colour c.
+        void drawMask(const uint8_t* mask, int maskStride, int w, int h, int dx, int dy, uint32_t c)
+        {
+            int x0 = std::max(dx, 0), y0 = std::max(dy, 0);
+            int x1 = std::min(dx + w, m_w), y1 = std::min(dy + h, m_h);
+            for (int py = y0; py < y1; py++)
+            {
+                const uint8_t* m = mask + size_t(py - dy) * maskStride;
+                uint32_t* r = row(py);
+                for (int px = x0; px < x1; px++)
+                {
+                    uint8_t cov = m[px - dx];
+                    if (!cov) continue;
+                    r[px] = blendOver(r[px], c, cov);
+                    m_written++;
+                }
+            }
+        }
+
+      private:
+        uint32_t* row(int y) { return m_px + size_t(y) * m_stride; }
+
+        static uint32_t lerpPixel(uint32_t a, uint32_t b, uint32_t w)
+        {
+            if (w == 0 || a == b) return a;
+            return scalePixel(a, 255 - w) + scalePixel(b, w);
+        }
+
+        static std::vector<PointF> lineQuad(PointF a, PointF b, float t)
+        {
+            float dx = b.x - a.x, dy = b.y - a.y;
+            float len = std::sqrt(dx * dx + dy * dy);
+            if (len <= 0.0f) return {};
+            float nx = -dy / len * t * 0.5f, ny = dx / len * t * 0.5f;
+            // Same orientation for every quad so non-zero winding unions them.
+            std::vector<PointF> q{{a.x + nx, a.y + ny}, {b.x + nx, b.y + ny}, {b.x - nx, b.y - ny}, {a.x - nx, a.y - ny}};
+            float area = 0;
+            for (size_t i = 0; i < 4; i++) area += q[i].x * q[(i + 1) % 4].y - q[(i + 1) % 4].x * q[i].y;
+            if (area < 0) std::reverse(q.begin(), q.end());
+            return q;
+        }
+
+        // Exact coverage of [xa, xb) on one sub-scanline, added per pixel.
+        static void addSpan(std::vector<float>& acc, int x0, int x1, float xa, float xb)
+        {
+            xa = std::max(xa, float(x0));
+            xb = std::min(xb, float(x1));
+            if (xb <= xa) return;
+            int ia = int(xa), ib = int(xb);
+            if (ia == ib)
+            {
+                acc[ia - x0] += xb - xa;
+                return;
+            }
+            acc[ia - x0] += (ia + 1) - xa;
+            for (int i = ia + 1; i < ib; i++) acc[i - x0] += 1.0f;
+            if (ib < x1) acc[ib - x0] += xb - ib;
+        }
+
+        // Shape fill via inside(x, y), edge pixels 4x4 supersampled. For a
+        // convex shape each row is scanned in from both ends only until a
+        // pixel with all four corners inside; the span between is full.
+        template <typename Inside>
+        void coverageFill(float fx0, float fy0, float fx1, float fy1, uint32_t c, Inside&& inside, bool convex)
+        {
+            int x0 = std::max(int(std::floor(fx0)), 0), x1 = std::min(int(std::ceil(fx1)), m_w);
+            int y0 = std::max(int(std::floor(fy0)), 0), y1 = std::min(int(std::ceil(fy1)), m_h);
+            auto full = [&](int px, int py) {
+                return inside(float(px), float(py)) && inside(px + 1.0f, float(py)) && inside(float(px), py + 1.0f) &&
+                       inside(px + 1.0f, py + 1.0f);
+            };
+            auto sampled = [&](int px, int py) {
+                int n = 0;
+                for (int sy = 0; sy < 4; sy++)
+                    for (int sx = 0; sx < 4; sx++) n += inside(px + (sx + 0.5f) / 4, py + (sy + 0.5f) / 4) ? 1 : 0;
+                return (uint32_t(n) * 255 + 8) / 16;
+            };
+            auto put = [&](uint32_t* r, int px, uint32_t cov) {
+                if (!cov) return;
+                r[px] = blendOver(r[px], c, cov);
+                m_written++;
+            };
+            for (int py = y0; py < y1; py++)
+            {
+                uint32_t* r = row(py);
+                if (!convex)
+                {
+                    for (int px = x0; px < x1; px++) put(r, px, sampled(px, py));
+                    continue;
+                }
+                int a = x0;
+                while (a < x1 && !full(a, py)) put(r, a, sampled(a, py)), a++;
+                if (a == x1) continue;
+                int b = x1 - 1;
+                while (b > a && !full(b, py)) put(r, b, sampled(b, py)), b--;
+                for (int px = a; px <= b; px++) r[px] = blendOver(r[px], c);
+                m_written += uint64_t(b - a + 1);
+            }
+        }
+
+        std::vector<uint32_t> m_own;
+        uint32_t* m_px{nullptr};
+        int m_w{0};
+        int m_h{0};
+        int m_stride{0};
+        uint64_t m_written{0};
+    };
+
+    // Glyph masks for one font/size, packed on demand into a single A8
+    // page with a shelf packer. Every glyph cell is lineHeight() tall, so
+    // text layout is a sum of advances.
+    class GlyphAtlas
+    {
+      public:
+        struct Glyph
+        {
+            int x{0}, y{0}, w{0}, h{0};
+            int advance{0};
+        };
+
+        // Fills an A8 mask (w x h, row-major) for one character and its
+        // advance; false = no glyph (drawn as blank space).
+        using Rasterizer = std::function<bool(wchar_t c, std::vector<uint8_t>& mask, int& w, int& h, int& advance)>;
+
+        GlyphAtlas(Rasterizer rasterize, int lineHeight, int pageWidth = 256)
+            : m_rasterize(std::move(rasterize)), m_lineHeight(lineHeight), m_pageW(pageWidth)
+        {
+        }
+
+        const Glyph& glyph(wchar_t c)
+        {
+            auto it = m_glyphs.find(c);
+            if (it != m_glyphs.end()) return it->second;
+            Glyph g;
+            std::vector<uint8_t> mask;
+            int w = 0, h = 0, adv = 0;
+            if (m_rasterize && m_rasterize(c, mask, w, h, adv) && w > 0 && h > 0 && w <= m_pageW &&
+                mask.size() >= size_t(w) * h)
+            {
+                if (m_shelfX + w > m_pageW)
+                {
+                    m_shelfY += m_shelfH;
+                    m_shelfX = 0;
+                    m_shelfH = 0;
+                }
+                if (m_shelfY + h > m_pageH)
+                {
+                    m_pageH = m_shelfY + std::max(h, m_lineHeight) * 4;
+                    m_page.resize(size_t(m_pageW) * m_pageH, 0);
+                }
+                g.x = m_shelfX;
+                g.y = m_shelfY;
+                g.w = w;
+                g.h = h;
+                for (int y = 0; y < h; y++)
+                    std::copy_n(&mask[size_t(y) * w], w, &m_page[size_t(g.y + y) * m_pageW + g.x]);
+                m_shelfX += w;
+                m_shelfH = std::max(m_shelfH, h);
+                m_rasterized++;
+            }
+            g.advance = adv > 0 ? adv : m_lineHeight / 2;
+            return m_glyphs.emplace(c, g).first->second;
+        }
+
+        int measure(std::wstring_view text)
+        {
+            int w = 0;
+            for (wchar_t c : text) w += glyph(c).advance;
+            return w;
+        }
+
+        // Centred on both axes in the box (StringAlignmentCenter).
+        void drawText(Surface& s, std::wstring_view text, float x, float y, float w, float h, uint32_t color)
+        {
+            int penX = int(std::lround(x + (w - measure(text)) * 0.5f));
+            int penY = int(std::lround(y + (h - m_lineHeight) * 0.5f));
+            for (wchar_t c : text)
+            {
+                const Glyph& g = glyph(c);
+                if (g.w > 0) s.drawMask(&m_page[size_t(g.y) * m_pageW + g.x], m_pageW, g.w, g.h, penX, penY, color);
+                penX += g.advance;
+            }
+        }
+
+        int lineHeight() const { return m_lineHeight; }
+        size_t glyphCount() const { return m_glyphs.size(); }
+        int pageHeight() const { return m_pageH; }
+        uint64_t rasterized() const { return m_rasterized; }
+
+      private:
+        Rasterizer m_rasterize;
+        int m_lineHeight;
+        int m_pageW;
+        int m_pageH{0};
+        int m_shelfX{0};
+        int m_shelfY{0};
+        int m_shelfH{0};
+        std::vector<uint8_t> m_page;
+        std::unordered_map<wchar_t, Glyph> m_glyphs;
+        uint64_t m_rasterized{0};
+    };
+
+    // Built-in 5x7 bitmap font in a 6x9 cell, integer-scaled to the
+    // requested line height. Upper case only (lower case folds up). Used
+    // where no system font rasterizer exists: tests, benchmark.
+    inline GlyphAtlas::Rasterizer builtinGlyphs(int lineHeight, bool bold = false)
+    {
+        struct Def
+        {
+            wchar_t c;
+            uint8_t rows[7];
+        };
+        static const Def kFont[] = {
+            {L'0', {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}}, {L'1', {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+            {L'2', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}}, {L'3', {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}},
+            {L'4', {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}}, {L'5', {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}},
+            {L'6', {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}}, {L'7', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}},
+            {L'8', {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}}, {L'9', {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}},
+            {L'A', {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11}}, {L'B', {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}},
+            {L'C', {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}}, {L'D', {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}},
+            {L'E', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}}, {L'F', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}},
+            {L'G', {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}}, {L'H', {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+            {L'I', {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}}, {L'J', {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}},
+            {L'K', {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}}, {L'L', {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}},
+            {L'M', {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}}, {L'N', {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}},
+            {L'O', {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}}, {L'P', {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}},
+            {L'Q', {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}}, {L'R', {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}},
+            {L'S', {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}}, {L'T', {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},
+            {L'U', {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}}, {L'V', {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}},
+            {L'W', {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}}, {L'X', {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}},
+            {L'Y', {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}}, {L'Z', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}},
+            {L'-', {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}}, {L'+', {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}},
+            {L'.', {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}}, {L':', {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}},
+            {L'/', {0x01, 0x01, 0x02, 0x04, 0x08, 0x10, 0x10}}, {L'|', {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},
+            {L'?', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}}, {L'\u00B0', {0x0C, 0x12, 0x12, 0x0C, 0x00, 0x00, 0x00}},
+        };
+        int s = std::max(1, lineHeight / 9);
+        return [s, bold](wchar_t c, std::vector<uint8_t>& mask, int& w, int& h, int& advance) {
+            if (c >= L'a' && c <= L'z') c = wchar_t(c - L'a' + L'A');
+            w = 6 * s;
+            h = 9 * s;
+            advance = w;
+            if (c == L' ') return false;
+            const Def* def = nullptr;
+            for (auto& d : kFont)
+                if (d.c == c) def = &d;
+            if (!def) def = &kFont[std::size(kFont) - 2];   // '?'
+            mask.assign(size_t(w) * h, 0);
+            for (int r = 0; r < 7; r++)
+                for (int col = 0; col < 5; col++)
+                {
+                    bool on = (def->rows[r] >> (4 - col)) & 1;
+                    if (bold && col > 0) on = on || ((def->rows[r] >> (5 - col)) & 1);
+                    if (!on) continue;
+                    for (int y = 0; y < s; y++)
+                        std::fill_n(&mask[size_t(r * s + y) * w + col * s], s, uint8_t(255));
+                }
+            return true;
+        };
+    }
+
+} // namespace MoriaMods
+
+#endif // MORIA_COMPOSITOR_H
@@ -146,6 +146,28 @@ struct DataTableUtil
     }
 
 
+    // Single RowMap pass: fn(FName rowName, uint8_t* rowData) for each
+    // readable row. For whole-table scans, instead of getRowNames() followed
+    // by a (linear) findRowData() per row.
+    template <typename Fn>
+    int32_t forEachRow(Fn&& fn) const
+    {
+        RowMapHeader hdr{};
+        if (!getRowMapHeader(hdr)) return 0;
+        if (hdr.Num > 100000) return 0;
+        for (int32_t i = 0; i < hdr.Num; i++)
+        {
+            uint8_t* elem = hdr.Data + i * SET_ELEMENT_SIZE;
+            if (!isReadableMemory(elem, SET_ELEMENT_SIZE)) continue;
+            FName rowName;
+            std::memcpy(&rowName, elem, FNAME_SIZE);
+            uint8_t* rowData = *reinterpret_cast<uint8_t**>(elem + FNAME_SIZE);
+            if (rowData && isReadableMemory(rowData, 8)) fn(rowName, rowData);
+        }
+        return hdr.Num;
+    }
+
+
     uint8_t* findRowData(const wchar_t* rowName) const
     {
         if (!rowName || !rowName[0]) return nullptr;
@@ -280,7 +280,7 @@
                 else
                     next = (cur >= 90) ? 5 : cur + 5;
                 s_overlay.rotationStep = next;
-                s_overlay.needsUpdate = true;
+                s_overlay.requestUpdate();
                 saveConfig();
                 setGATARotation(gata, static_cast<float>(next));
                 std::wstring msg = L"Rotation step: " + std::to_wstring(next) + L"\xB0";
@@ -292,7 +292,10 @@
                     toggleSnap();
                 break;
             case 2:
-                runStabilityAudit();
+                if (isModifierDown())
+                    toggleStabilityMonitor();
+                else
+                    runStabilityAudit();
                 break;
             case 3:
                 if (isModifierDown())
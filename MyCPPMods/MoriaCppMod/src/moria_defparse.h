@@ -0,0 +1,512 @@
+
+
+
+#pragma once
+#ifndef MORIA_DEFPARSE_H
+#define MORIA_DEFPARSE_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "moria_ini.h"
+#include "moria_json.h"
+
+// Definition pack parsing: .def XML and manifest .ini text. No UE4SS or
+// Windows dependency — the mod reads files and logs around these, and the
+// deflint tool (tools/deflint) lints packs with the same code on Linux.
+
+namespace MoriaMods
+{
+
+    // Parsed definition data. String fields are views into the load's DefArena
+    // (file text or decoded copies); containers allocate from it too. Nothing
+    // here outlives the applyDefinitionPack() call that parsed it.
+    struct DefChange
+    {
+        std::string_view item;
+        std::string_view property;
+        std::string_view value;
+    };
+
+    struct DefDelete
+    {
+        std::string_view item;
+        std::string_view property;
+        std::string_view value;
+    };
+
+    struct DefAddRow
+    {
+        std::string_view rowName;
+        JsonIndex json;     // tokenized once in parseDef
+    };
+
+    struct DefMod
+    {
+        std::string_view filePath;
+        std::pmr::vector<DefChange> changes;
+        std::pmr::vector<DefDelete> deletes;
+        std::pmr::vector<DefAddRow> addRows;
+
+        explicit DefMod(std::pmr::memory_resource* mr) : changes(mr), deletes(mr), addRows(mr) {}
+    };
+
+    struct DefDefinition
+    {
+        std::string_view title;
+        std::string_view author;
+        std::string_view description;
+        std::pmr::vector<DefMod> mods;
+
+        explicit DefDefinition(std::pmr::memory_resource* mr) : mods(mr) {}
+    };
+
+    struct DefManifest
+    {
+        std::string title;
+        std::string authors;
+        std::string description;
+        bool includeSecrets{false};
+        std::vector<std::string> defPaths;
+    };
+
+
+    inline bool strEndsWithCI(std::string_view str, std::string_view suffix)
+    {
+        if (suffix.size() > str.size()) return false;
+        return std::equal(suffix.rbegin(), suffix.rend(), str.rbegin(),
+            [](char a, char b) { return tolower(static_cast<unsigned char>(a)) == tolower(static_cast<unsigned char>(b)); });
+    }
+
+
+    // Copy into the arena and return a view of the copy.
+    inline std::string_view arenaCopy(std::pmr::memory_resource* mr, std::string_view s)
+    {
+        if (s.empty()) return {};
+        char* p = static_cast<char*>(mr->allocate(s.size(), 1));
+        std::memcpy(p, s.data(), s.size());
+        return {p, s.size()};
+    }
+
+
+    struct XmlAttribute
+    {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    struct XmlElement
+    {
+        std::string_view tag;
+        std::pmr::vector<XmlAttribute> attrs;
+        std::string_view text;
+        std::pmr::vector<XmlElement> children;
+        bool selfClosing{false};
+        uint32_t offset{0};             // byte offset of the '<' in the source
+
+        explicit XmlElement(std::pmr::memory_resource* mr) : attrs(mr), children(mr) {}
+    };
+
+    // Structural problem the tolerant parser recovered from. Collected only
+    // when the caller passes a vector (deflint); the game loader ignores them.
+    struct XmlIssue
+    {
+        size_t offset;
+        std::string message;
+    };
+
+    inline void xmlReport(std::vector<XmlIssue>* issues, size_t offset, std::string message)
+    {
+        if (issues) issues->push_back({offset, std::move(message)});
+    }
+
+    inline std::string_view xmlGetAttr(const XmlElement& elem, std::string_view name)
+    {
+        for (auto& a : elem.attrs)
+            if (a.name == name) return a.value;
+        return {};
+    }
+
+
+    inline size_t xmlSkipWS(std::string_view xml, size_t pos)
+    {
+        while (pos < xml.size() && (xml[pos] == ' ' || xml[pos] == '\t' || xml[pos] == '\r' || xml[pos] == '\n'))
+            ++pos;
+        return pos;
+    }
+
+
+    inline size_t xmlParseAttrValue(std::string_view xml, size_t pos, std::string_view& out, std::pmr::memory_resource* mr,
+                                    std::vector<XmlIssue>* issues = nullptr)
+    {
+        if (pos >= xml.size()) return pos;
+        char quote = xml[pos];
+        if (quote != '"' && quote != '\'')
+        {
+            xmlReport(issues, pos, "unquoted attribute value");
+            return pos;
+        }
+        ++pos;
+        size_t start = pos;
+        while (pos < xml.size() && xml[pos] != quote) ++pos;
+        out = xml.substr(start, pos - start);
+        if (pos < xml.size()) ++pos;
+        else xmlReport(issues, start - 1, "unterminated attribute value");
+
+        // Most values have no entities and stay a view into the file text.
+        if (out.find('&') == std::string_view::npos) return pos;
+
+        std::pmr::string decoded(mr);
+        decoded.reserve(out.size());
+        for (size_t i = 0; i < out.size(); i++)
+        {
+            if (out[i] == '&')
+            {
+                size_t semi = out.find(';', i);
+                if (semi != std::string_view::npos)
+                {
+                    std::string_view ent = out.substr(i + 1, semi - i - 1);
+                    if (ent == "amp") { decoded += '&'; i = semi; continue; }
+                    if (ent == "lt") { decoded += '<'; i = semi; continue; }
+                    if (ent == "gt") { decoded += '>'; i = semi; continue; }
+                    if (ent == "quot") { decoded += '"'; i = semi; continue; }
+                    if (ent == "apos") { decoded += '\''; i = semi; continue; }
+                }
+            }
+            decoded += out[i];
+        }
+        out = arenaCopy(mr, decoded);
+        return pos;
+    }
+
+
+    inline size_t xmlParseAttrs(std::string_view xml, size_t pos, std::pmr::vector<XmlAttribute>& attrs, bool& selfClose,
+                                std::pmr::memory_resource* mr, std::vector<XmlIssue>* issues = nullptr)
+    {
+        selfClose = false;
+        while (pos < xml.size())
+        {
+            pos = xmlSkipWS(xml, pos);
+            if (pos >= xml.size()) break;
+            if (xml[pos] == '/')
+            {
+                selfClose = true;
+                ++pos;
+                pos = xmlSkipWS(xml, pos);
+                if (pos < xml.size() && xml[pos] == '>') ++pos;
+                return pos;
+            }
+            if (xml[pos] == '>')
+            {
+                ++pos;
+                return pos;
+            }
+
+            size_t nameStart = pos;
+            while (pos < xml.size() && xml[pos] != '=' && xml[pos] != ' ' && xml[pos] != '>' && xml[pos] != '/') ++pos;
+            std::string_view attrName = xml.substr(nameStart, pos - nameStart);
+            pos = xmlSkipWS(xml, pos);
+            if (pos < xml.size() && xml[pos] == '=')
+            {
+                ++pos;
+                pos = xmlSkipWS(xml, pos);
+                std::string_view attrVal;
+                pos = xmlParseAttrValue(xml, pos, attrVal, mr, issues);
+                attrs.push_back({attrName, attrVal});
+            }
+        }
+        return pos;
+    }
+
+
+    // Element text is usually a single run (or one CDATA block) and stays a view;
+    // only mixed runs get concatenated into an arena copy.
+    inline void xmlAppendText(XmlElement& elem, std::string_view run, std::pmr::memory_resource* mr)
+    {
+        if (run.empty()) return;
+        if (elem.text.empty()) { elem.text = run; return; }
+        std::pmr::string joined(elem.text, mr);
+        joined += run;
+        elem.text = arenaCopy(mr, joined);
+    }
+
+
+    inline size_t xmlParseElement(std::string_view xml, size_t pos, XmlElement& elem, std::pmr::memory_resource* mr,
+                                  std::vector<XmlIssue>* issues = nullptr)
+    {
+        pos = xmlSkipWS(xml, pos);
+        if (pos >= xml.size() || xml[pos] != '<') return pos;
+
+
+        if (pos + 1 < xml.size() && xml[pos + 1] == '?')
+        {
+            size_t end = xml.find("?>", pos);
+            if (end != std::string_view::npos) return end + 2;
+            xmlReport(issues, pos, "unterminated <? ?> declaration");
+            return xml.size();
+        }
+        if (pos + 3 < xml.size() && xml.substr(pos, 4) == "<!--")
+        {
+            size_t end = xml.find("-->", pos);
+            if (end != std::string_view::npos) return end + 3;
+            xmlReport(issues, pos, "unterminated comment");
+            return xml.size();
+        }
+
+        elem.offset = static_cast<uint32_t>(pos);
+        ++pos;
+
+        size_t tagStart = pos;
+        while (pos < xml.size() && xml[pos] != ' ' && xml[pos] != '>' && xml[pos] != '/' && xml[pos] != '\t' && xml[pos] != '\r' && xml[pos] != '\n') ++pos;
+        elem.tag = xml.substr(tagStart, pos - tagStart);
+        if (elem.tag.empty()) xmlReport(issues, elem.offset, "element with no name");
+
+
+        bool selfClose = false;
+        pos = xmlParseAttrs(xml, pos, elem.attrs, selfClose, mr, issues);
+        elem.selfClosing = selfClose;
+        if (selfClose) return pos;
+
+
+        while (pos < xml.size())
+        {
+            pos = xmlSkipWS(xml, pos);
+            if (pos >= xml.size()) break;
+
+
+            if (pos + 2 + elem.tag.size() < xml.size() && xml[pos] == '<' && xml[pos + 1] == '/'
+                && xml.substr(pos + 2, elem.tag.size()) == elem.tag)
+            {
+                pos += 2 + elem.tag.size();
+                pos = xmlSkipWS(xml, pos);
+                if (pos < xml.size() && xml[pos] == '>') ++pos;
+                return pos;
+            }
+
+            if (xml[pos] == '<')
+            {
+
+                if (pos + 8 < xml.size() && xml.substr(pos, 9) == "<![CDATA[")
+                {
+                    size_t cdataStart = pos + 9;
+                    size_t cdataEnd = xml.find("]]>", cdataStart);
+                    if (cdataEnd != std::string_view::npos)
+                    {
+                        xmlAppendText(elem, xml.substr(cdataStart, cdataEnd - cdataStart), mr);
+                        pos = cdataEnd + 3;
+                    }
+                    else
+                    {
+                        xmlReport(issues, pos, "unterminated CDATA section");
+                        pos = xml.size();
+                    }
+                    continue;
+                }
+
+                if (pos + 3 < xml.size() && xml.substr(pos, 4) == "<!--")
+                {
+                    size_t end = xml.find("-->", pos);
+                    if (end == std::string_view::npos) xmlReport(issues, pos, "unterminated comment");
+                    pos = (end != std::string_view::npos) ? end + 3 : xml.size();
+                    continue;
+                }
+
+                if (pos + 1 < xml.size() && xml[pos + 1] == '?')
+                {
+                    size_t end = xml.find("?>", pos);
+                    pos = (end != std::string_view::npos) ? end + 2 : xml.size();
+                    continue;
+                }
+
+                if (pos + 1 < xml.size() && xml[pos + 1] == '/')
+                {
+                    size_t nameEnd = xml.find_first_of("> \t\r\n", pos + 2);
+                    std::string_view other = xml.substr(pos + 2, nameEnd == std::string_view::npos ? std::string_view::npos : nameEnd - pos - 2);
+                    xmlReport(issues, elem.offset, "<" + std::string(elem.tag) + "> closed by </" + std::string(other) + ">");
+                    break;
+                }
+
+                XmlElement child(mr);
+                pos = xmlParseElement(xml, pos, child, mr, issues);
+                if (!child.tag.empty())
+                    elem.children.push_back(std::move(child));
+            }
+            else
+            {
+
+                size_t textStart = pos;
+                while (pos < xml.size() && xml[pos] != '<') ++pos;
+                std::string_view text = xml.substr(textStart, pos - textStart);
+
+                size_t a = text.find_first_not_of(" \t\r\n");
+                size_t b = text.find_last_not_of(" \t\r\n");
+                if (a != std::string_view::npos)
+                    xmlAppendText(elem, text.substr(a, b - a + 1), mr);
+            }
+        }
+        if (pos >= xml.size()) xmlReport(issues, elem.offset, "unclosed <" + std::string(elem.tag) + ">");
+        return pos;
+    }
+
+
+    inline XmlElement xmlParse(std::string_view xml, std::pmr::memory_resource* mr,
+                               std::vector<XmlIssue>* issues = nullptr)
+    {
+        XmlElement root(mr);
+        size_t pos = 0;
+        while (pos < xml.size())
+        {
+            pos = xmlSkipWS(xml, pos);
+            if (pos >= xml.size()) break;
+            if (xml[pos] != '<') { ++pos; continue; }
+
+
+            if (pos + 1 < xml.size() && xml[pos + 1] == '?')
+            {
+                size_t end = xml.find("?>", pos);
+                if (end == std::string_view::npos) xmlReport(issues, pos, "unterminated <? ?> declaration");
+                pos = (end != std::string_view::npos) ? end + 2 : xml.size();
+                continue;
+            }
+            if (pos + 3 < xml.size() && xml.substr(pos, 4) == "<!--")
+            {
+                size_t end = xml.find("-->", pos);
+                if (end == std::string_view::npos) xmlReport(issues, pos, "unterminated comment");
+                pos = (end != std::string_view::npos) ? end + 3 : xml.size();
+                continue;
+            }
+
+            pos = xmlParseElement(xml, pos, root, mr, issues);
+            if (!root.tag.empty()) break;
+        }
+
+        if (issues)
+        {
+            if (root.tag.empty())
+                xmlReport(issues, 0, "no root element");
+            else
+            {
+                // Only whitespace and comments may follow the root.
+                while ((pos = xmlSkipWS(xml, pos)) < xml.size())
+                {
+                    if (xml.substr(pos, 4) != "<!--") { xmlReport(issues, pos, "content after root element"); break; }
+                    size_t end = xml.find("-->", pos);
+                    if (end == std::string_view::npos) { xmlReport(issues, pos, "unterminated comment"); break; }
+                    pos = end + 3;
+                }
+            }
+        }
+        return root;
+    }
+
+
+    // Manifest [Paths] keys use '|' between folders; `sep` is the separator
+    // the caller's file API wants ("\\" in game, "/" in deflint).
+    inline DefManifest parseManifestStream(std::istream& in, const std::string& defBaseDir, char sep)
+    {
+        DefManifest manifest;
+        std::string section;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            auto parsed = parseIniLine(line);
+            if (auto* sec = std::get_if<ParsedIniSection>(&parsed))
+            {
+                section = sec->name;
+            }
+            else if (auto* kv = std::get_if<ParsedIniKeyValue>(&parsed))
+            {
+                if (strEqualCI(section, "ModInfo"))
+                {
+                    if (strEqualCI(kv->key, "Title")) manifest.title = kv->value;
+                    else if (strEqualCI(kv->key, "Authors")) manifest.authors = kv->value;
+                    else if (strEqualCI(kv->key, "Description")) manifest.description += kv->value + "\n";
+                }
+                else if (strEqualCI(section, "Paths"))
+                {
+
+
+                    if (strEqualCI(kv->value, "true"))
+                    {
+                        std::string key = kv->key;
+
+                        for (auto& c : key) { if (c == '|') c = sep; }
+
+                        if (strEndsWithCI(key, ".def"))
+                            manifest.defPaths.push_back(defBaseDir + sep + key);
+                    }
+                }
+                else if (strEqualCI(section, "Settings"))
+                {
+                    if (strEqualCI(kv->key, "include_secrets"))
+                        manifest.includeSecrets = strEqualCI(kv->value, "true") || kv->value == "1";
+                }
+            }
+        }
+        return manifest;
+    }
+
+
+    // Build the Def* model from a parsed <definition> root. Unknown elements
+    // are ignored here; deflint reports them.
+    inline DefDefinition defFromXml(const XmlElement& root, std::pmr::memory_resource* mr)
+    {
+        DefDefinition def(mr);
+        if (root.tag != "definition") return def;
+
+        for (auto& child : root.children)
+        {
+            if (child.tag == "title") def.title = child.text;
+            else if (child.tag == "author") def.author = child.text;
+            else if (child.tag == "description") def.description = child.text;
+            else if (child.tag == "mod")
+            {
+                DefMod mod(mr);
+                mod.filePath = xmlGetAttr(child, "file");
+                for (auto& op : child.children)
+                {
+                    if (op.tag == "change")
+                    {
+                        mod.changes.push_back({xmlGetAttr(op, "item"), xmlGetAttr(op, "property"), xmlGetAttr(op, "value")});
+                    }
+                    else if (op.tag == "delete")
+                    {
+                        mod.deletes.push_back({xmlGetAttr(op, "item"), xmlGetAttr(op, "property"), xmlGetAttr(op, "value")});
+                    }
+                    else if (op.tag == "add_row")
+                    {
+                        std::string_view rowName = xmlGetAttr(op, "name");
+                        if (!rowName.empty() && !op.text.empty())
+                            mod.addRows.push_back({rowName, JsonIndex(op.text, mr)});
+                    }
+                }
+                def.mods.push_back(std::move(mod));
+            }
+        }
+        return def;
+    }
+
+
+    inline std::string extractDataTableName(std::string_view filePath)
+    {
+
+        size_t lastSlash = filePath.find_last_of("/\\");
+        std::string_view filename = (lastSlash != std::string_view::npos) ? filePath.substr(lastSlash + 1) : filePath;
+
+
+        if (strEndsWithCI(filename, ".json"))
+            filename = filename.substr(0, filename.size() - 5);
+
+        return std::string(filename);
+    }
+
+} // namespace MoriaMods
+
+#endif // MORIA_DEFPARSE_H
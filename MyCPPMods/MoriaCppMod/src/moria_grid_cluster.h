@@ -0,0 +1,130 @@
+
+
+
+#pragma once
+#ifndef MORIA_GRID_CLUSTER_H
+#define MORIA_GRID_CLUSTER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+// Grid merge of world points into at most maxClusters clusters, worst
+// first, for the stability audit markers.
+
+namespace MoriaMods
+{
+
+    struct ClusterPoint
+    {
+        float x, y, z;
+        bool critical;
+        float stability;
+    };
+
+    struct GridCluster
+    {
+        float x{0}, y{0}, z{0};       // centroid of members
+        int count{0};
+        int criticalCount{0};
+        float minStability{0};
+        bool critical() const { return criticalCount > 0; }
+    };
+
+    struct GridClusterResult
+    {
+        std::vector<GridCluster> clusters;
+        float cellSize{0};            // final cell edge after any doubling
+        int merges{0};                // times the cell size was doubled
+    };
+
+    namespace GridClusterDetail
+    {
+        struct Acc
+        {
+            double sx{0}, sy{0}, sz{0};
+            int count{0};
+            int critical{0};
+            float minStability{0};
+            int64_t order{0};         // first-seen index, for stable output
+        };
+
+        // Cells are anchored at `origin` (the input's minimum corner) so
+        // enough doublings always reach a single cell; a grid fixed at the
+        // world origin would keep points on either side of 0 apart forever.
+        inline int64_t cellKey(const GridCluster& c, const float origin[3], float cell)
+        {
+            // 21 bits per axis: 2M cells, far past any map at 1 m cells.
+            auto q = [cell](float v, float o) { return (static_cast<int64_t>(std::floor((v - o) / cell)) & 0x1FFFFF); };
+            return (q(c.x, origin[0]) << 42) | (q(c.y, origin[1]) << 21) | q(c.z, origin[2]);
+        }
+
+        inline std::vector<GridCluster> bucket(std::span<const GridCluster> in, const float origin[3], float cell)
+        {
+            std::unordered_map<int64_t, Acc> cells;
+            cells.reserve(in.size());
+            int64_t seen = 0;
+            for (auto& c : in)
+            {
+                auto [it, inserted] = cells.try_emplace(cellKey(c, origin, cell));
+                Acc& a = it->second;
+                if (inserted) { a.order = seen++; a.minStability = c.minStability; }
+                a.sx += static_cast<double>(c.x) * c.count;
+                a.sy += static_cast<double>(c.y) * c.count;
+                a.sz += static_cast<double>(c.z) * c.count;
+                a.count += c.count;
+                a.critical += c.criticalCount;
+                a.minStability = std::min(a.minStability, c.minStability);
+            }
+            std::vector<std::pair<int64_t, GridCluster>> ordered;
+            ordered.reserve(cells.size());
+            for (auto& [key, a] : cells)
+                ordered.push_back({a.order, {static_cast<float>(a.sx / a.count), static_cast<float>(a.sy / a.count),
+                                             static_cast<float>(a.sz / a.count), a.count, a.critical, a.minStability}});
+            std::sort(ordered.begin(), ordered.end(), [](auto& a, auto& b) { return a.first < b.first; });
+            std::vector<GridCluster> out;
+            out.reserve(ordered.size());
+            for (auto& [order, c] : ordered) out.push_back(c);
+            return out;
+        }
+    }
+
+    // `maxClusters` <= 0 means unbounded (one pass at `cellSize`).
+    inline GridClusterResult clusterOnGrid(std::span<const ClusterPoint> points, float cellSize, int maxClusters)
+    {
+        GridClusterResult result;
+        result.cellSize = cellSize > 0 ? cellSize : 1.0f;
+
+        std::vector<GridCluster> singles;
+        singles.reserve(points.size());
+        float origin[3] = {0, 0, 0};
+        for (auto& p : points)
+        {
+            if (singles.empty()) { origin[0] = p.x; origin[1] = p.y; origin[2] = p.z; }
+            origin[0] = std::min(origin[0], p.x);
+            origin[1] = std::min(origin[1], p.y);
+            origin[2] = std::min(origin[2], p.z);
+            singles.push_back({p.x, p.y, p.z, 1, p.critical ? 1 : 0, p.stability});
+        }
+
+        result.clusters = GridClusterDetail::bucket(singles, origin, result.cellSize);
+        while (maxClusters > 0 && static_cast<int>(result.clusters.size()) > maxClusters && result.merges < 24)
+        {
+            result.cellSize *= 2.0f;
+            result.merges++;
+            result.clusters = GridClusterDetail::bucket(result.clusters, origin, result.cellSize);
+        }
+
+        std::stable_sort(result.clusters.begin(), result.clusters.end(), [](const GridCluster& a, const GridCluster& b) {
+            if (a.critical() != b.critical()) return a.critical();
+            return a.count > b.count;
+        });
+        return result;
+    }
+
+} // namespace MoriaMods
+
+#endif // MORIA_GRID_CLUSTER_H
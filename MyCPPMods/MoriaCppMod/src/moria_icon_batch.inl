@@ -0,0 +1,282 @@
+
+
+
+
+        // ── Batched icon extraction ─────────────────────────────────────
+        // Recipe icons are rendered into s_iconStore (moria_icon_store.h)
+        // from the main tick instead of synchronously on the key press.
+        // One ICON_BATCH x 1 strip render target is created once and
+        // reused (recreated only if it was garbage-collected): each frame
+        // draws up to ICON_BATCH queued textures into its cells, then reads
+        // the whole strip back with a single ReadRenderTarget. That read
+        // waits for the render thread, so it happens once per batch rather
+        // than once per icon, and m_iconPacer sizes batches to the frame
+        // budget. Nothing is exported to disk or probed for; the pixels go
+        // straight into the pack file.
+        //
+        // If ReadRenderTarget is unavailable or fails, the job falls back to
+        // extractAndSaveIcon's PNG export. The overlay's icon worker imports
+        // that PNG into the store on its first decode.
+
+        static constexpr int ICON_SIDE = 128;
+        static constexpr int ICON_BATCH = 4;
+        static constexpr double ICON_FRAME_BUDGET_MS = 2.0;
+
+        // Queue `textureName` unless the store (or a legacy PNG the icon
+        // worker will import) already has it. `texture` may be null; the
+        // drain then looks it up by name.
+        void queueIconExtraction(const std::wstring& textureName, UObject* texture)
+        {
+            if (textureName.empty() || s_overlay.iconFolder.empty() || !s_iconStore.isOpen()) return;
+            if (s_iconStore.contains(textureName)) return;
+            std::wstring pngPath = s_overlay.iconFolder + L"\\" + textureName + L".png";
+            if (GetFileAttributesW(pngPath.c_str()) != INVALID_FILE_ATTRIBUTES) return;
+            for (auto& job : m_iconJobs)
+                if (job.textureName == textureName)
+                {
+                    if (texture && !job.texture.Get()) job.texture = FWeakObjectPtr(texture);
+                    return;
+                }
+            if (m_iconJobs.empty()) m_iconPacer.reset();
+            m_iconJobs.push_back({textureName, texture ? FWeakObjectPtr(texture) : FWeakObjectPtr()});
+            QBLOG(STR("[MoriaCppMod] [Icon] queued '{}' ({} pending)\n"), textureName, m_iconJobs.size());
+        }
+
+        // Draw `textures` into consecutive strip cells and read the strip
+        // back once. out[i] receives cell i as premultiplied ARGB32.
+        bool captureIconStrip(const std::vector<UObject*>& textures, std::vector<std::vector<uint32_t>>& out)
+        {
+            static UFunction* s_createRTFn = nullptr;
+            static UFunction* s_beginDrawFn = nullptr;
+            static UFunction* s_endDrawFn = nullptr;
+            static UFunction* s_drawTexFn = nullptr;
+            static UFunction* s_readRTFn = nullptr;
+            static UObject* s_krlCDO = nullptr;
+            static bool s_looked = false;
+            if (!s_looked)
+            {
+                s_looked = true;
+                s_createRTFn = UObjectGlobals::StaticFindObject<UFunction*>(
+                        nullptr, nullptr, STR("/Script/Engine.KismetRenderingLibrary:CreateRenderTarget2D"));
+                s_beginDrawFn = UObjectGlobals::StaticFindObject<UFunction*>(
+                        nullptr, nullptr, STR("/Script/Engine.KismetRenderingLibrary:BeginDrawCanvasToRenderTarget"));
+                s_endDrawFn = UObjectGlobals::StaticFindObject<UFunction*>(
+                        nullptr, nullptr, STR("/Script/Engine.KismetRenderingLibrary:EndDrawCanvasToRenderTarget"));
+                s_drawTexFn = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/Engine.Canvas:K2_DrawTexture"));
+                s_readRTFn = UObjectGlobals::StaticFindObject<UFunction*>(
+                        nullptr, nullptr, STR("/Script/Engine.KismetRenderingLibrary:ReadRenderTarget"));
+                auto* krlClass = UObjectGlobals::StaticFindObject<UClass*>(nullptr, nullptr, STR("/Script/Engine.KismetRenderingLibrary"));
+                s_krlCDO = krlClass ? krlClass->GetClassDefaultObject() : nullptr;
+                if (!s_readRTFn) VLOG(STR("[MoriaCppMod] [Icon] ReadRenderTarget not found, icons use the PNG export path\n"));
+            }
+            if (!s_createRTFn || !s_beginDrawFn || !s_endDrawFn || !s_drawTexFn || !s_readRTFn || !s_krlCDO) return false;
+            UObject* worldCtx = findPlayerController();
+            if (!worldCtx) return false;
+
+            if (!m_iconRT || !isObjectAlive(m_iconRT))
+            {
+                std::vector<uint8_t> params(s_createRTFn->GetParmsSize(), 0);
+                auto* pWC = findParam(s_createRTFn, STR("WorldContextObject"));
+                auto* pW = findParam(s_createRTFn, STR("Width"));
+                auto* pH = findParam(s_createRTFn, STR("Height"));
+                auto* pF = findParam(s_createRTFn, STR("Format"));
+                auto* pRV = findParam(s_createRTFn, STR("ReturnValue"));
+                if (!pWC || !pRV) return false;
+                *reinterpret_cast<UObject**>(params.data() + pWC->GetOffset_Internal()) = worldCtx;
+                if (pW) *reinterpret_cast<int32_t*>(params.data() + pW->GetOffset_Internal()) = ICON_SIDE * ICON_BATCH;
+                if (pH) *reinterpret_cast<int32_t*>(params.data() + pH->GetOffset_Internal()) = ICON_SIDE;
+                if (pF) params[pF->GetOffset_Internal()] = 2; // RTF_RGBA8
+                safeProcessEvent(s_krlCDO, s_createRTFn, params.data());
+                m_iconRT = *reinterpret_cast<UObject**>(params.data() + pRV->GetOffset_Internal());
+                if (!m_iconRT)
+                {
+                    VLOG(STR("[MoriaCppMod] [Icon] CreateRenderTarget2D returned null\n"));
+                    return false;
+                }
+            }
+
+            std::vector<uint8_t> beginParams(s_beginDrawFn->GetParmsSize(), 0);
+            UObject* canvas = nullptr;
+            {
+                auto* bWC = findParam(s_beginDrawFn, STR("WorldContextObject"));
+                auto* bRT = findParam(s_beginDrawFn, STR("TextureRenderTarget"));
+                auto* bCanvas = findParam(s_beginDrawFn, STR("Canvas"));
+                if (!bWC || !bRT) return false;
+                *reinterpret_cast<UObject**>(beginParams.data() + bWC->GetOffset_Internal()) = worldCtx;
+                *reinterpret_cast<UObject**>(beginParams.data() + bRT->GetOffset_Internal()) = m_iconRT;
+                safeProcessEvent(s_krlCDO, s_beginDrawFn, beginParams.data());
+                canvas = bCanvas ? *reinterpret_cast<UObject**>(beginParams.data() + bCanvas->GetOffset_Internal()) : nullptr;
+            }
+            if (canvas)
+            {
+                auto* dTex = findParam(s_drawTexFn, STR("RenderTexture"));
+                auto* dPos = findParam(s_drawTexFn, STR("ScreenPosition"));
+                auto* dSize = findParam(s_drawTexFn, STR("ScreenSize"));
+                auto* dCoordSize = findParam(s_drawTexFn, STR("CoordinateSize"));
+                auto* dColor = findParam(s_drawTexFn, STR("RenderColor"));
+                auto* dBlend = findParam(s_drawTexFn, STR("BlendMode"));
+                auto* dPivot = findParam(s_drawTexFn, STR("PivotPoint"));
+                std::vector<uint8_t> dtParams(s_drawTexFn->GetParmsSize(), 0);
+                for (size_t i = 0; i < textures.size() && dTex; i++)
+                {
+                    std::fill(dtParams.begin(), dtParams.end(), uint8_t(0));
+                    *reinterpret_cast<UObject**>(dtParams.data() + dTex->GetOffset_Internal()) = textures[i];
+                    if (dPos)
+                    {
+                        auto* v = reinterpret_cast<float*>(dtParams.data() + dPos->GetOffset_Internal());
+                        v[0] = float(i * ICON_SIDE);
+                        v[1] = 0.0f;
+                    }
+                    if (dSize)
+                    {
+                        auto* v = reinterpret_cast<float*>(dtParams.data() + dSize->GetOffset_Internal());
+                        v[0] = float(ICON_SIDE);
+                        v[1] = float(ICON_SIDE);
+                    }
+                    if (dCoordSize)
+                    {
+                        auto* v = reinterpret_cast<float*>(dtParams.data() + dCoordSize->GetOffset_Internal());
+                        v[0] = 1.0f;
+                        v[1] = 1.0f;
+                    }
+                    if (dColor)
+                    {
+                        auto* c = reinterpret_cast<float*>(dtParams.data() + dColor->GetOffset_Internal());
+                        c[0] = c[1] = c[2] = c[3] = 1.0f;
+                    }
+                    // Opaque: every cell is overwritten whole, alpha included,
+                    // so the strip never needs clearing between batches.
+                    if (dBlend) *reinterpret_cast<uint8_t*>(dtParams.data() + dBlend->GetOffset_Internal()) = 0;
+                    if (dPivot)
+                    {
+                        auto* v = reinterpret_cast<float*>(dtParams.data() + dPivot->GetOffset_Internal());
+                        v[0] = 0.5f;
+                        v[1] = 0.5f;
+                    }
+                    safeProcessEvent(canvas, s_drawTexFn, dtParams.data());
+                }
+            }
+            {
+                std::vector<uint8_t> eParams(s_endDrawFn->GetParmsSize(), 0);
+                auto* eWC = findParam(s_endDrawFn, STR("WorldContextObject"));
+                auto* eCtx = findParam(s_endDrawFn, STR("Context"));
+                if (eWC) *reinterpret_cast<UObject**>(eParams.data() + eWC->GetOffset_Internal()) = worldCtx;
+                if (eCtx)
+                {
+                    auto* bCtx = findParam(s_beginDrawFn, STR("Context"));
+                    if (bCtx && bCtx->GetSize() <= eCtx->GetSize())
+                        memcpy(eParams.data() + eCtx->GetOffset_Internal(), beginParams.data() + bCtx->GetOffset_Internal(), bCtx->GetSize());
+                }
+                safeProcessEvent(s_krlCDO, s_endDrawFn, eParams.data());
+            }
+            if (!canvas)
+            {
+                VLOG(STR("[MoriaCppMod] [Icon] BeginDrawCanvasToRenderTarget returned no Canvas\n"));
+                return false;
+            }
+
+            // ReadRenderTarget(WorldContextObject, TextureRenderTarget,
+            // TArray<FColor>& OutSamples, bNormalize) -> bool. The engine
+            // allocates OutSamples with FMemory; free it after copying.
+            std::vector<uint8_t> rParams(s_readRTFn->GetParmsSize(), 0);
+            auto* rWC = findParam(s_readRTFn, STR("WorldContextObject"));
+            auto* rRT = findParam(s_readRTFn, STR("TextureRenderTarget"));
+            auto* rOut = findParam(s_readRTFn, STR("OutSamples"));
+            auto* rNorm = findParam(s_readRTFn, STR("bNormalize"));
+            auto* rRV = findParam(s_readRTFn, STR("ReturnValue"));
+            if (!rWC || !rRT || !rOut) return false;
+            *reinterpret_cast<UObject**>(rParams.data() + rWC->GetOffset_Internal()) = worldCtx;
+            *reinterpret_cast<UObject**>(rParams.data() + rRT->GetOffset_Internal()) = m_iconRT;
+            if (rNorm) *reinterpret_cast<bool*>(rParams.data() + rNorm->GetOffset_Internal()) = true;
+            safeProcessEvent(s_krlCDO, s_readRTFn, rParams.data());
+
+            uint8_t* arr = rParams.data() + rOut->GetOffset_Internal();
+            auto* samples = *reinterpret_cast<uint8_t**>(arr);
+            int32_t count = *reinterpret_cast<int32_t*>(arr + 8);
+            bool ok = (!rRV || *reinterpret_cast<bool*>(rParams.data() + rRV->GetOffset_Internal())) && samples &&
+                      count == ICON_SIDE * ICON_BATCH * ICON_SIDE;
+            if (ok)
+            {
+                const int stride = ICON_SIDE * ICON_BATCH;
+                out.resize(textures.size());
+                for (size_t i = 0; i < textures.size(); i++)
+                {
+                    out[i].resize(size_t(ICON_SIDE) * ICON_SIDE);
+                    for (int y = 0; y < ICON_SIDE; y++)
+                    {
+                        const uint8_t* src = samples + (size_t(y) * stride + i * ICON_SIDE) * 4; // FColor: B, G, R, A
+                        uint32_t* dst = out[i].data() + size_t(y) * ICON_SIDE;
+                        for (int x = 0; x < ICON_SIDE; x++, src += 4) dst[x] = premul(src[3], src[2], src[1], src[0]);
+                    }
+                }
+            }
+            else
+            {
+                VLOG(STR("[MoriaCppMod] [Icon] ReadRenderTarget failed ({} samples)\n"), count);
+            }
+            if (samples) FMemory::Free(samples);
+            return ok;
+        }
+
+        // Main tick: one strip capture per frame, sized by m_iconPacer.
+        void drainIconQueue()
+        {
+            if (m_iconJobs.empty()) return;
+
+            using Clock = std::chrono::steady_clock;
+            auto frameStart = Clock::now();
+            double frameMs = m_iconLastFrame == Clock::time_point{} ? 0.0
+                : std::chrono::duration<double, std::milli>(frameStart - m_iconLastFrame).count();
+            m_iconLastFrame = frameStart;
+
+            int n = (int)std::min<size_t>(m_iconPacer.beginFrame(frameMs), m_iconJobs.size());
+            std::vector<IconJob> batch;
+            std::vector<UObject*> textures;
+            for (int i = 0; i < n; ++i)
+            {
+                IconJob job = std::move(m_iconJobs.front());
+                m_iconJobs.pop_front();
+                UObject* tex = job.texture.Get();
+                if (!tex) tex = findTexture2DByName(job.textureName);
+                if (!tex || !isObjectAlive(tex))
+                {
+                    VLOG(STR("[MoriaCppMod] [Icon] '{}' not loaded, dropped from the extraction queue\n"), job.textureName);
+                    continue;
+                }
+                batch.push_back(std::move(job));
+                textures.push_back(tex);
+            }
+
+            std::vector<std::vector<uint32_t>> pixels;
+            bool captured = !textures.empty() && captureIconStrip(textures, pixels);
+            for (size_t i = 0; i < batch.size(); i++)
+            {
+                const std::wstring& name = batch[i].textureName;
+                bool ok = captured && s_iconStore.put(name, ICON_SIDE, ICON_SIDE, pixels[i].data());
+                if (!ok)
+                {
+                    std::wstring pngPath = s_overlay.iconFolder + L"\\" + name + L".png";
+                    ok = extractAndSaveIcon(nullptr, name, pngPath, textures[i]);
+                }
+                if (ok)
+                {
+                    m_iconStored++;
+                    // A slot holding this texture may have cached a failed decode.
+                    s_iconCache.invalidate(name);
+                }
+                else
+                {
+                    VLOG(STR("[MoriaCppMod] [Icon] extraction failed for '{}'\n"), name);
+                }
+            }
+            m_iconPacer.endFrame(n, std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
+
+            if (m_iconJobs.empty())
+            {
+                s_iconStore.saveManifest();
+                VLOG(STR("[MoriaCppMod] [Icon] extraction queue drained: {} icons stored ({} in store, {} KB pack, {:.2f} ms/icon)\n"),
+                     m_iconStored, s_iconStore.size(), s_iconStore.packBytes() / 1024, m_iconPacer.callCostMs());
+                m_iconStored = 0;
+                m_iconLastFrame = {};
+            }
+        }
@@ -0,0 +1,303 @@
+
+
+
+#pragma once
+#ifndef MORIA_ICON_CACHE_H
+#define MORIA_ICON_CACHE_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Shared, refcounted icon cache with off-thread decoding. Consumers
+// acquire(name) / release(name) a texture name; the first acquire queues a
+// decode for the worker, and every consumer of the same name shares one
+// decoded image. Decoded images are published as an immutable snapshot
+// (name -> image) behind an atomically swapped shared_ptr, so the overlay
+// thread reads icons without taking the cache lock and never waits on a
+// PNG decode — the old path decoded on the game thread inside slotCS.
+//
+// Names nobody holds stay decoded (LRU) up to maxIdle, then are evicted. A
+// failed decode is not retried until invalidate(name) (e.g. after the PNG
+// has been extracted). The decoder runs outside the lock and returns a
+// shared_ptr<Image> (null = failed).
+//
+// Pure (no UE4SS, no GDI+): Image is a template parameter; tested in
+// tests/test_icon_cache.cpp.
+
+namespace MoriaMods
+{
+
+    template <typename Image>
+    class IconCache
+    {
+      public:
+        using Ptr = std::shared_ptr<Image>;
+        using Decoder = std::function<Ptr(const std::wstring&)>;
+
+        struct Snapshot
+        {
+            std::unordered_map<std::wstring, Ptr> ready;
+            uint64_t version{0};
+
+            Ptr find(const std::wstring& name) const
+            {
+                auto it = ready.find(name);
+                return it == ready.end() ? nullptr : it->second;
+            }
+        };
+
+        explicit IconCache(size_t maxIdle = 64) : m_maxIdle(maxIdle)
+        {
+            m_snapshot.store(std::make_shared<const Snapshot>());
+        }
+
+        // The owner calls stopWorker() first: a global's destructor runs
+        // under the loader lock at DLL unload, where joining deadlocks. A
+        // worker still running by then is detached, not joined.
+        ~IconCache()
+        {
+            if (m_worker.joinable()) m_worker.detach();
+        }
+
+        IconCache(const IconCache&) = delete;
+        IconCache& operator=(const IconCache&) = delete;
+
+        // ---- consumer side (any thread) ----
+
+        void acquire(const std::wstring& name)
+        {
+            if (name.empty()) return;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Entry& e = m_entries[name];
+            if (e.refs++ == 0) e.idleSince = 0;
+            if (e.state == State::None) enqueueLocked(name, e);
+        }
+
+        void release(const std::wstring& name)
+        {
+            if (name.empty()) return;
+            std::vector<std::wstring> evicted;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_entries.find(name);
+                if (it == m_entries.end() || it->second.refs == 0) return;
+                if (--it->second.refs == 0) it->second.idleSince = ++m_clock;
+                evictLocked(evicted);
+            }
+            if (!evicted.empty()) publish();
+        }
+
+        // Lock-free read of the published images.
+        std::shared_ptr<const Snapshot> snapshot() const { return m_snapshot.load(); }
+        Ptr find(const std::wstring& name) const { return snapshot()->find(name); }
+
+        // Re-decode on next demand (file replaced, or a failed name whose
+        // PNG now exists). Held names are re-queued immediately.
+        void invalidate(const std::wstring& name)
+        {
+            bool republish = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_entries.find(name);
+                if (it == m_entries.end()) return;
+                Entry& e = it->second;
+                if (e.state == State::Pending) { e.stale = true; return; }
+                republish = e.image != nullptr;
+                e.image.reset();
+                e.state = State::None;
+                if (e.refs > 0) enqueueLocked(name, e);
+            }
+            if (republish) publish();
+        }
+
+        // ---- worker side ----
+
+        // Decode up to `max` queued names on the calling thread. Returns the
+        // number decoded. Used by the worker loop and by tests.
+        size_t drain(const Decoder& decode, size_t max = SIZE_MAX)
+        {
+            size_t done = 0;
+            while (done < max)
+            {
+                std::wstring name;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!popLocked(name)) break;
+                }
+                Ptr img = decode(name);
+                bool changed = false;
+                std::vector<std::wstring> evicted;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto it = m_entries.find(name);
+                    if (it != m_entries.end() && it->second.state == State::Pending)
+                    {
+                        Entry& e = it->second;
+                        if (e.stale)
+                        {
+                            // Invalidated mid-decode: drop the result, decode again.
+                            e.stale = false;
+                            e.state = State::None;
+                            if (e.refs > 0) enqueueLocked(name, e);
+                        }
+                        else
+                        {
+                            e.image = img;
+                            e.state = img ? State::Ready : State::Failed;
+                            img ? m_decodes++ : m_failures++;
+                            changed = img != nullptr;
+                            evictLocked(evicted);
+                        }
+                    }
+                }
+                if (changed || !evicted.empty()) publish();
+                done++;
+            }
+            return done;
+        }
+
+        // Background thread running drain() whenever work is queued.
+        void startWorker(Decoder decode)
+        {
+            if (m_worker.joinable()) return;
+            m_stop = false;
+            m_worker = std::thread([this, decode = std::move(decode)] {
+                for (;;)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_wake.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+                        if (m_stop) return;
+                    }
+                    drain(decode);
+                }
+            });
+        }
+
+        void stopWorker()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            if (m_worker.joinable()) m_worker.join();
+        }
+
+        // Called (on the publishing thread) after each new snapshot.
+        void setOnPublish(std::function<void()> fn)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_onPublish = std::move(fn);
+        }
+
+        // Drop everything (GDI+ shutdown: images must die before it).
+        void clear()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_entries.clear();
+                m_queue.clear();
+            }
+            publish();
+        }
+
+        size_t queued() const { std::lock_guard<std::mutex> lock(m_mutex); return m_queue.size(); }
+        size_t entries() const { std::lock_guard<std::mutex> lock(m_mutex); return m_entries.size(); }
+        int refs(const std::wstring& name) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(name);
+            return it == m_entries.end() ? 0 : it->second.refs;
+        }
+        uint64_t decodes() const { std::lock_guard<std::mutex> lock(m_mutex); return m_decodes; }
+        uint64_t failures() const { std::lock_guard<std::mutex> lock(m_mutex); return m_failures; }
+        uint64_t evictions() const { std::lock_guard<std::mutex> lock(m_mutex); return m_evictions; }
+
+      private:
+        enum class State : uint8_t { None, Pending, Ready, Failed };
+
+        struct Entry
+        {
+            Ptr image;
+            State state{State::None};
+            int refs{0};
+            uint64_t idleSince{0};    // release clock when refs hit 0
+            bool stale{false};        // invalidated while Pending
+        };
+
+        void enqueueLocked(const std::wstring& name, Entry& e)
+        {
+            e.state = State::Pending;
+            m_queue.push_back(name);
+            m_wake.notify_one();
+        }
+
+        bool popLocked(std::wstring& out)
+        {
+            if (m_queue.empty()) return false;
+            out = std::move(m_queue.front());
+            m_queue.pop_front();
+            return true;
+        }
+
+        // Unheld, settled entries beyond maxIdle go, oldest release first.
+        void evictLocked(std::vector<std::wstring>& evicted)
+        {
+            std::vector<std::pair<uint64_t, const std::wstring*>> idle;
+            for (auto& [name, e] : m_entries)
+                if (e.refs == 0 && e.state != State::Pending) idle.push_back({e.idleSince, &name});
+            if (idle.size() <= m_maxIdle) return;
+            std::sort(idle.begin(), idle.end(), [](auto& a, auto& b) { return a.first < b.first; });
+            size_t excess = idle.size() - m_maxIdle;
+            for (size_t i = 0; i < excess; i++) evicted.push_back(*idle[i].second);
+            for (auto& name : evicted) m_entries.erase(name);
+            m_evictions += excess;
+        }
+
+        // Copy-on-write: build the next snapshot from Ready entries and swap it in.
+        void publish()
+        {
+            auto next = std::make_shared<Snapshot>();
+            std::function<void()> onPublish;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (auto& [name, e] : m_entries)
+                    if (e.state == State::Ready && e.image) next->ready.emplace(name, e.image);
+                next->version = ++m_version;
+                // Stored under the lock so versions publish in order.
+                m_snapshot.store(std::shared_ptr<const Snapshot>(std::move(next)));
+                onPublish = m_onPublish;
+            }
+            if (onPublish) onPublish();
+        }
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::unordered_map<std::wstring, Entry> m_entries;
+        std::deque<std::wstring> m_queue;
+        std::atomic<std::shared_ptr<const Snapshot>> m_snapshot;
+        std::function<void()> m_onPublish;
+        std::thread m_worker;
+        bool m_stop{false};
+        size_t m_maxIdle;
+        uint64_t m_clock{0};
+        uint64_t m_version{0};
+        uint64_t m_decodes{0};
+        uint64_t m_failures{0};
+        uint64_t m_evictions{0};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_ICON_CACHE_H
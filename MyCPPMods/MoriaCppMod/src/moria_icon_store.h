@@ -0,0 +1,303 @@
+
+
+
+#pragma once
+#ifndef MORIA_ICON_STORE_H
+#define MORIA_ICON_STORE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include "moria_ini.h"
+#include "moria_offset_cache.h" // fnv1a64, offsetHex
+
+// Persistent store for extracted recipe icons: one pack file holding every
+// icon's premultiplied ARGB32 pixels back to back (icons.pack), plus an INI
+// manifest (icons.manifest) mapping texture name -> size, pack offset and
+// a 64-bit FNV-1a hash of the pixels. Loading an icon is one seek and one
+// read of exactly its bytes, with no directory probing and no PNG decode.
+// Identical pixels under different names are stored once.
+//
+// Appends go to the end of the pack and are indexed only after the write
+// is flushed, so a reader on another thread (the overlay's icon worker)
+// never sees an entry whose bytes aren't there. The manifest is rewritten
+// through a temp file + rename by saveManifest(). After a crash between
+// an append and the manifest save, the orphaned tail is simply skipped.
+// read() re-hashes the bytes, and an entry that doesn't match its hash
+// counts as missing, so it is re-extracted.
+//
+// Entries are never removed: a re-extracted texture whose pixels changed
+// appends a new record, and the old bytes become dead weight until the
+// store is deleted.
+//
+// Format (manifest, parsed with parseIniLine):
+//   [Store]  Version=1  PackBytes=0x...
+//   [Icons]  T_UI_Icon_Wall=128,128,0x10,0x9F3C...   (w,h,offset,hash)
+//
+// Pure (std::filesystem only): tested in tests/test_icon_store.cpp.
+
+namespace MoriaMods
+{
+
+    struct IconStoreEntry
+    {
+        int w{0};
+        int h{0};
+        uint64_t offset{0};
+        uint64_t hash{0};
+
+        uint64_t bytes() const { return uint64_t(w) * uint64_t(h) * 4; }
+    };
+
+    class IconStore
+    {
+      public:
+        static constexpr char kMagic[8] = {'M', 'I', 'C', 'P', 'A', 'C', 'K', '1'};
+        static constexpr int kMaxSide = 1024;
+
+        static uint64_t hashPixels(const uint32_t* px, size_t count) { return fnv1a64(px, count * 4); }
+
+        // Texture asset names are ASCII identifiers; anything else (or a
+        // character the INI manifest can't hold) is refused by put().
+        static bool validName(std::wstring_view name)
+        {
+            if (name.empty() || name.size() > 200) return false;
+            for (wchar_t c : name)
+                if (c <= L' ' || c >= 0x7F || c == L'=' || c == L'[' || c == L']' || c == L';' || c == L'#') return false;
+            return true;
+        }
+
+        // Open (or create) the store in `dir`. A missing or foreign pack
+        // starts an empty store; manifest entries that point past the end
+        // of the pack are dropped.
+        bool open(const std::filesystem::path& dir)
+        {
+            std::lock_guard lk(m_mu);
+            m_index.clear();
+            m_byHash.clear();
+            m_dirty = false;
+            m_open = false;
+            std::error_code ec;
+            std::filesystem::create_directories(dir, ec);
+            m_pack = dir / L"icons.pack";
+            m_manifest = dir / L"icons.manifest";
+
+            uint64_t packSize = std::filesystem::file_size(m_pack, ec);
+            bool validPack = false;
+            if (!ec && packSize >= sizeof(kMagic))
+            {
+                std::ifstream in(m_pack, std::ios::binary);
+                char magic[sizeof(kMagic)]{};
+                validPack = in.read(magic, sizeof(magic)) && std::equal(magic, magic + sizeof(magic), kMagic);
+            }
+            if (!validPack)
+            {
+                std::ofstream out(m_pack, std::ios::binary | std::ios::trunc);
+                if (!out.write(kMagic, sizeof(kMagic))) return false;
+                packSize = sizeof(kMagic);
+                m_dirty = true;
+            }
+            m_packEnd = packSize;
+
+            if (validPack)
+            {
+                std::ifstream mf(m_manifest);
+                std::stringstream text;
+                text << mf.rdbuf();
+                for (auto& [name, e] : parseManifest(text.str()))
+                {
+                    if (e.offset < sizeof(kMagic) || e.offset + e.bytes() > packSize)
+                    {
+                        m_dirty = true;
+                        continue;
+                    }
+                    m_byHash.emplace(e.hash, e);
+                    m_index.emplace(std::move(name), e);
+                }
+            }
+            m_open = true;
+            return true;
+        }
+
+        bool isOpen() const
+        {
+            std::lock_guard lk(m_mu);
+            return m_open;
+        }
+
+        bool contains(std::wstring_view name) const
+        {
+            std::lock_guard lk(m_mu);
+            return m_index.count(std::wstring(name)) != 0;
+        }
+
+        size_t size() const
+        {
+            std::lock_guard lk(m_mu);
+            return m_index.size();
+        }
+
+        uint64_t packBytes() const
+        {
+            std::lock_guard lk(m_mu);
+            return m_packEnd;
+        }
+
+        // One positioned read of the icon's pixels; false if the name is
+        // unknown or its bytes don't match the recorded hash (the entry is
+        // then forgotten, so the next extraction pass stores it again).
+        bool read(std::wstring_view name, int& w, int& h, std::vector<uint32_t>& pixels)
+        {
+            IconStoreEntry e;
+            std::filesystem::path pack;
+            {
+                std::lock_guard lk(m_mu);
+                auto it = m_index.find(std::wstring(name));
+                if (!m_open || it == m_index.end()) return false;
+                e = it->second;
+                pack = m_pack;
+            }
+            std::ifstream in(pack, std::ios::binary);
+            if (!in.seekg(std::streamoff(e.offset))) return false;
+            pixels.resize(size_t(e.w) * e.h);
+            if (!in.read(reinterpret_cast<char*>(pixels.data()), std::streamsize(e.bytes()))) return false;
+            if (hashPixels(pixels.data(), pixels.size()) != e.hash)
+            {
+                std::lock_guard lk(m_mu);
+                auto it = m_index.find(std::wstring(name));
+                if (it != m_index.end() && it->second.offset == e.offset)
+                {
+                    m_index.erase(it);
+                    auto [hb, he] = m_byHash.equal_range(e.hash);
+                    for (auto h2 = hb; h2 != he;)
+                        h2 = h2->second.offset == e.offset ? m_byHash.erase(h2) : std::next(h2);
+                    m_dirty = true;
+                }
+                return false;
+            }
+            w = e.w;
+            h = e.h;
+            return true;
+        }
+
+        // Store `name`'s pixels (premultiplied ARGB32, w*h). Re-putting the
+        // same pixels is a no-op; pixels already stored under another name
+        // are shared.
+        bool put(const std::wstring& name, int w, int h, const uint32_t* pixels)
+        {
+            if (!validName(name) || w <= 0 || h <= 0 || w > kMaxSide || h > kMaxSide || !pixels) return false;
+            IconStoreEntry e{w, h, 0, hashPixels(pixels, size_t(w) * h)};
+
+            std::lock_guard lk(m_mu);
+            if (!m_open) return false;
+            auto cur = m_index.find(name);
+            if (cur != m_index.end() && cur->second.hash == e.hash && cur->second.w == w && cur->second.h == h) return true;
+
+            auto [b, end] = m_byHash.equal_range(e.hash);
+            for (auto it = b; it != end; ++it)
+                if (it->second.w == w && it->second.h == h) e.offset = it->second.offset;
+            if (e.offset == 0)
+            {
+                std::fstream out(m_pack, std::ios::binary | std::ios::in | std::ios::out);
+                if (!out.seekp(std::streamoff(m_packEnd))) return false;
+                if (!out.write(reinterpret_cast<const char*>(pixels), std::streamsize(e.bytes()))) return false;
+                if (!out.flush()) return false;
+                e.offset = m_packEnd;
+                m_packEnd += e.bytes();
+                m_byHash.emplace(e.hash, e);
+            }
+            m_index[name] = e;
+            m_dirty = true;
+            return true;
+        }
+
+        // Rewrite the manifest if anything changed since the last save.
+        bool saveManifest()
+        {
+            std::lock_guard lk(m_mu);
+            if (!m_open) return false;
+            if (!m_dirty) return true;
+            std::filesystem::path tmp = m_manifest;
+            tmp += L".tmp";
+            {
+                std::ofstream out(tmp, std::ios::trunc);
+                std::string text = serializeManifest(m_index, m_packEnd);
+                if (!out.write(text.data(), std::streamsize(text.size()))) return false;
+            }
+            std::error_code ec;
+            std::filesystem::rename(tmp, m_manifest, ec);
+            if (ec) return false;
+            m_dirty = false;
+            return true;
+        }
+
+        static std::string serializeManifest(const std::unordered_map<std::wstring, IconStoreEntry>& index, uint64_t packBytes)
+        {
+            // Sorted, so the file diffs cleanly between saves.
+            std::vector<const std::pair<const std::wstring, IconStoreEntry>*> rows;
+            for (auto& kv : index) rows.push_back(&kv);
+            std::sort(rows.begin(), rows.end(), [](auto* a, auto* b) { return a->first < b->first; });
+
+            std::string out = "# MoriaCppMod icon store. Regenerated automatically;\n"
+                              "# delete this file and icons.pack to re-extract every icon.\n";
+            out += "[Store]\nVersion=1\nPackBytes=" + offsetHex(packBytes) + "\n[Icons]\n";
+            for (auto* kv : rows)
+            {
+                const IconStoreEntry& e = kv->second;
+                out += offsetNarrow(kv->first.c_str()) + "=" + std::to_string(e.w) + "," + std::to_string(e.h) + "," +
+                       offsetHex(e.offset) + "," + offsetHex(e.hash) + "\n";
+            }
+            return out;
+        }
+
+        static std::vector<std::pair<std::wstring, IconStoreEntry>> parseManifest(const std::string& text)
+        {
+            std::vector<std::pair<std::wstring, IconStoreEntry>> out;
+            std::istringstream in(text);
+            std::string section, line;
+            bool versionOk = false;
+            while (std::getline(in, line))
+            {
+                auto parsed = parseIniLine(line);
+                if (auto* sec = std::get_if<ParsedIniSection>(&parsed)) { section = sec->name; continue; }
+                auto* kv = std::get_if<ParsedIniKeyValue>(&parsed);
+                if (!kv) continue;
+                if (section == "Store" && kv->key == "Version") versionOk = kv->value == "1";
+                if (section != "Icons" || !versionOk) continue;
+
+                IconStoreEntry e;
+                unsigned long long off = 0, hash = 0;
+                if (std::sscanf(kv->value.c_str(), "%d,%d,%llx,%llx", &e.w, &e.h, &off, &hash) != 4) continue;
+                if (e.w <= 0 || e.h <= 0 || e.w > kMaxSide || e.h > kMaxSide) continue;
+                e.offset = off;
+                e.hash = hash;
+                std::wstring name(kv->key.begin(), kv->key.end());
+                if (validName(name)) out.emplace_back(std::move(name), e);
+            }
+            return out;
+        }
+
+      private:
+        mutable std::mutex m_mu;
+        std::filesystem::path m_pack;
+        std::filesystem::path m_manifest;
+        std::unordered_map<std::wstring, IconStoreEntry> m_index;
+        std::unordered_multimap<uint64_t, IconStoreEntry> m_byHash;
+        uint64_t m_packEnd{0};
+        bool m_dirty{false};
+        bool m_open{false};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_ICON_STORE_H
@@ -0,0 +1,88 @@
+
+
+
+#pragma once
+#ifndef MORIA_INI_H
+#define MORIA_INI_H
+
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <variant>
+
+// INI line parsing shared by MoriaCppMod.ini, GameMods.ini and the
+// definition pack manifests. No Windows dependency, so the deflint tool
+// builds it on Linux too.
+
+namespace MoriaMods
+{
+
+    struct ParsedIniSection
+    {
+        std::string name;
+    };
+    struct ParsedIniKeyValue
+    {
+        std::string key;
+        std::string value;
+    };
+    using ParsedIniLine = std::variant<std::monostate, ParsedIniSection, ParsedIniKeyValue>;
+
+
+    inline std::string trimStr(const std::string& s)
+    {
+        size_t start = s.find_first_not_of(" \t\r\n");
+        if (start == std::string::npos) return "";
+        size_t end = s.find_last_not_of(" \t\r\n");
+        return s.substr(start, end - start + 1);
+    }
+
+
+    inline ParsedIniLine parseIniLine(const std::string& line)
+    {
+        std::string trimmed = trimStr(line);
+        if (trimmed.empty() || trimmed[0] == ';' || trimmed[0] == '#')
+            return std::monostate{};
+
+
+        if (trimmed.front() == '[' && trimmed.back() == ']')
+        {
+            std::string name = trimStr(trimmed.substr(1, trimmed.size() - 2));
+            if (!name.empty()) return ParsedIniSection{name};
+            return std::monostate{};
+        }
+
+
+        auto eq = trimmed.find('=');
+        if (eq == std::string::npos) return std::monostate{};
+
+        std::string key = trimStr(trimmed.substr(0, eq));
+        std::string value = trimStr(trimmed.substr(eq + 1));
+
+
+        for (size_t i = 1; i < value.size(); i++)
+        {
+            if (value[i] == ';' && value[i - 1] == ' ')
+            {
+                value = trimStr(value.substr(0, i - 1));
+                break;
+            }
+        }
+
+        if (!key.empty()) return ParsedIniKeyValue{key, value};
+        return std::monostate{};
+    }
+
+
+    inline bool strEqualCI(std::string_view a, std::string_view b)
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++)
+            if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i])))
+                return false;
+        return true;
+    }
+
+} // namespace MoriaMods
+
+#endif // MORIA_INI_H
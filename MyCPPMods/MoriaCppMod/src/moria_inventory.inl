@@ -48,62 +48,29 @@
         //   - sizeof(FActiveItemEffect)            (the entry stride)
         //   - offset of OnItem (int32 itemID)
         //   - offset of Effect (UObject* effect class)
-        // Falls back to the previously-hardcoded values (stride 0x30,
-        // OnItem 0x0C, Effect 0x10) on any reflection failure - those
-        // values are stable across the game's life today.
+        // One walk via the registry in moria_offsets.h; anything reflection
+        // can't find stays on the historic values (stride 0x30, OnItem 0x0C,
+        // Effect 0x10), which are stable across the game's life today.
         bool ensureActiveItemEffectOffsets(UObject* invComp)
         {
-            if (s_off_aieStride > 0 && s_off_aieOnItem >= 0 && s_off_aieEffect >= 0)
-                return true;
+            if (offsetsResolved(OffStruct::ActiveItemEffect)) return true;
             if (!invComp) return false;
-            int stride = -1;
-            int offOnItem = resolveArrayStructLayout(invComp, STR("Effects.List"), STR("OnItem"), &stride);
-            // FFastArraySerializer.List isn't directly addressable as a
-            // dotted property on most UE4SS reflection paths, so fall back
-            // to walking via the Effects FStructProperty.
-            if (offOnItem < 0)
-            {
-                if (auto* eProp = invComp->GetPropertyByNameInChain(STR("Effects")))
-                {
-                    if (auto* sProp = CastField<FStructProperty>(eProp))
-                    {
-                        UStruct* fastArrStruct = sProp->GetStruct();
-                        if (fastArrStruct)
-                        {
-                            if (auto* listProp = fastArrStruct->GetPropertyByNameInChain(STR("List")))
-                            {
-                                if (auto* listArrProp = CastField<FArrayProperty>(listProp))
-                                {
-                                    auto* innerProp = listArrProp->GetInner();
-                                    if (auto* innerStructProp = CastField<FStructProperty>(innerProp))
-                                    {
-                                        UStruct* aieStruct = innerStructProp->GetStruct();
-                                        if (aieStruct)
-                                        {
-                                            if (auto* sStruct = static_cast<UScriptStruct*>(aieStruct))
-                                                stride = static_cast<int>(sStruct->GetStructureSize());
-                                            if (auto* onItemProp = aieStruct->GetPropertyByNameInChain(STR("OnItem")))
-                                                offOnItem = onItemProp->GetOffset_Internal();
-                                            if (auto* effectProp = aieStruct->GetPropertyByNameInChain(STR("Effect")))
-                                                s_off_aieEffect = effectProp->GetOffset_Internal();
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            s_off_aieStride = (stride > 0) ? stride : 0x30;
-            s_off_aieOnItem = (offOnItem >= 0) ? offOnItem : 0x0C;
-            if (s_off_aieEffect < 0) s_off_aieEffect = 0x10;
+            UScriptStruct* aieStruct = nullptr;
+            FProperty* eProp = invComp->GetPropertyByNameInChain(STR("Effects"));
+            if (auto* sProp = eProp ? CastField<FStructProperty>(eProp) : nullptr)
+                if (UStruct* fastArrStruct = sProp->GetStruct())
+                    if (auto* listProp = fastArrStruct->GetPropertyByNameInChain(STR("List")))
+                        if (auto* listArrProp = CastField<FArrayProperty>(listProp))
+                            if (auto* innerStructProp = CastField<FStructProperty>(listArrProp->GetInner()))
+                                aieStruct = innerStructProp->GetStruct();
+            resolveRegisteredStruct(OffStruct::ActiveItemEffect, aieStruct,
+                                    aieStruct ? static_cast<int>(aieStruct->GetStructureSize()) : 0);
             return true;
         }
 
-        // WARNING [W4]: Direct TArray memory manipulation — no UFUNCTION alternative exists.
-        // Bypasses replication/internal bookkeeping. Bounds-checked. Single-player context only.
-        // See memory/deferred-fixes.md for rationale.
-        bool removeItemEffectFromList(UObject* invComp, int32_t itemID, const wchar_t* effectClassName)
+        // Effects.List of an inventory component: data pointer and a
+        // reference to its Num, so callers can shrink it in place.
+        bool readEffectsList(UObject* invComp, uint8_t*& arrData, int32_t*& arrNum)
         {
             if (!invComp) return false;
             FProperty* effectsProp = invComp->GetPropertyByNameInChain(STR("Effects"));
@@ -118,32 +85,60 @@
             uint8_t* listBase = reinterpret_cast<uint8_t*>(invComp) + effectsOff + 0x0110;
             if (!isReadableMemory(listBase, 16)) return false;
 
-            uint8_t* arrData = *reinterpret_cast<uint8_t**>(listBase);
-            int32_t& arrNum = *reinterpret_cast<int32_t*>(listBase + 8);
-            const int stride   = s_off_aieStride;
-            const int offOnItem = s_off_aieOnItem;
-            const int offEffect = s_off_aieEffect;
+            arrData = *reinterpret_cast<uint8_t**>(listBase);
+            arrNum = reinterpret_cast<int32_t*>(listBase + 8);
+            return true;
+        }
 
-            for (int32_t j = arrNum - 1; j >= 0; j--)
-            {
+        // WARNING [W4]: Direct TArray memory manipulation — no UFUNCTION alternative exists.
+        // Bypasses replication/internal bookkeeping. Bounds-checked. Single-player context only.
+        // See memory/deferred-fixes.md for rationale.
+        bool removeItemEffectFromList(UObject* invComp, int32_t itemID, const wchar_t* effectClassName)
+        {
+            uint8_t* arrData = nullptr;
+            int32_t* arrNumPtr = nullptr;
+            if (!readEffectsList(invComp, arrData, arrNumPtr)) return false;
+            int32_t& arrNum = *arrNumPtr;
+            const int stride   = off(Off::AieStride);
+            const int offOnItem = off(Off::AieOnItem);
+            const int offEffect = off(Off::AieEffect);
+
+            auto tryRemove = [&](int32_t j) {
                 uint8_t* e = arrData + j * stride;
-                if (!isReadableMemory(e, stride)) continue;
+                if (!isReadableMemory(e, stride)) return false;
 
                 int32_t onItem = *reinterpret_cast<int32_t*>(e + offOnItem);
-                if (onItem != itemID) continue;
+                if (onItem != itemID) return false;
 
                 UObject* effect = *reinterpret_cast<UObject**>(e + offEffect);
-                if (!effect || !isReadableMemory(reinterpret_cast<uint8_t*>(effect), 64)) continue;
+                if (!effect || !isReadableMemory(reinterpret_cast<uint8_t*>(effect), 64)) return false;
 
                 std::wstring cls = safeClassName(effect);
-                if (cls != effectClassName) continue;
+                if (cls != effectClassName) return false;
 
                 VLOG(STR("[MoriaCppMod] [RemoveEffect] Removing {} at index {} (OnItem={}) from Effects.List\n"), effectClassName, j, onItem);
                 if (j < arrNum - 1)
                     std::memcpy(e, arrData + (arrNum - 1) * stride, stride);
                 arrNum--;
+                m_invIndex.invalidateEffects();
                 return true;
-            }
+            };
+
+            // Only this item's entries (m_invIndex effect index), last first.
+            // The index is keyed on (data, num) alone, so the game editing an
+            // entry in place or reallocating to the same address leaves it
+            // stale: a miss falls back to the full scan below.
+            m_invIndex.syncEffects(arrData, arrNum, [&](int32_t i) {
+                uint8_t* e = arrData + i * stride;
+                return isReadableMemory(e, stride) ? *reinterpret_cast<int32_t*>(e + offOnItem) : 0;
+            });
+            const auto& entries = m_invIndex.effectEntries(itemID);
+            for (auto jt = entries.rbegin(); jt != entries.rend(); ++jt)
+                if (*jt < arrNum && tryRemove(*jt)) return true;
+
+            m_invIndex.invalidateEffects();
+            for (int32_t j = arrNum - 1; j >= 0; j--)
+                if (tryRemove(j)) return true;
             return false;
         }
 
@@ -244,11 +239,11 @@
                     uint8_t* arrData = *reinterpret_cast<uint8_t**>(effectsBase);
                     int32_t arrNum = *reinterpret_cast<int32_t*>(effectsBase + 8);
                     VLOG(STR("[MoriaCppMod] [EffectDump] InvComp Effects.List count={} (effectsOff=0x{:X} stride=0x{:X})\n"),
-                         arrNum, effectsOff, s_off_aieStride);
+                         arrNum, effectsOff, off(Off::AieStride));
 
-                    const int stride    = s_off_aieStride;
-                    const int offOnItem = s_off_aieOnItem;
-                    const int offEffect = s_off_aieEffect;
+                    const int stride    = off(Off::AieStride);
+                    const int offOnItem = off(Off::AieOnItem);
+                    const int offEffect = off(Off::AieEffect);
                     // EndTime + AssetId offsets aren't reflected by name in
                     // this build; keep diagnostic-only hardcoded fallbacks.
                     constexpr int offEndTime    = 0x18;
@@ -296,136 +291,173 @@
         }
 
 
-        // Audit: detect+remove orphaned items not contained in any container.
-        // Logs only when verbose; corrections always run. Local player only (MP fix).
-        void auditInventory()
+        // Items.List of an inventory component as raw (data, num).
+        bool readInventoryList(UObject* invComp, uint8_t*& arrData, int32_t& arrNum)
         {
-            // MP fix: audit local player's inventory only, not first dwarf found
-            UObject* pawn = getPawn();
-            if (!pawn) return;
+            arrData = nullptr;
+            arrNum = 0;
+            if (!invComp) return false;
+            probeItemInstanceStruct(invComp);
+            FProperty* itemsProp = invComp->GetPropertyByNameInChain(STR("Items"));
+            if (!itemsProp) return false;
+            uint8_t* listBase = reinterpret_cast<uint8_t*>(invComp) + itemsProp->GetOffset_Internal() + iiaListOff();
+            if (!isReadableMemory(listBase, 16)) return false;
+            arrData = *reinterpret_cast<uint8_t**>(listBase);
+            arrNum = *reinterpret_cast<int32_t*>(listBase + 8);
+            return arrData && arrNum > 0 && arrNum <= 10000;
+        }
 
-            std::vector<UObject*> allComps;
-            findAllOfSafe(STR("InventoryComponent"), allComps);
+        InvItem readInvItem(uint8_t* arrData, int32_t i)
+        {
+            uint8_t* entry = arrData + i * iiSize();
+            if (!isReadableMemory(entry, iiSize())) return {};
+            return {*reinterpret_cast<int32_t*>(entry + iiIDOff()),
+                    *reinterpret_cast<int32_t*>(entry + iiSlotOff()),
+                    *reinterpret_cast<int32_t*>(entry + iiCountOff()),
+                    *reinterpret_cast<int32_t*>(entry + iiContainerStartOff()),
+                    *reinterpret_cast<UClass**>(entry + iiItemOff())};
+        }
 
-            for (auto* comp : allComps)
+        // Slot count of a container item class (CDO Storage->MaxSlots).
+        int32_t containerCapacity(const void* itemClass)
+        {
+            int32_t cMax = 101; // safe fallback (game uses ~101 slot spacing)
+            auto* cClass = static_cast<UClass*>(const_cast<void*>(itemClass));
+            if (!cClass) return cMax;
+            if (UObject* cdo = cClass->GetClassDefaultObject())
             {
-                if (!comp) continue;
-                auto* ownerFunc = comp->GetFunctionByNameInChain(STR("GetOwner"));
-                if (!ownerFunc) continue;
-                struct { UObject* Ret{nullptr}; } op{};
-                if (!safeProcessEvent(comp, ownerFunc, &op)) continue;
-                if (op.Ret != pawn) continue;
+                FProperty* sp = cdo->GetPropertyByNameInChain(STR("Storage"));
+                if (sp)
+                {
+                    uint8_t* sPtr = *reinterpret_cast<uint8_t**>(reinterpret_cast<uint8_t*>(cdo) + sp->GetOffset_Internal());
+                    if (sPtr && isReadableMemory(sPtr, 0x44))
+                        cMax = *reinterpret_cast<int32_t*>(sPtr + 0x38);
+                }
+            }
+            return cMax;
+        }
 
-                probeItemInstanceStruct(comp);
+        // Flags items that newly fell outside every container (log only;
+        // auditInventory() does the removal).
+        void reportNewOrphans()
+        {
+            for (int32_t id : m_invIndex.takeNewOrphans())
+            {
+                const InvItem* it = m_invIndex.item(id);
+                if (!it) continue;
+                auto* cls = static_cast<UClass*>(const_cast<void*>(it->itemClass));
+                VLOG(STR("[MoriaCppMod] [InvIndex] ORPHANED: id={} slot={} count={} class={}\n"),
+                     id, it->slot, it->count, cls ? std::wstring(cls->GetName()) : std::wstring(STR("(null)")));
+            }
+        }
 
-                FProperty* itemsProp = comp->GetPropertyByNameInChain(STR("Items"));
-                if (!itemsProp) continue;
-                int itemsOff = itemsProp->GetOffset_Internal();
-                uint8_t* listBase = reinterpret_cast<uint8_t*>(comp) + itemsOff + iiaListOff();
-                if (!isReadableMemory(listBase, 16)) continue;
+        // Entry of `itemID` in invComp's Items via m_invIndex: one entry
+        // re-read while the array is unchanged, one rebuild pass otherwise.
+        uint8_t* indexedInventoryEntry(UObject* invComp, int32_t itemID)
+        {
+            uint8_t* arrData = nullptr;
+            int32_t arrNum = 0;
+            if (!readInventoryList(invComp, arrData, arrNum)) return nullptr;
+            if (m_invIndexComp.Get() != invComp)
+            {
+                m_invIndex.clear();
+                m_invIndexComp = RC::Unreal::FWeakObjectPtr(invComp);
+            }
+            int32_t idx = m_invIndex.touch(arrData, arrNum, itemID,
+                [&](int32_t i) { return readInvItem(arrData, i); },
+                [&](const void* cls) { return containerCapacity(cls); });
+            reportNewOrphans();
+            return idx >= 0 ? arrData + idx * iiSize() : nullptr;
+        }
 
-                uint8_t* arrData = *reinterpret_cast<uint8_t**>(listBase);
-                int32_t arrNum = *reinterpret_cast<int32_t*>(listBase + 8);
-                if (!arrData || arrNum <= 0 || arrNum > 10000) continue;
 
-                int stride = iiSize();
-                int itemOff = iiItemOff();
-                int countOff = 0x18;
-                int slotOff  = 0x1C;
-                int idOff    = iiIDOff();
-                int containerStartSlotOff = 0x2C;
+        // Full m_invIndex pass over invComp's Items, for callers that read
+        // the slots of items no hook has named (container contents).
+        bool rebuildInventoryIndex(UObject* invComp)
+        {
+            uint8_t* arrData = nullptr;
+            int32_t arrNum = 0;
+            if (!readInventoryList(invComp, arrData, arrNum)) return false;
+            m_invIndexComp = RC::Unreal::FWeakObjectPtr(invComp);
+            m_invIndex.rebuild(arrData, arrNum,
+                [&](int32_t i) { return readInvItem(arrData, i); },
+                [&](const void* cls) { return containerCapacity(cls); });
+            reportNewOrphans();
+            return true;
+        }
 
-                VLOG(STR("[MoriaCppMod] [InvAudit] ===== Inventory: {} items =====\n"), arrNum);
 
-                int numContainers = 0;
-                for (int32_t i = 0; i < arrNum; i++)
-                {
-                    uint8_t* entry = arrData + i * stride;
-                    if (!isReadableMemory(entry, stride)) continue;
-                    int32_t cs = *reinterpret_cast<int32_t*>(entry + containerStartSlotOff);
-                    if (cs > 0) numContainers++;
+        // Audit: detect+remove orphaned items not contained in any container.
+        // Logs only when verbose; corrections always run. Local player only (MP fix).
+        // Full rebuild of m_invIndex; between audits the item-move hooks keep
+        // it current and flag new orphans as they happen.
+        void auditInventory()
+        {
+            // MP fix: audit local player's inventory only, not first dwarf found
+            UObject* pawn = getPawn();
+            if (!pawn) return;
 
-                    if (s_verbose)
-                    {
-                        UClass* ic = *reinterpret_cast<UClass**>(entry + itemOff);
-                        int32_t cnt = *reinterpret_cast<int32_t*>(entry + countOff);
-                        int32_t sl  = *reinterpret_cast<int32_t*>(entry + slotOff);
-                        int32_t id  = *reinterpret_cast<int32_t*>(entry + idOff);
-                        std::wstring nm = ic ? ic->GetName() : STR("(null)");
-                        std::wstring extra;
-                        if (cs > 0) extra = STR(" [CONTAINER start=") + std::to_wstring(cs) + STR("]");
-                        RC::Output::send<RC::LogLevel::Warning>(
-                            STR("[MoriaCppMod] [InvAudit]   [{}] id={} slot={} count={} class={}{}\n"),
-                            i, id, sl, cnt, nm, extra);
-                    }
-                }
+            UObject* comp = findPlayerInventoryComponent(pawn);
+            uint8_t* arrData = nullptr;
+            int32_t arrNum = 0;
+            if (!readInventoryList(comp, arrData, arrNum)) return;
+
+            m_invIndexComp = RC::Unreal::FWeakObjectPtr(comp);
+            m_invIndex.rebuild(arrData, arrNum,
+                [&](int32_t i) { return readInvItem(arrData, i); },
+                [&](const void* cls) { return containerCapacity(cls); });
+            m_invIndex.takeNewOrphans();   // reported below
 
+            VLOG(STR("[MoriaCppMod] [InvAudit] ===== Inventory: {} items =====\n"), arrNum);
+
+            if (s_verbose)
+            {
                 for (int32_t i = 0; i < arrNum; i++)
                 {
-                    uint8_t* entry = arrData + i * stride;
-                    if (!isReadableMemory(entry, stride)) continue;
-
-                    int32_t slot = *reinterpret_cast<int32_t*>(entry + slotOff);
-                    int32_t cs2  = *reinterpret_cast<int32_t*>(entry + containerStartSlotOff);
-                    if (cs2 > 0) continue;  // skip containers themselves
+                    InvItem it = readInvItem(arrData, i);
+                    if (it.id <= 0) continue;
+                    auto* ic = static_cast<UClass*>(const_cast<void*>(it.itemClass));
+                    std::wstring nm = ic ? ic->GetName() : STR("(null)");
+                    std::wstring extra;
+                    if (it.isContainer()) extra = STR(" [CONTAINER start=") + std::to_wstring(it.containerStart) + STR("]");
+                    RC::Output::send<RC::LogLevel::Warning>(
+                        STR("[MoriaCppMod] [InvAudit]   [{}] id={} slot={} count={} class={}{}\n"),
+                        i, it.id, it.slot, it.count, nm, extra);
+                }
+            }
 
-                    bool inContainer = false;
-                    for (int32_t j = 0; j < arrNum; j++)
-                    {
-                        uint8_t* cEntry = arrData + j * stride;
-                        if (!isReadableMemory(cEntry, stride)) continue;
-                        int32_t cStart = *reinterpret_cast<int32_t*>(cEntry + containerStartSlotOff);
-                        if (cStart <= 0) continue;
-                        int32_t cMax = 101; // safe fallback (game uses ~101 slot spacing)
-                        UClass* cClass = *reinterpret_cast<UClass**>(cEntry + itemOff);
-                        if (cClass)
-                        {
-                            if (UObject* cdo = cClass->GetClassDefaultObject())
-                            {
-                                FProperty* sp = cdo->GetPropertyByNameInChain(STR("Storage"));
-                                if (sp)
-                                {
-                                    uint8_t* sPtr = *reinterpret_cast<uint8_t**>(reinterpret_cast<uint8_t*>(cdo) + sp->GetOffset_Internal());
-                                    if (sPtr && isReadableMemory(sPtr, 0x44))
-                                        cMax = *reinterpret_cast<int32_t*>(sPtr + 0x38);
-                                }
-                            }
-                        }
-                        if (slot >= cStart && slot < cStart + cMax) { inContainer = true; break; }
-                    }
+            std::vector<InvItem> orphans;
+            for (int32_t id : m_invIndex.orphans())
+                if (const InvItem* it = m_invIndex.item(id)) orphans.push_back(*it);
 
-                    if (!inContainer)
-                    {
-                        UClass* ic2 = *reinterpret_cast<UClass**>(entry + itemOff);
-                        int32_t id2 = *reinterpret_cast<int32_t*>(entry + idOff);
-                        int32_t count2 = *reinterpret_cast<int32_t*>(entry + countOff);
-                        std::wstring orphanName = ic2 ? ic2->GetName() : STR("(null)");
+            for (auto& orphan : orphans)
+            {
+                auto* ic2 = static_cast<UClass*>(const_cast<void*>(orphan.itemClass));
+                std::wstring orphanName = ic2 ? ic2->GetName() : STR("(null)");
 
-                        VLOG(STR("[MoriaCppMod] [InvAudit] *** ORPHANED: id={} slot={} count={} class={} — removing...\n"),
-                            id2, slot, count2, orphanName);
+                VLOG(STR("[MoriaCppMod] [InvAudit] *** ORPHANED: id={} slot={} count={} class={} — removing...\n"),
+                    orphan.id, orphan.slot, orphan.count, orphanName);
 
-                        auto* removeFn = comp->GetFunctionByNameInChain(STR("RemoveItem"));
-                        if (removeFn && ic2)
-                        {
-                            int dsz = removeFn->GetParmsSize();
-                            std::vector<uint8_t> dp(dsz, 0);
-                            auto* itemParam = findParam(removeFn, STR("Item"));
-                            auto* countParam = findParam(removeFn, STR("Count"));
-                            auto* fromParam = findParam(removeFn, STR("From"));
-                            if (itemParam) *reinterpret_cast<UClass**>(dp.data() + itemParam->GetOffset_Internal()) = ic2;
-                            if (countParam) *reinterpret_cast<int32_t*>(dp.data() + countParam->GetOffset_Internal()) = count2;
-                            if (fromParam) *reinterpret_cast<uint8_t*>(dp.data() + fromParam->GetOffset_Internal()) = 0;
-                            if (safeProcessEvent(comp, removeFn, dp.data()))
-                                VLOG(STR("[MoriaCppMod] [InvAudit] *** REMOVED orphaned {} x{}\n"), orphanName, count2);
-                            else
-                                VLOG(STR("[MoriaCppMod] [InvAudit] *** REMOVE FAILED for {}\n"), orphanName);
-                        }
-                    }
+                auto* removeFn = comp->GetFunctionByNameInChain(STR("RemoveItem"));
+                if (removeFn && ic2)
+                {
+                    int dsz = removeFn->GetParmsSize();
+                    std::vector<uint8_t> dp(dsz, 0);
+                    auto* itemParam = findParam(removeFn, STR("Item"));
+                    auto* countParam = findParam(removeFn, STR("Count"));
+                    auto* fromParam = findParam(removeFn, STR("From"));
+                    if (itemParam) *reinterpret_cast<UClass**>(dp.data() + itemParam->GetOffset_Internal()) = ic2;
+                    if (countParam) *reinterpret_cast<int32_t*>(dp.data() + countParam->GetOffset_Internal()) = orphan.count;
+                    if (fromParam) *reinterpret_cast<uint8_t*>(dp.data() + fromParam->GetOffset_Internal()) = 0;
+                    if (safeProcessEvent(comp, removeFn, dp.data()))
+                        VLOG(STR("[MoriaCppMod] [InvAudit] *** REMOVED orphaned {} x{}\n"), orphanName, orphan.count);
+                    else
+                        VLOG(STR("[MoriaCppMod] [InvAudit] *** REMOVE FAILED for {}\n"), orphanName);
                 }
-
-                VLOG(STR("[MoriaCppMod] [InvAudit] ===== END ({} containers, {} items) =====\n"), numContainers, arrNum);
-                break;  // only process the first matching inventory component
             }
+
+            VLOG(STR("[MoriaCppMod] [InvAudit] ===== END ({} containers, {} items) =====\n"),
+                 m_invIndex.containerCount(), arrNum);
         }
 
 
@@ -438,70 +470,44 @@
             if (handleID <= 0) return;
 
 
-            probeItemInstanceStruct(invComp);
-
-            FProperty* itemsProp = invComp->GetPropertyByNameInChain(STR("Items"));
-            if (!itemsProp) return;
-            int itemsOff = itemsProp->GetOffset_Internal();
-
-            uint8_t* invBase = reinterpret_cast<uint8_t*>(invComp);
-            uint8_t* listBase = invBase + itemsOff + iiaListOff();
-            if (!isReadableMemory(listBase, 16)) return;
+            uint8_t* entry = indexedInventoryEntry(invComp, handleID);
+            if (!entry) return;
 
-            uint8_t* arrData = *reinterpret_cast<uint8_t**>(listBase);
-            int32_t arrNum = *reinterpret_cast<int32_t*>(listBase + 8);
-            if (!arrData || arrNum <= 0 || arrNum > 10000) return;
+            UClass* entryClass = *reinterpret_cast<UClass**>(entry + iiItemOff());
+            if (!entryClass) return;
 
-            int stride = iiSize();
-            int itemOff = iiItemOff();
-            int idOff = iiIDOff();
+            m_lastPickedUpItemClass = entryClass;
+            m_lastPickedUpItemName = entryClass->GetName();
 
-            for (int32_t i = 0; i < arrNum; i++)
+            m_lastPickedUpDisplayName.clear();
+            if (UObject* cdo = entryClass->GetClassDefaultObject())
             {
-                uint8_t* entry = arrData + i * stride;
-                if (!isReadableMemory(entry, stride)) continue;
-
-                int32_t entryID = *reinterpret_cast<int32_t*>(entry + idOff);
-                if (entryID != handleID) continue;
-
-                UClass* entryClass = *reinterpret_cast<UClass**>(entry + itemOff);
-                if (entryClass)
+                auto* getNameFn = cdo->GetFunctionByNameInChain(STR("GetDisplayName"));
+                if (getNameFn)
                 {
-                    m_lastPickedUpItemClass = entryClass;
-                    m_lastPickedUpItemName = entryClass->GetName();
-
-                    m_lastPickedUpDisplayName.clear();
-                    if (UObject* cdo = entryClass->GetClassDefaultObject())
+                    int nsz = getNameFn->GetParmsSize();
+                    std::vector<uint8_t> nbuf(nsz, 0);
+                    if (safeProcessEvent(cdo, getNameFn, nbuf.data()))
                     {
-                        auto* getNameFn = cdo->GetFunctionByNameInChain(STR("GetDisplayName"));
-                        if (getNameFn)
+                        auto* pNameRet = findParam(getNameFn, STR("ReturnValue"));
+                        if (pNameRet)
                         {
-                            int nsz = getNameFn->GetParmsSize();
-                            std::vector<uint8_t> nbuf(nsz, 0);
-                            if (safeProcessEvent(cdo, getNameFn, nbuf.data()))
-                            {
-                                auto* pNameRet = findParam(getNameFn, STR("ReturnValue"));
-                                if (pNameRet)
-                                {
-                                    FText* ft = reinterpret_cast<FText*>(nbuf.data() + pNameRet->GetOffset_Internal());
-                                    m_lastPickedUpDisplayName = ft->ToString();
-                                }
-                            }
+                            FText* ft = reinterpret_cast<FText*>(nbuf.data() + pNameRet->GetOffset_Internal());
+                            m_lastPickedUpDisplayName = ft->ToString();
                         }
                     }
-                    if (m_lastPickedUpDisplayName.empty())
-                        m_lastPickedUpDisplayName = m_lastPickedUpItemName;
+                }
+            }
+            if (m_lastPickedUpDisplayName.empty())
+                m_lastPickedUpDisplayName = m_lastPickedUpItemName;
 
-                    m_lastPickedUpCount = *reinterpret_cast<int32_t*>(entry + iiCountOff());
+            m_lastPickedUpCount = *reinterpret_cast<int32_t*>(entry + iiCountOff());
 
-                    std::memcpy(m_lastItemHandle, parms, 20);
-                    m_lastItemInvComp = RC::Unreal::FWeakObjectPtr(invComp);
-                    VLOG(STR("[MoriaCppMod] [Capture] item={} display='{}' ID={} count={}\n"), m_lastPickedUpItemName, m_lastPickedUpDisplayName, handleID, m_lastPickedUpCount);
+            std::memcpy(m_lastItemHandle, parms, 20);
+            m_lastItemInvComp = RC::Unreal::FWeakObjectPtr(invComp);
+            VLOG(STR("[MoriaCppMod] [Capture] item={} display='{}' ID={} count={}\n"), m_lastPickedUpItemName, m_lastPickedUpDisplayName, handleID, m_lastPickedUpCount);
 
-                    if (s_verbose) dumpItemEffects(entryClass, handleID, invComp);
-                }
-                return;
-            }
+            if (s_verbose) dumpItemEffects(entryClass, handleID, invComp);
         }
 
         void replenishLastItem()
@@ -609,8 +615,8 @@
             // must remain unchanged. Only the targeted instance gets
             // bumped to MaxStack.
             //
-            // The approach: walk the FItemInstance Items array, find the
-            // entry whose ID matches m_lastItemHandle's ID, and write
+            // The approach: look up the FItemInstance entry whose ID
+            // matches m_lastItemHandle's ID in m_invIndex, and write
             // its Count field directly via reflected offset. The same
             // pattern removeItemEffectFromList uses successfully for the
             // Effects FFastArraySerializer at moria_inventory.inl:49-84.
@@ -653,54 +659,13 @@
                 return;
             }
 
-            probeItemInstanceStruct(invComp);
-            FProperty* itemsProp = invComp->GetPropertyByNameInChain(STR("Items"));
-            if (!itemsProp)
-            {
-                showOnScreen(L"Replenish failed: Items property not resolved",
-                             3.0f, 1.0f, 0.4f, 0.4f);
-                return;
-            }
-
-            int itemsOff = itemsProp->GetOffset_Internal();
-            uint8_t* listBase = reinterpret_cast<uint8_t*>(invComp) + itemsOff + iiaListOff();
-            if (!isReadableMemory(listBase, 16))
-            {
-                showOnScreen(L"Replenish failed: Items list unreadable",
-                             3.0f, 1.0f, 0.4f, 0.4f);
-                return;
-            }
-
-            uint8_t* arrData = *reinterpret_cast<uint8_t**>(listBase);
-            int32_t arrNum   = *reinterpret_cast<int32_t*>(listBase + 8);
-            if (!arrData || arrNum <= 0 || arrNum > 10000)
-            {
-                showOnScreen(L"Replenish failed: Items array invalid",
-                             3.0f, 1.0f, 0.4f, 0.4f);
-                return;
-            }
-
-            int stride   = iiSize();
-            int idOff    = iiIDOff();
-            int countOff = 0x18;
-            uint8_t* targetEntry = nullptr;
-            int32_t  targetCount = 0;
-            for (int32_t i = 0; i < arrNum; i++)
-            {
-                uint8_t* entry = arrData + i * stride;
-                if (!isReadableMemory(entry, stride)) continue;
-                int32_t entryID = *reinterpret_cast<int32_t*>(entry + idOff);
-                if (entryID == targetID)
-                {
-                    targetEntry = entry;
-                    targetCount = *reinterpret_cast<int32_t*>(entry + countOff);
-                    break;
-                }
-            }
+            int countOff = iiCountOff();
+            uint8_t* targetEntry = indexedInventoryEntry(invComp, targetID);
+            int32_t  targetCount = targetEntry ? *reinterpret_cast<int32_t*>(targetEntry + countOff) : 0;
             if (!targetEntry)
             {
                 VLOG(STR("[MoriaCppMod] [Replenish] target ID={} not found in Items (arrNum={})\n"),
-                     targetID, arrNum);
+                     targetID, m_invIndex.size());
                 showOnScreen(L"Replenish failed: targeted stack not found in inventory",
                              3.0f, 1.0f, 0.4f, 0.4f);
                 return;
@@ -782,6 +747,145 @@
         }
 
 
+        // ---- Remove Attributes for a whole container (modifier + Remove Attributes) ----
+
+        static constexpr double STRIP_FRAME_BUDGET_MS = 1.0;
+
+        // Runes are dropped from Effects.List in one swapRemoveIf pass; every
+        // item is then queued for ServerTintItem(nullptr), as
+        // removeItemAttributes() does for one item, and drained by
+        // drainStripQueue() under m_stripPacer. Target container: the
+        // last-moved item if it is a container, else the container holding it.
+        void stripContainerAttributes()
+        {
+            if (!m_stripQueue.empty())
+            {
+                showOnScreen(L"Remove Attributes: container strip already running", 2.0f, 1.0f, 0.7f, 0.2f);
+                return;
+            }
+            int32_t lastID = *reinterpret_cast<int32_t*>(m_lastItemHandle);
+            UObject* invComp = m_lastItemInvComp.Get();
+            if (lastID <= 0 || !invComp)
+            {
+                showOnScreen(Loc::get("msg.no_item_selected"), 3.0f, 1.0f, 0.4f, 0.4f);
+                return;
+            }
+            UObject* pawn = getPawn();
+            if (!pawn)
+            {
+                showOnScreen(Loc::get("err.remove_attrs_no_pawn"), 3.0f, 1.0f, 0.4f, 0.4f);
+                return;
+            }
+            UObject* craftComp = findActorComponentByClass(pawn, STR("MorCraftingComponent"));
+            if (!craftComp)
+            {
+                showOnScreen(Loc::get("err.remove_attrs_no_craft"), 3.0f, 1.0f, 0.4f, 0.4f);
+                return;
+            }
+
+            // The hooks only refresh the item they name, so the contents'
+            // slots can be stale: resolve the container from a full pass.
+            if (!rebuildInventoryIndex(invComp)) return;
+            const InvItem* last = m_invIndex.item(lastID);
+            if (!last) return;
+            int32_t containerID = last->isContainer() ? lastID : m_invIndex.containerAt(last->slot);
+            std::vector<int32_t> contents = m_invIndex.itemsIn(containerID);
+            if (contents.empty())
+            {
+                showOnScreen(L"Remove Attributes: no container contents found", 3.0f, 1.0f, 0.7f, 0.2f);
+                return;
+            }
+            std::unordered_set<int32_t> targets(contents.begin(), contents.end());
+
+            using Clock = std::chrono::steady_clock;
+            auto tStart = Clock::now();
+            uint8_t* arrData = nullptr;
+            int32_t* arrNum = nullptr;
+            int32_t runes = 0;
+            if (readEffectsList(invComp, arrData, arrNum) && arrData && *arrNum > 0 && *arrNum <= 10000)
+            {
+                const int stride    = off(Off::AieStride);
+                const int offOnItem = off(Off::AieOnItem);
+                const int offEffect = off(Off::AieEffect);
+                std::unordered_map<UClass*, bool> isRune;
+                runes = swapRemoveIf(*arrNum,
+                    [&](int32_t j) {
+                        uint8_t* e = arrData + j * stride;
+                        if (!isReadableMemory(e, stride)) return false;
+                        int32_t onItem = *reinterpret_cast<int32_t*>(e + offOnItem);
+                        if (!targets.count(onItem)) return false;
+                        UObject* effect = *reinterpret_cast<UObject**>(e + offEffect);
+                        if (!effect || !isReadableMemory(reinterpret_cast<uint8_t*>(effect), 64)) return false;
+                        UClass* cls = effect->GetClassPrivate();
+                        auto [it, fresh] = isRune.try_emplace(cls, false);
+                        if (fresh) it->second = safeClassName(effect) == STR("MorRuneEffect");
+                        return it->second;
+                    },
+                    [&](int32_t dst, int32_t src) { std::memcpy(arrData + dst * stride, arrData + src * stride, stride); });
+                if (runes > 0) m_invIndex.invalidateEffects();
+            }
+            double passMs = std::chrono::duration<double, std::milli>(Clock::now() - tStart).count();
+
+            // A tint can outlive its Effects.List entry, so every item gets the call.
+            m_stripQueue.assign(contents.rbegin(), contents.rend());
+            m_stripRunes = runes;
+            m_stripTints = 0;
+            m_stripTotal = static_cast<int>(contents.size());
+            m_stripCraftComp = RC::Unreal::FWeakObjectPtr(craftComp);
+            m_stripLastFrame = {};
+            std::memcpy(m_stripHandle, m_lastItemHandle, 20);
+
+            VLOG(STR("[MoriaCppMod] [RemoveAttrs] Container id={}: {} items, {} rune effect(s) removed in {:.2f} ms, "
+                     "{} item(s) queued for ServerTintItem\n"),
+                 containerID, contents.size(), runes, passMs, m_stripQueue.size());
+            if (m_stripQueue.empty()) finishContainerStrip();
+        }
+
+        void finishContainerStrip()
+        {
+            std::wstring msg = std::format(L"Removed attributes from {} item(s), {} rune effect(s)", m_stripTotal, m_stripRunes);
+            showOnScreen(msg, 3.0f, 0.3f, 1.0f, 0.3f);
+            VLOG(STR("[MoriaCppMod] [RemoveAttrs] {} ({} runes, {} tints; {:.3f} ms/call)\n"),
+                 msg, m_stripRunes, m_stripTints, m_stripPacer.callCostMs());
+            m_stripCraftComp = RC::Unreal::FWeakObjectPtr{};
+        }
+
+        // One ServerTintItem(nullptr) per queued item, batch sized by m_stripPacer.
+        void drainStripQueue()
+        {
+            if (m_stripQueue.empty()) return;
+            UObject* craftComp = m_stripCraftComp.Get();
+            UObject* pawn = getPawn();
+            if (!craftComp || !pawn)
+            {
+                m_stripQueue.clear();
+                return;
+            }
+
+            using Clock = std::chrono::steady_clock;
+            auto frameStart = Clock::now();
+            double frameMs = m_stripLastFrame == Clock::time_point{} ? 0.0
+                : std::chrono::duration<double, std::milli>(frameStart - m_stripLastFrame).count();
+            m_stripLastFrame = frameStart;
+
+            int n = (int)std::min<size_t>(m_stripPacer.beginFrame(frameMs), m_stripQueue.size());
+            for (int i = 0; i < n; ++i)
+            {
+                // FItemHandle: the captured handle's Owner (bytes 8..19)
+                // with this item's ID; Payload left 0.
+                uint8_t handle[20];
+                std::memcpy(handle, m_stripHandle, 20);
+                *reinterpret_cast<int32_t*>(handle) = m_stripQueue.back();
+                *reinterpret_cast<int32_t*>(handle + 4) = 0;
+                if (callServerTintItem(craftComp, handle, nullptr, pawn)) m_stripTints++;
+                m_stripQueue.pop_back();
+            }
+            m_stripPacer.endFrame(n, std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
+
+            if (m_stripQueue.empty()) finishContainerStrip();
+        }
+
+
         // Trash confirm uses WBP_UI_GenericPopup_C (game-native template).
         // Buttons fire OnButtonReleasedEvent / OnMenuButtonClicked into our
         // PE post-hook chain — see onTrashPopupButtonClicked.
@@ -816,16 +920,25 @@
                 return;
             }
 
-            UObject* popup = jw_createGameWidget(s_genericPopupCls);
-            if (!popup) { VLOG(STR("[MoriaCppMod] [Trash] popup spawn failed\n")); return; }
-
-            // AddToViewport at high ZOrder so it sits above pause menu (~100-200).
-            if (auto* fn = popup->GetFunctionByNameInChain(STR("AddToViewport")))
+            // Reuse the popup parked by the last close; OnShowWithTwoButtons
+            // below rewrites all of its text either way.
+            UObject* popup = nullptr;
+            if (auto parked = m_trashPopupPool.acquire([](const PooledWidget& p) { return pooledWidgetAlive(p); }))
+                popup = unparkPooledWidget(*parked, 500);
+            logWidgetPool(STR("trash popup"), m_trashPopupPool, popup != nullptr);
+            if (!popup)
             {
-                std::vector<uint8_t> b(fn->GetParmsSize(), 0);
-                auto* p = findParam(fn, STR("ZOrder"));
-                if (p) *reinterpret_cast<int32_t*>(b.data() + p->GetOffset_Internal()) = 500;
-                safeProcessEvent(popup, fn, b.data());
+                popup = jw_createGameWidget(s_genericPopupCls);
+                if (!popup) { VLOG(STR("[MoriaCppMod] [Trash] popup spawn failed\n")); return; }
+
+                // AddToViewport at high ZOrder so it sits above pause menu (~100-200).
+                if (auto* fn = popup->GetFunctionByNameInChain(STR("AddToViewport")))
+                {
+                    std::vector<uint8_t> b(fn->GetParmsSize(), 0);
+                    auto* p = findParam(fn, STR("ZOrder"));
+                    if (p) *reinterpret_cast<int32_t*>(b.data() + p->GetOffset_Internal()) = 500;
+                    safeProcessEvent(popup, fn, b.data());
+                }
             }
 
             // Build labelText (item name + count + container-marker).
@@ -926,18 +1039,26 @@
         void hideTrashDialog()
         {
             if (!m_trashDlgVisible) return;
-            if (m_trashDlgWidget)
+            UObject* dlg = m_trashDlgWidget;
+            m_trashDlgWidget = nullptr;
+            // A collected popup is just forgotten; nothing may be called on it.
+            if (dlg && isObjectAlive(dlg))
             {
-                // Hide() plays the BP's Outro animation; RemoveFromParent
-                // then drops the widget.
-                if (auto* hideFn = m_trashDlgWidget->GetFunctionByNameInChain(STR("Hide")))
+                // Hide() plays the BP's Outro animation; the widget is then
+                // parked for the next DEL, or removed if the pool is full.
+                // Its Visibility is saved first: the outro may collapse it,
+                // and a reused popup must open visible.
+                PooledWidget state = pooledWidgetState(dlg);
+                if (auto* hideFn = dlg->GetFunctionByNameInChain(STR("Hide")))
                 {
                     std::vector<uint8_t> b(hideFn->GetParmsSize(), 0);
-                    try { safeProcessEvent(m_trashDlgWidget, hideFn, b.data()); } catch (...) {}
+                    try { safeProcessEvent(dlg, hideFn, b.data()); } catch (...) {}
+                }
+                if (isObjectAlive(dlg) && !m_trashPopupPool.release(parkPooledWidget(state)))
+                {
+                    if (auto* removeFn = dlg->GetFunctionByNameInChain(STR("RemoveFromParent")))
+                        safeProcessEvent(dlg, removeFn, nullptr);
                 }
-                auto* removeFn = m_trashDlgWidget->GetFunctionByNameInChain(STR("RemoveFromParent"));
-                if (removeFn) safeProcessEvent(m_trashDlgWidget, removeFn, nullptr);
-                m_trashDlgWidget = nullptr;
             }
             m_pendingTrashPopup = FWeakObjectPtr();
             m_trashDlgVisible = false;
@@ -1056,31 +1177,8 @@
 
 
                 int32_t nowCount = 0;
-                {
-                    FProperty* itemsProp3 = invComp->GetPropertyByNameInChain(STR("Items"));
-                    if (itemsProp3)
-                    {
-                        int off3 = itemsProp3->GetOffset_Internal();
-                        uint8_t* lb3 = reinterpret_cast<uint8_t*>(invComp) + off3 + iiaListOff();
-                        if (isReadableMemory(lb3, 16))
-                        {
-                            uint8_t* ad3 = *reinterpret_cast<uint8_t**>(lb3);
-                            int32_t an3 = *reinterpret_cast<int32_t*>(lb3 + 8);
-                            int32_t origID = *reinterpret_cast<int32_t*>(m_lastItemHandle);
-                            if (ad3 && an3 > 0 && an3 < 10000)
-                            {
-                                int stride3 = iiSize(), idOff3 = iiIDOff();
-                                for (int32_t i = 0; i < an3; i++)
-                                {
-                                    uint8_t* e3 = ad3 + i * stride3;
-                                    if (!isReadableMemory(e3, stride3)) continue;
-                                    if (*reinterpret_cast<int32_t*>(e3 + idOff3) == origID)
-                                    { nowCount = *reinterpret_cast<int32_t*>(e3 + iiCountOff()); break; }
-                                }
-                            }
-                        }
-                    }
-                }
+                if (uint8_t* e3 = indexedInventoryEntry(invComp, *reinterpret_cast<int32_t*>(m_lastItemHandle)))
+                    nowCount = *reinterpret_cast<int32_t*>(e3 + iiCountOff());
                 if (nowCount <= 0) break;
                 if (nowCount >= remaining)
                 {
@@ -1115,41 +1213,15 @@
 
             bool recaptured = false;
             int32_t originalID = *reinterpret_cast<int32_t*>(m_lastItemHandle);
-            if (invComp && originalID > 0)
+            uint8_t* entry2 = (invComp && originalID > 0) ? indexedInventoryEntry(invComp, originalID) : nullptr;
+            int32_t newCount = entry2 ? *reinterpret_cast<int32_t*>(entry2 + iiCountOff()) : 0;
+            if (newCount > 0)
             {
-                FProperty* itemsProp2 = invComp->GetPropertyByNameInChain(STR("Items"));
-                if (itemsProp2)
-                {
-                    int itemsOff2 = itemsProp2->GetOffset_Internal();
-                    uint8_t* invBase2 = reinterpret_cast<uint8_t*>(invComp);
-                    uint8_t* listBase2 = invBase2 + itemsOff2 + iiaListOff();
-                    if (isReadableMemory(listBase2, 16))
-                    {
-                        uint8_t* arrData2 = *reinterpret_cast<uint8_t**>(listBase2);
-                        int32_t arrNum2 = *reinterpret_cast<int32_t*>(listBase2 + 8);
-                        if (arrData2 && arrNum2 > 0 && arrNum2 < 10000)
-                        {
-                            int stride2 = iiSize();
-                            int idOff2 = iiIDOff();
-                            for (int32_t i = 0; i < arrNum2; i++)
-                            {
-                                uint8_t* entry2 = arrData2 + i * stride2;
-                                if (!isReadableMemory(entry2, stride2)) continue;
-                                int32_t entryID = *reinterpret_cast<int32_t*>(entry2 + idOff2);
-                                if (entryID != originalID) continue;
-
-                                int32_t newCount = *reinterpret_cast<int32_t*>(entry2 + iiCountOff());
-                                if (newCount <= 0) break;
-                                m_lastPickedUpCount = newCount;
-                                m_lastItemInvComp = RC::Unreal::FWeakObjectPtr(invComp);
-                                recaptured = true;
-                                VLOG(STR("[MoriaCppMod] [Trash] Same instance ID={} still exists — remaining count={}\n"),
-                                     originalID, newCount);
-                                break;
-                            }
-                        }
-                    }
-                }
+                m_lastPickedUpCount = newCount;
+                m_lastItemInvComp = RC::Unreal::FWeakObjectPtr(invComp);
+                recaptured = true;
+                VLOG(STR("[MoriaCppMod] [Trash] Same instance ID={} still exists — remaining count={}\n"),
+                     originalID, newCount);
             }
 
             if (!recaptured)
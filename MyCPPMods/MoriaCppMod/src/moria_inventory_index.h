@@ -0,0 +1,316 @@
+
+
+
+#pragma once
+#ifndef MORIA_INVENTORY_INDEX_H
+#define MORIA_INVENTORY_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Item-id index over the local player's FItemInstanceArray and Effects.List,
+// refreshed per move hook and rebuilt only when the array changes.
+
+namespace MoriaMods
+{
+
+    struct InvItem
+    {
+        int32_t id{0};               // <= 0: unreadable / empty entry
+        int32_t slot{0};
+        int32_t count{0};
+        int32_t containerStart{0};   // > 0: this item is a container
+        const void* itemClass{nullptr};
+
+        bool isContainer() const { return containerStart > 0; }
+    };
+
+    // Removes every entry i of [0, num) with remove(i) in one backwards
+    // pass, filling each hole from the tail (FastArray-style swap-remove,
+    // order not preserved). move(dst, src) copies an entry. Entries moved
+    // in from the tail were already visited, so each is tested once.
+    template <typename Remove, typename Move>
+    int32_t swapRemoveIf(int32_t& num, Remove&& remove, Move&& move)
+    {
+        int32_t removed = 0;
+        for (int32_t j = num - 1; j >= 0; j--)
+        {
+            if (!remove(j)) continue;
+            if (j < num - 1) move(j, num - 1);
+            num--;
+            removed++;
+        }
+        return removed;
+    }
+
+    class InventoryIndex
+    {
+      public:
+        // Ensure the index describes (data, num), refresh item `id` from its
+        // entry and return its array index (-1 = not in the inventory).
+        // `read(i)` -> InvItem; `capacityOf(itemClass)` -> container slots.
+        template <typename Read, typename Capacity>
+        int32_t touch(const void* data, int32_t num, int32_t id, Read&& read, Capacity&& capacityOf)
+        {
+            if (!current(data, num))
+            {
+                rebuild(data, num, read, capacityOf);
+                return indexOf(id);
+            }
+            int32_t idx = indexOf(id);
+            int32_t oldSlot = idx >= 0 ? m_items[idx].slot : 0;
+            if (idx < 0 || !refreshAt(idx, id, read, capacityOf))
+            {
+                rebuild(data, num, read, capacityOf);
+                return indexOf(id);
+            }
+            // A swap moved whoever held the new slot; its cached slot is stale.
+            int32_t newSlot = m_items[idx].slot;
+            if (newSlot != oldSlot)
+            {
+                for (int32_t i = 0; i < static_cast<int32_t>(m_items.size()); i++)
+                {
+                    if (i == idx || m_items[i].id <= 0 || m_items[i].slot != newSlot) continue;
+                    if (!refreshAt(i, m_items[i].id, read, capacityOf))
+                    {
+                        rebuild(data, num, read, capacityOf);
+                        return indexOf(id);
+                    }
+                }
+            }
+            return idx;
+        }
+
+        template <typename Read, typename Capacity>
+        void rebuild(const void* data, int32_t num, Read&& read, Capacity&& capacityOf)
+        {
+            m_data = data;
+            m_num = num;
+            m_built = true;
+            m_rebuilds++;
+            m_items.assign(num > 0 ? num : 0, InvItem{});
+            m_byId.clear();
+            m_byId.reserve(m_items.size());
+            for (int32_t i = 0; i < num; i++)
+            {
+                m_items[i] = read(i);
+                if (m_items[i].id > 0) m_byId[m_items[i].id] = i;
+            }
+            buildRanges(capacityOf);
+            // Orphan flags are keyed by ID so they survive reordering.
+            reclassifyAll();
+        }
+
+        bool current(const void* data, int32_t num) const { return m_built && data == m_data && num == m_num; }
+
+        int32_t indexOf(int32_t id) const
+        {
+            auto it = m_byId.find(id);
+            return it == m_byId.end() ? -1 : it->second;
+        }
+
+        const InvItem* item(int32_t id) const
+        {
+            int32_t idx = indexOf(id);
+            return idx >= 0 ? &m_items[idx] : nullptr;
+        }
+
+        // Slot inside some container's [start, start + capacity)?
+        // Ranges may overlap; containerAt() walks back while an earlier
+        // start could still cover the slot.
+        bool inAnyContainer(int32_t slot) const { return containerAt(slot) != 0; }
+
+        // ID of the container whose slot range holds `slot` (0 = none).
+        int32_t containerAt(int32_t slot) const
+        {
+            auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), slot,
+                                       [](int32_t s, const Range& r) { return s < r.start; });
+            while (it != m_ranges.begin())
+            {
+                --it;
+                if (slot < it->start + it->capacity) return it->id;
+                if (it->start + m_maxCapacity <= slot) break;
+            }
+            return 0;
+        }
+
+        // IDs stored in container `containerId`, in array order.
+        std::vector<int32_t> itemsIn(int32_t containerId) const
+        {
+            std::vector<int32_t> out;
+            const InvItem* c = item(containerId);
+            if (!c || !c->isContainer()) return out;
+            auto cap = m_capacityCache.find(c->itemClass);
+            if (cap == m_capacityCache.end()) return out;
+            for (auto& it : m_items)
+                if (it.id > 0 && it.id != containerId && it.slot >= c->containerStart &&
+                    it.slot < c->containerStart + cap->second)
+                    out.push_back(it.id);
+            return out;
+        }
+
+        // IDs currently outside every container, in array order.
+        std::vector<int32_t> orphans() const
+        {
+            std::vector<int32_t> out;
+            for (auto& it : m_items)
+                if (it.id > 0 && m_orphaned.count(it.id)) out.push_back(it.id);
+            return out;
+        }
+
+        // IDs that became orphans since the last call.
+        std::vector<int32_t> takeNewOrphans()
+        {
+            std::vector<int32_t> out;
+            out.swap(m_newOrphans);
+            return out;
+        }
+
+        int32_t size() const { return m_num; }
+        int32_t containerCount() const { return static_cast<int32_t>(m_ranges.size()); }
+        uint64_t rebuilds() const { return m_rebuilds; }
+        uint64_t refreshes() const { return m_refreshes; }
+
+        // ---- Effects.List ----
+
+        // `readOnItem(i)` -> owning item ID of effect entry i. Keyed on
+        // (data, num) only: entries edited in place go unnoticed, so callers
+        // treat a miss as "maybe stale" and fall back to a scan.
+        template <typename ReadOnItem>
+        void syncEffects(const void* data, int32_t num, ReadOnItem&& readOnItem)
+        {
+            if (m_effectsBuilt && data == m_effectsData && num == m_effectsNum) return;
+            m_effectsData = data;
+            m_effectsNum = num;
+            m_effectsBuilt = true;
+            m_effects.clear();
+            for (int32_t i = 0; i < num; i++)
+            {
+                int32_t onItem = readOnItem(i);
+                if (onItem > 0) m_effects[onItem].push_back(i);
+            }
+        }
+
+        // Effect entry indices for one item, ascending.
+        const std::vector<int32_t>& effectEntries(int32_t id) const
+        {
+            static const std::vector<int32_t> kNone;
+            auto it = m_effects.find(id);
+            return it == m_effects.end() ? kNone : it->second;
+        }
+
+        // Force the next syncEffects() to rebuild (after editing the list).
+        void invalidateEffects() { m_effectsBuilt = false; }
+
+        void clear()
+        {
+            m_items.clear();
+            m_byId.clear();
+            m_ranges.clear();
+            m_orphaned.clear();
+            m_newOrphans.clear();
+            m_effects.clear();
+            m_data = nullptr;
+            m_num = 0;
+            m_built = false;
+            m_effectsBuilt = false;
+            m_maxCapacity = 0;
+        }
+
+      private:
+        // Re-read entry `idx`, expected to still hold `id`; false = it
+        // doesn't (the caller rebuilds).
+        template <typename Read, typename Capacity>
+        bool refreshAt(int32_t idx, int32_t id, Read&& read, Capacity&& capacityOf)
+        {
+            InvItem fresh = read(idx);
+            if (fresh.id != id) return false;
+            InvItem& cur = m_items[idx];
+            bool rangesChanged = (cur.isContainer() || fresh.isContainer()) &&
+                                 (cur.containerStart != fresh.containerStart || cur.itemClass != fresh.itemClass);
+            cur = fresh;
+            m_refreshes++;
+            if (rangesChanged)
+            {
+                buildRanges(capacityOf);
+                reclassifyAll();
+            }
+            else
+            {
+                classify(idx);
+            }
+            return true;
+        }
+
+        struct Range
+        {
+            int32_t start;
+            int32_t capacity;
+            int32_t id;
+        };
+
+        template <typename Capacity>
+        void buildRanges(Capacity&& capacityOf)
+        {
+            m_ranges.clear();
+            m_maxCapacity = 0;
+            for (auto& it : m_items)
+            {
+                if (it.id <= 0 || !it.isContainer()) continue;
+                auto c = m_capacityCache.find(it.itemClass);
+                if (c == m_capacityCache.end())
+                    c = m_capacityCache.emplace(it.itemClass, capacityOf(it.itemClass)).first;
+                m_ranges.push_back({it.containerStart, c->second, it.id});
+                m_maxCapacity = std::max(m_maxCapacity, c->second);
+            }
+            std::sort(m_ranges.begin(), m_ranges.end(), [](const Range& a, const Range& b) { return a.start < b.start; });
+        }
+
+        void classify(int32_t idx)
+        {
+            const InvItem& it = m_items[idx];
+            if (it.id <= 0) return;
+            bool orphan = !it.isContainer() && !inAnyContainer(it.slot);
+            if (orphan)
+            {
+                if (m_orphaned.insert(it.id).second) m_newOrphans.push_back(it.id);
+            }
+            else
+            {
+                m_orphaned.erase(it.id);
+            }
+        }
+
+        void reclassifyAll()
+        {
+            for (auto it = m_orphaned.begin(); it != m_orphaned.end();)
+                it = m_byId.count(*it) ? std::next(it) : m_orphaned.erase(it);
+            for (int32_t i = 0; i < static_cast<int32_t>(m_items.size()); i++) classify(i);
+        }
+
+        std::vector<InvItem> m_items;
+        std::unordered_map<int32_t, int32_t> m_byId;
+        std::vector<Range> m_ranges;
+        int32_t m_maxCapacity{0};
+        std::unordered_map<const void*, int32_t> m_capacityCache;
+        std::unordered_set<int32_t> m_orphaned;
+        std::vector<int32_t> m_newOrphans;
+        const void* m_data{nullptr};
+        int32_t m_num{0};
+        bool m_built{false};
+        uint64_t m_rebuilds{0};
+        uint64_t m_refreshes{0};
+
+        std::unordered_map<int32_t, std::vector<int32_t>> m_effects;
+        const void* m_effectsData{nullptr};
+        int32_t m_effectsNum{0};
+        bool m_effectsBuilt{false};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_INVENTORY_INDEX_H
@@ -0,0 +1,237 @@
+
+
+
+#pragma once
+#ifndef MORIA_JSON_H
+#define MORIA_JSON_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace MoriaMods
+{
+
+    // One-pass index over a UAssetAPI JSON blob (the CDATA body of an
+    // <add_row>). Tokenizes once into a flat node array — one node per value,
+    // children linked first-child / next-sibling — so the recursive add-row
+    // writer looks fields up among an object's own members instead of
+    // re-running a text search for every key at every nesting level.
+    //
+    // Value text semantics match the old jsonExtractString scanner:
+    //   - strings: the raw bytes between the quotes (escapes NOT decoded)
+    //   - objects / arrays: the full span including the brackets
+    //   - anything else (numbers, true/false/null, UAssetAPI's "+0"): the bare
+    //     token, so non-standard scalars survive the same way they used to
+    //
+    // Owns its text and is immutable once built, so it can be constructed on
+    // any thread (parseDef does it at parse time) and read concurrently. Text
+    // and nodes come from `mr` — the load's DefArena during a definitions load.
+    class JsonIndex
+    {
+      public:
+        enum class Kind : uint8_t { Null, Bool, Number, String, Object, Array };
+        static constexpr int npos = -1;
+
+        JsonIndex() = default;
+        explicit JsonIndex(std::string_view text,
+                           std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+            : m_text(text, mr), m_nodes(mr)
+        {
+            build();
+        }
+
+        bool ok() const { return m_ok; }
+        bool empty() const { return m_text.empty(); }
+        size_t errorOffset() const { return m_errorOffset; }
+        size_t nodeCount() const { return m_nodes.size(); }
+        std::string_view text() const { return m_text; }
+
+        int root() const { return m_nodes.empty() ? npos : 0; }
+        Kind kind(int n) const { return m_nodes[n].kind; }
+        int firstChild(int n) const { return n == npos ? npos : m_nodes[n].firstChild; }
+        int next(int n) const { return m_nodes[n].next; }
+
+        std::string_view view(int n) const
+        {
+            if (n == npos) return {};
+            return std::string_view(m_text).substr(m_nodes[n].begin, m_nodes[n].end - m_nodes[n].begin);
+        }
+
+        std::string_view key(int n) const
+        {
+            if (n == npos) return {};
+            return std::string_view(m_text).substr(m_nodes[n].keyBegin, m_nodes[n].keyLen);
+        }
+
+        // Direct member of an object, or npos. Walks only that object's own
+        // members (a handful for UAssetAPI property objects), never the text.
+        int member(int obj, std::string_view name) const
+        {
+            if (obj == npos || m_nodes[obj].kind != Kind::Object) return npos;
+            for (int c = m_nodes[obj].firstChild; c != npos; c = m_nodes[c].next)
+                if (key(c) == name) return c;
+            return npos;
+        }
+
+        // Member value as text ("" when missing) — drop-in for
+        // jsonExtractString(json, objStart, objEnd, key).
+        std::string str(int obj, std::string_view name) const
+        {
+            return std::string(view(member(obj, name)));
+        }
+
+        // Object elements of an array, skipping anything else — drop-in for
+        // jsonArrayObjects().
+        std::vector<int> objects(int arr) const
+        {
+            std::vector<int> out;
+            if (arr == npos || m_nodes[arr].kind != Kind::Array) return out;
+            for (int c = m_nodes[arr].firstChild; c != npos; c = m_nodes[c].next)
+                if (m_nodes[c].kind == Kind::Object) out.push_back(c);
+            return out;
+        }
+
+      private:
+        struct Node
+        {
+            uint32_t begin{0};
+            uint32_t end{0};
+            uint32_t keyBegin{0};
+            uint32_t keyLen{0};
+            int32_t firstChild{npos};
+            int32_t next{npos};
+            Kind kind{Kind::Null};
+        };
+
+        static constexpr int MAX_DEPTH = 256;
+
+        std::pmr::string m_text;
+        std::pmr::vector<Node> m_nodes;
+        bool m_ok{false};
+        size_t m_errorOffset{0};
+
+        void skipWs(size_t& p) const
+        {
+            while (p < m_text.size() && (m_text[p] == ' ' || m_text[p] == '\t' || m_text[p] == '\r' || m_text[p] == '\n')) ++p;
+        }
+
+        // Position just past the closing quote of the string starting at p,
+        // or npos when unterminated.
+        size_t scanString(size_t p) const
+        {
+            for (++p; p < m_text.size(); ++p)
+            {
+                if (m_text[p] == '\\') { ++p; continue; }
+                if (m_text[p] == '"') return p + 1;
+            }
+            return std::string::npos;
+        }
+
+        bool fail(size_t p)
+        {
+            m_errorOffset = p;
+            return false;
+        }
+
+        void build()
+        {
+            // UAssetAPI dumps run about one node per 40 bytes.
+            m_nodes.reserve(m_text.size() / 32 + 1);
+            size_t p = 0;
+            skipWs(p);
+            if (!parseValue(p, 0, 0, 0)) return;
+            skipWs(p);
+            m_ok = (p == m_text.size()) || fail(p);
+        }
+
+        bool parseValue(size_t& p, uint32_t keyBegin, uint32_t keyLen, int depth)
+        {
+            if (p >= m_text.size()) return fail(p);
+            if (depth > MAX_DEPTH) return fail(p);
+
+            int self = static_cast<int>(m_nodes.size());
+            m_nodes.push_back({});
+            m_nodes[self].keyBegin = keyBegin;
+            m_nodes[self].keyLen = keyLen;
+
+            char c = m_text[p];
+            if (c == '"')
+            {
+                size_t e = scanString(p);
+                if (e == std::string::npos) return fail(p);
+                m_nodes[self].kind = Kind::String;
+                m_nodes[self].begin = static_cast<uint32_t>(p + 1);
+                m_nodes[self].end = static_cast<uint32_t>(e - 1);
+                p = e;
+                return true;
+            }
+
+            if (c == '{' || c == '[')
+            {
+                bool isObj = (c == '{');
+                char close = isObj ? '}' : ']';
+                m_nodes[self].kind = isObj ? Kind::Object : Kind::Array;
+                m_nodes[self].begin = static_cast<uint32_t>(p);
+                ++p;
+                skipWs(p);
+                int prev = npos;
+                if (p < m_text.size() && m_text[p] == close)
+                {
+                    ++p;
+                    m_nodes[self].end = static_cast<uint32_t>(p);
+                    return true;
+                }
+                for (;;)
+                {
+                    uint32_t kb = 0, kl = 0;
+                    if (isObj)
+                    {
+                        if (p >= m_text.size() || m_text[p] != '"') return fail(p);
+                        size_t e = scanString(p);
+                        if (e == std::string::npos) return fail(p);
+                        kb = static_cast<uint32_t>(p + 1);
+                        kl = static_cast<uint32_t>(e - p - 2);
+                        p = e;
+                        skipWs(p);
+                        if (p >= m_text.size() || m_text[p] != ':') return fail(p);
+                        ++p;
+                        skipWs(p);
+                    }
+
+                    int child = static_cast<int>(m_nodes.size());
+                    if (!parseValue(p, kb, kl, depth + 1)) return false;
+                    if (prev == npos) m_nodes[self].firstChild = child;
+                    else m_nodes[prev].next = child;
+                    prev = child;
+
+                    skipWs(p);
+                    if (p >= m_text.size()) return fail(p);
+                    if (m_text[p] == ',') { ++p; skipWs(p); continue; }
+                    if (m_text[p] == close) { ++p; break; }
+                    return fail(p);
+                }
+                m_nodes[self].end = static_cast<uint32_t>(p);
+                return true;
+            }
+
+            // Bare scalar: take everything up to the next delimiter.
+            size_t s = p;
+            while (p < m_text.size() && m_text[p] != ',' && m_text[p] != '}' && m_text[p] != ']'
+                   && m_text[p] != ' ' && m_text[p] != '\t' && m_text[p] != '\r' && m_text[p] != '\n') ++p;
+            if (p == s) return fail(p);
+            m_nodes[self].kind = (c == 'n') ? Kind::Null
+                               : (c == 't' || c == 'f') ? Kind::Bool
+                               : Kind::Number;
+            m_nodes[self].begin = static_cast<uint32_t>(s);
+            m_nodes[self].end = static_cast<uint32_t>(p);
+            return true;
+        }
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_JSON_H
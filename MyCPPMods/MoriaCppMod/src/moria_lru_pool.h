@@ -0,0 +1,141 @@
+
+
+
+#pragma once
+#ifndef MORIA_LRU_POOL_H
+#define MORIA_LRU_POOL_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Slot bookkeeping for a capped pool of reusable actors: idle slot, then a
+// new one under the cap, then the least recently used.
+
+namespace MoriaMods
+{
+
+    class LruSlotPool
+    {
+      public:
+        enum class Source : uint8_t { Idle, Fresh, Evicted };
+
+        struct Lease
+        {
+            int32_t slot{-1};
+            Source source{Source::Fresh};
+        };
+
+        explicit LruSlotPool(int32_t capacity = 32) : m_capacity(capacity > 0 ? capacity : 1) {}
+
+        Lease acquire()
+        {
+            int32_t slot = -1;
+            Source src = Source::Fresh;
+            if (!m_idle.empty())
+            {
+                // Most recently released first: likeliest to still be alive.
+                slot = m_idle.back();
+                m_idle.pop_back();
+                src = Source::Idle;
+                m_reuses++;
+            }
+            else if (size() < m_capacity)
+            {
+                slot = size();
+                m_active.push_back(false);
+                m_lastUse.push_back(0);
+                m_spawns++;
+            }
+            else
+            {
+                // Cap reached, everything in use: take the stalest.
+                uint64_t oldest = UINT64_MAX;
+                for (int32_t i = 0; i < size(); i++)
+                    if (m_active[i] && m_lastUse[i] < oldest) { oldest = m_lastUse[i]; slot = i; }
+                src = Source::Evicted;
+                m_evictions++;
+            }
+            if (!m_active[slot]) m_activeCount++;
+            m_active[slot] = true;
+            m_lastUse[slot] = ++m_clock;
+            return {slot, src};
+        }
+
+        // Back to the idle list; the object stays alive (hidden) for reuse.
+        void release(int32_t slot)
+        {
+            if (slot < 0 || slot >= size() || !m_active[slot]) return;
+            m_active[slot] = false;
+            m_activeCount--;
+            m_idle.push_back(slot);
+        }
+
+        // Calls fn(slot) for each active slot (oldest first), then releases them.
+        template <typename F>
+        void releaseAll(F&& fn)
+        {
+            std::vector<int32_t> order;
+            order.reserve(m_activeCount);
+            for (int32_t i = 0; i < size(); i++)
+                if (m_active[i]) order.push_back(i);
+            for (size_t a = 1; a < order.size(); a++)
+                for (size_t b = a; b > 0 && m_lastUse[order[b]] < m_lastUse[order[b - 1]]; b--)
+                    std::swap(order[b], order[b - 1]);
+            for (int32_t s : order)
+            {
+                fn(s);
+                release(s);
+            }
+        }
+
+        // Shrinking calls onRetire(slot) for every slot past the new cap,
+        // so the caller can destroy those objects; the rest are untouched.
+        template <typename F>
+        void setCapacity(int32_t capacity, F&& onRetire)
+        {
+            m_capacity = capacity > 0 ? capacity : 1;
+            if (size() <= m_capacity) return;
+            for (int32_t i = m_capacity; i < size(); i++)
+            {
+                if (m_active[i]) m_activeCount--;
+                onRetire(i);
+            }
+            m_active.resize(m_capacity);
+            m_lastUse.resize(m_capacity);
+            std::erase_if(m_idle, [this](int32_t s) { return s >= m_capacity; });
+        }
+
+        // Forget every slot (world teardown: the objects are gone anyway).
+        void clear()
+        {
+            m_active.clear();
+            m_lastUse.clear();
+            m_idle.clear();
+            m_activeCount = 0;
+        }
+
+        bool active(int32_t slot) const { return slot >= 0 && slot < size() && m_active[slot]; }
+        int32_t size() const { return static_cast<int32_t>(m_active.size()); }
+        int32_t activeCount() const { return m_activeCount; }
+        int32_t idleCount() const { return static_cast<int32_t>(m_idle.size()); }
+        int32_t capacity() const { return m_capacity; }
+        uint64_t spawns() const { return m_spawns; }
+        uint64_t reuses() const { return m_reuses; }
+        uint64_t evictions() const { return m_evictions; }
+
+      private:
+        std::vector<bool> m_active;
+        std::vector<uint64_t> m_lastUse;
+        std::vector<int32_t> m_idle;
+        int32_t m_capacity;
+        int32_t m_activeCount{0};
+        uint64_t m_clock{0};
+        uint64_t m_spawns{0};
+        uint64_t m_reuses{0};
+        uint64_t m_evictions{0};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_LRU_POOL_H
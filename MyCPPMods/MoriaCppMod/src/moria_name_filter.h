@@ -0,0 +1,180 @@
+
+
+
+#pragma once
+#ifndef MORIA_NAME_FILTER_H
+#define MORIA_NAME_FILTER_H
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// FName filters keyed on raw name-pool indices, so each base string is
+// resolved and tested once per index.
+
+namespace MoriaMods
+{
+
+    inline constexpr uint64_t nameKey(uint32_t comparisonIndex, uint32_t number)
+    {
+        return (static_cast<uint64_t>(comparisonIndex) << 32) | number;
+    }
+
+    // Open addressing with linear probing over a power-of-two table. All-ones
+    // marks an empty slot (it would need index and number both 0xFFFFFFFF).
+    template <typename V>
+    class NameKeyMap
+    {
+      public:
+        static constexpr uint64_t kEmpty = ~0ull;
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        void clear()
+        {
+            m_slots.clear();
+            m_size = 0;
+        }
+
+        void reserve(size_t n)
+        {
+            size_t want = 16;
+            while (want < n * 2) want <<= 1;
+            if (want > m_slots.size()) rehash(want);
+        }
+
+        // Inserts {key, value} unless present. Returns the stored value and
+        // whether it was inserted; nullptr for the reserved key.
+        std::pair<V*, bool> tryEmplace(uint64_t key, V value)
+        {
+            if (key == kEmpty) return {nullptr, false};
+            if ((m_size + 1) * 2 > m_slots.size()) rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+            size_t i = slotOf(key);
+            while (m_slots[i].key != kEmpty)
+            {
+                if (m_slots[i].key == key) return {&m_slots[i].value, false};
+                i = (i + 1) & (m_slots.size() - 1);
+            }
+            m_slots[i] = {key, value};
+            m_size++;
+            return {&m_slots[i].value, true};
+        }
+
+        const V* find(uint64_t key) const
+        {
+            if (m_size == 0 || key == kEmpty) return nullptr;
+            size_t i = slotOf(key);
+            while (m_slots[i].key != kEmpty)
+            {
+                if (m_slots[i].key == key) return &m_slots[i].value;
+                i = (i + 1) & (m_slots.size() - 1);
+            }
+            return nullptr;
+        }
+
+      private:
+        struct Slot
+        {
+            uint64_t key{kEmpty};
+            V value{};
+        };
+
+        size_t slotOf(uint64_t key) const
+        {
+            // Fibonacci hashing; the high bits are the best mixed.
+            return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+        }
+
+        void rehash(size_t capacity)
+        {
+            std::vector<Slot> old;
+            old.swap(m_slots);
+            m_slots.assign(capacity, Slot{});
+            m_shift = 64;
+            for (size_t n = capacity; n > 1; n >>= 1) m_shift--;
+            m_size = 0;
+            for (auto& s : old)
+                if (s.key != kEmpty) tryEmplace(s.key, s.value);
+        }
+
+        std::vector<Slot> m_slots;
+        size_t m_size{0};
+        int m_shift{64};
+    };
+
+    class NameKeySet
+    {
+      public:
+        size_t size() const { return m_map.size(); }
+        bool empty() const { return m_map.empty(); }
+        void clear() { m_map.clear(); }
+        void reserve(size_t n) { m_map.reserve(n); }
+
+        // True if newly inserted.
+        bool insert(uint64_t key) { return m_map.tryEmplace(key, 0).second; }
+        bool contains(uint64_t key) const { return m_map.find(key) != nullptr; }
+
+      private:
+        NameKeyMap<uint8_t> m_map;
+    };
+
+    // Row-name prefixes that mark dev/test/cheat content. Case variants are
+    // listed explicitly: the match is case-sensitive.
+    inline constexpr std::wstring_view kHiddenRowPrefixes[] = {
+        L"DEV_",        L"dev_",
+        L"Test_",       L"TEST_",      L"test_",
+        L"Playtest_",   L"PLAYTEST_",  L"playtest_",
+        L"Debug_",      L"DEBUG_",     L"debug_",
+        L"Cheat_",      L"CHEAT_",     L"cheat_",
+        L"WIP_",        L"wip_",
+        L"DEPRECATED_", L"_DEPRECATED_",
+    };
+
+    inline bool hasHiddenRowPrefix(std::wstring_view name)
+    {
+        for (auto p : kHiddenRowPrefixes)
+            if (name.starts_with(p)) return true;
+        return false;
+    }
+
+    // Hidden-prefix verdicts keyed by comparison index. The base string is
+    // resolved once per index; the Number only matters when the base is a
+    // prefix minus its trailing '_' ("DEV" #1 prints as "DEV_0").
+    class HiddenPrefixIndex
+    {
+      public:
+        // `resolveBase(index)` returns the base string (anything convertible to
+        // wstring_view) for an index not seen before.
+        template <typename Resolve>
+        bool isHidden(uint32_t comparisonIndex, uint32_t number, Resolve&& resolveBase)
+        {
+            auto [v, inserted] = m_verdicts.tryEmplace(comparisonIndex, Visible);
+            if (inserted)
+            {
+                auto resolved = resolveBase(comparisonIndex);
+                std::wstring_view base(resolved);
+                if (hasHiddenRowPrefix(base)) *v = Hidden;
+                else
+                {
+                    for (auto p : kHiddenRowPrefixes)
+                        if (p.size() == base.size() + 1 && p.starts_with(base)) { *v = HiddenIfNumbered; break; }
+                }
+            }
+            return *v == Hidden || (*v == HiddenIfNumbered && number > 0);
+        }
+
+        // Number of base strings resolved so far (one per distinct index).
+        size_t resolvedCount() const { return m_verdicts.size(); }
+
+        void clear() { m_verdicts.clear(); }
+
+      private:
+        enum : uint8_t { Visible, Hidden, HiddenIfNumbered };
+        NameKeyMap<uint8_t> m_verdicts;
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_NAME_FILTER_H
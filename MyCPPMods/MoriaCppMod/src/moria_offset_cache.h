@@ -0,0 +1,257 @@
+
+
+
+#pragma once
+#ifndef MORIA_OFFSET_CACHE_H
+#define MORIA_OFFSET_CACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <istream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "moria_ini.h"
+#include "moria_offsets.h"
+
+// On-disk cache of resolved reflection offsets, so a relaunch of the same
+// game build starts with every layout known instead of resolving lazily on
+// the first quick-build press or inventory action.
+//
+// Keyed by the game build id and a hash of the game module, plus a schema
+// hash of kOffsetTable and the persisted probe names — any of those
+// changing discards the whole file. Registry structs load as "cached" and
+// are spot-checked on first use (spotCheckCached). Plain s_off_* probe
+// slots load into place but stay pending per struct until one of them is
+// confirmed against a live object (spotCheckCachedProbes); a mismatch drops
+// everything the file supplied, since the key evidently missed a change.
+//
+// Format (INI, parsed with parseIniLine):
+//   [Key]      Build= Module= Schema=
+//   [Offsets]  FActiveItemEffect=0x30  FActiveItemEffect.OnItem=0x0C ...
+//   [Probes]   s_off_font=0x2A8 ...
+//
+// Pure: moria_reflection.h supplies the key and the file I/O.
+
+namespace MoriaMods
+{
+
+    struct OffsetCacheKey
+    {
+        uint32_t buildId{0};
+        uint64_t moduleHash{0};
+    };
+
+    // A plain `int` sentinel cache (-2 unresolved / -1 failed / >= 0 offset)
+    // that is persisted by name. Only resolved (>= 0) values are written.
+    // `root` names the live object the slot is resolved from and `path` the
+    // reflected property under it ("Brush.ImageSize"; a trailing '.' means
+    // the size of the struct reached), so a loaded value can be re-checked.
+    struct OffsetProbeSlot
+    {
+        const char* name;
+        int* value;
+        const char* root;
+        const char* path;
+    };
+
+    // Probe slots filled from the file, and the "root|struct path" groups
+    // among them not yet confirmed against a live object.
+    inline std::vector<int*> s_probeSlotsCached;
+    inline std::unordered_set<std::string> s_probeGroupsPending;
+
+    inline std::string offsetProbeGroup(const OffsetProbeSlot& p)
+    {
+        std::string_view path(p.path);
+        size_t dot = path.rfind('.');
+        return std::string(p.root) + '|' + std::string(dot == std::string_view::npos ? std::string_view{} : path.substr(0, dot));
+    }
+
+    inline uint64_t fnv1a64(const void* data, size_t len, uint64_t h = 0xcbf29ce484222325ull)
+    {
+        auto* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < len; i++)
+        {
+            h ^= p[i];
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    inline std::string offsetNarrow(const wchar_t* w)
+    {
+        std::string out;
+        for (; w && *w; ++w) out += static_cast<char>(*w);
+        return out;
+    }
+
+    // "FActiveItemEffect.OnItem", or just "FActiveItemEffect" for a stride row.
+    inline std::string offsetRowName(size_t row)
+    {
+        const OffsetField& f = kOffsetTable[row];
+        std::string name = offsetNarrow(kOffStructNames[static_cast<size_t>(f.owner)]);
+        if (f.field) name += '.' + offsetNarrow(f.field);
+        return name;
+    }
+
+    inline uint64_t offsetSchemaHash(std::span<const OffsetProbeSlot> probes)
+    {
+        uint64_t h = fnv1a64("moria-offsets-v1", 16);
+        for (size_t i = 0; i < OFF_COUNT; i++)
+        {
+            std::string row = offsetRowName(i);
+            h = fnv1a64(row.data(), row.size(), h);
+            h = fnv1a64(&kOffsetTable[i].fallback, sizeof(int), h);
+        }
+        for (auto& p : probes)
+        {
+            h = fnv1a64(p.name, std::string_view(p.name).size() + 1, h);
+            h = fnv1a64(p.path, std::string_view(p.path).size() + 1, h);
+        }
+        return h;
+    }
+
+    inline std::string offsetHex(uint64_t v)
+    {
+        char buf[24];
+        std::snprintf(buf, sizeof(buf), "0x%llX", static_cast<unsigned long long>(v));
+        return buf;
+    }
+
+    // Resolved (or still-cached) registry structs and resolved probe slots,
+    // ready to write.
+    inline std::string serializeOffsetCache(const OffsetCacheKey& key, std::span<const OffsetProbeSlot> probes)
+    {
+        std::string out = "# MoriaCppMod reflection offset cache. Regenerated automatically;\n"
+                          "# delete to force a full re-resolve.\n";
+        out += "[Key]\nBuild=" + offsetHex(key.buildId) + "\nModule=" + offsetHex(key.moduleHash) +
+               "\nSchema=" + offsetHex(offsetSchemaHash(probes)) + "\n";
+        out += "[Offsets]\n";
+        for (size_t s = 0; s < OFF_STRUCT_COUNT; s++)
+        {
+            if (!offsetsResolved(static_cast<OffStruct>(s)) && !offsetsCached(static_cast<OffStruct>(s))) continue;
+            auto [b, e] = offsetRows(static_cast<OffStruct>(s));
+            for (size_t i = b; i < e; i++)
+                out += offsetRowName(i) + "=" + offsetHex(static_cast<uint32_t>(s_offsets[i])) + "\n";
+        }
+        out += "[Probes]\n";
+        for (auto& p : probes)
+            if (*p.value >= 0) out += std::string(p.name) + "=" + offsetHex(static_cast<uint32_t>(*p.value)) + "\n";
+        return out;
+    }
+
+    // Apply a cache file if its key and schema match. Registry structs are
+    // taken only when every row is present and are marked cached (not yet
+    // resolved); probe slots still at -2 take their stored value and mark
+    // their group pending. Returns the number of values applied, or -1 when
+    // the file is for another build.
+    inline int loadOffsetCacheStream(std::istream& in, const OffsetCacheKey& key, std::span<const OffsetProbeSlot> probes)
+    {
+        std::unordered_map<std::string, std::string> keys, offsets, probeValues;
+        std::string section, line;
+        while (std::getline(in, line))
+        {
+            auto parsed = parseIniLine(line);
+            if (auto* sec = std::get_if<ParsedIniSection>(&parsed)) { section = sec->name; continue; }
+            auto* kv = std::get_if<ParsedIniKeyValue>(&parsed);
+            if (!kv) continue;
+            if (section == "Key") keys[kv->key] = kv->value;
+            else if (section == "Offsets") offsets[kv->key] = kv->value;
+            else if (section == "Probes") probeValues[kv->key] = kv->value;
+        }
+
+        if (keys["Build"] != offsetHex(key.buildId) || keys["Module"] != offsetHex(key.moduleHash) ||
+            keys["Schema"] != offsetHex(offsetSchemaHash(probes)))
+            return -1;
+
+        auto parseInt = [](const std::string& v, int& out) {
+            try
+            {
+                size_t used = 0;
+                long long n = std::stoll(v, &used, 0);
+                if (used != v.size() || n < 0 || n > 0x7FFFFFFF) return false;
+                out = static_cast<int>(n);
+                return true;
+            }
+            catch (...) { return false; }
+        };
+
+        int applied = 0;
+        for (size_t s = 0; s < OFF_STRUCT_COUNT; s++)
+        {
+            if (offsetsResolved(static_cast<OffStruct>(s))) continue;
+            auto [b, e] = offsetRows(static_cast<OffStruct>(s));
+            std::array<int, OFF_COUNT> values{};
+            bool complete = true;
+            for (size_t i = b; i < e && complete; i++)
+            {
+                auto it = offsets.find(offsetRowName(i));
+                complete = (it != offsets.end()) && parseInt(it->second, values[i]);
+            }
+            if (!complete) continue;
+            for (size_t i = b; i < e; i++) s_offsets[i] = values[i];
+            s_offStructCached[s] = true;
+            applied += static_cast<int>(e - b);
+        }
+        for (auto& p : probes)
+        {
+            auto it = probeValues.find(p.name);
+            int v = 0;
+            if (*p.value == -2 && it != probeValues.end() && parseInt(it->second, v))
+            {
+                *p.value = v;
+                s_probeSlotsCached.push_back(p.value);
+                s_probeGroupsPending.insert(offsetProbeGroup(p));
+                applied++;
+            }
+        }
+        return applied;
+    }
+
+    // Forget everything the file supplied: probe slots back to -2 and cached
+    // registry structs back to their fallbacks. Live-resolved values stay.
+    inline void dropOffsetCache()
+    {
+        for (int* v : s_probeSlotsCached) *v = -2;
+        s_probeSlotsCached.clear();
+        s_probeGroupsPending.clear();
+        for (size_t s = 0; s < OFF_STRUCT_COUNT; s++)
+        {
+            if (!offsetsCached(static_cast<OffStruct>(s))) continue;
+            s_offStructCached[s] = false;
+            auto [b, e] = offsetRows(static_cast<OffStruct>(s));
+            for (size_t i = b; i < e; i++) s_offsets[i] = kOffsetTable[i].fallback;
+        }
+    }
+
+    // Confirm the cached probe slots read from `root` before they're used:
+    // for each pending struct under it, the first loaded slot is compared
+    // with `offsetOf(path)` (-1 when absent). One mismatch drops the whole
+    // cache (dropOffsetCache) and returns false, so the caller resolves
+    // from scratch.
+    template <typename Lookup>
+    bool spotCheckCachedProbes(std::span<const OffsetProbeSlot> probes, std::string_view root, Lookup&& offsetOf)
+    {
+        if (s_probeGroupsPending.empty()) return true;
+        for (auto& p : probes)
+        {
+            if (root != p.root || *p.value < 0) continue;
+            auto it = s_probeGroupsPending.find(offsetProbeGroup(p));
+            if (it == s_probeGroupsPending.end()) continue;
+            s_probeGroupsPending.erase(it);
+            if (offsetOf(std::string_view(p.path)) != *p.value)
+            {
+                dropOffsetCache();
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace MoriaMods
+
+#endif // MORIA_OFFSET_CACHE_H
@@ -0,0 +1,287 @@
+
+
+
+#pragma once
+#ifndef MORIA_OFFSETS_H
+#define MORIA_OFFSETS_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cwchar>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Struct-layout table for raw reads: one OffStruct per game struct, resolved
+// from a single walk of its property chain and read through off(Off::X).
+
+namespace MoriaMods
+{
+
+    enum class OffStruct : uint8_t
+    {
+        ItemInstance,          // FItemInstance (Items.List element)
+        ItemInstanceArray,     // FItemInstanceArray (InventoryComponent.Items)
+        ActiveItemEffect,      // FActiveItemEffect (Effects.List element)
+        ConnectionHistoryItem, // FMorConnectionHistoryItem (AddSessionHistoryItem parm)
+        UITab,                 // FFGKUITab (UI_WBP_NavBar tabArray element)
+        Count
+    };
+
+    // Handles, in kOffsetTable order. *Stride rows are the struct size.
+    enum class Off : uint8_t
+    {
+        IiStride, IiItem, IiCount, IiID, IiDur,
+        IiaList,
+        AieStride, AieOnItem, AieEffect,
+        ChiStride, ChiWorldName, ChiConnType, ChiInviteString, ChiUniqueInvite,
+        ChiPassword, ChiIsDedicated, ChiCreated,
+        UitStride, UitName, UitDisplayName, UitWidgetClass, UitTabConfig,
+        Count
+    };
+
+    struct OffsetField
+    {
+        Off handle;
+        OffStruct owner;
+        const wchar_t* field;  // nullptr = the struct's own size (stride)
+        int fallback;
+        int size;              // expected property size; 0 = don't check
+    };
+
+    inline constexpr OffsetField kOffsetTable[] = {
+        {Off::IiStride,        OffStruct::ItemInstance,          nullptr,                0x30, 0},
+        {Off::IiItem,          OffStruct::ItemInstance,          L"Item",                0x10, 8},
+        {Off::IiCount,         OffStruct::ItemInstance,          L"Count",               0x18, 4},
+        {Off::IiID,            OffStruct::ItemInstance,          L"ID",                  0x20, 4},
+        {Off::IiDur,           OffStruct::ItemInstance,          L"Durability",          0x24, 4},
+
+        {Off::IiaList,         OffStruct::ItemInstanceArray,     L"List",                0x110, 0x10},
+
+        {Off::AieStride,       OffStruct::ActiveItemEffect,      nullptr,                0x30, 0},
+        {Off::AieOnItem,       OffStruct::ActiveItemEffect,      L"OnItem",              0x0C, 4},
+        {Off::AieEffect,       OffStruct::ActiveItemEffect,      L"Effect",              0x10, 8},
+
+        {Off::ChiStride,       OffStruct::ConnectionHistoryItem, nullptr,                0x58, 0},
+        {Off::ChiWorldName,    OffStruct::ConnectionHistoryItem, L"WorldName",           0x00, 0x10},
+        {Off::ChiConnType,     OffStruct::ConnectionHistoryItem, L"ConnectionType",      0x10, 1},
+        {Off::ChiInviteString, OffStruct::ConnectionHistoryItem, L"InviteString",        0x18, 0x10},
+        {Off::ChiUniqueInvite, OffStruct::ConnectionHistoryItem, L"UniqueInviteCode",    0x28, 0x10},
+        {Off::ChiPassword,     OffStruct::ConnectionHistoryItem, L"OptionalPassword",    0x38, 0x10},
+        {Off::ChiIsDedicated,  OffStruct::ConnectionHistoryItem, L"bIsDedicatedServer",  0x48, 1},
+        {Off::ChiCreated,      OffStruct::ConnectionHistoryItem, L"CreationDateTime",    0x50, 8},
+
+        {Off::UitStride,       OffStruct::UITab,                 nullptr,                0xE8, 0},
+        {Off::UitName,         OffStruct::UITab,                 L"Name",                0x00, 8},
+        {Off::UitDisplayName,  OffStruct::UITab,                 L"DisplayName",         0x08, 0x18},
+        {Off::UitWidgetClass,  OffStruct::UITab,                 L"WidgetClass",         0x20, 0},
+        {Off::UitTabConfig,    OffStruct::UITab,                 L"TabConfig",           0x48, 0},
+    };
+
+    // FItemInstance fields read at their shipping offsets without a probe:
+    // their reflected names aren't confirmed by a header dump, and a row
+    // under a guessed name would only ever resolve as Missing.
+    inline constexpr int kIiSlotOff = 0x1C;
+    inline constexpr int kIiContainerStartOff = 0x2C;
+
+    inline constexpr size_t OFF_COUNT = static_cast<size_t>(Off::Count);
+    inline constexpr size_t OFF_STRUCT_COUNT = static_cast<size_t>(OffStruct::Count);
+
+    constexpr bool offsetTableInHandleOrder()
+    {
+        for (size_t i = 0; i < std::size(kOffsetTable); i++)
+            if (static_cast<size_t>(kOffsetTable[i].handle) != i) return false;
+        return std::size(kOffsetTable) == OFF_COUNT;
+    }
+    static_assert(offsetTableInHandleOrder(), "kOffsetTable rows must match the Off enum one-to-one, in order");
+
+    inline constexpr const wchar_t* kOffStructNames[] = {
+        L"FItemInstance", L"FItemInstanceArray", L"FActiveItemEffect", L"FMorConnectionHistoryItem", L"FFGKUITab",
+    };
+    static_assert(std::size(kOffStructNames) == OFF_STRUCT_COUNT);
+
+    // Field rows of one struct, as a [begin, end) range into kOffsetTable.
+    // Rows of a struct are contiguous (checked below).
+    constexpr std::pair<size_t, size_t> offsetRows(OffStruct s)
+    {
+        size_t b = std::size(kOffsetTable), e = 0;
+        for (size_t i = 0; i < std::size(kOffsetTable); i++)
+            if (kOffsetTable[i].owner == s) { b = std::min(b, i); e = i + 1; }
+        return {b, e};
+    }
+
+    constexpr bool offsetRowsContiguous()
+    {
+        for (size_t s = 0; s < OFF_STRUCT_COUNT; s++)
+        {
+            auto [b, e] = offsetRows(static_cast<OffStruct>(s));
+            for (size_t i = b; i < e; i++)
+                if (kOffsetTable[i].owner != static_cast<OffStruct>(s)) return false;
+        }
+        return true;
+    }
+    static_assert(offsetRowsContiguous(), "kOffsetTable rows of one struct must be adjacent");
+
+    constexpr std::array<int, OFF_COUNT> offsetFallbacks()
+    {
+        std::array<int, OFF_COUNT> out{};
+        for (size_t i = 0; i < OFF_COUNT; i++) out[i] = kOffsetTable[i].fallback;
+        return out;
+    }
+
+    // Resolved offsets, seeded with the fallbacks.
+    inline std::array<int, OFF_COUNT> s_offsets = offsetFallbacks();
+    inline std::array<bool, OFF_STRUCT_COUNT> s_offStructResolved{};
+
+    // Loaded from the on-disk cache (moria_offset_cache.h) but not yet
+    // spot-checked against live reflection.
+    inline std::array<bool, OFF_STRUCT_COUNT> s_offStructCached{};
+
+    inline int off(Off h) { return s_offsets[static_cast<size_t>(h)]; }
+    inline bool offsetsResolved(OffStruct s) { return s_offStructResolved[static_cast<size_t>(s)]; }
+    inline bool offsetsCached(OffStruct s) { return s_offStructCached[static_cast<size_t>(s)]; }
+
+    // One discrepancy between reflection and the table.
+    struct OffsetMismatch
+    {
+        Off handle;
+        enum class Kind : uint8_t { Missing, Offset, Size } kind;
+        int expected;
+        int actual;
+    };
+
+    // Every mismatch found so far, across all resolved structs.
+    inline std::vector<OffsetMismatch> s_offsetMismatches;
+
+    // Resolve every registered field of `s` in one pass. `walk(visit)` must
+    // call visit(name, offset, size) for each property in the struct's chain
+    // (most-derived first). `structSize` <= 0 means the struct itself was not
+    // found, in which case everything stays on its fallback. Returns the
+    // number of mismatches added. Idempotent: later calls are a no-op.
+    template <typename Walk>
+    size_t resolveStruct(OffStruct s, int structSize, Walk&& walk)
+    {
+        if (offsetsResolved(s)) return 0;
+        s_offStructResolved[static_cast<size_t>(s)] = true;
+        s_offStructCached[static_cast<size_t>(s)] = false;
+        auto [b, e] = offsetRows(s);
+        size_t before = s_offsetMismatches.size();
+
+        std::array<bool, OFF_COUNT> found{};
+        if (structSize > 0)
+        {
+            walk([&](std::wstring_view name, int offset, int size) {
+                for (size_t i = b; i < e; i++)
+                {
+                    const OffsetField& f = kOffsetTable[i];
+                    if (!f.field || found[i] || name != f.field) continue;
+                    found[i] = true;
+                    s_offsets[i] = offset;
+                    if (offset != f.fallback)
+                        s_offsetMismatches.push_back({f.handle, OffsetMismatch::Kind::Offset, f.fallback, offset});
+                    if (f.size > 0 && size != f.size)
+                        s_offsetMismatches.push_back({f.handle, OffsetMismatch::Kind::Size, f.size, size});
+                    return;
+                }
+            });
+        }
+
+        for (size_t i = b; i < e; i++)
+        {
+            const OffsetField& f = kOffsetTable[i];
+            if (!f.field)
+            {
+                if (structSize <= 0)
+                {
+                    s_offsetMismatches.push_back({f.handle, OffsetMismatch::Kind::Missing, f.fallback, -1});
+                    continue;
+                }
+                s_offsets[i] = structSize;
+                if (structSize != f.fallback)
+                    s_offsetMismatches.push_back({f.handle, OffsetMismatch::Kind::Size, f.fallback, structSize});
+            }
+            else if (!found[i])
+            {
+                s_offsets[i] = f.fallback;
+                s_offsetMismatches.push_back({f.handle, OffsetMismatch::Kind::Missing, f.fallback, -1});
+            }
+        }
+        return s_offsetMismatches.size() - before;
+    }
+
+    // Confirm a struct loaded from the cache against live reflection with
+    // two cheap probes instead of a full walk: the struct size (when the
+    // struct has a stride row) and its first named field, looked up via
+    // `offsetOf(name)` (-1 when absent). On success the struct counts as
+    // resolved; on failure its rows go back to the fallbacks so the caller
+    // can run resolveStruct(). Returns false when `s` wasn't cached.
+    template <typename Lookup>
+    bool spotCheckCached(OffStruct s, int structSize, Lookup&& offsetOf)
+    {
+        if (!offsetsCached(s)) return false;
+        s_offStructCached[static_cast<size_t>(s)] = false;
+        auto [b, e] = offsetRows(s);
+        bool ok = structSize > 0;
+        bool checkedField = false;
+        for (size_t i = b; i < e && ok; i++)
+        {
+            const OffsetField& f = kOffsetTable[i];
+            if (!f.field)
+                ok = (s_offsets[i] == structSize);
+            else if (!checkedField)
+            {
+                checkedField = true;
+                ok = (offsetOf(std::wstring_view(f.field)) == s_offsets[i]);
+            }
+        }
+        if (ok)
+        {
+            s_offStructResolved[static_cast<size_t>(s)] = true;
+            return true;
+        }
+        for (size_t i = b; i < e; i++) s_offsets[i] = kOffsetTable[i].fallback;
+        return false;
+    }
+
+    // One line per mismatch ("FActiveItemEffect.OnItem offset 0x0C -> 0x14")
+    // from index `from` on, or empty when reflection agrees with the table.
+    inline std::wstring offsetMismatchSummary(size_t from = 0)
+    {
+        std::wstring out;
+        auto hex = [](int v) {
+            wchar_t buf[16];
+            swprintf(buf, 16, L"0x%02X", static_cast<unsigned>(v));
+            return std::wstring(buf);
+        };
+        for (size_t i = from; i < s_offsetMismatches.size(); i++)
+        {
+            const OffsetMismatch& m = s_offsetMismatches[i];
+            const OffsetField& f = kOffsetTable[static_cast<size_t>(m.handle)];
+            out += kOffStructNames[static_cast<size_t>(f.owner)];
+            if (f.field) { out += L'.'; out += f.field; }
+            switch (m.kind)
+            {
+            case OffsetMismatch::Kind::Missing: out += L" not found, using " + hex(m.expected); break;
+            case OffsetMismatch::Kind::Offset: out += L" offset " + hex(m.expected) + L" -> " + hex(m.actual); break;
+            case OffsetMismatch::Kind::Size: out += L" size " + hex(m.expected) + L" -> " + hex(m.actual); break;
+            }
+            out += L'\n';
+        }
+        return out;
+    }
+
+    // Back to fallbacks; for tests and a future LoadMap-time reset.
+    inline void resetOffsets()
+    {
+        s_offsets = offsetFallbacks();
+        s_offStructResolved = {};
+        s_offStructCached = {};
+        s_offsetMismatches.clear();
+    }
+
+} // namespace MoriaMods
+
+#endif // MORIA_OFFSETS_H
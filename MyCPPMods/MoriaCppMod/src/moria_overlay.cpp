@@ -8,307 +8,273 @@ namespace MoriaMods
 {
 
 
-    static void renderOverlay(HWND hwnd)
+    // Retained surface: the DIB and the glyph atlases survive across ticks
+    // and are recreated only when the layout changes (game resize / DPI).
+    // All drawing goes through the software compositor straight into the
+    // DIB bits; GDI is only used to present them. Owned by the overlay thread.
+    struct OverlaySurface
     {
-        if (!s_overlay.gameHwnd || !IsWindow(s_overlay.gameHwnd))
+        OverlayLayout layout;
+        HDC memDC{nullptr};
+        HBITMAP bmp{nullptr};
+        HBITMAP oldBmp{nullptr};
+        std::optional<Surface> pixels;        // compositor view of the DIB bits
+        std::optional<OverlayFonts> fonts;    // rasterizers hold GDI+ fonts
+    };
+    static OverlaySurface s_surface;
+    static OverlayFrameTracker<OVERLAY_SLOTS> s_frame;
+
+    // GDI+ Consolas as a glyph rasterizer: each character is drawn once in
+    // white onto a scratch PARGB bitmap and its alpha becomes the A8 mask.
+    static std::pair<GlyphAtlas::Rasterizer, int> gdipOverlayFont(float px, bool bold)
+    {
+        auto family = std::make_shared<Gdiplus::FontFamily>(L"Consolas");
+        auto font = std::make_shared<Gdiplus::Font>(family.get(), px, bold ? Gdiplus::FontStyleBold : Gdiplus::FontStyleRegular,
+                                                    Gdiplus::UnitPixel);
+        int lineHeight = 0;
         {
-            s_overlay.gameHwnd = findGameWindow();
-            if (!s_overlay.gameHwnd) return;
+            Gdiplus::Bitmap probe(1, 1, PixelFormat32bppPARGB);
+            Gdiplus::Graphics g(&probe);
+            lineHeight = static_cast<int>(std::ceil(font->GetHeight(&g)));
         }
+        auto raster = [family, font, lineHeight](wchar_t c, std::vector<uint8_t>& mask, int& w, int& h, int& advance) {
+            Gdiplus::StringFormat fmt(Gdiplus::StringFormat::GenericTypographic());
+            fmt.SetFormatFlags(fmt.GetFormatFlags() | Gdiplus::StringFormatFlagsMeasureTrailingSpaces);
+            Gdiplus::Bitmap bmp(lineHeight * 2, lineHeight, PixelFormat32bppPARGB);
+            Gdiplus::Graphics g(&bmp);
+            g.SetTextRenderingHint(Gdiplus::TextRenderingHintAntiAliasGridFit);
+
+            Gdiplus::RectF box;
+            g.MeasureString(&c, 1, font.get(), Gdiplus::PointF(0, 0), &fmt, &box);
+            advance = static_cast<int>(std::lround(box.Width));
+            if (c == L' ') return false;
+
+            g.Clear(Gdiplus::Color(0, 0, 0, 0));
+            Gdiplus::SolidBrush white(Gdiplus::Color(255, 255, 255, 255));
+            g.DrawString(&c, 1, font.get(), Gdiplus::PointF(0, 0), &fmt, &white);
+            g.Flush(Gdiplus::FlushIntentionSync);
+
+            w = std::min(static_cast<int>(std::ceil(box.Width)) + 1, lineHeight * 2);
+            h = lineHeight;
+            Gdiplus::Rect rect(0, 0, w, h);
+            Gdiplus::BitmapData data{};
+            if (bmp.LockBits(&rect, Gdiplus::ImageLockModeRead, PixelFormat32bppPARGB, &data) != Gdiplus::Ok) return false;
+            mask.resize(size_t(w) * h);
+            for (int y = 0; y < h; y++)
+            {
+                auto* row = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(data.Scan0) + y * data.Stride);
+                for (int x = 0; x < w; x++) mask[size_t(y) * w + x] = uint8_t(row[x] >> 24);
+            }
+            bmp.UnlockBits(&data);
+            return true;
+        };
+        return {raster, lineHeight};
+    }
 
-        RECT clientRect;
-        GetClientRect(s_overlay.gameHwnd, &clientRect);
-        POINT origin = {0, 0};
-        ClientToScreen(s_overlay.gameHwnd, &origin);
-        int gameW = clientRect.right;
-        int gameH = clientRect.bottom;
-        if (gameW < 100 || gameH < 100) return;
-
-        float scale = gameH / 1080.0f;
-        if (scale < 0.5f) scale = 0.5f;
-
-
-        int slotSize = static_cast<int>(48 * scale);
-        int gap = static_cast<int>(4 * scale);
-        int padding = static_cast<int>(6 * scale);
-        int labelH = static_cast<int>(14 * scale);
-        int separatorW = static_cast<int>(8 * scale);
-
-        int overlayW = padding * 2 + OVERLAY_SLOTS * slotSize + (OVERLAY_SLOTS - 1) * gap + separatorW;
-        int overlayH = padding * 2 + slotSize + labelH;
-        int overlayX = origin.x + (gameW - overlayW) / 2;
-        int overlayY = origin.y + static_cast<int>(4 * scale);
-
-        if (!s_overlay.visible)
+    // Must run on the overlay thread before stopOverlay shuts GDI+ down.
+    static void releaseOverlaySurface()
+    {
+        s_surface.fonts.reset();
+        s_surface.pixels.reset();
+        if (s_surface.memDC)
         {
-            ShowWindow(hwnd, SW_HIDE);
-            return;
+            SelectObject(s_surface.memDC, s_surface.oldBmp);
+            DeleteDC(s_surface.memDC);
         }
-        if (!IsWindowVisible(hwnd)) ShowWindow(hwnd, SW_SHOWNOACTIVATE);
+        if (s_surface.bmp) DeleteObject(s_surface.bmp);
+        s_surface.memDC = nullptr;
+        s_surface.bmp = nullptr;
+        s_surface.oldBmp = nullptr;
+        s_frame.invalidate();
+    }
 
+    static bool rebuildOverlaySurface(const OverlayLayout& l)
+    {
+        releaseOverlaySurface();
 
         HDC screenDC = GetDC(nullptr);
-        HDC memDC = CreateCompatibleDC(screenDC);
+        s_surface.memDC = CreateCompatibleDC(screenDC);
         BITMAPINFO bmi{};
         bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-        bmi.bmiHeader.biWidth = overlayW;
-        bmi.bmiHeader.biHeight = -overlayH;
+        bmi.bmiHeader.biWidth = l.width;
+        bmi.bmiHeader.biHeight = -l.height;
         bmi.bmiHeader.biPlanes = 1;
         bmi.bmiHeader.biBitCount = 32;
         bmi.bmiHeader.biCompression = BI_RGB;
         void* bits = nullptr;
-        HBITMAP bmp = CreateDIBSection(screenDC, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
-        if (!bmp)
-        {
-            DeleteDC(memDC);
-            ReleaseDC(nullptr, screenDC);
-            return;
-        }
-        HBITMAP oldBmp = (HBITMAP)SelectObject(memDC, bmp);
-
-
-        OverlaySlot localSlots[OVERLAY_SLOTS]{};
-        if (s_overlay.csInit)
+        s_surface.bmp = CreateDIBSection(screenDC, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
+        ReleaseDC(nullptr, screenDC);
+        if (!s_surface.bmp || !s_surface.memDC)
         {
-            CriticalSectionLock slotLock(s_overlay.slotCS);
-            for (int i = 0; i < OVERLAY_SLOTS; i++)
-                localSlots[i] = s_overlay.slots[i];
+            releaseOverlaySurface();
+            return false;
         }
+        s_surface.oldBmp = (HBITMAP)SelectObject(s_surface.memDC, s_surface.bmp);
+        s_surface.layout = l;
+
+        // Top-down 32bpp DIB rows are exactly width pixels; the compositor
+        // writes premultiplied ARGB, which is what AC_SRC_ALPHA expects.
+        s_surface.pixels.emplace(Surface::wrap(static_cast<uint32_t*>(bits), l.width, l.height, l.width));
+        s_surface.fonts.emplace(OverlayFonts::make(l, gdipOverlayFont));
+        return true;
+    }
 
+    // Per-tick values the cell keys are built from; the icon snapshot keeps
+    // every image a key points at alive until the frame is painted.
+    struct OverlayTickState
+    {
+        const OverlaySlots* slots{nullptr};   // overlay thread's published front buffer
+        std::shared_ptr<const IconCache<ArgbImage>::Snapshot> icons;
+        int rotationStep{0};
+        int totalRotation{0};
+        int stabMarginal{-1};
+        int stabCritical{-1};
+    };
+
+    static OverlayFrameTracker<OVERLAY_SLOTS>::Cells collectOverlayCells(const OverlayTickState& st)
+    {
+        OverlayFrameTracker<OVERLAY_SLOTS>::Cells cells{};
+        for (int i = 0; i < OVERLAY_SLOTS; i++)
         {
-            Gdiplus::Graphics gfx(memDC);
-            gfx.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
-            gfx.SetTextRenderingHint(Gdiplus::TextRenderingHintAntiAliasGridFit);
-            gfx.SetInterpolationMode(Gdiplus::InterpolationModeHighQualityBicubic);
-
-
-            Gdiplus::SolidBrush bgBrush(Gdiplus::Color(100, 5, 8, 18));
-            int radius = static_cast<int>(6 * scale);
-            Gdiplus::GraphicsPath bgPath;
-            bgPath.AddArc(0, 0, radius * 2, radius * 2, 180, 90);
-            bgPath.AddArc(overlayW - radius * 2 - 1, 0, radius * 2, radius * 2, 270, 90);
-            bgPath.AddArc(overlayW - radius * 2 - 1, overlayH - radius * 2 - 1, radius * 2, radius * 2, 0, 90);
-            bgPath.AddArc(0, overlayH - radius * 2 - 1, radius * 2, radius * 2, 90, 90);
-            bgPath.CloseFigure();
-            gfx.FillPath(&bgBrush, &bgPath);
-
-
-            Gdiplus::SolidBrush emptyBrush(Gdiplus::Color(51, 235, 235, 230));
-            Gdiplus::SolidBrush usedBrush(Gdiplus::Color(51, 245, 245, 240));
-            Gdiplus::Pen slotBorder(Gdiplus::Color(180, 100, 160, 230), 3.0f);
-            Gdiplus::Pen usedBorder(Gdiplus::Color(220, 120, 180, 255), 3.0f);
-            float labelFontSz = 10.0f * scale;
-            if (labelFontSz < 9.0f) labelFontSz = 9.0f;
-            Gdiplus::FontFamily fontFamily(L"Consolas");
-            Gdiplus::Font labelFont(&fontFamily, labelFontSz, Gdiplus::FontStyleRegular, Gdiplus::UnitPixel);
-            float nameFontSz = 9.0f * scale;
-            if (nameFontSz < 8.0f) nameFontSz = 8.0f;
-            Gdiplus::Font nameFont(&fontFamily, nameFontSz, Gdiplus::FontStyleRegular, Gdiplus::UnitPixel);
-            Gdiplus::SolidBrush labelBrush(Gdiplus::Color(200, 140, 170, 210));
-            Gdiplus::SolidBrush nameBrush(Gdiplus::Color(180, 180, 200, 230));
-            Gdiplus::SolidBrush letterBrush(Gdiplus::Color(140, 100, 140, 200));
-            Gdiplus::Font letterFont(&fontFamily, slotSize * 0.45f, Gdiplus::FontStyleBold, Gdiplus::UnitPixel);
-            Gdiplus::StringFormat centerFmt;
-            centerFmt.SetAlignment(Gdiplus::StringAlignmentCenter);
-            centerFmt.SetLineAlignment(Gdiplus::StringAlignmentCenter);
-
-
-            Gdiplus::Pen separatorPen(Gdiplus::Color(180, 200, 210, 230), 1.0f);
-
-            for (int i = 0; i < OVERLAY_SLOTS; i++)
+            auto& c = cells[i];
+            if (i < OVERLAY_BUILD_SLOTS)
             {
-
-                int sx = padding + i * (slotSize + gap) + (i >= OVERLAY_BUILD_SLOTS ? separatorW : 0);
-                int sy = padding;
-
-
-                if (i == OVERLAY_BUILD_SLOTS)
-                {
-                    int sepX = padding + OVERLAY_BUILD_SLOTS * (slotSize + gap) - gap / 2 + separatorW / 2;
-                    gfx.DrawLine(&separatorPen, sepX, sy + 2, sepX, sy + slotSize - 2);
-                }
-
-
-                Gdiplus::Rect slotRect(sx, sy, slotSize, slotSize);
-                if (i < OVERLAY_BUILD_SLOTS && localSlots[i].used)
-                {
-                    gfx.FillRectangle(&usedBrush, slotRect);
-                    gfx.DrawRectangle(&usedBorder, slotRect);
-                }
-                else
-                {
-                    gfx.FillRectangle(&emptyBrush, slotRect);
-                    gfx.DrawRectangle(&slotBorder, slotRect);
-                }
-
-
-                if (i < OVERLAY_BUILD_SLOTS)
+                const OverlaySlot& slot = (*st.slots)[i];
+                c.used = slot.used;
+                if (c.used)
                 {
-                    if (localSlots[i].used && localSlots[i].icon)
-                    {
-                        int iconPad = static_cast<int>(3 * scale);
-                        gfx.DrawImage(localSlots[i].icon.get(), Gdiplus::Rect(sx + iconPad, sy + iconPad, slotSize - iconPad * 2, slotSize - iconPad * 2));
-                    }
-                    else if (localSlots[i].used && !localSlots[i].displayName.empty())
-                    {
-                        wchar_t letter[2] = {localSlots[i].displayName[0], 0};
-                        Gdiplus::RectF letterRect((float)sx, (float)sy, (float)slotSize, (float)slotSize);
-                        gfx.DrawString(letter, 1, &letterFont, letterRect, &centerFmt, &letterBrush);
-                    }
+                    c.icon = st.icons->find(slot.textureName).get();
+                    if (!c.icon && !slot.displayName.empty()) c.text.assign(1, slot.displayName[0]);
                 }
+            }
+            if (i <= 7) c.label = keyName(s_bindings[i].key);
+            else if (i == 8)
+            {
+                c.text = Loc::get("ovr.target");
+                c.label = keyName(s_bindings[BIND_TARGET].key);
+            }
+            else if (i == 9)
+            {
+                c.text = std::to_wstring(st.rotationStep) + Loc::get("ovr.degree");
+                c.text2 = L"T" + std::to_wstring(st.totalRotation);
+                c.label = keyName(s_bindings[BIND_ROTATION].key);
+            }
+            else if (i == 10 && st.stabCritical >= 0)
+            {
+                c.text = L"C" + std::to_wstring(st.stabCritical);
+                c.text2 = L"M" + std::to_wstring(st.stabMarginal);
+                c.style = (st.stabCritical > 0 ? 1u : 0u) | (st.stabMarginal > 0 ? 2u : 0u);
+                c.label = keyName(s_bindings[MC_BIND_BASE + 2].key);
+            }
+            else if (i == 11)
+            {
+                c.text = Loc::get("ovr.config");
+                c.label = keyName(s_bindings[BIND_CONFIG].key);
+            }
+        }
+        return cells;
+    }
 
+    // WinEvent hooks (WINEVENT_OUTOFCONTEXT: delivered on the overlay
+    // thread while it pumps messages). The lifecycle hook sees windows of
+    // this process appear and go away; the move hook follows the game
+    // window's position and size.
+    static HWINEVENTHOOK s_lifecycleHook{nullptr};
+    static HWINEVENTHOOK s_moveHook{nullptr};
+    static void renderOverlay(HWND hwnd);
 
-                if (i == 8)
-                {
-                    float bcx = (float)(sx + slotSize / 2);
-                    float bcy = (float)(sy + slotSize / 2);
-
-                    float r5 = slotSize * 0.42f;
-                    float r4 = slotSize * 0.35f;
-                    float r3 = slotSize * 0.28f;
-                    float r2 = slotSize * 0.20f;
-                    float r1 = slotSize * 0.12f;
-                    Gdiplus::SolidBrush bWhite(Gdiplus::Color(160, 240, 240, 235));
-                    Gdiplus::SolidBrush bBlack(Gdiplus::Color(160, 40, 40, 40));
-                    Gdiplus::SolidBrush bBlue(Gdiplus::Color(160, 50, 120, 200));
-                    Gdiplus::SolidBrush bRed(Gdiplus::Color(160, 210, 50, 40));
-                    Gdiplus::SolidBrush bGold(Gdiplus::Color(160, 240, 200, 50));
-                    gfx.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
-                    gfx.FillEllipse(&bWhite, bcx - r5, bcy - r5, r5 * 2, r5 * 2);
-                    gfx.FillEllipse(&bBlack, bcx - r4, bcy - r4, r4 * 2, r4 * 2);
-                    gfx.FillEllipse(&bBlue, bcx - r3, bcy - r3, r3 * 2, r3 * 2);
-                    gfx.FillEllipse(&bRed, bcx - r2, bcy - r2, r2 * 2, r2 * 2);
-                    gfx.FillEllipse(&bGold, bcx - r1, bcy - r1, r1 * 2, r1 * 2);
-                    gfx.SetSmoothingMode(Gdiplus::SmoothingModeDefault);
-
-                    float tgtFontSz = slotSize * 0.28f;
-                    Gdiplus::Font tgtFont(&fontFamily, tgtFontSz, Gdiplus::FontStyleBold, Gdiplus::UnitPixel);
-                    Gdiplus::SolidBrush tgtBrush(Gdiplus::Color(240, 10, 15, 70));
-                    Gdiplus::RectF tgtRect((float)sx, (float)sy, (float)slotSize, (float)slotSize);
-                    gfx.DrawString(Loc::get("ovr.target").c_str(), -1, &tgtFont, tgtRect, &centerFmt, &tgtBrush);
-                }
-
+    static void CALLBACK overlayWinEvent(HWINEVENTHOOK, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD, DWORD)
+    {
+        if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF || !s_overlay.overlayHwnd) return;
+        bool tracked = s_overlay.gameHwnd && IsWindow(s_overlay.gameHwnd);
+        switch (event)
+        {
+        case EVENT_OBJECT_LOCATIONCHANGE:
+        case EVENT_OBJECT_DESTROY:
+            if (hwnd != s_overlay.gameHwnd) return;
+            break;
+        case EVENT_OBJECT_SHOW:
+            if (tracked) return;
+            break;
+        default:
+            return;
+        }
+        renderOverlay(s_overlay.overlayHwnd);
+    }
 
-                if (i == 9)
-                {
-                    int stepVal = s_overlay.rotationStep;
-                    int totalVal = s_overlay.totalRotation;
-
-
-                    std::wstring stepStr = std::to_wstring(stepVal) + Loc::get("ovr.degree");
-                    float stepFontSz = slotSize * 0.28f;
-                    Gdiplus::Font stepFont(&fontFamily, stepFontSz, Gdiplus::FontStyleBold, Gdiplus::UnitPixel);
-                    Gdiplus::SolidBrush stepBrush(Gdiplus::Color(220, 180, 210, 255));
-                    Gdiplus::StringFormat topFmt;
-                    topFmt.SetAlignment(Gdiplus::StringAlignmentCenter);
-                    topFmt.SetLineAlignment(Gdiplus::StringAlignmentCenter);
-                    Gdiplus::RectF topRect((float)sx, (float)sy + slotSize * 0.02f, (float)slotSize, (float)slotSize * 0.45f);
-                    gfx.DrawString(stepStr.c_str(), -1, &stepFont, topRect, &topFmt, &stepBrush);
-
-
-                    float lineY = (float)sy + slotSize * 0.48f;
-                    float lineMargin = slotSize * 0.15f;
-                    Gdiplus::Pen linePen(Gdiplus::Color(120, 180, 180, 200), 1.0f);
-                    gfx.DrawLine(&linePen, (float)sx + lineMargin, lineY, (float)sx + slotSize - lineMargin, lineY);
-
-
-                    std::wstring totalStr = L"T" + std::to_wstring(totalVal);
-                    float totalFontSz = slotSize * 0.28f;
-                    Gdiplus::Font totalFont(&fontFamily, totalFontSz, Gdiplus::FontStyleBold, Gdiplus::UnitPixel);
-                    Gdiplus::SolidBrush totalBrush(Gdiplus::Color(255, 200, 230, 255));
-                    Gdiplus::StringFormat botFmt;
-                    botFmt.SetAlignment(Gdiplus::StringAlignmentCenter);
-                    botFmt.SetLineAlignment(Gdiplus::StringAlignmentCenter);
-                    Gdiplus::RectF botRect((float)sx, (float)sy + slotSize * 0.50f, (float)slotSize, (float)slotSize * 0.48f);
-                    gfx.DrawString(totalStr.c_str(), -1, &totalFont, botRect, &botFmt, &totalBrush);
-                }
+    static void trackGameWindow(HWND game)
+    {
+        if (s_moveHook) UnhookWinEvent(s_moveHook);
+        s_moveHook = nullptr;
+        s_overlay.gameHwnd = game;
+        if (!game) return;
+        DWORD pid = 0;
+        DWORD tid = GetWindowThreadProcessId(game, &pid);
+        s_moveHook = SetWinEventHook(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE, nullptr, overlayWinEvent, pid, tid,
+                                     WINEVENT_OUTOFCONTEXT);
+    }
 
+    static void renderOverlay(HWND hwnd)
+    {
+        if (!s_overlay.gameHwnd || !IsWindow(s_overlay.gameHwnd))
+        {
+            trackGameWindow(findGameWindow());
+            if (!s_overlay.gameHwnd)
+            {
+                if (IsWindowVisible(hwnd)) ShowWindow(hwnd, SW_HIDE);
+                return;
+            }
+        }
 
-                if (i == 11)
-                {
-                    float gcx = (float)(sx + slotSize / 2);
-                    float gcy = (float)(sy + slotSize / 2);
-                    constexpr int nTeeth = 8;
-                    constexpr float kPI = 3.14159265f;
-                    float tipR = slotSize * 0.40f;
-                    float rootR = slotSize * 0.28f;
-                    float holeR = slotSize * 0.10f;
-
-
-                    float segAngle = 2.0f * kPI / nTeeth;
-                    float halfTip = segAngle * 0.22f;
-                    float halfRoot = segAngle * 0.28f;
-
-                    std::vector<Gdiplus::PointF> gearPts;
-                    for (int t = 0; t < nTeeth; t++)
-                    {
-                        float ctrAngle = t * segAngle - kPI / 2.0f;
-                        float gapCtr = ctrAngle + segAngle * 0.5f;
-
-                        gearPts.push_back({gcx + tipR * cosf(ctrAngle - halfTip), gcy + tipR * sinf(ctrAngle - halfTip)});
-                        gearPts.push_back({gcx + tipR * cosf(ctrAngle + halfTip), gcy + tipR * sinf(ctrAngle + halfTip)});
-
-                        gearPts.push_back({gcx + rootR * cosf(gapCtr - halfRoot), gcy + rootR * sinf(gapCtr - halfRoot)});
-                        gearPts.push_back({gcx + rootR * cosf(gapCtr + halfRoot), gcy + rootR * sinf(gapCtr + halfRoot)});
-                    }
-
-                    Gdiplus::GraphicsPath gearPath;
-                    gearPath.AddPolygon(gearPts.data(), (int)gearPts.size());
-
-                    Gdiplus::SolidBrush gearBrush(Gdiplus::Color(150, 150, 165, 185));
-                    Gdiplus::Pen gearOutline(Gdiplus::Color(140, 100, 115, 140), 1.2f * (slotSize / 48.0f));
-                    gfx.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
-                    gfx.FillPath(&gearBrush, &gearPath);
-                    gfx.DrawPath(&gearOutline, &gearPath);
-
-                    Gdiplus::SolidBrush holeBrush(Gdiplus::Color(150, 25, 30, 45));
-                    gfx.FillEllipse(&holeBrush, gcx - holeR, gcy - holeR, holeR * 2, holeR * 2);
-                    Gdiplus::Pen holeRing(Gdiplus::Color(140, 100, 115, 140), 1.2f * (slotSize / 48.0f));
-                    gfx.DrawEllipse(&holeRing, gcx - holeR, gcy - holeR, holeR * 2, holeR * 2);
-                    gfx.SetSmoothingMode(Gdiplus::SmoothingModeDefault);
-
-                    float cfgFontSz = slotSize * 0.28f;
-                    Gdiplus::Font cfgFont(&fontFamily, cfgFontSz, Gdiplus::FontStyleBold, Gdiplus::UnitPixel);
-                    Gdiplus::SolidBrush cfgBrush(Gdiplus::Color(240, 10, 15, 70));
-                    Gdiplus::RectF cfgRect((float)sx, (float)sy, (float)slotSize, (float)slotSize);
-                    gfx.DrawString(Loc::get("ovr.config").c_str(), -1, &cfgFont, cfgRect, &centerFmt, &cfgBrush);
-                }
+        RECT clientRect;
+        GetClientRect(s_overlay.gameHwnd, &clientRect);
+        POINT origin = {0, 0};
+        ClientToScreen(s_overlay.gameHwnd, &origin);
+        int gameW = clientRect.right;
+        int gameH = clientRect.bottom;
+        if (gameW < 100 || gameH < 100) return;
 
+        OverlayLayout layout = OverlayLayout::forClient(gameH, OVERLAY_SLOTS, OVERLAY_BUILD_SLOTS);
+        int overlayX = origin.x + (gameW - layout.width) / 2;
+        int overlayY = origin.y + static_cast<int>(4 * layout.scale);
 
-                std::wstring fLabel;
-                if (i <= 7)
-                {
-                    fLabel = keyName(s_bindings[i].key);
-                }
-                else if (i == 8)
-                {
-                    fLabel = keyName(s_bindings[BIND_TARGET].key);
-                }
-                else if (i == 9)
-                {
-                    fLabel = keyName(s_bindings[BIND_ROTATION].key);
-                }
-                else if (i == 11)
-                {
-                    fLabel = keyName(s_bindings[BIND_CONFIG].key);
-                }
-                Gdiplus::RectF labelRect((float)sx, (float)(sy + slotSize + 1), (float)slotSize, (float)labelH);
-                gfx.DrawString(fLabel.c_str(), -1, &labelFont, labelRect, &centerFmt, &labelBrush);
-            }
+        if (!s_overlay.visible)
+        {
+            if (IsWindowVisible(hwnd)) ShowWindow(hwnd, SW_HIDE);
+            return;
         }
+        if (!IsWindowVisible(hwnd)) ShowWindow(hwnd, SW_SHOWNOACTIVATE);
 
+        OverlayTickState st;
+        // Lock-free: adopt the newest slots the game thread published (no copy).
+        s_overlay.published.refresh();
+        st.slots = &s_overlay.published.front();
+        st.icons = s_iconCache.snapshot();
+        st.rotationStep = s_overlay.rotationStep;
+        st.totalRotation = s_overlay.totalRotation;
+        st.stabMarginal = s_overlay.stabMarginal;
+        st.stabCritical = s_overlay.stabCritical;
+
+        // Idle tick: same cells, same layout, same position -> nothing drawn or presented.
+        auto cells = collectOverlayCells(st);
+        auto plan = s_frame.plan(layout, overlayX, overlayY, cells);
+        if (!plan.present) return;
+
+        bool rebuild = plan.rebuild || !s_surface.pixels;
+        if (rebuild && !rebuildOverlaySurface(layout)) return;
+        paintOverlay(*s_surface.pixels, layout, cells, rebuild ? s_frame.kAll : plan.dirty, rebuild, *s_surface.fonts,
+                     [&](int i) { return static_cast<const ArgbImage*>(cells[i].icon); });
+        GdiFlush();
+
+        HDC screenDC = GetDC(nullptr);
         POINT ptSrc = {0, 0};
-        SIZE sz = {overlayW, overlayH};
+        SIZE sz = {layout.width, layout.height};
         POINT ptDst = {overlayX, overlayY};
         BLENDFUNCTION blend{};
         blend.BlendOp = AC_SRC_OVER;
         blend.SourceConstantAlpha = 255;
         blend.AlphaFormat = AC_SRC_ALPHA;
-        UpdateLayeredWindow(hwnd, screenDC, &ptDst, &sz, memDC, &ptSrc, 0, &blend, ULW_ALPHA);
-
-        SelectObject(memDC, oldBmp);
-        DeleteObject(bmp);
-        DeleteDC(memDC);
+        UpdateLayeredWindow(hwnd, screenDC, &ptDst, &sz, s_surface.memDC, &ptSrc, 0, &blend, ULW_ALPHA);
         ReleaseDC(nullptr, screenDC);
     }
 
@@ -319,52 +285,25 @@ namespace MoriaMods
         {
         case WM_NCHITTEST:
             return HTTRANSPARENT;
-        case WM_TIMER:
-            renderOverlay(hwnd);
-            return 0;
         case WM_DESTROY:
-            KillTimer(hwnd, 1);
             PostQuitMessage(0);
             return 0;
         }
         return DefWindowProcW(hwnd, msg, wp, lp);
     }
 
+    // GDI+ is started and shut down by startOverlay/stopOverlay, never here:
+    // the icon worker decodes with it too.
     DWORD WINAPI overlayThreadProc(LPVOID )
     {
 
-        if (!s_overlay.gdipToken)
-        {
-            Gdiplus::GdiplusStartupInput gdipInput;
-            Gdiplus::GdiplusStartup(&s_overlay.gdipToken, &gdipInput, nullptr);
-        }
-
         WNDCLASSEXW wc{};
         wc.cbSize = sizeof(wc);
         wc.lpfnWndProc = overlayWndProc;
         wc.hInstance = GetModuleHandle(nullptr);
         wc.lpszClassName = L"MoriaCppModOverlay";
         UnregisterClassW(L"MoriaCppModOverlay", GetModuleHandle(nullptr));
-        if (!RegisterClassExW(&wc))
-        {
-            Gdiplus::GdiplusShutdown(s_overlay.gdipToken);
-            s_overlay.gdipToken = 0;
-            return 1;
-        }
-
-        for (int i = 0; i < 60 && s_overlay.running; i++)
-        {
-            s_overlay.gameHwnd = findGameWindow();
-            if (s_overlay.gameHwnd) break;
-            Sleep(500);
-        }
-        if (!s_overlay.running || !s_overlay.gameHwnd)
-        {
-            Gdiplus::GdiplusShutdown(s_overlay.gdipToken);
-            s_overlay.gdipToken = 0;
-            UnregisterClassW(L"MoriaCppModOverlay", GetModuleHandle(nullptr));
-            return 0;
-        }
+        if (!RegisterClassExW(&wc)) return 1;
 
         HWND hwnd = CreateWindowExW(WS_EX_LAYERED | WS_EX_TOPMOST | WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE,
                                     L"MoriaCppModOverlay",
@@ -380,31 +319,45 @@ namespace MoriaMods
                                     nullptr);
         if (!hwnd)
         {
-            Gdiplus::GdiplusShutdown(s_overlay.gdipToken);
-            s_overlay.gdipToken = 0;
             UnregisterClassW(L"MoriaCppModOverlay", GetModuleHandle(nullptr));
             return 1;
         }
 
         s_overlay.overlayHwnd = hwnd;
-        ShowWindow(hwnd, SW_SHOWNOACTIVATE);
+        s_lifecycleHook = SetWinEventHook(EVENT_OBJECT_DESTROY, EVENT_OBJECT_SHOW, nullptr, overlayWinEvent, GetCurrentProcessId(), 0,
+                                          WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNTHREAD);
         renderOverlay(hwnd);
 
-        SetTimer(hwnd, 1, 200, nullptr);
-
-        MSG msg;
-        while (GetMessage(&msg, nullptr, 0, 0))
+        // Sleep until a game-thread change signals wakeEvent or a message /
+        // WinEvent arrives; nothing wakes the thread while the overlay is idle.
+        HANDLE wake = s_overlay.wakeEvent;
+        DWORD waitCount = wake ? 1 : 0;
+        bool quit = false;
+        while (!quit && s_overlay.running)
         {
+            DWORD r = MsgWaitForMultipleObjectsEx(waitCount, &wake, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
             if (!s_overlay.running) break;
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
+            if (waitCount && r == WAIT_OBJECT_0) renderOverlay(hwnd);
+            // Pump after every wake so a busy wakeEvent cannot starve messages.
+            MSG msg;
+            while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
+            {
+                if (msg.message == WM_QUIT)
+                {
+                    quit = true;
+                    break;
+                }
+                TranslateMessage(&msg);
+                DispatchMessageW(&msg);
+            }
         }
 
-        KillTimer(hwnd, 1);
+        if (s_lifecycleHook) UnhookWinEvent(s_lifecycleHook);
+        s_lifecycleHook = nullptr;
+        trackGameWindow(nullptr);
         DestroyWindow(hwnd);
         s_overlay.overlayHwnd = nullptr;
-        Gdiplus::GdiplusShutdown(s_overlay.gdipToken);
-        s_overlay.gdipToken = 0;
+        releaseOverlaySurface();
         UnregisterClassW(L"MoriaCppModOverlay", GetModuleHandle(nullptr));
         return 0;
     }
@@ -0,0 +1,179 @@
+
+
+
+#pragma once
+#ifndef MORIA_OVERLAY_FRAME_H
+#define MORIA_OVERLAY_FRAME_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Change tracking for the retained-mode Win32 overlay. Each timer tick the
+// renderer describes every slot as a small value (OverlayCellKey: what would
+// be drawn there) plus the window layout and screen position. plan()
+// compares that with the last presented frame and answers:
+//   rebuild - layout changed (first frame, game resize / DPI): recreate the
+//             surface + GDI+ resources and redraw everything
+//   dirty   - bitmask of slots whose content changed: redraw only those
+//   present - anything to push via UpdateLayeredWindow (dirty slots or a
+//             moved window); false on an idle tick, which then costs no GDI
+//
+// Pure (no Win32/GDI+): tested in tests/test_overlay_frame.cpp.
+
+namespace MoriaMods
+{
+
+    // Overlay geometry for a game client height; integer pixels, derived
+    // the same way renderOverlay() always has (48 px slots at 1080p).
+    struct OverlayLayout
+    {
+        int slots{0};
+        int buildSlots{0};
+        float scale{1.0f};
+        int slotSize{0};
+        int gap{0};
+        int padding{0};
+        int labelH{0};
+        int separatorW{0};
+        int radius{0};
+        int width{0};
+        int height{0};
+
+        static OverlayLayout forClient(int clientH, int slots, int buildSlots)
+        {
+            OverlayLayout l;
+            l.slots = slots;
+            l.buildSlots = buildSlots;
+            l.scale = clientH / 1080.0f;
+            if (l.scale < 0.5f) l.scale = 0.5f;
+            l.slotSize = static_cast<int>(48 * l.scale);
+            l.gap = static_cast<int>(4 * l.scale);
+            l.padding = static_cast<int>(6 * l.scale);
+            l.labelH = static_cast<int>(14 * l.scale);
+            l.separatorW = static_cast<int>(8 * l.scale);
+            l.radius = static_cast<int>(6 * l.scale);
+            l.width = l.padding * 2 + slots * l.slotSize + (slots - 1) * l.gap + l.separatorW;
+            l.height = l.padding * 2 + l.slotSize + l.labelH;
+            return l;
+        }
+
+        int slotX(int i) const { return padding + i * (slotSize + gap) + (i >= buildSlots ? separatorW : 0); }
+        int slotY() const { return padding; }
+        int separatorX() const { return padding + buildSlots * (slotSize + gap) - gap / 2 + separatorW / 2; }
+
+        // Area a slot owns (box + 2 px border overhang + key label). With a
+        // gap of 4+ px cells never overlap each other or the separator, so a
+        // dirty slot is cleared and redrawn on its own; below that (scale
+        // < 1) neighbouring borders touch and the tracker redraws all slots.
+        struct Rect { int x, y, w, h; };
+        static constexpr int kBorderOverhang = 2;
+        bool cellsIsolated() const { return gap >= kBorderOverhang * 2; }
+        Rect cell(int i) const
+        {
+            int over = kBorderOverhang;
+            return {slotX(i) - over, slotY() - over, slotSize + over * 2, slotSize + labelH + over * 2};
+        }
+
+        bool operator==(const OverlayLayout& o) const
+        {
+            return slots == o.slots && buildSlots == o.buildSlots && slotSize == o.slotSize && gap == o.gap &&
+                   padding == o.padding && labelH == o.labelH && separatorW == o.separatorW && width == o.width &&
+                   height == o.height;
+        }
+        bool operator!=(const OverlayLayout& o) const { return !(*this == o); }
+    };
+
+    // Everything that decides how one slot looks. Two equal keys draw the
+    // same pixels, so an unchanged key means the slot is left alone.
+    struct OverlayCellKey
+    {
+        bool used{false};
+        const void* icon{nullptr};   // decoded icon identity (null = none)
+        std::wstring text;           // fallback letter / caption / first line
+        std::wstring text2;          // second line (rotation total, marginal count)
+        std::wstring label;          // key name under the slot
+        uint32_t style{0};           // per-slot colour state (e.g. non-zero counts)
+
+        bool operator==(const OverlayCellKey& o) const
+        {
+            return used == o.used && icon == o.icon && style == o.style && text == o.text && text2 == o.text2 &&
+                   label == o.label;
+        }
+        bool operator!=(const OverlayCellKey& o) const { return !(*this == o); }
+    };
+
+    template <size_t N>
+    class OverlayFrameTracker
+    {
+        static_assert(N <= 32, "dirty mask is 32 bits");
+
+      public:
+        using Cells = std::array<OverlayCellKey, N>;
+
+        struct Plan
+        {
+            bool rebuild{false};
+            bool present{false};
+            uint32_t dirty{0};
+        };
+
+        static constexpr uint32_t kAll = N == 32 ? 0xFFFFFFFFu : ((1u << N) - 1);
+
+        Plan plan(const OverlayLayout& layout, int x, int y, const Cells& cells)
+        {
+            Plan p;
+            m_frames++;
+            if (!m_valid || layout != m_layout)
+            {
+                p.rebuild = true;
+                p.dirty = kAll;
+            }
+            else
+            {
+                for (size_t i = 0; i < N; i++)
+                    if (cells[i] != m_cells[i]) p.dirty |= 1u << i;
+                if (p.dirty && !layout.cellsIsolated()) p.dirty = kAll;
+            }
+            bool moved = !m_valid || x != m_x || y != m_y;
+            p.present = p.dirty != 0 || moved;
+
+            m_layout = layout;
+            m_x = x;
+            m_y = y;
+            for (size_t i = 0; i < N; i++)
+                if (p.dirty & (1u << i)) m_cells[i] = cells[i];
+            m_valid = true;
+
+            if (p.rebuild) m_rebuilds++;
+            if (p.present) m_presents++;
+            for (size_t i = 0; i < N; i++)
+                if (p.dirty & (1u << i)) m_cellsDrawn++;
+            return p;
+        }
+
+        // Next plan() rebuilds and presents everything (surface lost,
+        // window re-shown after being hidden).
+        void invalidate() { m_valid = false; }
+
+        uint64_t frames() const { return m_frames; }
+        uint64_t presents() const { return m_presents; }
+        uint64_t rebuilds() const { return m_rebuilds; }
+        uint64_t cellsDrawn() const { return m_cellsDrawn; }
+
+      private:
+        OverlayLayout m_layout;
+        Cells m_cells{};
+        int m_x{0};
+        int m_y{0};
+        bool m_valid{false};
+        uint64_t m_frames{0};
+        uint64_t m_presents{0};
+        uint64_t m_rebuilds{0};
+        uint64_t m_cellsDrawn{0};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_OVERLAY_FRAME_H
@@ -1,46 +1,65 @@
 
 
 
+        // Icon worker decoder. Icons from the batched extractor are one
+        // read from s_iconStore, already premultiplied. Older installs still
+        // have per-icon PNGs: those are decoded with GDI+ (the copy forces
+        // the full decode here and releases the file), and then imported into
+        // the store so the next launch reads them from the pack too.
+        static std::shared_ptr<ArgbImage> decodeOverlayIcon(const std::wstring& textureName)
+        {
+            if (s_overlay.iconFolder.empty()) return nullptr;
+            {
+                auto img = std::make_shared<ArgbImage>();
+                if (s_iconStore.read(textureName, img->width, img->height, img->pixels)) return img;
+            }
+            std::wstring pngPath = s_overlay.iconFolder + L"\\" + textureName + L".png";
+            Gdiplus::Bitmap src(pngPath.c_str());
+            if (src.GetLastStatus() != Gdiplus::Ok) return nullptr;
+            INT w = static_cast<INT>(src.GetWidth()), h = static_cast<INT>(src.GetHeight());
+            if (w <= 0 || h <= 0) return nullptr;
+            auto img = std::make_shared<ArgbImage>(ArgbImage{w, h, std::vector<uint32_t>(size_t(w) * h)});
+            Gdiplus::BitmapData data{};
+            data.Width = w;
+            data.Height = h;
+            data.Stride = w * 4;
+            data.PixelFormat = PixelFormat32bppPARGB;
+            data.Scan0 = img->pixels.data();
+            Gdiplus::Rect rect(0, 0, w, h);
+            if (src.LockBits(&rect, Gdiplus::ImageLockModeRead | Gdiplus::ImageLockModeUserInputBuf, PixelFormat32bppPARGB, &data) !=
+                Gdiplus::Ok)
+                return nullptr;
+            src.UnlockBits(&data);
+            if (s_iconStore.put(textureName, w, h, img->pixels.data())) s_iconStore.saveManifest();
+            return img;
+        }
+
         void updateOverlaySlots()
         {
-            if (!s_overlay.csInit) return;
-            CriticalSectionLock slotLock(s_overlay.slotCS);
             for (int i = 0; i < OVERLAY_BUILD_SLOTS && i < QUICK_BUILD_SLOTS; i++)
             {
                 s_overlay.slots[i].used = m_recipeSlots[i].used;
                 s_overlay.slots[i].displayName = m_recipeSlots[i].displayName;
 
+                // Hold one cache reference per slot; decoding happens on the
+                // icon worker, the overlay picks the image up once published.
                 if (s_overlay.slots[i].textureName != m_recipeSlots[i].textureName)
                 {
-                    s_overlay.slots[i].icon.reset();
+                    s_iconCache.release(s_overlay.slots[i].textureName);
+                    s_iconCache.acquire(m_recipeSlots[i].textureName);
                 }
                 s_overlay.slots[i].textureName = m_recipeSlots[i].textureName;
-
-                if (s_overlay.slots[i].used && !s_overlay.slots[i].textureName.empty() && !s_overlay.slots[i].icon && !s_overlay.iconFolder.empty())
-                {
-                    std::wstring pngPath = s_overlay.iconFolder + L"\\" + s_overlay.slots[i].textureName + L".png";
-                    Gdiplus::Image* img = Gdiplus::Image::FromFile(pngPath.c_str());
-                    if (img && img->GetLastStatus() == Gdiplus::Ok)
-                    {
-                        s_overlay.slots[i].icon.reset(img);
-                    }
-                    else
-                    {
-                        delete img;
-                    }
-                }
             }
-            s_overlay.needsUpdate = true;
+            s_overlay.published.publish(s_overlay.slots);
+            s_overlay.requestUpdate();
         }
 
         void startOverlay()
         {
             if (s_overlay.thread) return;
-            if (!s_overlay.csInit)
-            {
-                InitializeCriticalSection(&s_overlay.slotCS);
-                s_overlay.csInit = true;
-            }
+            // Kept for the process lifetime: game-thread writers may still
+            // signal it after the overlay has stopped.
+            if (!s_overlay.wakeEvent) s_overlay.wakeEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
 
             wchar_t dllPath[MAX_PATH]{};
             GetModuleFileNameW(nullptr, dllPath, MAX_PATH);
@@ -48,6 +67,8 @@
             auto pos = gamePath.rfind(L'\\');
             if (pos != std::wstring::npos) gamePath = gamePath.substr(0, pos);
             s_overlay.iconFolder = gamePath + L"\\Mods\\MoriaCppMod\\icons";
+            if (!s_iconStore.isOpen() && !s_iconStore.open(s_overlay.iconFolder))
+                VLOG(STR("[MoriaCppMod] [Icon] could not open the icon store in {}\n"), s_overlay.iconFolder);
 
 
             if (!s_overlay.gdipToken)
@@ -56,39 +77,63 @@
                 Gdiplus::GdiplusStartup(&s_overlay.gdipToken, &gdipInput, nullptr);
             }
 
+            s_iconCache.setOnPublish([] { s_overlay.requestUpdate(); });
+            s_iconCache.startWorker(decodeOverlayIcon);
+
             s_overlay.running = true;
             s_overlay.visible = m_showHotbar;
             updateOverlaySlots();
             s_overlay.thread = CreateThread(nullptr, 0, overlayThreadProc, nullptr, 0, nullptr);
+            if (!s_overlay.thread)
+            {
+                s_overlay.running = false;
+                s_iconCache.stopWorker();
+                s_iconCache.clear();
+                shutdownOverlayGdiplus();
+                VLOG(STR("[MoriaCppMod] Overlay thread failed to start\n"));
+                return;
+            }
             VLOG(STR("[MoriaCppMod] Overlay thread started, icons: {}\n"), s_overlay.iconFolder);
         }
 
+        // Only caller of GdiplusShutdown; both the icon worker and the
+        // overlay thread must be finished with GDI+ by now.
+        static void shutdownOverlayGdiplus()
+        {
+            if (!s_overlay.gdipToken) return;
+            Gdiplus::GdiplusShutdown(s_overlay.gdipToken);
+            s_overlay.gdipToken = 0;
+        }
+
 
+        // Also the explicit teardown of s_iconCache's worker at unload
+        // (~MoriaCppMod), so no thread is joined from a global destructor.
         void stopOverlay()
         {
+            // The worker decodes with GDI+: stop it first.
+            s_iconCache.stopWorker();
+
+            bool threadDone = true;
             s_overlay.running = false;
+            s_overlay.requestUpdate();   // a thread still starting up sees running == false
             if (s_overlay.overlayHwnd) PostMessage(s_overlay.overlayHwnd, WM_CLOSE, 0, 0);
             if (s_overlay.thread)
             {
-                WaitForSingleObject(s_overlay.thread, 3000);
+                threadDone = WaitForSingleObject(s_overlay.thread, 3000) == WAIT_OBJECT_0;
                 CloseHandle(s_overlay.thread);
                 s_overlay.thread = nullptr;
             }
 
-            for (int i = 0; i < OVERLAY_SLOTS; i++)
-            {
-                s_overlay.slots[i].icon.reset();
-            }
-            if (s_overlay.gdipToken)
-            {
-                Gdiplus::GdiplusShutdown(s_overlay.gdipToken);
-                s_overlay.gdipToken = 0;
-            }
-            if (s_overlay.csInit)
-            {
-                DeleteCriticalSection(&s_overlay.slotCS);
-                s_overlay.csInit = false;
-            }
+            s_iconCache.clear();
+            s_iconStore.saveManifest();   // legacy PNGs the worker imported
+            for (auto& slot : s_overlay.slots) slot.textureName.clear();
+            s_overlay.published.publish(s_overlay.slots);
+            // A thread that didn't exit may still hold GDI+ fonts; leaving
+            // GDI+ up (the next startOverlay reuses the token) beats a crash.
+            if (threadDone)
+                shutdownOverlayGdiplus();
+            else
+                VLOG(STR("[MoriaCppMod] Overlay thread did not exit in 3 s; GDI+ left running\n"));
         }
 
 
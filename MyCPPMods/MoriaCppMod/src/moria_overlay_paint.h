@@ -0,0 +1,199 @@
+
+
+
+#pragma once
+#ifndef MORIA_OVERLAY_PAINT_H
+#define MORIA_OVERLAY_PAINT_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "moria_compositor.h"
+#include "moria_overlay_frame.h"
+
+// Overlay painter on the software compositor: the rounded background and
+// separator (chrome, redrawn on layout change) and one slot cell at a time
+// (redrawn when its OverlayCellKey changes). Geometry comes from
+// OverlayLayout, colours match the original GDI+ renderer. Text goes
+// through three glyph atlases (key label, fallback letter, bold captions)
+// built from a FontFactory - GDI+ Consolas in game, the built-in bitmap
+// font off Windows - so the same frame renders headless for golden tests
+// and the benchmark.
+//
+// Pure (no Win32/GDI+): tested in tests/test_overlay_paint.cpp.
+
+namespace MoriaMods
+{
+
+    enum class OverlayCellKind : uint8_t { Build, Target, Rotation, Stability, Config };
+
+    inline OverlayCellKind overlayCellKind(const OverlayLayout& l, int i)
+    {
+        if (i < l.buildSlots) return OverlayCellKind::Build;
+        switch (i - l.buildSlots)
+        {
+        case 0: return OverlayCellKind::Target;
+        case 1: return OverlayCellKind::Rotation;
+        case 2: return OverlayCellKind::Stability;
+        default: return OverlayCellKind::Config;
+        }
+    }
+
+    // (pixel size, bold) -> glyph rasterizer + its line height.
+    using OverlayFontFactory = std::function<std::pair<GlyphAtlas::Rasterizer, int>(float px, bool bold)>;
+
+    inline OverlayFontFactory builtinOverlayFonts()
+    {
+        return [](float px, bool bold) {
+            int lh = std::max(9, int(px));
+            return std::make_pair(builtinGlyphs(lh, bold), 9 * std::max(1, lh / 9));
+        };
+    }
+
+    struct OverlayFonts
+    {
+        GlyphAtlas label;     // key names under the slots
+        GlyphAtlas letter;    // fallback initial of an icon-less recipe
+        GlyphAtlas caption;   // bold 0.28 x slot: captions, counters
+
+        static OverlayFonts make(const OverlayLayout& l, const OverlayFontFactory& factory)
+        {
+            float labelPx = std::max(9.0f, 10.0f * l.scale);
+            auto a = factory(labelPx, false);
+            auto b = factory(l.slotSize * 0.45f, true);
+            auto c = factory(l.slotSize * 0.28f, true);
+            return {GlyphAtlas(a.first, a.second), GlyphAtlas(b.first, b.second), GlyphAtlas(c.first, c.second)};
+        }
+    };
+
+    namespace OverlayPalette
+    {
+        inline const uint32_t Background = premul(100, 5, 8, 18);
+        inline const uint32_t Separator = premul(180, 200, 210, 230);
+        inline const uint32_t EmptyFill = premul(51, 235, 235, 230);
+        inline const uint32_t UsedFill = premul(51, 245, 245, 240);
+        inline const uint32_t EmptyBorder = premul(180, 100, 160, 230);
+        inline const uint32_t UsedBorder = premul(220, 120, 180, 255);
+        inline const uint32_t Label = premul(200, 140, 170, 210);
+        inline const uint32_t Letter = premul(140, 100, 140, 200);
+        inline const uint32_t Caption = premul(240, 10, 15, 70);
+        inline const uint32_t Idle = premul(160, 150, 165, 185);
+    }
+
+    inline void paintOverlayChrome(Surface& s, const OverlayLayout& l)
+    {
+        s.clear(0);
+        s.fillRoundRect(0, 0, float(l.width), float(l.height), float(l.radius), OverlayPalette::Background);
+        float sepX = l.separatorX() + 0.5f;
+        s.drawLine({sepX, float(l.slotY() + 2)}, {sepX, float(l.slotY() + l.slotSize - 2)}, 1.0f, OverlayPalette::Separator);
+    }
+
+    inline void paintOverlayCell(Surface& s, const OverlayLayout& l, int i, const OverlayCellKey& key, const ArgbImage* icon,
+                                 OverlayFonts& fonts)
+    {
+        const int slot = l.slotSize;
+        const int sx = l.slotX(i);
+        const int sy = l.slotY();
+        const float fsx = float(sx), fsy = float(sy), fslot = float(slot);
+        auto kind = overlayCellKind(l, i);
+
+        // Cells sit inside the uniform part of the background.
+        auto cell = l.cell(i);
+        s.fillRect(cell.x, cell.y, cell.w, cell.h, OverlayPalette::Background, Blend::Copy);
+
+        bool used = kind == OverlayCellKind::Build && key.used;
+        s.fillRect(sx, sy, slot, slot, used ? OverlayPalette::UsedFill : OverlayPalette::EmptyFill);
+        s.strokeRect(sx, sy, slot, slot, 3, used ? OverlayPalette::UsedBorder : OverlayPalette::EmptyBorder);
+
+        switch (kind)
+        {
+        case OverlayCellKind::Build:
+            if (icon)
+            {
+                int pad = int(3 * l.scale);
+                s.blitImage(*icon, sx + pad, sy + pad, slot - pad * 2, slot - pad * 2);
+            }
+            else if (!key.text.empty())
+            {
+                fonts.letter.drawText(s, std::wstring_view(key.text).substr(0, 1), fsx, fsy, fslot, fslot, OverlayPalette::Letter);
+            }
+            break;
+
+        case OverlayCellKind::Target:
+        {
+            float cx = float(sx + slot / 2), cy = float(sy + slot / 2);
+            const float radii[] = {0.42f, 0.35f, 0.28f, 0.20f, 0.12f};
+            const uint32_t rings[] = {premul(160, 240, 240, 235), premul(160, 40, 40, 40), premul(160, 50, 120, 200),
+                                      premul(160, 210, 50, 40), premul(160, 240, 200, 50)};
+            for (int r = 0; r < 5; r++) s.fillEllipse(cx, cy, slot * radii[r], slot * radii[r], rings[r]);
+            fonts.caption.drawText(s, key.text, fsx, fsy, fslot, fslot, OverlayPalette::Caption);
+            break;
+        }
+
+        case OverlayCellKind::Rotation:
+        {
+            fonts.caption.drawText(s, key.text, fsx, fsy + slot * 0.02f, fslot, slot * 0.45f, premul(220, 180, 210, 255));
+            float lineY = fsy + slot * 0.48f, margin = slot * 0.15f;
+            s.drawLine({fsx + margin, lineY}, {fsx + slot - margin, lineY}, 1.0f, premul(120, 180, 180, 200));
+            fonts.caption.drawText(s, key.text2, fsx, fsy + slot * 0.50f, fslot, slot * 0.48f, premul(255, 200, 230, 255));
+            break;
+        }
+
+        case OverlayCellKind::Stability:
+            // Counts only while the monitor runs; style bit 0 = critical > 0, bit 1 = marginal > 0.
+            if (!key.text.empty())
+            {
+                uint32_t crit = (key.style & 1) ? premul(240, 230, 60, 50) : OverlayPalette::Idle;
+                uint32_t marg = (key.style & 2) ? premul(240, 240, 200, 50) : OverlayPalette::Idle;
+                fonts.caption.drawText(s, key.text, fsx, fsy + slot * 0.02f, fslot, slot * 0.45f, crit);
+                fonts.caption.drawText(s, key.text2, fsx, fsy + slot * 0.50f, fslot, slot * 0.48f, marg);
+            }
+            break;
+
+        case OverlayCellKind::Config:
+        {
+            float cx = float(sx + slot / 2), cy = float(sy + slot / 2);
+            constexpr int nTeeth = 8;
+            constexpr float kPI = 3.14159265f;
+            float tipR = slot * 0.40f, rootR = slot * 0.28f, holeR = slot * 0.10f;
+            float seg = 2.0f * kPI / nTeeth, halfTip = seg * 0.22f, halfRoot = seg * 0.28f;
+            std::vector<PointF> gear;
+            for (int t = 0; t < nTeeth; t++)
+            {
+                float ctr = t * seg - kPI / 2.0f, gapCtr = ctr + seg * 0.5f;
+                gear.push_back({cx + tipR * std::cos(ctr - halfTip), cy + tipR * std::sin(ctr - halfTip)});
+                gear.push_back({cx + tipR * std::cos(ctr + halfTip), cy + tipR * std::sin(ctr + halfTip)});
+                gear.push_back({cx + rootR * std::cos(gapCtr - halfRoot), cy + rootR * std::sin(gapCtr - halfRoot)});
+                gear.push_back({cx + rootR * std::cos(gapCtr + halfRoot), cy + rootR * std::sin(gapCtr + halfRoot)});
+            }
+            float pen = 1.2f * (slot / 48.0f);
+            uint32_t outline = premul(140, 100, 115, 140);
+            s.fillPolygon(gear, premul(150, 150, 165, 185));
+            s.strokePolygon(gear, pen, outline);
+            s.fillEllipse(cx, cy, holeR, holeR, premul(150, 25, 30, 45));
+            s.strokeEllipse(cx, cy, holeR, pen, outline);
+            fonts.caption.drawText(s, key.text, fsx, fsy, fslot, fslot, OverlayPalette::Caption);
+            break;
+        }
+        }
+
+        fonts.label.drawText(s, key.label, fsx, float(sy + slot + 1), fslot, float(l.labelH), OverlayPalette::Label);
+    }
+
+    // One frame: chrome on rebuild, then every dirty cell. iconOf(i) ->
+    // const ArgbImage* (null = none).
+    template <size_t N, typename IconOf>
+    void paintOverlay(Surface& s, const OverlayLayout& l, const std::array<OverlayCellKey, N>& cells, uint32_t dirty,
+                      bool rebuild, OverlayFonts& fonts, IconOf&& iconOf)
+    {
+        if (rebuild) paintOverlayChrome(s, l);
+        for (size_t i = 0; i < N; i++)
+            if (dirty & (1u << i)) paintOverlayCell(s, l, int(i), cells[i], iconOf(int(i)), fonts);
+    }
+
+} // namespace MoriaMods
+
+#endif // MORIA_OVERLAY_PAINT_H
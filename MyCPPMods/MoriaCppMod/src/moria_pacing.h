@@ -0,0 +1,159 @@
+
+
+
+#pragma once
+#ifndef MORIA_PACING_H
+#define MORIA_PACING_H
+
+#include <algorithm>
+#include <cstddef>
+
+// Per-frame batch sizing for queued game calls (recipe unlock drain).
+// A fixed count per frame ignores what each call costs; on a listen or
+// dedicated server a DiscoverRecipe call replicates and can cost far more
+// than in single player. The pacer instead:
+//
+//   - keeps an EMA of the measured cost per call and sizes each batch to
+//     fit budgetMs of work per frame;
+//   - keeps an EMA of the game's frame time (the interval minus the
+//     pacer's own work last frame, so a full batch can't read as a spike),
+//     and when a frame comes in slower than spikeFactor x that baseline,
+//     drops to minBatch for backoffFrames;
+//   - treats rebaseAfter spikes in a row as the new frame time (heavier
+//     scene, a client joined) and stops backing off, instead of staying
+//     at minBatch for good;
+//   - estimates time remaining from calls-per-frame and frame time.
+//
+// Pure (no UE4SS, no clock): the caller measures and passes milliseconds,
+// so cost traces are replayed in tests/test_pacing.cpp.
+
+namespace MoriaMods
+{
+
+    struct PacerConfig
+    {
+        double budgetMs{2.0};       // work allowed per frame
+        int minBatch{1};
+        int maxBatch{200};
+        int probeBatch{4};          // first batch, before any cost is known
+        double spikeFactor{2.0};    // frame > factor x baseline = spike
+        int backoffFrames{30};
+        int rebaseAfter{10};        // consecutive spikes that become the new baseline
+        double costAlpha{0.25};     // EMA weights
+        double frameAlpha{0.1};
+    };
+
+    class AdaptivePacer
+    {
+      public:
+        AdaptivePacer() = default;
+        explicit AdaptivePacer(const PacerConfig& cfg) : m_cfg(cfg) {}
+
+        const PacerConfig& config() const { return m_cfg; }
+        void setBudgetMs(double ms) { m_cfg.budgetMs = std::max(0.1, ms); }
+
+        // Start of a frame. `frameMs` is the time since the previous
+        // beginFrame (<= 0 for the first frame), including the work
+        // reported to the previous endFrame. Returns how many calls to
+        // make this frame.
+        int beginFrame(double frameMs)
+        {
+            if (frameMs > 0)
+            {
+                double gameMs = std::max(frameMs - m_lastWorkMs, 0.001);
+                if (m_frameMs > 0 && gameMs > m_cfg.spikeFactor * m_frameMs)
+                {
+                    m_spikes++;
+                    if (++m_spikeRun >= m_cfg.rebaseAfter)
+                    {
+                        // Not a hitch: the game got slower. Adopt it.
+                        m_frameMs = gameMs;
+                        m_spikeRun = 0;
+                        m_backoffLeft = 0;
+                        m_rebases++;
+                    }
+                    else
+                    {
+                        // Keep the spike out of the baseline so one hitch
+                        // doesn't raise the bar for detecting the next.
+                        m_backoffLeft = m_cfg.backoffFrames;
+                    }
+                }
+                else
+                {
+                    m_spikeRun = 0;
+                    m_frameMs = m_frameMs > 0 ? m_frameMs + m_cfg.frameAlpha * (gameMs - m_frameMs) : gameMs;
+                }
+            }
+            m_lastWorkMs = 0;
+
+            int n;
+            if (m_backoffLeft > 0)
+            {
+                m_backoffLeft--;
+                n = m_cfg.minBatch;
+            }
+            else if (m_costMs <= 0)
+                n = m_cfg.probeBatch;
+            else
+                n = static_cast<int>(m_cfg.budgetMs / m_costMs);
+            return std::clamp(n, m_cfg.minBatch, m_cfg.maxBatch);
+        }
+
+        // End of a frame: `calls` were made and took `elapsedMs` in total.
+        void endFrame(int calls, double elapsedMs)
+        {
+            m_lastWorkMs = std::max(0.0, elapsedMs);
+            if (calls <= 0) return;
+            double perCall = m_lastWorkMs / calls;
+            m_costMs = m_costMs > 0 ? m_costMs + m_cfg.costAlpha * (perCall - m_costMs) : std::max(perCall, 1e-6);
+            m_rate = m_rate > 0 ? m_rate + m_cfg.costAlpha * (calls - m_rate) : calls;
+            m_totalCalls += calls;
+        }
+
+        // Seconds to drain `remaining` calls at the current rate, or -1
+        // before there's enough data.
+        double etaSeconds(size_t remaining) const
+        {
+            if (m_rate <= 0 || m_frameMs <= 0) return -1;
+            return static_cast<double>(remaining) / m_rate * (m_frameMs + m_rate * m_costMs) / 1000.0;
+        }
+
+        double callCostMs() const { return m_costMs; }
+        double frameMs() const { return m_frameMs; }   // game only, without our work
+        double callsPerFrame() const { return m_rate; }
+        bool backingOff() const { return m_backoffLeft > 0; }
+        int spikes() const { return m_spikes; }
+        int rebases() const { return m_rebases; }
+        size_t totalCalls() const { return m_totalCalls; }
+
+        // Forget measurements (new queue); keeps the config.
+        void reset()
+        {
+            m_costMs = 0;
+            m_frameMs = 0;
+            m_rate = 0;
+            m_backoffLeft = 0;
+            m_spikes = 0;
+            m_spikeRun = 0;
+            m_rebases = 0;
+            m_lastWorkMs = 0;
+            m_totalCalls = 0;
+        }
+
+      private:
+        PacerConfig m_cfg;
+        double m_costMs{0};
+        double m_frameMs{0};
+        double m_rate{0};
+        int m_backoffLeft{0};
+        int m_spikes{0};
+        int m_spikeRun{0};
+        int m_rebases{0};
+        double m_lastWorkMs{0};
+        size_t m_totalCalls{0};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_PACING_H
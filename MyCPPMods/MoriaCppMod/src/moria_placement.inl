@@ -854,6 +854,7 @@
             bool gotFreshBLock = false;
 
 
+            confirmCachedProbe(s_off_bLock, matchedWidget);
             if (s_off_bLock == -2)
             {
                 resolveOffset(matchedWidget, L"bLock", s_off_bLock);
@@ -1465,7 +1466,7 @@
                 if (result == SelectResult::Found)
                 {
                     s_overlay.totalRotation = 0;
-                    s_overlay.needsUpdate = true;
+                    s_overlay.requestUpdate();
                     m_pendingQuickBuildSlot = -1;
                     m_isTargetBuild = false;
                     m_qbPhase = PlacePhase::Idle;
@@ -130,6 +130,14 @@
             file << "RemoveAttributes = " << (m_removeAttrsEnabled ? "true" : "false") << "\n";
             file << "PitchRotate = " << (m_pitchRotateEnabled ? "true" : "false") << "\n";
             file << "RollRotate = " << (m_rollRotateEnabled ? "true" : "false") << "\n";
+            file << "StabilityMonitor = " << (m_stabMonitorEnabled ? "true" : "false") << "\n";
+            file << "; max pooled stability-audit markers (light + VFX), reused across audits\n";
+            file << "AuditPoolSize = " << m_auditPool.capacity() << "\n";
+            file << "; ms of recipe-unlock work per frame; batch size adapts to measured call cost\n";
+            file << "UnlockFrameBudgetMs = " << m_unlockPacer.config().budgetMs << "\n";
+            file << "; off | json | csv - resolve definition packs without applying, write definitions_dryrun.*\n";
+            file << "DefinitionsDryRun = "
+                 << (m_defDryRun == DefDryRun::Json ? "json" : m_defDryRun == DefDryRun::Csv ? "csv" : "off") << "\n";
 
             // [Cheats]: only "true" entries written; absent keys = false.
             {
@@ -287,7 +295,11 @@
                                 try
                                 {
                                     int val = std::stoi(kv->value);
-                                    if (val >= 0 && val <= 90) s_overlay.rotationStep = val;
+                                    if (val >= 0 && val <= 90)
+                                    {
+                                        s_overlay.rotationStep = val;
+                                        s_overlay.requestUpdate();
+                                    }
                                 }
                                 catch (...) {}
                             }
@@ -319,6 +331,35 @@
                             {
                                 m_rollRotateEnabled = (kv->value == "true" || kv->value == "1" || kv->value == "yes");
                             }
+                            else if (strEqualCI(kv->key, "StabilityMonitor"))
+                            {
+                                m_stabMonitorEnabled = (kv->value == "true" || kv->value == "1" || kv->value == "yes");
+                            }
+                            else if (strEqualCI(kv->key, "AuditPoolSize"))
+                            {
+                                try
+                                {
+                                    int val = std::stoi(kv->value);
+                                    if (val > 0) setAuditPoolSize(val);
+                                }
+                                catch (...) {}
+                            }
+                            else if (strEqualCI(kv->key, "UnlockFrameBudgetMs"))
+                            {
+                                try
+                                {
+                                    float val = std::stof(kv->value);
+                                    if (val > 0.0f && val <= 50.0f) m_unlockPacer.setBudgetMs(val);
+                                }
+                                catch (...) {}
+                            }
+                            else if (strEqualCI(kv->key, "DefinitionsDryRun"))
+                            {
+                                if (strEqualCI(kv->value, "csv")) m_defDryRun = DefDryRun::Csv;
+                                else if (strEqualCI(kv->value, "json") || kv->value == "true" || kv->value == "1")
+                                    m_defDryRun = DefDryRun::Json;
+                                else m_defDryRun = DefDryRun::Off;
+                            }
                         }
                         else if (strEqualCI(section, "Cheats"))
                         {
@@ -469,60 +510,77 @@
         }
 
 
-        bool extractAndSaveIcon(UObject* widget, const std::wstring& textureName,
-                                const std::wstring& outPath, UObject* textureOverride = nullptr)
+        // Texture behind a build-menu item widget's Icon image: the brush's
+        // Texture2D, or the first texture parameter of its material.
+        UObject* iconTextureFromWidget(UObject* widget)
         {
-            QBLOG(STR("[MoriaCppMod] [QB] extractAndSaveIcon ENTER: widget={:p} tex='{}' path='{}' override={:p}\n"),
-                  (void*)widget, textureName, outPath, (void*)textureOverride);
-            if (textureName.empty()) return false;
-            if (!textureOverride && !widget) return false;
+            if (!widget) return nullptr;
+            UObject* texture = nullptr;
             try
             {
-
-                UObject* texture = textureOverride;
-                if (!texture && widget)
+                uint8_t* base = reinterpret_cast<uint8_t*>(widget);
+                resolveOffset(widget, L"Icon", s_off_icon);
+                UObject* iconImg = (s_off_icon >= 0) ? *reinterpret_cast<UObject**>(base + s_off_icon) : nullptr;
+                if (iconImg && isReadableMemory(iconImg, 400))
                 {
-                    uint8_t* base = reinterpret_cast<uint8_t*>(widget);
-                    if (s_off_icon == -2) resolveOffset(widget, L"Icon", s_off_icon);
-                    UObject* iconImg = (s_off_icon >= 0) ? *reinterpret_cast<UObject**>(base + s_off_icon) : nullptr;
-                    if (iconImg && isReadableMemory(iconImg, 400))
+                    ensureBrushOffset(iconImg);
+                    if (s_off_brush >= 0)
                     {
-                        ensureBrushOffset(iconImg);
-                        if (s_off_brush >= 0)
+                        uint8_t* imgBase = reinterpret_cast<uint8_t*>(iconImg);
+                        UObject* brushResource = *reinterpret_cast<UObject**>(imgBase + s_off_brush + brushResourceObj());
+                        if (brushResource && isReadableMemory(brushResource, 64))
                         {
-                            uint8_t* imgBase = reinterpret_cast<uint8_t*>(iconImg);
-                            UObject* brushResource = *reinterpret_cast<UObject**>(imgBase + s_off_brush + brushResourceObj());
-                            if (brushResource && isReadableMemory(brushResource, 64))
+                            std::wstring resClass = safeClassName(brushResource);
+                            if (resClass.find(L"Texture2D") != std::wstring::npos)
+                            {
+                                texture = brushResource;
+                            }
+                            else if (resClass.find(L"Material") != std::wstring::npos && isReadableMemory(brushResource, 280))
                             {
-                                std::wstring resClass = safeClassName(brushResource);
-                                if (resClass.find(L"Texture2D") != std::wstring::npos)
+
+                                confirmCachedProbe(s_off_texParamValues, brushResource);
+                                if (s_off_texParamValues == -2)
                                 {
-                                    texture = brushResource;
+                                    resolveOffset(brushResource, L"TextureParameterValues", s_off_texParamValues);
+                                    probeTexParamStruct(brushResource);
                                 }
-                                else if (resClass.find(L"Material") != std::wstring::npos && isReadableMemory(brushResource, 280))
+                                if (s_off_texParamValues >= 0)
                                 {
-
-                                    if (s_off_texParamValues == -2)
-                                    {
-                                        resolveOffset(brushResource, L"TextureParameterValues", s_off_texParamValues);
-                                        probeTexParamStruct(brushResource);
-                                    }
-                                    if (s_off_texParamValues >= 0)
+                                    uint8_t* midBase = reinterpret_cast<uint8_t*>(brushResource);
+                                    uint8_t* arrData = *reinterpret_cast<uint8_t**>(midBase + s_off_texParamValues);
+                                    int32_t arrNum = *reinterpret_cast<int32_t*>(midBase + s_off_texParamValues + 8);
+                                    if (arrNum >= 1 && arrNum <= 32 && arrData && isReadableMemory(arrData, 40))
                                     {
-                                        uint8_t* midBase = reinterpret_cast<uint8_t*>(brushResource);
-                                        uint8_t* arrData = *reinterpret_cast<uint8_t**>(midBase + s_off_texParamValues);
-                                        int32_t arrNum = *reinterpret_cast<int32_t*>(midBase + s_off_texParamValues + 8);
-                                        if (arrNum >= 1 && arrNum <= 32 && arrData && isReadableMemory(arrData, 40))
-                                        {
-                                            texture = *reinterpret_cast<UObject**>(arrData + texParamValueOff());
-                                            if (texture && !isReadableMemory(texture, 64)) texture = nullptr;
-                                        }
+                                        texture = *reinterpret_cast<UObject**>(arrData + texParamValueOff());
+                                        if (texture && !isReadableMemory(texture, 64)) texture = nullptr;
                                     }
                                 }
                             }
                         }
                     }
                 }
+            }
+            catch (...)
+            {
+                return nullptr;
+            }
+            return texture;
+        }
+
+
+        bool extractAndSaveIcon(UObject* widget, const std::wstring& textureName,
+                                const std::wstring& outPath, UObject* textureOverride = nullptr)
+        {
+            QBLOG(STR("[MoriaCppMod] [QB] extractAndSaveIcon ENTER: widget={:p} tex='{}' path='{}' override={:p}\n"),
+                  (void*)widget, textureName, outPath, (void*)textureOverride);
+            if (textureName.empty()) return false;
+            if (!textureOverride && !widget) return false;
+            try
+            {
+
+                UObject* texture = textureOverride;
+                if (!texture && widget) texture = iconTextureFromWidget(widget);
+
                 if (!texture)
                 {
                     VLOG(STR("[MoriaCppMod] [Icon] UTexture2D not found from widget chain\n"));
@@ -892,7 +950,7 @@
                 uint8_t* base = reinterpret_cast<uint8_t*>(widget);
                 QBLOG(STR("[MoriaCppMod] [QB] extractIconTextureName: widget={:p} cls='{}'\n"),
                       (void*)widget, safeClassName(widget));
-                if (s_off_icon == -2) resolveOffset(widget, L"Icon", s_off_icon);
+                resolveOffset(widget, L"Icon", s_off_icon);
                 if (s_off_icon < 0) { QBLOG(STR("[MoriaCppMod] [QB] extractIconTextureName: s_off_icon not resolved\n")); return L""; }
                 UObject* iconImg = *reinterpret_cast<UObject**>(base + s_off_icon);
                 QBLOG(STR("[MoriaCppMod] [QB] extractIconTextureName: iconImg={:p} readable={}\n"),
@@ -923,7 +981,7 @@
                     return L"";
                 }
                 if (!isReadableMemory(brushResource, 280)) return L"";
-                if (s_off_texParamValues == -2) resolveOffset(brushResource, L"TextureParameterValues", s_off_texParamValues);
+                resolveOffset(brushResource, L"TextureParameterValues", s_off_texParamValues);
                 if (s_off_texParamValues < 0) { QBLOG(STR("[MoriaCppMod] [QB] extractIconTextureName: s_off_texParamValues not resolved\n")); return L""; }
                 uint8_t* midBase = reinterpret_cast<uint8_t*>(brushResource);
                 uint8_t* arrData = *reinterpret_cast<uint8_t**>(midBase + s_off_texParamValues);
@@ -1120,23 +1178,9 @@
             if (!m_recipeSlots[slot].textureName.empty())
             {
                 QBLOG(STR("[MoriaCppMod] [QuickBuild] F{} icon: '{}'\n"), slot + 1, m_recipeSlots[slot].textureName);
-
-                if (!s_overlay.iconFolder.empty())
-                {
-                    std::wstring pngPath = s_overlay.iconFolder + L"\\" + m_recipeSlots[slot].textureName + L".png";
-                    DWORD attr = GetFileAttributesW(pngPath.c_str());
-                    if (attr == INVALID_FILE_ATTRIBUTES)
-                    {
-                        QBLOG(STR("[MoriaCppMod] [QB] assignRecipeSlot: extracting PNG to '{}'\n"), pngPath);
-                        bool iconOk = extractAndSaveIcon(itemWidget, m_recipeSlots[slot].textureName, pngPath, dtIcon);
-                        QBLOG(STR("[MoriaCppMod] [QB] assignRecipeSlot: extractAndSaveIcon -> {}\n"),
-                              iconOk ? STR("OK") : STR("FAILED"));
-                    }
-                    else
-                    {
-                        VLOG(STR("[MoriaCppMod] [Icon] PNG already exists: {}\n"), pngPath);
-                    }
-                }
+                // Rendered into the icon store over the next frames (moria_icon_batch.inl).
+                queueIconExtraction(m_recipeSlots[slot].textureName,
+                                    dtIcon ? dtIcon : (itemWidget ? iconTextureFromWidget(itemWidget) : nullptr));
             }
 
             saveQuickBuildSlots();
@@ -1157,7 +1201,7 @@
         {
             if (!widget || !isObjectAlive(widget)) return L"";
             uint8_t* base = reinterpret_cast<uint8_t*>(widget);
-            if (s_off_blockName == -2) resolveOffset(widget, L"blockName", s_off_blockName);
+            resolveOffset(widget, L"blockName", s_off_blockName);
             if (s_off_blockName < 0) return L"";
             UObject* blockNameWidget = *reinterpret_cast<UObject**>(base + s_off_blockName);
             if (!blockNameWidget || !isObjectAlive(blockNameWidget)) return L"";
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "moria_common.h"
+#include "moria_offsets.h"
+#include "moria_offset_cache.h"
 #include <Unreal/Property/FArrayProperty.hpp>
 #include <Unreal/FField.hpp>
 
@@ -39,6 +41,10 @@ namespace MoriaMods
     //      do the lookup and write the resolved offset, or -1 on failure.
     //   3. Add a getter that returns the cached value or the moria_common.h
     //      hardcoded fallback.
+    //
+    // Struct clusters read as raw bytes (FItemInstance, FActiveItemEffect,
+    // FMorConnectionHistoryItem, FFGKUITab) live in the declarative table in
+    // moria_offsets.h instead: add a row there and read it with off(Off::X).
 
     inline int s_off_font = -2;
     inline int s_off_brush = -2;
@@ -50,6 +56,7 @@ namespace MoriaMods
 
     inline int s_off_brushImageSize = -2;
     inline int s_off_brushResourceObj = -2;
+    inline int s_off_brushUVRegion = -2;
     inline int s_off_fontTypefaceName = -2;
     inline int s_off_fontSize = -2;
     inline int s_off_texParamValue = -2;
@@ -62,46 +69,85 @@ namespace MoriaMods
     inline int s_off_rhRowName = -2;
     inline int s_off_variantEntrySize = -2;
 
+    // Stability audit: UMorStabilityComponent State/Stability and
+    // UActorComponent::OwnerPrivate. No hardcoded fallback; -1 skips the read.
+    inline int s_off_stabState = -2;
+    inline int s_off_stabStability = -2;
+    inline int s_off_compOwner = -2;
+
+    // Sentinel caches persisted by name alongside the registry. The
+    // LineTrace/UIT/DSP/SIMUI/BSE parm layouts and PSOffsets aren't here:
+    // each resolves in the same pass that looks up its UFunction, which
+    // has to happen every launch anyway. Root + path say where each one is
+    // re-checked after a load (confirmCachedProbe).
+    inline const OffsetProbeSlot kOffsetProbeSlots[] = {
+        {"s_off_font", &s_off_font, "TextBlock", "Font"},
+        {"s_off_brush", &s_off_brush, "Image", "Brush"},
+        {"s_off_bLock", &s_off_bLock, "BuildItem", "bLock"},
+        {"s_off_icon", &s_off_icon, "BuildItem", "Icon"},
+        {"s_off_blockName", &s_off_blockName, "BuildItem", "blockName"},
+        {"s_off_texParamValues", &s_off_texParamValues, "MaterialInstance", "TextureParameterValues"},
+        {"s_off_brushImageSize", &s_off_brushImageSize, "Image", "Brush.ImageSize"},
+        {"s_off_brushResourceObj", &s_off_brushResourceObj, "Image", "Brush.ResourceObject"},
+        {"s_off_brushUVRegion", &s_off_brushUVRegion, "Image", "Brush.UVRegion"},
+        {"s_off_fontTypefaceName", &s_off_fontTypefaceName, "TextBlock", "Font.TypefaceFontName"},
+        {"s_off_fontSize", &s_off_fontSize, "TextBlock", "Font.Size"},
+        {"s_off_texParamValue", &s_off_texParamValue, "MaterialInstance", "TextureParameterValues.ParameterValue"},
+        {"s_off_rbVariants", &s_off_rbVariants, "BuildItem", "bLock.Variants"},
+        {"s_off_varResultHandle", &s_off_varResultHandle, "BuildItem", "bLock.Variants.ResultConstructionHandle"},
+        {"s_off_rhRowName", &s_off_rhRowName, "BuildItem", "bLock.Variants.ResultConstructionHandle.RowName"},
+        {"s_off_variantEntrySize", &s_off_variantEntrySize, "BuildItem", "bLock.Variants."},
+        {"s_off_stabState", &s_off_stabState, "StabilityComponent", "State"},
+        {"s_off_stabStability", &s_off_stabStability, "StabilityComponent", "Stability"},
+        {"s_off_compOwner", &s_off_compOwner, "StabilityComponent", "OwnerPrivate"},
+    };
 
-    inline int s_off_iiItem = -2;
-    inline int s_off_iiCount = -2;
-    inline int s_off_iiID = -2;
-    inline int s_off_iiDur = -2;
-    inline int s_off_iiSize = -2;
-
-
-    inline int s_off_iiaList = -2;
+    // Reflected offset of a kOffsetProbeSlots path under `obj`'s class,
+    // stepping through struct and TArray<struct> properties. -1 when any
+    // step is missing.
+    inline int reflectedPathOffset(UObject* obj, std::string_view path)
+    {
+        UStruct* strct = obj ? static_cast<UStruct*>(obj->GetClassPrivate()) : nullptr;
+        while (strct)
+        {
+            size_t dot = path.find('.');
+            std::string_view seg = path.substr(0, dot);
+            if (seg.empty()) return strct->GetPropertiesSize();
+            FProperty* prop = strct->GetPropertyByNameInChain(std::wstring(seg.begin(), seg.end()).c_str());
+            if (!prop) return -1;
+            if (dot == std::string_view::npos) return prop->GetOffset_Internal();
+            path.remove_prefix(dot + 1);
+            if (auto* arrProp = CastField<FArrayProperty>(prop)) prop = arrProp->GetInner();
+            auto* structProp = prop ? CastField<FStructProperty>(prop) : nullptr;
+            strct = structProp ? structProp->GetStruct() : nullptr;
+        }
+        return -1;
+    }
 
-    // Active-item-effect cluster (FActiveItemEffect on FFastArraySerializer).
-    inline int s_off_aieListOff      = -2;  // Effects.List inner offset (FFastArray header size; usually 0x0110)
-    inline int s_off_aieStride       = -2;  // sizeof(FActiveItemEffect) (typ. 0x30)
-    inline int s_off_aieOnItem       = -2;  // FActiveItemEffect.OnItem (typ. 0x0C)
-    inline int s_off_aieEffect       = -2;  // FActiveItemEffect.Effect (typ. 0x10)
-    inline int s_off_aieEndTime      = -2;  // FActiveItemEffect.EndTime (typ. 0x18)
-    inline int s_off_aieAssetIdLo    = -2;  // FActiveItemEffect.AssetId word0 (typ. 0x1C)
-    inline int s_off_aieAssetIdHi    = -2;  // FActiveItemEffect.AssetId word1 (typ. 0x20)
+    // Before trusting `slot` (or any other slot read from the same live
+    // object) as loaded from offsets.cache, check one per struct against
+    // `obj`. On a mismatch the whole cache is dropped and `slot` is -2
+    // again, so the caller's usual resolve path runs.
+    inline void confirmCachedProbe(const int& slot, UObject* obj)
+    {
+        if (!obj || s_probeGroupsPending.empty() || slot < 0) return;
+        for (auto& p : kOffsetProbeSlots)
+        {
+            if (p.value != &slot) continue;
+            if (!spotCheckCachedProbes(kOffsetProbeSlots, p.root, [&](std::string_view path) { return reflectedPathOffset(obj, path); }))
+                RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Offsets] Cached {} offsets don't match this build; offset cache dropped\n"),
+                                                        std::wstring(p.root, p.root + std::strlen(p.root)));
+            return;
+        }
+    }
 
-    // FMorConnectionHistoryItem cluster (game struct in moria_session_history.inl).
-    inline int s_off_chiStride       = -2;  // sizeof(FMorConnectionHistoryItem) (typ. 0x58)
-    inline int s_off_chiWorldName    = -2;  // typ. 0x00
-    inline int s_off_chiConnType     = -2;  // typ. 0x10
-    inline int s_off_chiInviteString = -2;  // typ. 0x18
-    inline int s_off_chiUniqueInvite = -2;  // typ. 0x28
-    inline int s_off_chiPassword     = -2;  // typ. 0x38
-    inline int s_off_chiIsDedicated  = -2;  // typ. 0x48
-    inline int s_off_chiCreated      = -2;  // typ. 0x50
 
-    // FFGKUITab cluster (game struct in moria_settings_ui.inl tabArray walk).
-    inline int s_off_uitStride       = -2;  // sizeof(FFGKUITab) (typ. 0xE8)
-    inline int s_off_uitName         = -2;  // typ. 0x00
-    inline int s_off_uitDisplayName  = -2;  // typ. 0x08
-    inline int s_off_uitWidgetClass  = -2;  // typ. 0x20
-    inline int s_off_uitTabConfig    = -2;  // typ. 0x48
 
 
     inline int brushImageSizeX() { return (s_off_brushImageSize >= 0) ? s_off_brushImageSize     : BRUSH_IMAGE_SIZE_X; }
     inline int brushImageSizeY() { return (s_off_brushImageSize >= 0) ? s_off_brushImageSize + 4 : BRUSH_IMAGE_SIZE_Y; }
     inline int brushResourceObj(){ return (s_off_brushResourceObj >= 0) ? s_off_brushResourceObj  : BRUSH_RESOURCE_OBJECT; }
+    inline int brushUVRegion()   { return (s_off_brushUVRegion >= 0)    ? s_off_brushUVRegion     : BRUSH_UV_REGION; }
     inline int fontTypefaceName(){ return (s_off_fontTypefaceName >= 0) ? s_off_fontTypefaceName  : FONT_TYPEFACE_NAME; }
     inline int fontSizeOff()     { return (s_off_fontSize >= 0)         ? s_off_fontSize          : FONT_SIZE; }
     inline int texParamValueOff(){ return (s_off_texParamValue >= 0)    ? s_off_texParamValue     : TEX_PARAM_VALUE_PTR; }
@@ -124,18 +170,21 @@ namespace MoriaMods
     inline int variantEntrySize() { return (s_off_variantEntrySize >= 0) ? s_off_variantEntrySize : VARIANT_ENTRY_SIZE; }
 
 
-    inline int iiItemOff()  { return (s_off_iiItem >= 0)  ? s_off_iiItem : 0x10; }
-    inline int iiCountOff() { return (s_off_iiCount >= 0) ? s_off_iiCount: 0x18; }
-    inline int iiIDOff()    { return (s_off_iiID >= 0)    ? s_off_iiID   : 0x20; }
-    inline int iiDurOff()   { return (s_off_iiDur >= 0)   ? s_off_iiDur  : 0x24; }
-    inline int iiSize()     { return (s_off_iiSize >= 0)  ? s_off_iiSize : 0x30; }
+    inline int iiItemOff()  { return off(Off::IiItem); }
+    inline int iiCountOff() { return off(Off::IiCount); }
+    inline int iiSlotOff()  { return kIiSlotOff; }
+    inline int iiIDOff()    { return off(Off::IiID); }
+    inline int iiDurOff()   { return off(Off::IiDur); }
+    inline int iiContainerStartOff() { return kIiContainerStartOff; }
+    inline int iiSize()     { return off(Off::IiStride); }
 
 
-    inline int iiaListOff() { return (s_off_iiaList >= 0) ? s_off_iiaList : 0x110; }
+    inline int iiaListOff() { return off(Off::IiaList); }
 
 
     inline int resolveOffset(UObject* obj, const wchar_t* propName, int& cache)
     {
+        confirmCachedProbe(cache, obj);
         if (cache != -2) return cache;
         cache = -1;
         if (!obj) return -1;
@@ -213,6 +262,44 @@ namespace MoriaMods
     }
 
 
+    // Resolve every moria_offsets.h row of `id` from one walk of `strct`'s
+    // property chain. Mismatches against the table's fallbacks are logged
+    // together, always; the full layout only when verbose. A layout loaded
+    // from offsets.cache is spot-checked instead and walked only if stale.
+    inline void resolveRegisteredStruct(OffStruct id, UStruct* strct, int structSize)
+    {
+        if (offsetsResolved(id)) return;
+        if (offsetsCached(id))
+        {
+            bool fresh = spotCheckCached(id, strct ? structSize : 0, [&](std::wstring_view field) {
+                auto* prop = strct->GetPropertyByNameInChain(std::wstring(field).c_str());
+                return prop ? prop->GetOffset_Internal() : -1;
+            });
+            if (fresh) return;
+            RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Offsets] Cached {} layout is stale, re-resolving\n"),
+                                                    kOffStructNames[static_cast<size_t>(id)]);
+        }
+        size_t from = s_offsetMismatches.size();
+        size_t mismatches = resolveStruct(id, strct ? structSize : 0, [&](auto&& visit) {
+            for (auto* s = strct; s; s = s->GetSuperStruct())
+                for (auto* prop : s->ForEachProperty())
+                    visit(std::wstring_view(prop->GetName()), prop->GetOffset_Internal(), prop->GetSize());
+        });
+        const wchar_t* name = kOffStructNames[static_cast<size_t>(id)];
+        if (mismatches > 0)
+            RC::Output::send<RC::LogLevel::Warning>(STR("[MoriaCppMod] [Offsets] {}: {} mismatch(es) vs fallbacks\n{}"),
+                                                    name, mismatches, offsetMismatchSummary(from));
+        if (s_verbose)
+        {
+            std::wstring layout;
+            auto [b, e] = offsetRows(id);
+            for (size_t i = b; i < e; i++)
+                layout += std::format(L" {}=0x{:02X}", kOffsetTable[i].field ? kOffsetTable[i].field : L"size", s_offsets[i]);
+            VLOG(STR("[MoriaCppMod] [Offsets] {}:{}\n"), name, layout);
+        }
+    }
+
+
     inline FStructProperty* findStructProperty(UObject* obj, const wchar_t* propName)
     {
         if (!obj) return nullptr;
@@ -232,6 +319,7 @@ namespace MoriaMods
 
     inline void ensureBrushOffset(UObject* imageWidget)
     {
+        confirmCachedProbe(s_off_brush, imageWidget);
         if (s_off_brush == -2 && imageWidget)
         {
             resolveOffset(imageWidget, L"Brush", s_off_brush);
@@ -246,6 +334,7 @@ namespace MoriaMods
                     {
                         resolveStructFieldOffset(brushStruct, L"ImageSize", s_off_brushImageSize);
                         resolveStructFieldOffset(brushStruct, L"ResourceObject", s_off_brushResourceObj);
+                        resolveStructFieldOffset(brushStruct, L"UVRegion", s_off_brushUVRegion);
                         int structSize = brushStruct->GetPropertiesSize();
                         if (s_off_brushImageSize >= 0 && s_off_brushImageSize != BRUSH_IMAGE_SIZE_X)
                             VLOG(STR("[MoriaCppMod] [Validate] FSlateBrush::ImageSize MISMATCH: expected 0x{:02X}, got 0x{:02X}\n"),
@@ -253,6 +342,9 @@ namespace MoriaMods
                         if (s_off_brushResourceObj >= 0 && s_off_brushResourceObj != BRUSH_RESOURCE_OBJECT)
                             VLOG(STR("[MoriaCppMod] [Validate] FSlateBrush::ResourceObject MISMATCH: expected 0x{:02X}, got 0x{:02X}\n"),
                                  BRUSH_RESOURCE_OBJECT, s_off_brushResourceObj);
+                        if (s_off_brushUVRegion >= 0 && s_off_brushUVRegion != BRUSH_UV_REGION)
+                            VLOG(STR("[MoriaCppMod] [Validate] FSlateBrush::UVRegion MISMATCH: expected 0x{:02X}, got 0x{:02X}\n"),
+                                 BRUSH_UV_REGION, s_off_brushUVRegion);
                         VLOG(STR("[MoriaCppMod] [Validate] FSlateBrush: PropertiesSize={} ImageSize@0x{:02X} ResourceObject@0x{:02X}\n"),
                              structSize,
                              s_off_brushImageSize >= 0 ? s_off_brushImageSize : BRUSH_IMAGE_SIZE_X,
@@ -266,6 +358,7 @@ namespace MoriaMods
 
     inline void probeFontStruct(UObject* textBlock)
     {
+        confirmCachedProbe(s_off_font, textBlock);
         if (s_off_fontTypefaceName != -2) return;
         auto* structProp = findStructProperty(textBlock, L"Font");
         if (!structProp) { s_off_fontTypefaceName = -1; s_off_fontSize = -1; return; }
@@ -292,6 +385,7 @@ namespace MoriaMods
 
     inline void probeTexParamStruct(UObject* materialInstance)
     {
+        confirmCachedProbe(s_off_texParamValues, materialInstance);
         if (s_off_texParamValue != -2) return;
         if (!materialInstance) { s_off_texParamValue = -1; return; }
 
@@ -332,6 +426,7 @@ namespace MoriaMods
 
     inline void probeRecipeBlockStruct(UObject* widget)
     {
+        confirmCachedProbe(s_off_bLock, widget);
         if (s_off_rbVariants != -2) return;
         s_off_rbVariants = -1;
         s_off_varResultHandle = -1;
@@ -407,56 +502,25 @@ namespace MoriaMods
 
     inline void probeItemInstanceStruct(UObject* invComp)
     {
-        if (s_off_iiItem != -2) return;
-        s_off_iiItem = -1;
-        s_off_iiCount = -1;
-        s_off_iiID = -1;
-        s_off_iiDur = -1;
-        s_off_iiSize = -1;
-        s_off_iiaList = -1;
+        if (offsetsResolved(OffStruct::ItemInstance)) return;
 
-
-        FProperty* itemsProp = invComp->GetPropertyByNameInChain(STR("Items"));
-        if (!itemsProp)
-        {
+        UScriptStruct* iiaStruct = nullptr;
+        UScriptStruct* iiStruct = nullptr;
+        if (FProperty* itemsProp = invComp->GetPropertyByNameInChain(STR("Items")))
+            iiaStruct = static_cast<FStructProperty*>(itemsProp)->GetStruct();
+        else
             VLOG(STR("[MoriaCppMod] [Validate] probeItemInstanceStruct: Items property not found\n"));
-            return;
-        }
-        auto* itemsStructProp = static_cast<FStructProperty*>(itemsProp);
-        UScriptStruct* iiaStruct = itemsStructProp->GetStruct();
-        if (!iiaStruct)
-        {
-            VLOG(STR("[MoriaCppMod] [Validate] probeItemInstanceStruct: FItemInstanceArray struct null\n"));
-            return;
-        }
 
-
-        resolveStructFieldOffset(iiaStruct, L"List", s_off_iiaList);
-        VLOG(STR("[MoriaCppMod] [Validate] FItemInstanceArray: List@0x{:02X} (expected @0x110)\n"),
-             s_off_iiaList >= 0 ? s_off_iiaList : 0x110);
-
-
-        for (auto* prop : iiaStruct->ForEachProperty())
+        if (iiaStruct)
         {
-            if (prop->GetName() == std::wstring_view(L"List"))
-            {
-                auto* arrProp = static_cast<FArrayProperty*>(prop);
-                FProperty* inner = arrProp->GetInner();
-                if (!inner) break;
-                auto* innerStructProp = static_cast<FStructProperty*>(inner);
-                UScriptStruct* iiStruct = innerStructProp->GetStruct();
-                if (!iiStruct) break;
-
-                s_off_iiSize = iiStruct->GetPropertiesSize();
-                resolveStructFieldOffset(iiStruct, L"Item", s_off_iiItem);
-                resolveStructFieldOffset(iiStruct, L"Count", s_off_iiCount);
-                resolveStructFieldOffset(iiStruct, L"ID", s_off_iiID);
-                resolveStructFieldOffset(iiStruct, L"Durability", s_off_iiDur);
-                VLOG(STR("[MoriaCppMod] [Validate] FItemInstance: size=0x{:02X} Item@0x{:02X} Count@0x{:02X} ID@0x{:02X} Dur@0x{:02X}\n"),
-                     s_off_iiSize, s_off_iiItem >= 0 ? s_off_iiItem : 0x10, s_off_iiCount >= 0 ? s_off_iiCount : 0x18, s_off_iiID >= 0 ? s_off_iiID : 0x20, s_off_iiDur >= 0 ? s_off_iiDur : 0x24);
-                break;
-            }
+            if (FProperty* listProp = iiaStruct->GetPropertyByNameInChain(STR("List")))
+                if (auto* arrProp = CastField<FArrayProperty>(listProp))
+                    if (auto* innerStructProp = CastField<FStructProperty>(arrProp->GetInner()))
+                        iiStruct = innerStructProp->GetStruct();
         }
+
+        resolveRegisteredStruct(OffStruct::ItemInstanceArray, iiaStruct, iiaStruct ? iiaStruct->GetPropertiesSize() : 0);
+        resolveRegisteredStruct(OffStruct::ItemInstance, iiStruct, iiStruct ? iiStruct->GetPropertiesSize() : 0);
     }
 
 
@@ -724,58 +788,56 @@ namespace MoriaMods
         return s_bse.resolved && s_bse.bLock >= 0 && s_bse.selfRef >= 0;
     }
 
-    // Resolves the size + a property offset of a UScriptStruct that's the
-    // element type of a TArray<FStructXxx> property on `owner`. Used to
-    // back-fill stride + inner-field offsets via reflection rather than
-    // hardcoding them.
-    //
-    //   owner          : the UObject whose TArray<FStructXxx> we walk
-    //   arrayPropName  : name of the TArray property on owner
-    //   fieldName      : name of an inner field on FStructXxx (or nullptr
-    //                    to only resolve stride)
-    // Returns the inner field's offset, or -1 if any step failed.
-    // Always also writes the struct stride into outStride if the struct
-    // was found (even when fieldName is null or fieldName lookup fails).
-    inline int resolveArrayStructLayout(UObject* owner,
-                                        const wchar_t* arrayPropName,
-                                        const wchar_t* fieldName,
-                                        int* outStride)
-    {
-        if (outStride) *outStride = -1;
-        if (!owner || !arrayPropName) return -1;
-        auto* prop = owner->GetPropertyByNameInChain(arrayPropName);
-        if (!prop) return -1;
-        auto* arrProp = CastField<FArrayProperty>(prop);
-        if (!arrProp) return -1;
-        FProperty* inner = arrProp->GetInner();
-        if (!inner) return -1;
-        auto* sProp = CastField<FStructProperty>(inner);
-        if (!sProp) return -1;
-        UScriptStruct* sStruct = sProp->GetStruct();
-        if (!sStruct) return -1;
-        if (outStride) *outStride = static_cast<int>(sStruct->GetStructureSize());
-        if (!fieldName) return -1;
-        auto* fProp = sStruct->GetPropertyByNameInChain(fieldName);
-        return fProp ? fProp->GetOffset_Internal() : -1;
-    }
-
-    // Same as resolveArrayStructLayout but for a single FStructProperty
-    // (not a TArray). Used for FMorConnectionHistoryItem etc. that
-    // appear as struct-typed UFunction parms.
-    //
-    // Returns the inner field's offset, or -1 on failure. outStride gets
-    // the struct's GetStructureSize() if the struct was located.
-    inline int resolveStructLayout(UStruct* sStruct,
-                                   const wchar_t* fieldName,
-                                   int* outStride)
-    {
-        if (outStride) *outStride = -1;
-        if (!sStruct) return -1;
-        if (auto* ss = sStruct->IsA<UScriptStruct>() ? static_cast<UScriptStruct*>(sStruct) : nullptr)
-            if (outStride) *outStride = static_cast<int>(ss->GetStructureSize());
-        if (!fieldName) return -1;
-        auto* fProp = sStruct->GetPropertyByNameInChain(fieldName);
-        return fProp ? fProp->GetOffset_Internal() : -1;
+
+    // ── Persisted offset cache (moria_offset_cache.h) ──
+
+    // Build id = the game exe's PE link timestamp; module hash = FNV-1a of
+    // its mapped PE headers (section table, image size, checksum), so any
+    // patch that relinks the exe changes the key.
+    inline OffsetCacheKey currentOffsetCacheKey()
+    {
+        OffsetCacheKey key;
+        auto* base = reinterpret_cast<const uint8_t*>(GetModuleHandleW(nullptr));
+        if (!base) return key;
+        auto* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+        if (dos->e_magic != IMAGE_DOS_SIGNATURE) return key;
+        auto* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
+        if (nt->Signature != IMAGE_NT_SIGNATURE) return key;
+        key.buildId = nt->FileHeader.TimeDateStamp;
+        key.moduleHash = fnv1a64(base, nt->OptionalHeader.SizeOfHeaders);
+        return key;
+    }
+
+    inline std::string offsetCachePath() { return modPath("Mods/MoriaCppMod/offsets.cache"); }
+
+    // Last text written, so the periodic save only touches disk on change.
+    inline std::string s_offsetCacheWritten;
+
+    // Called from on_unreal_init, before anything resolves.
+    inline void loadOffsetCache()
+    {
+        std::ifstream file = openInputFile(offsetCachePath());
+        if (!file.is_open())
+        {
+            VLOG(STR("[MoriaCppMod] [Offsets] No offset cache; layouts resolve on first use\n"));
+            return;
+        }
+        OffsetCacheKey key = currentOffsetCacheKey();
+        int applied = loadOffsetCacheStream(file, key, kOffsetProbeSlots);
+        if (applied < 0)
+            VLOG(STR("[MoriaCppMod] [Offsets] Offset cache is for another game build (now {:#x}); re-resolving\n"), key.buildId);
+        else
+            VLOG(STR("[MoriaCppMod] [Offsets] Loaded {} cached offsets for build {:#x}\n"), applied, key.buildId);
+    }
+
+    inline void saveOffsetCache()
+    {
+        std::string text = serializeOffsetCache(currentOffsetCacheKey(), kOffsetProbeSlots);
+        if (text == s_offsetCacheWritten) return;
+        std::ofstream file = openOutputFile(offsetCachePath(), std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return;
+        file << text;
+        s_offsetCacheWritten = std::move(text);
     }
 
 }
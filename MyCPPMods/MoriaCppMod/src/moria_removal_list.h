@@ -0,0 +1,252 @@
+
+
+
+#pragma once
+#ifndef MORIA_REMOVAL_LIST_H
+#define MORIA_REMOVAL_LIST_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Grouped row model behind the F12 saved-removals list, kept current
+// incrementally as removals are added and undone.
+
+namespace MoriaMods
+{
+
+    struct RemovalListRow
+    {
+        enum class Kind : uint8_t { TypeRulesHeader, BubbleHeader, Entry };
+
+        Kind kind{Kind::Entry};
+        uint32_t group{0};   // BubbleHeader/Entry: index into groups(); kTypeRules for type rules
+        uint32_t entry{0};   // Entry: index into the removal entries
+    };
+
+    class RemovalGroupIndex
+    {
+      public:
+        static constexpr uint32_t kTypeRules = UINT32_MAX;
+        // Full regroup instead of per-entry shifting once a diff gets this big.
+        static constexpr size_t kIncrementalLimit = 64;
+
+        struct Group
+        {
+            std::string bubbleId;
+            std::vector<uint32_t> entries;   // ascending
+        };
+
+        // Entries without a bubble are listed under this id.
+        static std::string_view groupId(std::string_view bubbleId) { return bubbleId.empty() ? "Unknown" : bubbleId; }
+
+        // Bring the index in line with `count` entries; keyAt(i) returns
+        // {isTypeRule, bubbleId} for entry i. Returns true if anything
+        // changed. Only the differing middle of the sequence is touched.
+        template <typename KeyAt>
+        bool sync(size_t count, KeyAt&& keyAt)
+        {
+            size_t oldN = m_keys.size();
+            auto same = [&](size_t oldI, size_t newI) {
+                auto [typeRule, bubble] = keyAt(newI);
+                const Key& k = m_keys[oldI];
+                return k.typeRule == bool(typeRule) && (typeRule || k.id == groupId(bubble));
+            };
+            size_t p = 0;
+            while (p < oldN && p < count && same(p, p)) p++;
+            size_t s = 0;
+            while (s < oldN - p && s < count - p && same(oldN - 1 - s, count - 1 - s)) s++;
+
+            size_t removed = oldN - p - s, added = count - p - s;
+            if (removed == 0 && added == 0) return false;
+            if (removed + added > kIncrementalLimit)
+            {
+                clear();
+                for (size_t i = 0; i < count; i++)
+                {
+                    auto [typeRule, bubble] = keyAt(i);
+                    insert(i, typeRule, bubble);
+                }
+                return true;
+            }
+            for (size_t i = oldN - s; i-- > p;) erase(i);
+            for (size_t i = p; i < p + added; i++)
+            {
+                auto [typeRule, bubble] = keyAt(i);
+                insert(i, typeRule, bubble);
+            }
+            return true;
+        }
+
+        // Insert entry `pos`; entries at or after it move down by one.
+        void insert(size_t pos, bool typeRule, std::string_view bubbleId)
+        {
+            pos = std::min(pos, m_keys.size());
+            uint32_t at = uint32_t(pos);
+            if (at < m_keys.size())
+            {
+                shift(m_typeRules, at, +1);
+                for (auto& g : m_groups) shift(g.entries, at, +1);
+            }
+            Key key{typeRule, typeRule ? std::string() : std::string(groupId(bubbleId))};
+            std::vector<uint32_t>* list = &m_typeRules;
+            if (!typeRule)
+            {
+                auto it = findGroup(key.id);
+                if (it == m_groups.end() || it->bubbleId != key.id) it = m_groups.insert(it, Group{key.id, {}});
+                list = &it->entries;
+            }
+            list->insert(std::lower_bound(list->begin(), list->end(), at), at);
+            m_keys.insert(m_keys.begin() + pos, std::move(key));
+            touch();
+        }
+
+        // Remove entry `pos`; later entries move up by one. Empty groups go.
+        void erase(size_t pos)
+        {
+            if (pos >= m_keys.size()) return;
+            uint32_t at = uint32_t(pos);
+            const Key& key = m_keys[pos];
+            if (key.typeRule)
+                removeIndex(m_typeRules, at);
+            else
+            {
+                auto it = findGroup(key.id);
+                if (it != m_groups.end() && it->bubbleId == key.id)
+                {
+                    removeIndex(it->entries, at);
+                    if (it->entries.empty()) m_groups.erase(it);
+                }
+            }
+            m_keys.erase(m_keys.begin() + pos);
+            shift(m_typeRules, at, -1);
+            for (auto& g : m_groups) shift(g.entries, at, -1);
+            touch();
+        }
+
+        void clear()
+        {
+            m_keys.clear();
+            m_typeRules.clear();
+            m_groups.clear();
+            touch();
+        }
+
+        // The current bubble's group is listed first. Returns true if that
+        // changes the row order.
+        bool setCurrentBubble(std::string_view bubbleId)
+        {
+            if (bubbleId == m_current) return false;
+            m_current = std::string(bubbleId);
+            touch();
+            return true;
+        }
+
+        const std::string& currentBubble() const { return m_current; }
+        size_t entryCount() const { return m_keys.size(); }
+        const std::vector<uint32_t>& typeRules() const { return m_typeRules; }
+        const std::vector<Group>& groups() const { return m_groups; }   // sorted by bubbleId
+        bool isCurrent(uint32_t group) const { return group < m_groups.size() && m_groups[group].bubbleId == m_current; }
+
+        // Bumped on every change; a bound row whose version differs is stale.
+        uint64_t version() const { return m_version; }
+
+        // Header and entry rows in display order, rebuilt at most once per change.
+        const std::vector<RemovalListRow>& rows()
+        {
+            if (m_rowsVersion == m_version) return m_rows;
+            m_rows.clear();
+            m_rows.reserve(m_keys.size() + m_groups.size() + 1);
+            if (!m_typeRules.empty())
+            {
+                m_rows.push_back({RemovalListRow::Kind::TypeRulesHeader, kTypeRules, 0});
+                for (uint32_t e : m_typeRules) m_rows.push_back({RemovalListRow::Kind::Entry, kTypeRules, e});
+            }
+            auto emit = [&](uint32_t g) {
+                m_rows.push_back({RemovalListRow::Kind::BubbleHeader, g, 0});
+                for (uint32_t e : m_groups[g].entries) m_rows.push_back({RemovalListRow::Kind::Entry, g, e});
+            };
+            auto cur = findGroup(m_current);
+            uint32_t curIdx = (cur != m_groups.end() && cur->bubbleId == m_current) ? uint32_t(cur - m_groups.begin()) : kTypeRules;
+            if (curIdx != kTypeRules) emit(curIdx);
+            for (uint32_t g = 0; g < m_groups.size(); g++)
+                if (g != curIdx) emit(g);
+            m_rowsVersion = m_version;
+            return m_rows;
+        }
+
+      private:
+        struct Key
+        {
+            bool typeRule{false};
+            std::string id;   // groupId(bubbleId); empty for type rules
+        };
+
+        std::vector<Group>::iterator findGroup(std::string_view id)
+        {
+            return std::lower_bound(m_groups.begin(), m_groups.end(), id,
+                                    [](const Group& g, std::string_view v) { return std::string_view(g.bubbleId) < v; });
+        }
+
+        // Add `delta` to every index >= at (the vector stays sorted).
+        static void shift(std::vector<uint32_t>& v, uint32_t at, int delta)
+        {
+            for (auto it = std::lower_bound(v.begin(), v.end(), at); it != v.end(); ++it) *it = uint32_t(int64_t(*it) + delta);
+        }
+
+        static void removeIndex(std::vector<uint32_t>& v, uint32_t at)
+        {
+            auto it = std::lower_bound(v.begin(), v.end(), at);
+            if (it != v.end() && *it == at) v.erase(it);
+        }
+
+        void touch() { m_version++; }
+
+        std::vector<Key> m_keys;
+        std::vector<uint32_t> m_typeRules;
+        std::vector<Group> m_groups;
+        std::string m_current;
+        std::vector<RemovalListRow> m_rows;
+        uint64_t m_version{1};
+        uint64_t m_rowsVersion{0};
+    };
+
+    // Which rows a fixed pool of `pool` equal-height rows shows when the
+    // list is scrolled `scrollY` past its top, plus the spacer heights above
+    // and below that keep the total content height at rows * rowH (so the
+    // scroll box's range and thumb match the full list).
+    struct RemovalListWindow
+    {
+        size_t first{0};
+        size_t count{0};
+        float topPad{0.0f};
+        float bottomPad{0.0f};
+    };
+
+    inline RemovalListWindow removalListWindow(size_t rows, size_t pool, float rowH, float scrollY)
+    {
+        RemovalListWindow w;
+        if (rows == 0 || pool == 0 || rowH <= 0.0f) return w;
+        size_t first = scrollY > 0.0f ? size_t(std::floor(scrollY / rowH)) : 0;
+        w.first = std::min(first, rows > pool ? rows - pool : size_t(0));
+        w.count = std::min(pool, rows - w.first);
+        w.topPad = float(w.first) * rowH;
+        w.bottomPad = float(rows - w.first - w.count) * rowH;
+        return w;
+    }
+
+    // Row under a point `y` below the list's top, or -1.
+    inline int removalListRowAt(float y, float rowH, size_t rows)
+    {
+        if (y < 0.0f || rowH <= 0.0f) return -1;
+        size_t r = size_t(y / rowH);
+        return r < rows ? int(r) : -1;
+    }
+
+} // namespace MoriaMods
+
+#endif // MORIA_REMOVAL_LIST_H
@@ -196,12 +196,12 @@
                 // Name offset.
                 if (uint8_t* base = tabArrFnameBased->GetData())
                 {
-                    const int kStride = s_off_uitStride;
+                    const int kStride = off(Off::UitStride);
                     for (int i = 0; i < n && i < 16; ++i)
                     {
                         uint8_t* entry = base + (size_t)i * kStride;
                         // FName is 8 bytes — 4 ComparisonIndex + 4 Number
-                        FName* fn = reinterpret_cast<FName*>(entry + s_off_uitName);
+                        FName* fn = reinterpret_cast<FName*>(entry + off(Off::UitName));
                         std::wstring nameStr;
                         try { nameStr = fn->ToString(); } catch (...) {}
                         VLOG(STR("[SettingsUI]     tabArray[{}].Name = '{}'\n"),
@@ -1269,6 +1269,7 @@
                          fname.c_str(), vk, modBits,
                          std::wstring(r.iniKey.begin(), r.iniKey.end()).c_str());
                     saveConfig();
+                    s_overlay.requestUpdate();
                 };
 
                 // Edge-detect each table entry.
@@ -1641,6 +1642,7 @@
                          std::wstring(r.iniKey.begin(), r.iniKey.end()).c_str(), vk, modBits);
                 }
                 saveConfig();
+                s_overlay.requestUpdate();
                 return;
             }
         }
@@ -3065,9 +3067,10 @@
                                ? m_ftGameModEntries[modIdx].enabled : false;
                     },
                     [this, modIdx](bool newState) {
-                        if (modIdx >= 0 && modIdx < (int)m_ftGameModEntries.size()) {
+                        if (modIdx >= 0 && modIdx < (int)m_ftGameModEntries.size()
+                            && m_ftGameModEntries[modIdx].enabled != newState) {
                             m_ftGameModEntries[modIdx].enabled = newState;
-                            saveGameMods(m_ftGameModEntries);
+                            onGameModToggled(modIdx);
                         }
                     });
             }
@@ -4343,7 +4346,7 @@
                 if (m.modIdx >= 0 && m.modIdx < (int)m_ftGameModEntries.size())
                 {
                     m_ftGameModEntries[m.modIdx].enabled = !m_ftGameModEntries[m.modIdx].enabled;
-                    saveGameMods(m_ftGameModEntries);
+                    onGameModToggled(m.modIdx);
                     VLOG(STR("[SettingsUI] CP5 — modpack[{}].enabled={}\n"),
                          m.modIdx, m_ftGameModEntries[m.modIdx].enabled ? L"true" : L"false");
                 }
@@ -4382,51 +4385,20 @@
         }
 
         // Resolve FFGKUITab layout via reflection. Probe walks the supplied
-        // FArrayProperty -> inner FStructProperty -> UScriptStruct, reads
-        // stride and the field offsets we touch (Name, DisplayName).
-        // Stores results in s_off_uit* sentinels (in moria_reflection.h).
-        // Falls back to historic shipping layout (stride 0xE8, Name 0x00,
-        // DisplayName 0x08, WidgetClass 0x20, TabConfig 0x48) on failure.
+        // FArrayProperty -> inner FStructProperty -> UScriptStruct and
+        // resolves stride + the fields we touch in one pass through the
+        // registry (moria_offsets.h). Missing fields keep the historic
+        // shipping layout (stride 0xE8, Name 0x00, DisplayName 0x08,
+        // WidgetClass 0x20, TabConfig 0x48).
         bool ensureFGKUITabOffsets(FProperty* pArrProp)
         {
-            if (s_off_uitStride > 0
-                && s_off_uitName        >= 0
-                && s_off_uitDisplayName >= 0)
-                return true;
-            int stride = -1;
-            int offName = -1, offDisplay = -1, offWidgetCls = -1, offTabCfg = -1;
-            if (pArrProp)
-            {
-                if (auto* arrProp = CastField<FArrayProperty>(pArrProp))
-                {
-                    if (auto* innerStructProp = CastField<FStructProperty>(arrProp->GetInner()))
-                    {
-                        if (UStruct* sStruct = innerStructProp->GetStruct())
-                        {
-                            if (auto* ss = static_cast<UScriptStruct*>(sStruct))
-                                stride = static_cast<int>(ss->GetStructureSize());
-                            if (auto* p = sStruct->GetPropertyByNameInChain(STR("Name")))
-                                offName = p->GetOffset_Internal();
-                            if (auto* p = sStruct->GetPropertyByNameInChain(STR("DisplayName")))
-                                offDisplay = p->GetOffset_Internal();
-                            if (auto* p = sStruct->GetPropertyByNameInChain(STR("WidgetClass")))
-                                offWidgetCls = p->GetOffset_Internal();
-                            if (auto* p = sStruct->GetPropertyByNameInChain(STR("TabConfig")))
-                                offTabCfg = p->GetOffset_Internal();
-                        }
-                    }
-                }
-            }
-            s_off_uitStride      = (stride       > 0) ? stride       : 0xE8;
-            s_off_uitName        = (offName      >= 0) ? offName      : 0x00;
-            s_off_uitDisplayName = (offDisplay   >= 0) ? offDisplay   : 0x08;
-            s_off_uitWidgetClass = (offWidgetCls >= 0) ? offWidgetCls : 0x20;
-            s_off_uitTabConfig   = (offTabCfg    >= 0) ? offTabCfg    : 0x48;
-            VLOG(STR("[SettingsUI] FFGKUITab layout resolved: stride={:#x} Name={:#x} "
-                     "Display={:#x} Widget={:#x} TabCfg={:#x}\n"),
-                 (unsigned)s_off_uitStride, (unsigned)s_off_uitName,
-                 (unsigned)s_off_uitDisplayName, (unsigned)s_off_uitWidgetClass,
-                 (unsigned)s_off_uitTabConfig);
+            if (offsetsResolved(OffStruct::UITab)) return true;
+            UScriptStruct* sStruct = nullptr;
+            if (auto* arrProp = pArrProp ? CastField<FArrayProperty>(pArrProp) : nullptr)
+                if (auto* innerStructProp = CastField<FStructProperty>(arrProp->GetInner()))
+                    sStruct = innerStructProp->GetStruct();
+            resolveRegisteredStruct(OffStruct::UITab, sStruct,
+                                    sStruct ? static_cast<int>(sStruct->GetStructureSize()) : 0);
             return true;
         }
 
@@ -4456,13 +4428,13 @@
                 return;
             }
             ensureFGKUITabOffsets(p);
-            const int kStride = s_off_uitStride;
+            const int kStride = off(Off::UitStride);
 
             int legalIdx = -1;
             for (int i = 0; i < n && i < 16; ++i)
             {
                 uint8_t* entry = base + (size_t)i * kStride;
-                FName* fnEntry = reinterpret_cast<FName*>(entry + s_off_uitName);
+                FName* fnEntry = reinterpret_cast<FName*>(entry + off(Off::UitName));
                 std::wstring name;
                 try { name = fnEntry->ToString(); } catch (...) { continue; }
                 if (name == L"Cheats") return; // already augmented
@@ -4500,9 +4472,9 @@
             uint8_t* src = writeBase + (size_t)legalIdx * kStride;
             std::memcpy(dst, src, kStride);
             RC::Unreal::FName cheatsName(STR("Cheats"), RC::Unreal::FNAME_Add);
-            std::memcpy(dst + s_off_uitName, &cheatsName, sizeof(RC::Unreal::FName));
+            std::memcpy(dst + off(Off::UitName), &cheatsName, sizeof(RC::Unreal::FName));
             FText cheatsDisplay(L"Cheats");
-            std::memcpy(dst + s_off_uitDisplayName, &cheatsDisplay, sizeof(FText));
+            std::memcpy(dst + off(Off::UitDisplayName), &cheatsDisplay, sizeof(FText));
             tabs->SetNum(n + 1, false);
 
             static int s_loggedTimes = 0;
@@ -4540,7 +4512,7 @@
             uint8_t* base = outArr->GetData();
             if (!base || n <= 0) return;
             ensureFGKUITabOffsets(p);
-            const int kStride = s_off_uitStride;
+            const int kStride = off(Off::UitStride);
 
             // Skip if Cheats already in this array (double-add guard).
             // Also find legal entry to clone from.
@@ -4548,7 +4520,7 @@
             for (int i = 0; i < n && i < 16; ++i)
             {
                 uint8_t* entry = base + (size_t)i * kStride;
-                FName* fnEntry = reinterpret_cast<FName*>(entry + s_off_uitName);
+                FName* fnEntry = reinterpret_cast<FName*>(entry + off(Off::UitName));
                 std::wstring name;
                 try { name = fnEntry->ToString(); } catch (...) { continue; }
                 if (name == L"Cheats") return;
@@ -4579,9 +4551,9 @@
             uint8_t* src = writeBase + (size_t)legalIdx * kStride;
             std::memcpy(dst, src, kStride);
             RC::Unreal::FName cheatsName(STR("Cheats"), RC::Unreal::FNAME_Add);
-            std::memcpy(dst + s_off_uitName, &cheatsName, sizeof(RC::Unreal::FName));
+            std::memcpy(dst + off(Off::UitName), &cheatsName, sizeof(RC::Unreal::FName));
             FText cheatsDisplay(L"Cheats");
-            std::memcpy(dst + s_off_uitDisplayName, &cheatsDisplay, sizeof(FText));
+            std::memcpy(dst + off(Off::UitDisplayName), &cheatsDisplay, sizeof(FText));
             outArr->SetNum(n + 1, false);
 
             static int s_loggedTimes = 0;
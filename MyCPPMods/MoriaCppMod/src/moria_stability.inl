@@ -15,9 +15,20 @@
         static constexpr float AUDIT_LIGHT_MARGINAL_INTENSITY = 15000.0f;
         static constexpr float AUDIT_LIGHT_RADIUS              = 10.0f;
 
+        // Problems are merged on a grid before spawning markers (moria_grid_cluster.h).
+        static constexpr float AUDIT_CLUSTER_CELL   = 800.0f;   // 8 m
+        static constexpr int   AUDIT_MAX_CLUSTERS   = 24;
 
-        void spawnVfxAtLocation(UObject* worldContext, UObject* niagaraSystem,
-                                float x, float y, float z)
+        // Marker actors are pooled (moria_lru_pool.h): hidden on clear,
+        // moved and re-shown by the next audit. Cap: [Preferences] AuditPoolSize.
+        static constexpr int   AUDIT_POOL_DEFAULT   = 32;
+        static constexpr int   AUDIT_POOL_MAX       = 256;
+
+
+        // Returns the NiagaraComponent. Pooled markers pass autoDestroy=false
+        // so the component survives its one-shot and can be re-activated.
+        UObject* spawnVfxAtLocation(UObject* worldContext, UObject* niagaraSystem,
+                                    float x, float y, float z, bool autoDestroy = true)
         {
             static UFunction* s_fn = nullptr;
             static UObject* s_cdo = nullptr;
@@ -28,7 +39,7 @@
                 s_cdo = UObjectGlobals::StaticFindObject<UObject*>(
                     nullptr, nullptr, STR("/Script/Niagara.Default__NiagaraFunctionLibrary"));
             }
-            if (!s_fn || !s_cdo) return;
+            if (!s_fn || !s_cdo) return nullptr;
 
             static int s_parmsSize = -1;
             static int s_offWCO = -1, s_offSystem = -1, s_offLocation = -1;
@@ -55,7 +66,7 @@
                     else if (name == L"ReturnValue") s_offRet = off;
                 }
             }
-            if (s_offSystem < 0 || s_offLocation < 0) return;
+            if (s_offSystem < 0 || s_offLocation < 0) return nullptr;
 
             std::vector<uint8_t> buf(s_parmsSize, 0);
             if (s_offWCO >= 0) std::memcpy(buf.data() + s_offWCO, &worldContext, 8);
@@ -67,14 +78,15 @@
                 float scale[3] = {1.0f, 1.0f, 1.0f};
                 std::memcpy(buf.data() + s_offScale, scale, 12);
             }
-            if (s_offAutoDestroy >= 0) buf[s_offAutoDestroy] = 1;
+            if (s_offAutoDestroy >= 0) buf[s_offAutoDestroy] = autoDestroy ? 1 : 0;
             if (s_offAutoActivate >= 0) buf[s_offAutoActivate] = 1;
             safeProcessEvent(s_cdo, s_fn, buf.data());
+            return s_offRet >= 0 ? *reinterpret_cast<UObject**>(buf.data() + s_offRet) : nullptr;
         }
 
 
-        void spawnPointLightAtLocation(UObject* worldContext,
-                                       float x, float y, float z, bool critical)
+        // Spawns a bare PointLight actor; configureAuditLight() colours it.
+        UObject* spawnPointLightAtLocation(UObject* worldContext, float x, float y, float z)
         {
 
             static UFunction* s_spawnFn = nullptr;
@@ -103,12 +115,12 @@
                 if (!s_spawnFn || !s_gsCDO)
                 {
                     VLOG(STR("[MoriaCppMod] [STAB] BeginDeferredActorSpawnFromClass NOT FOUND\n"));
-                    return;
+                    return nullptr;
                 }
                 if (!s_lightClass)
                 {
                     VLOG(STR("[MoriaCppMod] [STAB] PointLight class NOT FOUND\n"));
-                    return;
+                    return nullptr;
                 }
 
                 s_spawnSize = s_spawnFn->GetPropertiesSize();
@@ -138,8 +150,8 @@
                 VLOG(STR("[MoriaCppMod] [STAB] SpawnFn: size={} wco={} cls={} xform={} ret={}\n"),
                      s_spawnSize, s_sWCO, s_sClass, s_sXform, s_sRet);
             }
-            if (!s_spawnFn || !s_gsCDO || !s_lightClass) return;
-            if (s_sClass < 0 || s_sXform < 0) return;
+            if (!s_spawnFn || !s_gsCDO || !s_lightClass) return nullptr;
+            if (s_sClass < 0 || s_sXform < 0) return nullptr;
 
 
             FTransformRaw xform{};
@@ -160,7 +172,7 @@
             if (!spawned)
             {
                 VLOG(STR("[MoriaCppMod] [STAB] PointLight spawn returned null\n"));
-                return;
+                return nullptr;
             }
 
             if (s_finishFn && s_fActor >= 0)
@@ -171,8 +183,13 @@
                     std::memcpy(finBuf.data() + s_fXform, &xform, 48);
                 safeProcessEvent(s_gsCDO, s_finishFn, finBuf.data());
             }
+            VLOG(STR("[MoriaCppMod] [STAB] PointLight spawned at ({:.0f},{:.0f},{:.0f})\n"), x, y, z);
+            return spawned;
+        }
 
 
+        void configureAuditLight(UObject* spawned, bool critical)
+        {
             {
                 static UFunction* s_setIntFn = nullptr;
                 static UFunction* s_setColorFn = nullptr;
@@ -266,33 +283,151 @@
                     safeProcessEvent(lightComp, s_setRadFn, b.data());
                 }
             }
+        }
 
-            m_auditSpawnedActors.push_back(RC::Unreal::FWeakObjectPtr(spawned));
-            VLOG(STR("[MoriaCppMod] [STAB] PointLight spawned at ({:.0f},{:.0f},{:.0f}) {}\n"),
-                 x, y, z, critical ? STR("CRITICAL/red") : STR("MARGINAL/yellow"));
+
+        // Calls a NewLocation/bTeleport setter (K2_SetActorLocation on the
+        // light actor, K2_SetWorldLocation on the Niagara component).
+        void teleportAuditObject(UObject* obj, const wchar_t* fnName, float x, float y, float z)
+        {
+            auto* fn = obj->GetFunctionByNameInChain(fnName);
+            if (!fn) return;
+            auto* pLoc = findParam(fn, STR("NewLocation"));
+            auto* pTeleport = findParam(fn, STR("bTeleport"));
+            if (!pLoc) return;
+            std::vector<uint8_t> buf(fn->GetParmsSize(), 0);
+            float loc[3] = {x, y, z};
+            std::memcpy(buf.data() + pLoc->GetOffset_Internal(), loc, 12);
+            if (pTeleport) buf[pTeleport->GetOffset_Internal()] = 1;
+            safeProcessEvent(obj, fn, buf.data());
         }
 
+        void setAuditActorHidden(UObject* actor, bool hidden)
+        {
+            auto* fn = actor->GetFunctionByNameInChain(STR("SetActorHiddenInGame"));
+            if (!fn) return;
+            std::vector<uint8_t> params(fn->GetParmsSize(), 0);
+            params[0] = hidden ? 1 : 0;
+            safeProcessEvent(actor, fn, params.data());
+        }
 
-        void destroyAuditActors()
+        // Activate(bReset) / Deactivate() on a pooled Niagara component.
+        void setAuditVfxActive(UObject* vfx, bool active)
         {
-            for (auto& weakActor : m_auditSpawnedActors)
+            auto* fn = vfx->GetFunctionByNameInChain(active ? STR("Activate") : STR("Deactivate"));
+            if (!fn) return;
+            std::vector<uint8_t> params(std::max(fn->GetParmsSize(), 1), 0);
+            if (active)
+                if (auto* pReset = findParam(fn, STR("bReset"))) params[pReset->GetOffset_Internal()] = 1;
+            safeProcessEvent(vfx, fn, params.data());
+        }
+
+
+        // One light (+ VFX when the manager has a StabilityLossVFX) from the
+        // pool: an idle or LRU-evicted slot is moved and re-shown, a new
+        // slot (or one whose actor died) is spawned.
+        void placeAuditMarker(UObject* pc, UObject* vfxSystem, float x, float y, float z, bool critical)
+        {
+            auto lease = m_auditPool.acquire();
+            if (lease.slot >= static_cast<int32_t>(m_auditMarkers.size()))
+                m_auditMarkers.resize(lease.slot + 1);
+            AuditMarker& marker = m_auditMarkers[lease.slot];
+
+            UObject* light = marker.light.Get();
+            if (light && isObjectAlive(light))
+            {
+                teleportAuditObject(light, STR("K2_SetActorLocation"), x, y, z);
+                setAuditActorHidden(light, false);
+            }
+            else
+            {
+                light = spawnPointLightAtLocation(pc, x, y, z);
+                marker.light = RC::Unreal::FWeakObjectPtr(light);
+            }
+            if (light) configureAuditLight(light, critical);
+
+            if (!vfxSystem) return;
+            UObject* vfx = marker.vfx.Get();
+            if (vfx && isObjectAlive(vfx))
+            {
+                teleportAuditObject(vfx, STR("K2_SetWorldLocation"), x, y, z);
+                setAuditVfxActive(vfx, true);
+            }
+            else
+            {
+                vfx = spawnVfxAtLocation(pc, vfxSystem, x, y, z, false);
+                marker.vfx = RC::Unreal::FWeakObjectPtr(vfx);
+            }
+        }
+
+
+        void destroyAuditMarker(AuditMarker& marker)
+        {
+            if (UObject* actor = marker.light.Get())
             {
-                UObject* actor = weakActor.Get();
-                if (!actor) continue;
                 auto* destroyFn = actor->GetFunctionByNameInChain(STR("K2_DestroyActor"));
                 if (destroyFn)
                     safeProcessEvent(actor, destroyFn, nullptr);
             }
-            if (!m_auditSpawnedActors.empty())
-                VLOG(STR("[MoriaCppMod] [STAB] Destroyed {} spawned actor(s)\n"),
-                     m_auditSpawnedActors.size());
-            m_auditSpawnedActors.clear();
+            if (UObject* vfx = marker.vfx.Get())
+            {
+                auto* destroyFn = vfx->GetFunctionByNameInChain(STR("K2_DestroyComponent"));
+                if (destroyFn)
+                {
+                    std::vector<uint8_t> params(std::max(destroyFn->GetParmsSize(), 1), 0);
+                    safeProcessEvent(vfx, destroyFn, params.data());
+                }
+            }
+            marker = AuditMarker{};
+        }
+
+
+        // Hide active markers and return them to the pool.
+        void releaseAuditMarkers()
+        {
+            int released = 0;
+            m_auditPool.releaseAll([&](int32_t slot) {
+                AuditMarker& marker = m_auditMarkers[slot];
+                if (UObject* light = marker.light.Get()) setAuditActorHidden(light, true);
+                if (UObject* vfx = marker.vfx.Get()) setAuditVfxActive(vfx, false);
+                released++;
+            });
+            if (released > 0)
+                VLOG(STR("[MoriaCppMod] [STAB] Released {} marker(s) to pool ({} pooled; {} spawned, {} reused, {} evicted)\n"),
+                     released, m_auditPool.size(), m_auditPool.spawns(), m_auditPool.reuses(), m_auditPool.evictions());
+        }
+
+
+        // Destroys every pooled actor (world teardown, pool shrink to 0).
+        void destroyAuditActors()
+        {
+            int destroyed = 0;
+            for (auto& marker : m_auditMarkers)
+            {
+                if (marker.light.Get() || marker.vfx.Get()) destroyed++;
+                destroyAuditMarker(marker);
+            }
+            if (destroyed > 0)
+                VLOG(STR("[MoriaCppMod] [STAB] Destroyed {} pooled marker(s)\n"), destroyed);
+            m_auditMarkers.clear();
+            m_auditPool.clear();
+        }
+
+
+        void setAuditPoolSize(int size)
+        {
+            size = std::clamp(size, 1, AUDIT_POOL_MAX);
+            m_auditPool.setCapacity(size, [&](int32_t slot) {
+                if (slot < static_cast<int32_t>(m_auditMarkers.size())) destroyAuditMarker(m_auditMarkers[slot]);
+            });
+            if (static_cast<int32_t>(m_auditMarkers.size()) > m_auditPool.size())
+                m_auditMarkers.resize(m_auditPool.size());
         }
 
 
         void clearStabilityHighlights()
         {
-            destroyAuditActors();
+            releaseAuditMarkers();
             if (!m_auditLocations.empty())
                 VLOG(STR("[MoriaCppMod] [STAB] Audit cleared ({} locations)\n"),
                      m_auditLocations.size());
@@ -301,6 +436,101 @@
         }
 
 
+        UObject* findConstructionManager()
+        {
+            std::vector<UObject*> mgrs;
+            findAllOfSafe(STR("MorConstructionManager"), mgrs);
+            for (auto* m : mgrs)
+            {
+                if (!m) continue;
+                std::wstring name(m->GetName());
+                if (name.find(L"Default__") == std::wstring::npos)
+                    return m;
+            }
+            return nullptr;
+        }
+
+
+        // AllStabilityComponents as {data, num}; false if unreadable.
+        bool readStabilityComponents(UObject* mgr, UObject**& data, int32_t& num)
+        {
+            static int s_offAllComps = -2;
+            if (resolveOffset(mgr, L"AllStabilityComponents", s_offAllComps) < 0) return false;
+            auto* arr = reinterpret_cast<uint8_t*>(mgr) + s_offAllComps;
+            if (!isReadableMemory(arr, 16)) return false;
+            data = *reinterpret_cast<UObject***>(arr);
+            num = *reinterpret_cast<int32_t*>(arr + 8);
+            return data && num > 0;
+        }
+
+
+        // Field offsets resolve once per process (and persist in offsets.cache);
+        // scans are then plain loads per component.
+        bool ensureStabilityOffsets(UObject** arrData, int32_t arrNum)
+        {
+            UObject* firstComp = nullptr;
+            for (int32_t i = 0; i < arrNum && !firstComp; i++) firstComp = arrData[i];
+            confirmCachedProbe(s_off_stabStability, firstComp);
+            if (s_off_stabStability >= 0) return true;
+            if (!firstComp) return false;
+            resolveOffset(firstComp, L"State", s_off_stabState);
+            resolveOffset(firstComp, L"Stability", s_off_stabStability);
+            resolveOffset(firstComp, L"OwnerPrivate", s_off_compOwner);
+            if (s_off_stabStability < 0)
+            {
+                VLOG(STR("[MoriaCppMod] [STAB] ERROR: Stability property not found on {}\n"),
+                     firstComp->GetClassPrivate()->GetName());
+                return false;
+            }
+            return true;
+        }
+
+
+        StabBand classifyStabilityComponent(UObject* comp, float& stability)
+        {
+            auto* base = reinterpret_cast<uint8_t*>(comp);
+            uint8_t state = s_off_stabState >= 0 ? base[s_off_stabState] : 0;
+            stability = *reinterpret_cast<float*>(base + s_off_stabStability);
+
+            if (state == STAB_DECONSTRUCTED || state == STAB_UNINITIALIZED || state == STAB_INITIALIZING)
+                return StabBand::Ignored;
+            if (state == STAB_UNSTABLE || stability <= THRESHOLD_CRITICAL)
+                return StabBand::Critical;
+            if (state == STAB_PROVISIONAL)
+                return StabBand::Provisional;
+            if (stability <= THRESHOLD_MARGINAL)
+                return StabBand::Marginal;
+            return StabBand::Stable;
+        }
+
+
+        // Owner from OwnerPrivate (GetOwner if that didn't resolve), then one
+        // K2_GetActorLocation call.
+        bool stabilityComponentLocation(UObject* comp, FVec3f& loc)
+        {
+            static UFunction* s_getOwnerFn = nullptr;
+            static UFunction* s_getLocFn = nullptr;
+            UObject* owner = nullptr;
+            if (s_off_compOwner >= 0)
+                owner = *reinterpret_cast<UObject**>(reinterpret_cast<uint8_t*>(comp) + s_off_compOwner);
+            else
+            {
+                if (!s_getOwnerFn) s_getOwnerFn = comp->GetFunctionByNameInChain(STR("GetOwner"));
+                if (!s_getOwnerFn) return false;
+                struct { UObject* Ret{nullptr}; } op{};
+                safeProcessEvent(comp, s_getOwnerFn, &op);
+                owner = op.Ret;
+            }
+            if (!owner || !isObjectAlive(owner)) return false;
+
+            if (!s_getLocFn) s_getLocFn = owner->GetFunctionByNameInChain(STR("K2_GetActorLocation"));
+            if (!s_getLocFn) return false;
+            loc = {0, 0, 0};
+            safeProcessEvent(owner, s_getLocFn, &loc);
+            return true;
+        }
+
+
         void runStabilityAudit()
         {
             clearStabilityHighlights();
@@ -308,21 +538,7 @@
             VLOG(STR("[MoriaCppMod] [STAB] === Stability Audit ===\n"));
 
 
-            UObject* mgr = nullptr;
-            {
-                std::vector<UObject*> mgrs;
-                findAllOfSafe(STR("MorConstructionManager"), mgrs);
-                for (auto* m : mgrs)
-                {
-                    if (!m) continue;
-                    std::wstring name(m->GetName());
-                    if (name.find(L"Default__") == std::wstring::npos)
-                    {
-                        mgr = m;
-                        break;
-                    }
-                }
-            }
+            UObject* mgr = findConstructionManager();
             if (!mgr)
             {
                 VLOG(STR("[MoriaCppMod] [STAB] ERROR: no construction manager found\n"));
@@ -334,21 +550,20 @@
             UObject* stabilityVfx = vfxPtr ? *static_cast<UObject**>(vfxPtr) : nullptr;
 
 
-            void* arrPtr = mgr->GetValuePtrByPropertyNameInChain(STR("AllStabilityComponents"));
-            if (!arrPtr || !isReadableMemory(arrPtr, 16)) return;
-
-            UObject** arrData = *reinterpret_cast<UObject***>(arrPtr);
-            int32_t arrNum = *reinterpret_cast<int32_t*>(reinterpret_cast<uint8_t*>(arrPtr) + 8);
+            UObject** arrData = nullptr;
+            int32_t arrNum = 0;
+            if (!readStabilityComponents(mgr, arrData, arrNum)) return;
             VLOG(STR("[MoriaCppMod] [STAB] Scanning {} stability components\n"), arrNum);
-            if (arrNum <= 0 || !arrData) return;
 
             auto* pc = findPlayerController();
             FVec3f playerLoc = getPawnLocation();
 
-            int countStable = 0, countMarginal = 0, countCritical = 0;
+            using Clock = std::chrono::steady_clock;
+            auto tStart = Clock::now();
+            if (!ensureStabilityOffsets(arrData, arrNum)) return;
 
-            struct ProblemInfo { UObject* actor; float stability; uint8_t state; float x, y, z; };
-            std::vector<ProblemInfo> problems;
+            int countStable = 0, countMarginal = 0, countCritical = 0;
+            std::vector<ClusterPoint> problems;
 
 
             for (int32_t i = 0; i < arrNum; i++)
@@ -356,43 +571,22 @@
                 UObject* comp = arrData[i];
                 if (!comp) continue;
 
-                void* statePtr = comp->GetValuePtrByPropertyNameInChain(STR("State"));
-                void* stabPtr = comp->GetValuePtrByPropertyNameInChain(STR("Stability"));
-                if (!stabPtr) continue;
+                float stability = 0;
+                StabBand band = classifyStabilityComponent(comp, stability);
+                if (band == StabBand::Ignored) continue;
+                if (band == StabBand::Stable) { countStable++; continue; }
+                if (band == StabBand::Critical) countCritical++;
+                else countMarginal++;
 
-                uint8_t state = statePtr ? *static_cast<uint8_t*>(statePtr) : 0;
-                float stability = *static_cast<float*>(stabPtr);
-
-                if (state == STAB_DECONSTRUCTED || state == STAB_UNINITIALIZED || state == STAB_INITIALIZING)
-                    continue;
-
-                bool isProblem = false;
-                if (state == STAB_UNSTABLE || stability <= THRESHOLD_CRITICAL)
-                    { countCritical++; isProblem = true; }
-                else if (state == STAB_PROVISIONAL || stability <= THRESHOLD_MARGINAL)
-                    { countMarginal++; isProblem = true; }
-                else
-                    countStable++;
-
-                if (isProblem)
-                {
-                    auto* ownerFunc = comp->GetFunctionByNameInChain(STR("GetOwner"));
-                    if (!ownerFunc) continue;
-                    struct { UObject* Ret{nullptr}; } op{};
-                    safeProcessEvent(comp, ownerFunc, &op);
-                    if (!op.Ret) continue;
-
-                    FVec3f loc{0, 0, 0};
-                    auto* locFunc = op.Ret->GetFunctionByNameInChain(STR("K2_GetActorLocation"));
-                    if (locFunc) safeProcessEvent(op.Ret, locFunc, &loc);
-
-                    problems.push_back({op.Ret, stability, state, loc.X, loc.Y, loc.Z});
-                }
+                FVec3f loc{};
+                if (!stabilityComponentLocation(comp, loc)) continue;
+                problems.push_back({loc.X, loc.Y, loc.Z, band == StabBand::Critical, stability});
             }
+            double scanMs = std::chrono::duration<double, std::milli>(Clock::now() - tStart).count();
 
             int totalChecked = countStable + countMarginal + countCritical;
-            VLOG(STR("[MoriaCppMod] [STAB] {} checked ({} stable, {} marginal, {} critical)\n"),
-                 totalChecked, countStable, countMarginal, countCritical);
+            VLOG(STR("[MoriaCppMod] [STAB] {} checked ({} stable, {} marginal, {} critical) in {:.2f} ms\n"),
+                 totalChecked, countStable, countMarginal, countCritical, scanMs);
 
             if (problems.empty())
             {
@@ -400,27 +594,122 @@
                 return;
             }
 
+            auto tCluster = Clock::now();
+            GridClusterResult grid = clusterOnGrid(problems, AUDIT_CLUSTER_CELL, AUDIT_MAX_CLUSTERS);
+            double clusterMs = std::chrono::duration<double, std::milli>(Clock::now() - tCluster).count();
 
-            for (auto& p : problems)
+            auto tSpawn = Clock::now();
+            for (auto& c : grid.clusters)
             {
-                float dx = p.x - playerLoc.X, dy = p.y - playerLoc.Y, dz = p.z - playerLoc.Z;
+                float dx = c.x - playerLoc.X, dy = c.y - playerLoc.Y, dz = c.z - playerLoc.Z;
                 float dist = std::sqrt(dx*dx + dy*dy + dz*dz) / 100.0f;
-                bool isCritical = (p.state == STAB_UNSTABLE || p.stability <= THRESHOLD_CRITICAL);
-                const wchar_t* label = isCritical ? L"CRITICAL" : L"MARGINAL";
-                VLOG(STR("[MoriaCppMod] [STAB]   {} stab={:.1f} dist={:.0f}m at ({:.0f},{:.0f},{:.0f})\n"),
-                     label, p.stability, dist, p.x, p.y, p.z);
+                const wchar_t* label = c.critical() ? L"CRITICAL" : L"MARGINAL";
+                VLOG(STR("[MoriaCppMod] [STAB]   {} x{} ({} critical) min stab={:.1f} dist={:.0f}m at ({:.0f},{:.0f},{:.0f})\n"),
+                     label, c.count, c.criticalCount, c.minStability, dist, c.x, c.y, c.z);
 
-                if (stabilityVfx && pc)
-                    spawnVfxAtLocation(pc, stabilityVfx, p.x, p.y, p.z);
-
-                m_auditLocations.push_back({p.x, p.y, p.z, isCritical});
+                m_auditLocations.push_back({c.x, c.y, c.z, c.critical()});
 
                 if (pc)
-                    spawnPointLightAtLocation(pc, p.x, p.y, p.z, isCritical);
+                    placeAuditMarker(pc, stabilityVfx, c.x, c.y, c.z, c.critical());
             }
+            double spawnMs = std::chrono::duration<double, std::milli>(Clock::now() - tSpawn).count();
 
-            VLOG(STR("[MoriaCppMod] [STAB] {} PointLight(s) + VFX spawned\n"), problems.size());
+            VLOG(STR("[MoriaCppMod] [STAB] {} problem(s) -> {} cluster(s) (cell {:.0f}m, {} merge pass(es)); "
+                     "scan {:.2f} ms, cluster {:.2f} ms, spawn {:.2f} ms\n"),
+                 problems.size(), grid.clusters.size(), grid.cellSize / 100.0f, grid.merges,
+                 scanMs, clusterMs, spawnMs);
 
 
             m_auditClearTime = GetTickCount64() + 10000;
         }
+
+
+        // ---- Continuous monitor (modifier + Integrity Check) ----
+
+        static constexpr double MONITOR_BUDGET_MS          = 0.5;
+        static constexpr int    MONITOR_MAX_PER_FRAME      = 2000;
+        static constexpr int    MONITOR_MAX_HIGHLIGHTS     = 4;      // per frame; the rest are only counted
+
+        void publishStabilityCounts()
+        {
+            int marginal = m_stabMonitorEnabled ? m_stabMonitor.count(StabBand::Marginal) : -1;
+            int critical = m_stabMonitorEnabled ? m_stabMonitor.count(StabBand::Critical) : -1;
+            bool changed = s_overlay.stabMarginal.exchange(marginal) != marginal;
+            changed |= s_overlay.stabCritical.exchange(critical) != critical;
+            if (changed) s_overlay.requestUpdate();
+        }
+
+        void toggleStabilityMonitor()
+        {
+            m_stabMonitorEnabled = !m_stabMonitorEnabled;
+            m_stabMonitor.clear();
+            m_stabMonitorMgr = RC::Unreal::FWeakObjectPtr();
+            publishStabilityCounts();
+            showOnScreen(m_stabMonitorEnabled ? L"Stability monitor ON" : L"Stability monitor OFF",
+                         2.0f, 0.3f, 1.0f, 0.3f);
+            VLOG(STR("[MoriaCppMod] [STAB] Continuous monitor {}\n"), m_stabMonitorEnabled ? STR("enabled") : STR("disabled"));
+            saveConfig();
+        }
+
+        // Per-frame slice of AllStabilityComponents under MONITOR_BUDGET_MS.
+        // Highlights (light + VFX, cleared by the audit timer) only for pieces
+        // that get worse than their last-known band.
+        void tickStabilityMonitor()
+        {
+            if (!m_stabMonitorEnabled) return;
+
+            UObject* mgr = m_stabMonitorMgr.Get();
+            if (!mgr)
+            {
+                if (!intervalElapsed(m_stabMonitorLastFind, 5000)) return;
+                mgr = findConstructionManager();
+                if (!mgr) return;
+                m_stabMonitorMgr = RC::Unreal::FWeakObjectPtr(mgr);
+                m_stabMonitor.clear();
+            }
+
+            UObject** arrData = nullptr;
+            int32_t arrNum = 0;
+            if (!readStabilityComponents(mgr, arrData, arrNum)) arrNum = 0;
+            if (arrNum > 0 && !ensureStabilityOffsets(arrData, arrNum)) return;
+
+            using Clock = std::chrono::steady_clock;
+            auto deadline = Clock::now() + std::chrono::duration<double, std::milli>(MONITOR_BUDGET_MS);
+            m_stabCrossings.clear();
+            uint32_t sweepsBefore = m_stabMonitor.sweeps();
+            m_stabMonitor.step(arrNum, MONITOR_MAX_PER_FRAME,
+                [&](int32_t i) {
+                    UObject* comp = arrData[i];
+                    if (!comp) return StabilitySample{0, StabBand::Unknown, 0.0f};
+                    float stability = 0;
+                    StabBand band = classifyStabilityComponent(comp, stability);
+                    return StabilitySample{reinterpret_cast<uint64_t>(comp), band, stability};
+                },
+                [&] { return Clock::now() >= deadline; },
+                m_stabCrossings);
+
+            int highlighted = 0;
+            for (auto& c : m_stabCrossings)
+            {
+                if (!c.worsened()) continue;
+                bool critical = c.to == StabBand::Critical;
+                VLOG(STR("[MoriaCppMod] [STAB] Monitor: component #{} {} -> {} (stab={:.1f})\n"),
+                     c.index, stabBandName(c.from), stabBandName(c.to), c.stability);
+                if (highlighted >= MONITOR_MAX_HIGHLIGHTS) continue;
+                FVec3f loc{};
+                auto* pc = findPlayerController();
+                if (!pc || !stabilityComponentLocation(reinterpret_cast<UObject*>(c.id), loc)) continue;
+                void* vfxPtr = mgr->GetValuePtrByPropertyNameInChain(STR("StabilityLossVFX"));
+                UObject* vfx = vfxPtr ? *static_cast<UObject**>(vfxPtr) : nullptr;
+                placeAuditMarker(pc, vfx, loc.X, loc.Y, loc.Z, critical);
+                m_auditLocations.push_back({loc.X, loc.Y, loc.Z, critical});
+                m_auditClearTime = GetTickCount64() + 10000;
+                highlighted++;
+            }
+
+            if (m_stabMonitor.sweeps() != sweepsBefore)
+                VLOG(STR("[MoriaCppMod] [STAB] Monitor sweep {}: {} components, {} marginal, {} critical\n"),
+                     m_stabMonitor.sweeps(), arrNum,
+                     m_stabMonitor.count(StabBand::Marginal), m_stabMonitor.count(StabBand::Critical));
+            publishStabilityCounts();
+        }
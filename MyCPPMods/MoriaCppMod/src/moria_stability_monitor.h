@@ -0,0 +1,140 @@
+
+
+
+#pragma once
+#ifndef MORIA_STABILITY_MONITOR_H
+#define MORIA_STABILITY_MONITOR_H
+
+#include <cstdint>
+#include <vector>
+
+// Sliced, continuous stability sweep over AllStabilityComponents that
+// reports only band changes.
+
+namespace MoriaMods
+{
+
+    // Ordered by severity; Unknown = not sampled yet. Provisional = placed
+    // but not yet settled by the game.
+    enum class StabBand : uint8_t { Unknown, Ignored, Provisional, Stable, Marginal, Critical, Count };
+
+    inline const wchar_t* stabBandName(StabBand b)
+    {
+        switch (b)
+        {
+        case StabBand::Ignored: return L"ignored";
+        case StabBand::Provisional: return L"provisional";
+        case StabBand::Stable: return L"stable";
+        case StabBand::Marginal: return L"MARGINAL";
+        case StabBand::Critical: return L"CRITICAL";
+        default: return L"unknown";
+        }
+    }
+
+    struct StabilitySample
+    {
+        uint64_t id;           // component identity (pointer); 0 = empty slot
+        StabBand band;
+        float stability;
+    };
+
+    class StabilityMonitor
+    {
+      public:
+        struct Crossing
+        {
+            int32_t index;
+            uint64_t id;
+            StabBand from;
+            StabBand to;
+            float stability;
+            bool worsened() const { return from >= StabBand::Stable && to > from && to >= StabBand::Marginal; }
+        };
+
+        static constexpr int kBudgetCheckEvery = 32;
+
+        // Sample up to maxItems slots from the cursor, wrapping at
+        // numElements. `probe(idx)` returns a StabilitySample;
+        // `budgetSpent()` is polled every kBudgetCheckEvery items and ends
+        // the step early. Band changes are appended to `out`. Returns the
+        // number of slots sampled.
+
+        template <typename Probe, typename Spent>
+        int step(int32_t numElements, int maxItems, Probe&& probe, Spent&& budgetSpent, std::vector<Crossing>& out)
+        {
+            resize(numElements);
+            if (numElements <= 0) return 0;
+            int sampled = 0;
+            while (sampled < maxItems && sampled < numElements)
+            {
+                if (sampled > 0 && sampled % kBudgetCheckEvery == 0 && budgetSpent()) break;
+                int32_t i = m_cursor;
+                StabilitySample s = probe(i);
+                if (s.id == 0) s.band = StabBand::Unknown;
+                StabBand old = m_bands[i];
+                // A new occupant, a first sample, or a piece leaving
+                // Ignored/Provisional is a baseline only.
+                bool baseline = (s.id != m_ids[i]) || old < StabBand::Stable;
+                m_ids[i] = s.id;
+                if (old != s.band)
+                {
+                    m_counts[static_cast<size_t>(old)]--;
+                    m_counts[static_cast<size_t>(s.band)]++;
+                    m_bands[i] = s.band;
+                    if (!baseline && s.band != StabBand::Unknown)
+                        out.push_back({i, s.id, old, s.band, s.stability});
+                }
+                sampled++;
+                if (++m_cursor >= numElements)
+                {
+                    m_cursor = 0;
+                    m_sweeps++;
+                }
+            }
+            return sampled;
+        }
+
+        int count(StabBand b) const { return m_counts[static_cast<size_t>(b)]; }
+        int32_t cursor() const { return m_cursor; }
+        uint32_t sweeps() const { return m_sweeps; }
+        int32_t size() const { return static_cast<int32_t>(m_bands.size()); }
+
+        void clear()
+        {
+            m_ids.clear();
+            m_bands.clear();
+            for (auto& c : m_counts) c = 0;
+            m_cursor = 0;
+            m_sweeps = 0;
+        }
+
+      private:
+        void resize(int32_t n)
+        {
+            if (n < 0) n = 0;
+            int32_t cur = size();
+            if (n < cur)
+            {
+                for (int32_t i = n; i < cur; i++) m_counts[static_cast<size_t>(m_bands[i])]--;
+                m_ids.resize(n);
+                m_bands.resize(n);
+            }
+            else if (n > cur)
+            {
+                m_ids.resize(n, 0);
+                m_bands.resize(n, StabBand::Unknown);
+                m_counts[static_cast<size_t>(StabBand::Unknown)] += n - cur;
+            }
+            if (m_cursor >= n) m_cursor = 0;
+        }
+
+        std::vector<uint64_t> m_ids;
+        std::vector<StabBand> m_bands;
+        int m_counts[static_cast<size_t>(StabBand::Count)]{};
+        int32_t m_cursor{0};
+        uint32_t m_sweeps{0};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_STABILITY_MONITOR_H
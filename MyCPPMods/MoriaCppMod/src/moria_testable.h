@@ -11,6 +11,7 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -23,6 +24,8 @@
 #endif
 #include <Windows.h>
 
+#include "moria_ini.h"
+
 namespace MoriaMods
 {
 
@@ -358,7 +361,7 @@ namespace MoriaMods
             s_table["msg.remove_attrs_disabled"] = L"Remove Attributes is disabled (enable in F12 settings)";
             s_table["msg.trash_disabled"] = L"Trash Item is disabled (enable in F12 settings)";
             s_table["msg.no_definition_packs"] = L"No definition packs found";
-            s_table["msg.game_mods_restart_notice"] = L"Changes take effect on next game launch";
+            s_table["msg.game_mods_restart_notice"] = L"Changes apply in-world; new rows need a restart";
             s_table["msg.settings_closed"] = L"Settings panel closed";
             s_table["msg.settings_opened"] = L"Settings panel opened";
             s_table["msg.ab_toolbar_created"] = L"Advanced Builder toolbar created!";
@@ -705,63 +708,6 @@ namespace MoriaMods
     }
 
 
-    struct ParsedIniSection
-    {
-        std::string name;
-    };
-    struct ParsedIniKeyValue
-    {
-        std::string key;
-        std::string value;
-    };
-    using ParsedIniLine = std::variant<std::monostate, ParsedIniSection, ParsedIniKeyValue>;
-
-
-    static std::string trimStr(const std::string& s)
-    {
-        size_t start = s.find_first_not_of(" \t\r\n");
-        if (start == std::string::npos) return "";
-        size_t end = s.find_last_not_of(" \t\r\n");
-        return s.substr(start, end - start + 1);
-    }
-
-
-    static ParsedIniLine parseIniLine(const std::string& line)
-    {
-        std::string trimmed = trimStr(line);
-        if (trimmed.empty() || trimmed[0] == ';' || trimmed[0] == '#')
-            return std::monostate{};
-
-
-        if (trimmed.front() == '[' && trimmed.back() == ']')
-        {
-            std::string name = trimStr(trimmed.substr(1, trimmed.size() - 2));
-            if (!name.empty()) return ParsedIniSection{name};
-            return std::monostate{};
-        }
-
-
-        auto eq = trimmed.find('=');
-        if (eq == std::string::npos) return std::monostate{};
-
-        std::string key = trimStr(trimmed.substr(0, eq));
-        std::string value = trimStr(trimmed.substr(eq + 1));
-
-
-        for (size_t i = 1; i < value.size(); i++)
-        {
-            if (value[i] == ';' && value[i - 1] == ' ')
-            {
-                value = trimStr(value.substr(0, i - 1));
-                break;
-            }
-        }
-
-        if (!key.empty()) return ParsedIniKeyValue{key, value};
-        return std::monostate{};
-    }
-
-
     static const char* bindIndexToIniKey(int idx)
     {
         static const char* keys[BIND_COUNT] = {
@@ -796,15 +742,6 @@ namespace MoriaMods
     }
 
 
-    static bool strEqualCI(const std::string& a, const std::string& b)
-    {
-        if (a.size() != b.size()) return false;
-        for (size_t i = 0; i < a.size(); i++)
-            if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i])))
-                return false;
-        return true;
-    }
-
     static int iniKeyToBindIndex(const std::string& key)
     {
         for (int i = 0; i < BIND_COUNT; i++)
@@ -943,6 +880,72 @@ namespace MoriaMods
     }
 
 
+    // One resolved definition-pack operation recorded by a dry run.
+    // oldValue is the live ExportText of the field; newValue is what the
+    // pack would write. status is "ok" or a short reason the op would fail.
+    struct DefDiffEntry
+    {
+        std::string pack;
+        std::string op;         // change | delete | add_row
+        std::string table;
+        std::string row;
+        std::string property;
+        std::string oldValue;
+        std::string newValue;
+        std::string status;
+    };
+
+    // RFC 4180 field quoting: wrap in quotes only when the field contains a
+    // separator, quote or line break; embedded quotes are doubled.
+    static std::string csvEscape(const std::string& s)
+    {
+        if (s.find_first_of(",\"\r\n") == std::string::npos) return s;
+        std::string out;
+        out.reserve(s.size() + 4);
+        out += '"';
+        for (char c : s)
+        {
+            if (c == '"') out += '"';
+            out += c;
+        }
+        out += '"';
+        return out;
+    }
+
+    static std::string formatDefDiffCsv(const std::vector<DefDiffEntry>& entries)
+    {
+        std::string out = "pack,op,table,row,property,old,new,status\n";
+        for (auto& e : entries)
+        {
+            out += csvEscape(e.pack) + ',' + csvEscape(e.op) + ',' + csvEscape(e.table) + ',' +
+                   csvEscape(e.row) + ',' + csvEscape(e.property) + ',' + csvEscape(e.oldValue) + ',' +
+                   csvEscape(e.newValue) + ',' + csvEscape(e.status) + '\n';
+        }
+        return out;
+    }
+
+    // JSON array, one object per line so the output stays diffable.
+    static std::string formatDefDiffJson(const std::vector<DefDiffEntry>& entries)
+    {
+        std::string out = "[\n";
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            auto& e = entries[i];
+            out += "{\"pack\":\"" + RemovalJson::escape(e.pack) +
+                   "\",\"op\":\"" + RemovalJson::escape(e.op) +
+                   "\",\"table\":\"" + RemovalJson::escape(e.table) +
+                   "\",\"row\":\"" + RemovalJson::escape(e.row) +
+                   "\",\"property\":\"" + RemovalJson::escape(e.property) +
+                   "\",\"old\":\"" + RemovalJson::escape(e.oldValue) +
+                   "\",\"new\":\"" + RemovalJson::escape(e.newValue) +
+                   "\",\"status\":\"" + RemovalJson::escape(e.status) + "\"}";
+            out += (i + 1 < entries.size()) ? ",\n" : "\n";
+        }
+        out += "]\n";
+        return out;
+    }
+
+
     static ParsedRemovalLine parseRemovalLine(const std::string& line)
     {
         if (line.empty() || line[0] == '#') return std::monostate{};
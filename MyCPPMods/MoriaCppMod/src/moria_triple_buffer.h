@@ -0,0 +1,86 @@
+
+
+
+#pragma once
+#ifndef MORIA_TRIPLE_BUFFER_H
+#define MORIA_TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-writer / single-reader hand-off of a value snapshot.
+// Three buffers: the writer fills its back buffer and publish() exchanges
+// it with the shared middle one; the reader's refresh() exchanges the
+// middle with its front buffer only if something newer was published.
+// Each side only ever touches its own buffer, so neither blocks the other,
+// a read never sees a half-written value, and reading front() copies and
+// allocates nothing. Intermediate values the reader never picked up are
+// simply overwritten (latest wins).
+//
+// T is copy-assigned into the back buffer on publish, so buffers that
+// hold strings keep their capacity and steady-state publishes stop
+// allocating too. Replaces the overlay's CRITICAL_SECTION-guarded slot
+// copy (every overlay frame copied all slot strings under the lock).
+//
+// Pure (no Win32): tested in tests/test_triple_buffer.cpp.
+
+namespace MoriaMods
+{
+
+    template <typename T>
+    class TripleBuffer
+    {
+      public:
+        TripleBuffer() = default;
+        explicit TripleBuffer(const T& initial) : m_buf{{initial, 0}, {initial, 0}, {initial, 0}} {}
+
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+        // ---- writer thread ----
+
+        void publish(const T& value)
+        {
+            m_buf[m_back].value = value;
+            m_buf[m_back].sequence = ++m_published;
+            m_back = m_middle.exchange(uint8_t(m_back | kFresh), std::memory_order_acq_rel) & kIndex;
+        }
+
+        uint64_t published() const { return m_published; }
+
+        // ---- reader thread ----
+
+        // Adopt the newest published value; false = nothing new since the
+        // last refresh (front() unchanged).
+        bool refresh()
+        {
+            if (!(m_middle.load(std::memory_order_relaxed) & kFresh)) return false;
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & kIndex;
+            return true;
+        }
+
+        const T& front() const { return m_buf[m_front].value; }
+
+        // Publish count of front() (0 = the initial value).
+        uint64_t sequence() const { return m_buf[m_front].sequence; }
+
+      private:
+        static constexpr uint8_t kIndex = 0x3;
+        static constexpr uint8_t kFresh = 0x4;
+
+        struct Slot
+        {
+            T value{};
+            uint64_t sequence{0};
+        };
+
+        Slot m_buf[3]{};
+        uint8_t m_back{0};                 // writer-owned
+        uint8_t m_front{1};                // reader-owned
+        std::atomic<uint8_t> m_middle{2};  // index | kFresh
+        uint64_t m_published{0};           // writer-owned
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_TRIPLE_BUFFER_H
@@ -0,0 +1,254 @@
+
+
+
+
+        // ── UMG icon atlas ──────────────────────────────────────────────
+        // The New Building Bar's slot glyphs (empty / focused / corners,
+        // key rect, numbered markers) and its eight recipe icons are drawn
+        // into one RGBA8 render target; every UImage points its brush at
+        // that target and selects its sub-rect through FSlateBrush::UVRegion.
+        // Slate then sees a single texture resource for the whole bar, so
+        // the slots batch into few draw elements instead of one per distinct
+        // texture, and changing a recipe icon redraws its rect in the atlas
+        // rather than rebinding a brush on the slot image.
+        //
+        // Layout comes from AtlasLayout (moria_atlas_pack.h); icon rects
+        // exist for all eight slots whether assigned or not, so the layout
+        // (and every bound UVRegion) survives icon changes. Callers fall back
+        // to umgSetBrush when the atlas could not be built.
+
+        // Same texture at the same display size shares one atlas rect.
+        static std::wstring uiAtlasGlyphKey(UObject* tex, float w, float h)
+        {
+            std::wstring name;
+            try { name = tex->GetName(); } catch (...) {}
+            return name + L"@" + std::to_wstring(int(w)) + L"x" + std::to_wstring(int(h));
+        }
+
+        static std::wstring uiAtlasIconKey(int slot) { return L"icon" + std::to_wstring(slot); }
+
+        bool uiAtlasReady() const
+        {
+            return m_uiAtlasLayout.ok() && m_uiAtlasRT && isObjectAlive(m_uiAtlasRT);
+        }
+
+        // (Re)build the atlas for `items`, drawing sources[i] into item i's
+        // rect (null = leave the rect transparent). With an unchanged item
+        // list and a live target, only rects whose source changed are
+        // redrawn; otherwise the target is re-packed, recreated if its size
+        // changed, and cleared.
+        bool buildUiAtlas(const std::vector<AtlasItem>& items, const std::vector<UObject*>& sources)
+        {
+            if (items.size() != sources.size()) return false;
+            bool relayout = !m_uiAtlasLayout.sameItems(items) || !m_uiAtlasRT || !isObjectAlive(m_uiAtlasRT);
+
+            std::vector<size_t> dirty;
+            for (size_t i = 0; i < items.size(); i++)
+                if (relayout || i >= m_uiAtlasSources.size() || m_uiAtlasSources[i] != sources[i])
+                    if (sources[i] || !relayout) dirty.push_back(i);
+            if (!relayout && dirty.empty()) return true;
+
+            auto* createRTFn = UObjectGlobals::StaticFindObject<UFunction*>(
+                    nullptr, nullptr, STR("/Script/Engine.KismetRenderingLibrary:CreateRenderTarget2D"));
+            auto* clearRTFn = UObjectGlobals::StaticFindObject<UFunction*>(
+                    nullptr, nullptr, STR("/Script/Engine.KismetRenderingLibrary:ClearRenderTarget2D"));
+            auto* beginDrawFn = UObjectGlobals::StaticFindObject<UFunction*>(
+                    nullptr, nullptr, STR("/Script/Engine.KismetRenderingLibrary:BeginDrawCanvasToRenderTarget"));
+            auto* endDrawFn = UObjectGlobals::StaticFindObject<UFunction*>(
+                    nullptr, nullptr, STR("/Script/Engine.KismetRenderingLibrary:EndDrawCanvasToRenderTarget"));
+            auto* drawTexFn = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/Engine.Canvas:K2_DrawTexture"));
+            auto* krlClass = UObjectGlobals::StaticFindObject<UClass*>(nullptr, nullptr, STR("/Script/Engine.KismetRenderingLibrary"));
+            UObject* krlCDO = krlClass ? krlClass->GetClassDefaultObject() : nullptr;
+            UObject* worldCtx = findPlayerController();
+            if (!createRTFn || !clearRTFn || !beginDrawFn || !endDrawFn || !drawTexFn || !krlCDO || !worldCtx)
+            {
+                VLOG(STR("[MoriaCppMod] [Atlas] render-target functions unavailable, using per-texture brushes\n"));
+                m_uiAtlasLayout = {};
+                return false;
+            }
+
+            if (relayout)
+            {
+                AtlasLayout layout = AtlasLayout::pack(items);
+                if (!layout.ok())
+                {
+                    VLOG(STR("[MoriaCppMod] [Atlas] {} items do not fit a 2048 atlas\n"), items.size());
+                    m_uiAtlasLayout = {};
+                    return false;
+                }
+                bool sizeChanged = layout.width() != m_uiAtlasLayout.width() || layout.height() != m_uiAtlasLayout.height();
+                if (sizeChanged || !m_uiAtlasRT || !isObjectAlive(m_uiAtlasRT))
+                {
+                    std::vector<uint8_t> params(createRTFn->GetParmsSize(), 0);
+                    auto* pWC = findParam(createRTFn, STR("WorldContextObject"));
+                    auto* pW = findParam(createRTFn, STR("Width"));
+                    auto* pH = findParam(createRTFn, STR("Height"));
+                    auto* pF = findParam(createRTFn, STR("Format"));
+                    auto* pC = findParam(createRTFn, STR("ClearColor"));
+                    auto* pRV = findParam(createRTFn, STR("ReturnValue"));
+                    if (!pWC || !pRV) return false;
+                    *reinterpret_cast<UObject**>(params.data() + pWC->GetOffset_Internal()) = worldCtx;
+                    if (pW) *reinterpret_cast<int32_t*>(params.data() + pW->GetOffset_Internal()) = layout.width();
+                    if (pH) *reinterpret_cast<int32_t*>(params.data() + pH->GetOffset_Internal()) = layout.height();
+                    if (pF) params[pF->GetOffset_Internal()] = 2; // RTF_RGBA8, as the icon extractor
+                    if (pC) std::memset(params.data() + pC->GetOffset_Internal(), 0, 16); // transparent gutters
+                    safeProcessEvent(krlCDO, createRTFn, params.data());
+                    m_uiAtlasRT = *reinterpret_cast<UObject**>(params.data() + pRV->GetOffset_Internal());
+                    if (!m_uiAtlasRT)
+                    {
+                        VLOG(STR("[MoriaCppMod] [Atlas] CreateRenderTarget2D returned null\n"));
+                        m_uiAtlasLayout = {};
+                        return false;
+                    }
+                }
+                else
+                {
+                    std::vector<uint8_t> params(clearRTFn->GetParmsSize(), 0);
+                    if (auto* p = findParam(clearRTFn, STR("WorldContextObject")))
+                        *reinterpret_cast<UObject**>(params.data() + p->GetOffset_Internal()) = worldCtx;
+                    if (auto* p = findParam(clearRTFn, STR("TextureRenderTarget")))
+                        *reinterpret_cast<UObject**>(params.data() + p->GetOffset_Internal()) = m_uiAtlasRT;
+                    safeProcessEvent(krlCDO, clearRTFn, params.data());
+                }
+                m_uiAtlasLayout = std::move(layout);
+            }
+
+            std::vector<uint8_t> beginParams(beginDrawFn->GetParmsSize(), 0);
+            UObject* canvas = nullptr;
+            {
+                auto* bWC = findParam(beginDrawFn, STR("WorldContextObject"));
+                auto* bRT = findParam(beginDrawFn, STR("TextureRenderTarget"));
+                auto* bCanvas = findParam(beginDrawFn, STR("Canvas"));
+                if (!bWC || !bRT) return false;
+                *reinterpret_cast<UObject**>(beginParams.data() + bWC->GetOffset_Internal()) = worldCtx;
+                *reinterpret_cast<UObject**>(beginParams.data() + bRT->GetOffset_Internal()) = m_uiAtlasRT;
+                safeProcessEvent(krlCDO, beginDrawFn, beginParams.data());
+                canvas = bCanvas ? *reinterpret_cast<UObject**>(beginParams.data() + bCanvas->GetOffset_Internal()) : nullptr;
+            }
+
+            int drawn = 0;
+            if (canvas)
+            {
+                auto* dTex = findParam(drawTexFn, STR("RenderTexture"));
+                auto* dPos = findParam(drawTexFn, STR("ScreenPosition"));
+                auto* dSize = findParam(drawTexFn, STR("ScreenSize"));
+                auto* dCoordSize = findParam(drawTexFn, STR("CoordinateSize"));
+                auto* dColor = findParam(drawTexFn, STR("RenderColor"));
+                auto* dBlend = findParam(drawTexFn, STR("BlendMode"));
+                auto* dPivot = findParam(drawTexFn, STR("PivotPoint"));
+                std::vector<uint8_t> dtParams(drawTexFn->GetParmsSize(), 0);
+                for (size_t i : dirty)
+                {
+                    if (!dTex || !sources[i] || !isObjectAlive(sources[i])) continue;
+                    const AtlasSlot& s = m_uiAtlasLayout.slot(i);
+                    std::fill(dtParams.begin(), dtParams.end(), uint8_t(0));
+                    *reinterpret_cast<UObject**>(dtParams.data() + dTex->GetOffset_Internal()) = sources[i];
+                    if (dPos)
+                    {
+                        auto* v = reinterpret_cast<float*>(dtParams.data() + dPos->GetOffset_Internal());
+                        v[0] = float(s.x);
+                        v[1] = float(s.y);
+                    }
+                    if (dSize)
+                    {
+                        auto* v = reinterpret_cast<float*>(dtParams.data() + dSize->GetOffset_Internal());
+                        v[0] = float(s.w);
+                        v[1] = float(s.h);
+                    }
+                    if (dCoordSize)
+                    {
+                        auto* v = reinterpret_cast<float*>(dtParams.data() + dCoordSize->GetOffset_Internal());
+                        v[0] = 1.0f;
+                        v[1] = 1.0f;
+                    }
+                    if (dColor)
+                    {
+                        auto* c = reinterpret_cast<float*>(dtParams.data() + dColor->GetOffset_Internal());
+                        c[0] = c[1] = c[2] = c[3] = 1.0f;
+                    }
+                    // Opaque: rects never overlap, and the source alpha must
+                    // land in the atlas as-is (it also fully replaces a stale
+                    // icon, so in-place redraws need no clear).
+                    if (dBlend) *reinterpret_cast<uint8_t*>(dtParams.data() + dBlend->GetOffset_Internal()) = 0;
+                    if (dPivot)
+                    {
+                        auto* v = reinterpret_cast<float*>(dtParams.data() + dPivot->GetOffset_Internal());
+                        v[0] = 0.5f;
+                        v[1] = 0.5f;
+                    }
+                    safeProcessEvent(canvas, drawTexFn, dtParams.data());
+                    ++drawn;
+                }
+            }
+
+            {
+                std::vector<uint8_t> eParams(endDrawFn->GetParmsSize(), 0);
+                auto* eWC = findParam(endDrawFn, STR("WorldContextObject"));
+                auto* eCtx = findParam(endDrawFn, STR("Context"));
+                if (eWC) *reinterpret_cast<UObject**>(eParams.data() + eWC->GetOffset_Internal()) = worldCtx;
+                if (eCtx)
+                {
+                    auto* bCtx = findParam(beginDrawFn, STR("Context"));
+                    if (bCtx && bCtx->GetSize() <= eCtx->GetSize())
+                        memcpy(eParams.data() + eCtx->GetOffset_Internal(), beginParams.data() + bCtx->GetOffset_Internal(), bCtx->GetSize());
+                }
+                safeProcessEvent(krlCDO, endDrawFn, eParams.data());
+            }
+            if (!canvas)
+            {
+                VLOG(STR("[MoriaCppMod] [Atlas] BeginDrawCanvasToRenderTarget returned no Canvas\n"));
+                m_uiAtlasLayout = {};
+                return false;
+            }
+
+            m_uiAtlasSources = sources;
+            VLOG(STR("[MoriaCppMod] [Atlas] {} {}x{} atlas, drew {}/{} rects ({}% used)\n"),
+                 relayout ? STR("built") : STR("updated"), m_uiAtlasLayout.width(), m_uiAtlasLayout.height(), drawn,
+                 items.size(), int(m_uiAtlasLayout.occupancy() * 100.0f));
+            return true;
+        }
+
+        // Point img's brush at the atlas rect for `key`, displayed at w x h.
+        // False (brush untouched) when the atlas or the key is unavailable.
+        bool umgSetAtlasBrush(UObject* img, const std::wstring& key, float w, float h)
+        {
+            if (!img || !isObjectAlive(img) || !uiAtlasReady()) return false;
+            const AtlasSlot* s = m_uiAtlasLayout.find(key);
+            if (!s) return false;
+            static UFunction* s_setResFn = nullptr;
+            if (!s_setResFn)
+                s_setResFn = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.Image:SetBrushResourceObject"));
+            if (!s_setResFn) return false;
+            ensureBrushOffset(img);
+            if (s_off_brush < 0) return false;
+            uint8_t* brush = reinterpret_cast<uint8_t*>(img) + s_off_brush;
+            if (!isReadableMemory(brush + brushUVRegion(), 20)) return false;
+
+            std::vector<uint8_t> bp(s_setResFn->GetParmsSize(), 0);
+            auto* pRes = findParam(s_setResFn, STR("ResourceObject"));
+            if (!pRes) return false;
+            *reinterpret_cast<UObject**>(bp.data() + pRes->GetOffset_Internal()) = m_uiAtlasRT;
+            safeProcessEvent(img, s_setResFn, bp.data());
+
+            // FBox2D { FVector2D Min, Max; uint8 bIsValid } — Slate only
+            // honours the region when bIsValid is set.
+            auto* uv = reinterpret_cast<float*>(brush + brushUVRegion());
+            uv[0] = s->u0;
+            uv[1] = s->v0;
+            uv[2] = s->u1;
+            uv[3] = s->v1;
+            *reinterpret_cast<uint8_t*>(brush + brushUVRegion() + 16) = 1;
+            *reinterpret_cast<float*>(brush + brushImageSizeX()) = w;
+            *reinterpret_cast<float*>(brush + brushImageSizeY()) = h;
+            return true;
+        }
+
+        // Drop a UVRegion left by umgSetAtlasBrush, for images that fall back
+        // to a plain texture brush.
+        void umgClearBrushUV(UObject* img)
+        {
+            if (!img || !isObjectAlive(img) || s_off_brush < 0) return;
+            uint8_t* brush = reinterpret_cast<uint8_t*>(img) + s_off_brush;
+            if (isReadableMemory(brush + brushUVRegion(), 20))
+                *reinterpret_cast<uint8_t*>(brush + brushUVRegion() + 16) = 0;
+        }
@@ -0,0 +1,363 @@
+
+
+
+#pragma once
+#ifndef MORIA_UI_TREE_H
+#define MORIA_UI_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+// Declarative widget subtrees for the F12 panel (built by instantiateUiTree
+// in moria_widgets.inl) and the UMG call-site cache behind the umg* setters.
+
+namespace MoriaMods
+{
+
+    // ── Call sites ──
+
+    enum class UiOp : uint8_t
+    {
+        SetText,
+        SetColorAndOpacity,
+        SetFont,
+        SetOpacity,
+        SetBrushSize,
+        SetRenderScale,
+        SetSlotSize,
+        SetSlotPadding,
+        SetHAlign,
+        SetVAlign,
+        AddToHBox,
+        AddToVBox,
+        AddToOverlay,
+        AddChild,
+        SetBrushFromTexture,
+        Count
+    };
+
+    // UFunction name, the parameter the setter writes, and the property it
+    // stores that value in (nullptr where the builder never writes it directly).
+    struct UiOpName
+    {
+        const wchar_t* function;
+        const wchar_t* param;
+        const wchar_t* property;
+    };
+
+    inline const UiOpName& uiOpName(UiOp op)
+    {
+        static const UiOpName kNames[size_t(UiOp::Count)] = {
+                {L"SetText", L"InText", nullptr},
+                {L"SetColorAndOpacity", L"InColorAndOpacity", L"ColorAndOpacity"},
+                {L"SetFont", L"InFontInfo", nullptr},   // s_off_font
+                {L"SetOpacity", L"InOpacity", nullptr},
+                {L"SetBrushSize", L"DesiredSize", nullptr},   // s_off_brush
+                {L"SetRenderScale", L"Scale", nullptr},
+                {L"SetSize", L"InSize", L"Size"},
+                {L"SetPadding", L"InPadding", L"Padding"},
+                {L"SetHorizontalAlignment", L"InHorizontalAlignment", L"HorizontalAlignment"},
+                {L"SetVerticalAlignment", L"InVerticalAlignment", L"VerticalAlignment"},
+                {L"AddChildToHorizontalBox", L"Content", nullptr},
+                {L"AddChildToVerticalBox", L"Content", nullptr},
+                {L"AddChildToOverlay", L"Content", nullptr},
+                {L"AddChild", L"Content", nullptr},
+                {L"SetBrushFromTexture", L"Texture", nullptr},
+        };
+        return kNames[size_t(op) < size_t(UiOp::Count) ? size_t(op) : 0];
+    }
+
+    // Site is whatever the caller resolves (UFunction* + offsets in the
+    // mod). Failed lookups are cached too, so a class without the function
+    // is only searched once.
+    template <typename Site>
+    class UiCallCache
+    {
+      public:
+        const Site* find(const void* cls, UiOp op)
+        {
+            auto it = m_sites.find(Key{cls, op});
+            if (it == m_sites.end())
+            {
+                m_misses++;
+                return nullptr;
+            }
+            m_hits++;
+            return &it->second;
+        }
+
+        const Site& put(const void* cls, UiOp op, const Site& site) { return m_sites.insert_or_assign(Key{cls, op}, site).first->second; }
+
+        void clear() { m_sites.clear(); }
+
+        size_t size() const { return m_sites.size(); }
+        uint32_t hits() const { return m_hits; }
+        uint32_t misses() const { return m_misses; }
+
+      private:
+        struct Key
+        {
+            const void* cls;
+            UiOp op;
+            bool operator==(const Key& o) const { return cls == o.cls && op == o.op; }
+        };
+        struct KeyHash
+        {
+            size_t operator()(const Key& k) const { return std::hash<const void*>()(k.cls) * 31 + size_t(k.op); }
+        };
+
+        std::unordered_map<Key, Site, KeyHash> m_sites;
+        uint32_t m_hits{0};
+        uint32_t m_misses{0};
+    };
+
+    // ── Subtree tables ──
+
+    enum class UiKind : uint8_t { HBox, VBox, Overlay, Image, Text, Count };
+
+    struct UiColor
+    {
+        float r, g, b, a;
+    };
+
+    inline bool uiIsPanel(UiKind k) { return k == UiKind::HBox || k == UiKind::VBox || k == UiKind::Overlay; }
+
+    // Widget-side style. Images: texture/brush size/tint. Text: colour, font
+    // size, bold. Zero/negative fields are left at the widget default; a
+    // node's per-instance tint replaces `color`.
+    struct UiStyle
+    {
+        int8_t texture{-1};        // index into the caller's texture table
+        float brushW{0.0f};
+        float brushH{0.0f};
+        bool tint{false};          // images: apply color as ColorAndOpacity
+        float color[4]{1.0f, 1.0f, 1.0f, 1.0f};
+        int32_t fontSize{0};
+        bool bold{false};
+    };
+
+    // Slot-side spec, applied after the node is added to its parent.
+    // Alignment: -1 leave, 0 fill, 1 left/top, 2 center, 3 right/bottom.
+    struct UiSlotSpec
+    {
+        bool fill{false};          // SetSize(1.0, Fill)
+        bool padded{false};
+        float pad[4]{};            // left, top, right, bottom
+        int8_t hAlign{-1};
+        int8_t vAlign{-1};
+    };
+
+    struct UiNode
+    {
+        UiKind kind{UiKind::Overlay};
+        int8_t parent{-1};         // earlier node index; -1 for the root (node 0)
+        uint8_t style{0};          // row in the subtree's UiStyle table
+        UiSlotSpec slot{};
+        int8_t needs{-1};          // texture index that must be loaded, else skip subtree
+        int8_t text{-1};           // per-instance text index (Text nodes)
+        int8_t capture{-1};        // per-instance output slot for the built widget
+        int8_t tint{-1};           // per-instance UiColor index (Text nodes)
+    };
+
+    // Node 0 is the only root, every parent precedes its children and is a
+    // panel, style rows exist, and text/capture/tint indices are in range.
+    inline bool uiTreeValid(const UiNode* nodes, size_t n, size_t styles, size_t texts, size_t captures, size_t tints = 0)
+    {
+        if (!nodes || n == 0 || nodes[0].parent != -1) return false;
+        for (size_t i = 0; i < n; i++)
+        {
+            const UiNode& nd = nodes[i];
+            if (nd.kind >= UiKind::Count || nd.style >= styles) return false;
+            if (i > 0 && (nd.parent < 0 || size_t(nd.parent) >= i || !uiIsPanel(nodes[nd.parent].kind))) return false;
+            if (nd.text >= 0 && (nd.kind != UiKind::Text || size_t(nd.text) >= texts)) return false;
+            if (nd.capture >= 0 && size_t(nd.capture) >= captures) return false;
+            if (nd.tint >= 0 && (nd.kind != UiKind::Text || size_t(nd.tint) >= tints)) return false;
+        }
+        return true;
+    }
+
+    // ProcessEvent calls to build one instance (widget construction not
+    // counted; it is the same either way). `legacy` is the hand-written
+    // path: one umg* setter per style or slot field, each of which also
+    // looked up its UFunction and parameter by name. `table` is the
+    // instantiateUiTree path with the pre-Slate direct writes.
+    struct UiBuildCost
+    {
+        uint32_t legacy{0};
+        uint32_t table{0};
+    };
+
+    inline UiBuildCost uiTreeCost(const UiNode* nodes, size_t n, const UiStyle* styles, bool rootAttached)
+    {
+        UiBuildCost c;
+        for (size_t i = 0; i < n; i++)
+        {
+            const UiNode& nd = nodes[i];
+            const UiStyle& st = styles[nd.style];
+            uint32_t add = (nd.parent >= 0 || rootAttached) ? 1 : 0;
+            const UiSlotSpec& sl = nd.slot;
+            uint32_t slot = add ? uint32_t(sl.fill) + uint32_t(sl.padded) + uint32_t(sl.hAlign >= 0) + uint32_t(sl.vAlign >= 0) : 0;
+            c.legacy += add + slot;
+            c.table += add;
+            if (nd.kind == UiKind::Image)
+            {
+                c.legacy += uint32_t(st.texture >= 0) + uint32_t(st.brushW > 0.0f) + uint32_t(st.tint);
+                c.table += uint32_t(st.texture >= 0);
+            }
+            else if (nd.kind == UiKind::Text)
+            {
+                c.legacy += 2 + uint32_t(st.fontSize > 0) + uint32_t(st.bold);   // text, colour, font, bold
+                c.table += 1;                                                     // text
+            }
+        }
+        return c;
+    }
+
+    // skip[i] = node i is not built: its required texture is missing or its
+    // parent was skipped. haveTexture(idx) reports whether texture idx loaded.
+    template <typename HaveTexture>
+    void uiTreeSkips(const UiNode* nodes, size_t n, HaveTexture&& haveTexture, bool* skip)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            skip[i] = (nodes[i].needs >= 0 && !haveTexture(nodes[i].needs)) || (nodes[i].parent >= 0 && skip[nodes[i].parent]);
+        }
+    }
+
+    // ── F12 panel subtrees ──
+
+    // Texture table the panel passes to instantiateUiTree. FtTexTab is
+    // swapped per tab button (focused texture for the selected tab).
+    enum FtTex : int8_t { FtTexCheckBox, FtTexCheck, FtTexKeyBox, FtTexSectionBg, FtTexTab, FtTexCount };
+
+    enum FtStyle : uint8_t
+    {
+        FtStyleNone,
+        FtStyleSectionBg,
+        FtStyleSectionTitle,
+        FtStyleCheckBox,
+        FtStyleCheck,
+        FtStyleRowLabel,
+        FtStyleRowLabelBright,
+        FtStyleRowTitle,
+        FtStyleKeyBox,
+        FtStyleKeyText,
+        FtStyleButtonText,
+        FtStyleTab,
+        FtStyleTabLabel,
+        FtStyleCount
+    };
+
+    inline constexpr UiStyle kFtStyles[FtStyleCount] = {
+            {},
+            {FtTexSectionBg, 900.0f, 80.0f},
+            {-1, 0.0f, 0.0f, false, {0.78f, 0.86f, 1.0f, 1.0f}, 28, true},
+            {FtTexCheckBox, 80.0f, 80.0f},
+            {FtTexCheck, 80.0f, 80.0f},
+            {-1, 0.0f, 0.0f, false, {0.86f, 0.90f, 0.96f, 0.85f}, 24},
+            {-1, 0.0f, 0.0f, false, {0.86f, 0.90f, 0.96f, 1.0f}, 24},
+            {-1, 0.0f, 0.0f, false, {0.86f, 0.90f, 0.96f, 0.85f}, 24, true},
+            {FtTexKeyBox, 400.0f, 128.0f},
+            {-1, 0.0f, 0.0f, false, {1.0f, 1.0f, 1.0f, 1.0f}, 24},
+            {-1, 0.0f, 0.0f, false, {1.0f, 1.0f, 1.0f, 1.0f}, 24, true},
+            {FtTexTab, 512.0f, 128.0f},
+            {-1, 0.0f, 0.0f, false, {1.0f, 1.0f, 1.0f, 1.0f}, 24},
+    };
+
+    inline constexpr UiSlotSpec kUiSlotCentered{false, false, {}, 2, 2};
+    inline constexpr UiSlotSpec kFtSlotCheckBox{false, true, {4.0f, 24.0f, 8.0f, 24.0f}};
+    inline constexpr UiSlotSpec kFtSlotLabel{true, true, {0.0f, 24.0f, 0.0f, 24.0f}, -1, 2};
+    inline constexpr UiSlotSpec kFtSlotIndentedLabel{true, true, {92.0f, 24.0f, 0.0f, 24.0f}, -1, 2};
+    inline constexpr UiSlotSpec kFtSlotKeyBox{false, true, {0.0f, 0.0f, 50.0f, 0.0f}};
+    inline constexpr UiSlotSpec kFtSlotListItem{false, true, {0.0f, 2.0f, 0.0f, 2.0f}};
+
+    // Section header: banner image with a centered bold title; not built
+    // at all without the banner texture. Texts: 0 = title.
+    inline constexpr UiNode kFtSectionHeader[] = {
+            {UiKind::Overlay, -1, FtStyleNone, {}, FtTexSectionBg},
+            {UiKind::Image, 0, FtStyleSectionBg},
+            {UiKind::Text, 0, FtStyleSectionTitle, kUiSlotCentered, -1, 0},
+    };
+
+    // Same header for the Cheats/Tweaks lists, whose row offsets assume
+    // the header exists: the title is kept when the banner is missing.
+    inline constexpr UiNode kFtSectionHeaderPlain[] = {
+            {UiKind::Overlay, -1, FtStyleNone},
+            {UiKind::Image, 0, FtStyleSectionBg, {}, FtTexSectionBg},
+            {UiKind::Text, 0, FtStyleSectionTitle, kUiSlotCentered, -1, 0},
+    };
+
+    // Key-binding row: [checkbox] label ............ [key box].
+    // Texts: 0 = label, 1 = key name. Captures: 0 = check image, 1 = key label.
+    inline constexpr UiNode kFtBindRow[] = {
+            {UiKind::HBox, -1, FtStyleNone},
+            {UiKind::Overlay, 0, FtStyleNone, kFtSlotCheckBox, FtTexCheckBox},
+            {UiKind::Image, 1, FtStyleCheckBox},
+            {UiKind::Image, 1, FtStyleCheck, {}, FtTexCheck, -1, 0},
+            {UiKind::Text, 0, FtStyleRowLabel, kFtSlotLabel, -1, 0},
+            {UiKind::Overlay, 0, FtStyleNone, kFtSlotKeyBox, FtTexKeyBox},
+            {UiKind::Image, 5, FtStyleKeyBox},
+            {UiKind::Text, 5, FtStyleKeyText, kUiSlotCentered, -1, 1, 1},
+    };
+
+    // Toggle row: [checkbox] label ......... [BUTTON] (No Collision, Peace
+    // Mode, buff toggles). Texts: 0 = label, 1 = button. Tints: 0 = button
+    // text. Captures: 0 = check image, 1 = label, 2 = button image,
+    // 3 = button label, 4 = checkbox overlay.
+    inline constexpr UiNode kFtToggleRow[] = {
+            {UiKind::HBox, -1, FtStyleNone},
+            {UiKind::Overlay, 0, FtStyleNone, kFtSlotCheckBox, FtTexCheckBox, -1, 4},
+            {UiKind::Image, 1, FtStyleCheckBox},
+            {UiKind::Image, 1, FtStyleCheck, {}, FtTexCheck, -1, 0},
+            {UiKind::Text, 0, FtStyleRowLabelBright, kFtSlotLabel, -1, 0, 1},
+            {UiKind::Overlay, 0, FtStyleNone, kFtSlotKeyBox, FtTexKeyBox},
+            {UiKind::Image, 5, FtStyleKeyBox, {}, -1, -1, 2},
+            {UiKind::Text, 5, FtStyleButtonText, kUiSlotCentered, -1, 1, 3, 0},
+    };
+
+    // Action row: indented label ......... [BUTTON] (Rename Character, Save
+    // Game, cheats, Clear All, tweak cycles). Texts: 0 = label, 1 = button.
+    // Tints: 0 = button text. Captures: 0 = button image, 1 = button label.
+    inline constexpr UiNode kFtButtonRow[] = {
+            {UiKind::HBox, -1, FtStyleNone},
+            {UiKind::Text, 0, FtStyleRowLabel, kFtSlotIndentedLabel, -1, 0},
+            {UiKind::Overlay, 0, FtStyleNone, kFtSlotKeyBox, FtTexKeyBox},
+            {UiKind::Image, 2, FtStyleKeyBox, {}, -1, -1, 0},
+            {UiKind::Text, 2, FtStyleButtonText, kUiSlotCentered, -1, 1, 1, 0},
+    };
+
+    // Indented label with a plain key box (modifier key).
+    // Texts: 0 = label, 1 = key name. Captures: 0 = key label.
+    inline constexpr UiNode kFtKeyValueRow[] = {
+            {UiKind::HBox, -1, FtStyleNone},
+            {UiKind::Text, 0, FtStyleRowLabel, kFtSlotIndentedLabel, -1, 0},
+            {UiKind::Overlay, 0, FtStyleNone, kFtSlotKeyBox, FtTexKeyBox},
+            {UiKind::Image, 2, FtStyleKeyBox},
+            {UiKind::Text, 2, FtStyleKeyText, kUiSlotCentered, -1, 1, 0},
+    };
+
+    // Definition-pack row: [checkbox] bold title over an optional
+    // description (added by the caller to the captured VBox).
+    // Texts: 0 = title. Captures: 0 = check image, 1 = info VBox.
+    inline constexpr UiNode kFtGameModRow[] = {
+            {UiKind::HBox, -1, FtStyleNone, kFtSlotListItem},
+            {UiKind::Overlay, 0, FtStyleNone, kFtSlotCheckBox, FtTexCheckBox},
+            {UiKind::Image, 1, FtStyleCheckBox},
+            {UiKind::Image, 1, FtStyleCheck, {}, FtTexCheck, -1, 0},
+            {UiKind::VBox, 0, FtStyleNone, {true, false, {}, -1, 2}, -1, -1, 1},
+            {UiKind::Text, 4, FtStyleRowTitle, {}, -1, 0},
+    };
+
+    // Left-column tab button. Texts: 0 = name. Tints: 0 = label colour.
+    // Captures: 0 = button image, 1 = label.
+    inline constexpr UiNode kFtTab[] = {
+            {UiKind::Overlay, -1, FtStyleNone, kFtSlotListItem},
+            {UiKind::Image, 0, FtStyleTab, {}, -1, -1, 0},
+            {UiKind::Text, 0, FtStyleTabLabel, kUiSlotCentered, -1, 0, 1, 0},
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_UI_TREE_H
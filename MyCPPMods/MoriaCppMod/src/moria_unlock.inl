@@ -467,90 +467,90 @@
             saveConfig();
         }
 
-        // Cache: short GE name → UClass*. Populated from enumerating loaded GE Class Default Objects.
-        std::unordered_map<std::wstring, UClass*> m_geClassCache;
-        bool m_geClassCachePopulated{false};
-
-        // Populate the cache by iterating every UObject via UE4SS's ForEachUObject, filtering
-        // to UClass objects whose super-chain includes UGameplayEffect. Expensive on first call
-        // (~50K objects), cheap on subsequent calls.
-        void populateGEClassCache()
+        // Short GE name → UClass*, grown incrementally from GUObjectArray
+        // (moria_class_index.h): each lookup scans only slots allocated since
+        // the previous one, and a miss isn't rescanned until the array grows.
+        IncrementalClassIndex<UClass*> m_geClassIndex;
+        UClass* m_geBaseClass{nullptr};
+        ULONGLONG m_geLastRewind{0};
+
+        // Index GE classes in GUObjectArray slots above the high-water mark.
+        // First call covers the whole array (~50K objects); later calls only
+        // the tail. Returns the number of classes added.
+        int scanNewGEClasses(int32_t numElements)
         {
-            if (m_geClassCachePopulated) return;
-            m_geClassCachePopulated = true;
-
-            // Find the UGameplayEffect base class by its full engine path
-            UClass* geBaseClass = UObjectGlobals::StaticFindObject<UClass*>(
-                nullptr, nullptr, STR("/Script/GameplayAbilities.GameplayEffect"));
-            if (!geBaseClass)
+            if (!m_geBaseClass)
             {
-                VLOG(STR("[Buff] UGameplayEffect base class not found — cache left empty\n"));
-                return;
+                // Find the UGameplayEffect base class by its full engine path
+                m_geBaseClass = UObjectGlobals::StaticFindObject<UClass*>(
+                    nullptr, nullptr, STR("/Script/GameplayAbilities.GameplayEffect"));
+                if (!m_geBaseClass)
+                {
+                    VLOG(STR("[Buff] UGameplayEffect base class not found — index left empty\n"));
+                    return 0;
+                }
             }
 
-            int indexed = 0;
-            int visited = 0;
-
-            UObjectGlobals::ForEachUObject([&](UObject* obj, int32_t /*idx*/, int32_t /*chunk*/) -> LoopAction {
-                visited++;
-                if (!obj) return LoopAction::Continue;
+            int32_t from = m_geClassIndex.highWater();
+            int added = m_geClassIndex.scanTo(numElements, [&](int32_t idx, auto&& add) {
+                FUObjectItem* item = UObjectArray::IndexToObject(idx);
+                UObject* obj = item ? item->GetUObject() : nullptr;
+                if (!obj) return;
 
-                UClass* objClass = nullptr;
-                try { objClass = obj->GetClassPrivate(); } catch (...) { return LoopAction::Continue; }
-                if (!objClass) return LoopAction::Continue;
-
-                std::wstring cname;
-                try { cname = objClass->GetName(); } catch (...) { return LoopAction::Continue; }
-
-                // Is this UObject itself a UClass-derived object?
-                bool isClassObj = (cname == L"Class" ||
-                                   cname == L"BlueprintGeneratedClass" ||
-                                   cname == L"DynamicClass");
-                if (!isClassObj) return LoopAction::Continue;
+                // Only UClass-derived objects (native, BlueprintGenerated, Dynamic)
+                bool isClassObj = false;
+                try { isClassObj = obj->IsA<UClass>(); } catch (...) { return; }
+                if (!isClassObj) return;
 
                 // Walk its super chain looking for UGameplayEffect
-                UStruct* asStruct = static_cast<UStruct*>(obj);
-                for (UStruct* s = asStruct; s; s = s->GetSuperStruct())
+                for (UStruct* s = static_cast<UStruct*>(obj); s; s = s->GetSuperStruct())
                 {
-                    if (s == geBaseClass)
-                    {
-                        std::wstring name;
-                        try { name = obj->GetName(); } catch (...) { break; }
-                        if (name.size() > 2 && name.substr(name.size() - 2) == L"_C")
-                            name = name.substr(0, name.size() - 2);
-                        if (!name.empty() && m_geClassCache.find(name) == m_geClassCache.end())
-                        {
-                            m_geClassCache[name] = static_cast<UClass*>(obj);
-                            indexed++;
-                        }
-                        break;
-                    }
+                    if (s != m_geBaseClass) continue;
+                    std::wstring name;
+                    try { name = obj->GetName(); } catch (...) { return; }
+                    if (name.size() > 2 && name.substr(name.size() - 2) == L"_C")
+                        name = name.substr(0, name.size() - 2);
+                    add(name, static_cast<UClass*>(obj));
+                    return;
                 }
-                return LoopAction::Continue;
             });
 
-            VLOG(STR("[Buff] populateGEClassCache: indexed {} GE classes (visited {} objects)\n"),
-                 indexed, visited);
+            VLOG(STR("[Buff] GE class index: +{} classes from slots [{}, {}) ({} total)\n"),
+                 added, from, numElements, m_geClassIndex.size());
+            return added;
         }
 
         // Find a GameplayEffect class by its short name (without _C).
         UClass* findGameplayEffectClass(const wchar_t* shortName)
         {
             if (!shortName || !shortName[0]) return nullptr;
-            populateGEClassCache();
+            std::wstring_view key(shortName);
+
+            if (UClass* cls = m_geClassIndex.find(key))
+            {
+                if (isObjectAlive(cls)) return cls;
+                m_geClassIndex.erase(key);  // unloaded since it was indexed
+            }
 
-            std::wstring key(shortName);
-            auto it = m_geClassCache.find(key);
-            if (it != m_geClassCache.end()) return it->second;
+            // GUObjectArray recycles freed slots, so a class can load below the
+            // mark without the array growing. At most once a minute, rescan
+            // from 0; rewind() also expires the cached misses, so this has
+            // to run before the knownMissing short-circuit.
+            int32_t numElements = UObjectArray::GetNumElements();
+            if (m_geClassIndex.highWater() == 0) m_geLastRewind = GetTickCount64();
+            else if (intervalElapsed(m_geLastRewind, 60000)) m_geClassIndex.rewind();
 
-            // Not in cache — may not be loaded yet. Force a fresh scan in case it was just loaded.
-            m_geClassCachePopulated = false;
-            m_geClassCache.clear();  // wipe to allow fresh indexing
-            populateGEClassCache();
-            it = m_geClassCache.find(key);
-            if (it != m_geClassCache.end()) return it->second;
+            if (m_geClassIndex.knownMissing(key, numElements))
+            {
+                VLOG(STR("[Buff] class '{}' not loaded (no new objects since last miss)\n"), shortName);
+                return nullptr;
+            }
+
+            scanNewGEClasses(numElements);
+            if (UClass* cls = m_geClassIndex.find(key)) return cls;
 
-            VLOG(STR("[Buff] class '{}' not loaded (not in GE cache)\n"), shortName);
+            m_geClassIndex.recordMiss(key);
+            VLOG(STR("[Buff] class '{}' not loaded (not in GE index)\n"), shortName);
             return nullptr;
         }
 
@@ -764,25 +764,24 @@
 
 // ---- Recipe unlock + read-history clear ----
 
+        static uint64_t unlock_nameKey(const FName& n)
+        {
+            return nameKey(n.GetComparisonIndex(), n.GetNumber());
+        }
+
         // Returns true if the row name matches a hidden/dev/test prefix — those
         // rows are NOT to be unlocked by the "Unlock All Recipes" feature.
-        bool unlock_hasHiddenPrefix(const std::wstring& name)
+        // Verdicts are cached per comparison index (m_unlockHiddenNames), so the
+        // name pool is only read the first time a base string is seen.
+        bool unlock_hasHiddenPrefix(const FName& name)
         {
-            static const std::vector<std::wstring> prefixes = {
-                L"DEV_",       L"dev_",
-                L"Test_",      L"TEST_",      L"test_",
-                L"Playtest_",  L"PLAYTEST_",  L"playtest_",
-                L"Debug_",     L"DEBUG_",     L"debug_",
-                L"Cheat_",     L"CHEAT_",     L"cheat_",
-                L"WIP_",       L"wip_",
-                L"DEPRECATED_", L"_DEPRECATED_"
-            };
-            for (const auto& p : prefixes)
-            {
-                if (name.size() >= p.size() && name.compare(0, p.size(), p) == 0)
-                    return true;
-            }
-            return false;
+            return m_unlockHiddenNames.isHidden(name.GetComparisonIndex(), name.GetNumber(), [](uint32_t idx) {
+                struct { uint32_t ComparisonIndex; uint32_t Number; } raw{idx, 0};
+                FName base;
+                std::memcpy(&base, &raw, sizeof(FName));
+                try { return std::wstring(base.ToString()); }
+                catch (...) { return std::wstring(); }
+            });
         }
 
         // Read a FName from an FMor*RowHandle at the given offset (handle base).
@@ -801,9 +800,9 @@
         // Algorithm: iterate DT_Entitlements, for each row, check GetIsEntitlementOwned(RowName).
         // If owned → skip (its content is fair game).
         // If not owned → union Items/Constructions/Runes handle names into the block sets.
-        void unlock_buildDLCBlockList(std::set<std::wstring>& blockedItems,
-                                     std::set<std::wstring>& blockedConstructions,
-                                     std::set<std::wstring>& blockedRunes)
+        void unlock_buildDLCBlockList(NameKeySet& blockedItems,
+                                     NameKeySet& blockedConstructions,
+                                     NameKeySet& blockedRunes)
         {
             // Locate the entitlement manager
             std::vector<UObject*> mgrs;
@@ -831,20 +830,17 @@
                 return;
             }
 
-            auto entRowNames = entTable.getRowNames();
             int blockedTotal = 0;
-            for (const auto& entRowName : entRowNames)
+            entTable.forEachRow([&](const FName& entRowName, uint8_t* rowData)
             {
                 // Call GetIsEntitlementOwned(FName EntitlementID) -> bool
                 struct { FName EntID; bool Ret; } params{};
-                params.EntID = FName(entRowName.c_str(), FNAME_Find);
+                params.EntID = entRowName;
                 params.Ret = false;
-                if (!safeProcessEvent(entMgr, isOwnedFn, &params)) continue;
-                if (params.Ret) continue;  // owned → no block
+                if (!safeProcessEvent(entMgr, isOwnedFn, &params)) return;
+                if (params.Ret) return;  // owned → no block
 
                 // Not owned — union its Items/Constructions/Runes into block sets
-                uint8_t* rowData = entTable.findRowData(entRowName.c_str());
-                if (!rowData) continue;
 
                 // FMorEntitlementDefinition layout (from Moria.hpp:2568):
                 //   0x0128: TArray<FMorAnyItemRowHandle>       Items
@@ -853,7 +849,7 @@
                 // Each handle is 0x10 bytes (FFGKDataTableRowHandle — vtable@0 + FName@8).
                 struct TArrayHeader { uint8_t* Data; int32_t Num; int32_t Max; };
 
-                auto collectHandles = [&](int offset, std::set<std::wstring>& blockSet) {
+                auto collectHandles = [&](int offset, NameKeySet& blockSet) {
                     if (!isReadableMemory(rowData + offset, sizeof(TArrayHeader))) return;
                     TArrayHeader hdr{};
                     std::memcpy(&hdr, rowData + offset, sizeof(TArrayHeader));
@@ -861,17 +857,15 @@
                     for (int32_t i = 0; i < hdr.Num; ++i)
                     {
                         FName n = unlock_readHandleName(hdr.Data + i * 0x10);
-                        try {
-                            std::wstring s = n.ToString();
-                            if (!s.empty()) { blockSet.insert(s); blockedTotal++; }
-                        } catch (...) {}
+                        if (n.GetComparisonIndex() == 0) continue;  // None / unreadable
+                        if (blockSet.insert(unlock_nameKey(n))) blockedTotal++;
                     }
                 };
 
                 collectHandles(0x0128, blockedItems);
                 collectHandles(0x0138, blockedConstructions);
                 collectHandles(0x0148, blockedRunes);
-            }
+            });
 
             VLOG(STR("[Unlock] DLC filter: {} handles blocked (items={} constructions={} runes={})\n"),
                  blockedTotal, (int)blockedItems.size(), (int)blockedConstructions.size(), (int)blockedRunes.size());
@@ -889,10 +883,11 @@
         }
 
         // Enumerate one recipe table and append all eligible row names to outQueue.
+        // One RowMap pass; every filter works on FName indices, no strings.
         void unlock_collectFromTable(const wchar_t* tableName,
-                                    const std::set<std::wstring>& blockedByDLC,
+                                    const NameKeySet& blockedByDLC,
                                     bool checkResultHandle,
-                                    std::vector<std::wstring>& outQueue)
+                                    std::vector<FName>& outQueue)
         {
             DataTableUtil dt;
             if (!dt.bind(tableName))
@@ -901,39 +896,26 @@
                 return;
             }
 
-            auto rowNames = dt.getRowNames();
             int before = (int)outQueue.size();
-            for (const auto& rowName : rowNames)
+            int32_t rowCount = dt.forEachRow([&](const FName& rowName, uint8_t* rowData)
             {
                 // Filter 1: hidden-prefix names
-                if (unlock_hasHiddenPrefix(rowName)) continue;
+                if (unlock_hasHiddenPrefix(rowName)) return;
 
                 // Filter 2: Disabled rows
-                uint8_t* rowData = dt.findRowData(rowName.c_str());
-                if (!rowData) continue;
-                if (!isReadableMemory(rowData, 0x20)) continue;
+                if (!isReadableMemory(rowData, 0x20)) return;
                 uint8_t enabledState = *reinterpret_cast<uint8_t*>(rowData + 0x10);
-                if (enabledState != 0) continue;  // Disabled == 1
+                if (enabledState != 0) return;  // Disabled == 1
 
-                // Filter 3: DLC-gated (check the result handle's RowName against block set)
-                if (checkResultHandle)
-                {
-                    FName resultName = unlock_readRecipeResultName(rowData);
-                    try {
-                        std::wstring resultStr = resultName.ToString();
-                        if (!resultStr.empty() && blockedByDLC.count(resultStr) > 0) continue;
-                    } catch (...) { continue; }
-                }
-                else
-                {
-                    // For rune recipes the row IS the rune — check rowName against block set
-                    if (blockedByDLC.count(rowName) > 0) continue;
-                }
+                // Filter 3: DLC-gated (check the result handle's RowName against block set).
+                // For rune recipes the row IS the rune — check rowName itself.
+                FName gateName = checkResultHandle ? unlock_readRecipeResultName(rowData) : rowName;
+                if (blockedByDLC.contains(unlock_nameKey(gateName))) return;
 
                 outQueue.push_back(rowName);
-            }
+            });
             VLOG(STR("[Unlock] '{}': {}/{} rows eligible\n"),
-                 tableName, (int)outQueue.size() - before, (int)rowNames.size());
+                 tableName, (int)outQueue.size() - before, rowCount);
         }
 
         // Entry point — triggered by Ctrl+Shift+U.
@@ -967,11 +949,11 @@
             }
 
             // 2. Build the DLC block list (best-effort; empty set = no filter if it fails)
-            std::set<std::wstring> blockedItems, blockedConstructions, blockedRunes;
+            NameKeySet blockedItems, blockedConstructions, blockedRunes;
             unlock_buildDLCBlockList(blockedItems, blockedConstructions, blockedRunes);
 
             // 3. Enumerate each recipe table, collect eligible row names
-            std::vector<std::wstring> queue;
+            std::vector<FName> queue;
             unlock_collectFromTable(L"DT_ConstructionRecipes", blockedConstructions, true,  queue);
             unlock_collectFromTable(L"DT_ItemRecipes",         blockedItems,         true,  queue);
             unlock_collectFromTable(L"DT_Runes",               blockedRunes,         false, queue);
@@ -989,13 +971,18 @@
             m_unlockProcessed = 0;
             m_unlockDiscoveryMgr = discoveryMgr;
             m_unlockDiscoverRecipeFn = fn;
+            m_unlockPacer.reset();
+            m_unlockLastFrame = {};
+            m_unlockLastProgress = GetTickCount64();
 
-            VLOG(STR("[Unlock] Queued {} recipes (paced {} per frame)\n"),
-                 m_unlockTotal, UNLOCK_BATCH_SIZE);
+            VLOG(STR("[Unlock] Queued {} recipes (paced to {:.1f} ms per frame)\n"),
+                 m_unlockTotal, m_unlockPacer.config().budgetMs);
             showOnScreen(L"Unlocking recipes...", 3.0f, 0.3f, 1.0f, 0.3f);
         }
 
-        // Called from the main tick each frame — processes UNLOCK_BATCH_SIZE entries then returns.
+        // Called from the main tick each frame. The pacer sizes each batch from
+        // the measured DiscoverRecipe cost (each call replicates on a server)
+        // and backs off for a while after a frame-time spike.
         void drainUnlockQueue()
         {
             if (m_unlockQueue.empty()) return;
@@ -1005,23 +992,42 @@
                 return;
             }
 
-            int n = (int)std::min<size_t>(UNLOCK_BATCH_SIZE, m_unlockQueue.size());
+            using Clock = std::chrono::steady_clock;
+            auto frameStart = Clock::now();
+            double frameMs = m_unlockLastFrame == Clock::time_point{} ? 0.0
+                : std::chrono::duration<double, std::milli>(frameStart - m_unlockLastFrame).count();
+            m_unlockLastFrame = frameStart;
+
+            int n = (int)std::min<size_t>(m_unlockPacer.beginFrame(frameMs), m_unlockQueue.size());
             for (int i = 0; i < n; ++i)
             {
-                const std::wstring& rowName = m_unlockQueue.back();
                 struct { FName RecipeName; } params{};
-                params.RecipeName = FName(rowName.c_str(), FNAME_Find);
+                params.RecipeName = m_unlockQueue.back();
                 safeProcessEvent(m_unlockDiscoveryMgr, m_unlockDiscoverRecipeFn, &params);
                 m_unlockQueue.pop_back();
                 m_unlockProcessed++;
             }
+            m_unlockPacer.endFrame(n, std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
 
             if (m_unlockQueue.empty())
             {
-                VLOG(STR("[Unlock] Complete — {} recipes discovered\n"), m_unlockProcessed);
+                VLOG(STR("[Unlock] Complete — {} recipes discovered ({:.3f} ms/call, {} frame spikes, {} rebases)\n"),
+                     m_unlockProcessed, m_unlockPacer.callCostMs(), m_unlockPacer.spikes(), m_unlockPacer.rebases());
                 showOnScreen(L"All available recipes unlocked", 3.0f, 0.3f, 1.0f, 0.3f);
                 m_unlockDiscoveryMgr = nullptr;
                 m_unlockDiscoverRecipeFn = nullptr;
+                return;
+            }
+
+            if (intervalElapsed(m_unlockLastProgress, 1000))
+            {
+                double eta = m_unlockPacer.etaSeconds(m_unlockQueue.size());
+                std::wstring msg = std::format(L"Unlocking recipes... {}/{}", m_unlockProcessed, m_unlockTotal);
+                if (eta >= 0) msg += std::format(L" (~{}s left)", (int)std::ceil(eta));
+                showOnScreen(msg, 1.5f, 0.3f, 1.0f, 0.3f);
+                VLOG(STR("[Unlock] {}/{} — {:.1f}/frame, {:.3f} ms/call{}\n"),
+                     m_unlockProcessed, m_unlockTotal, m_unlockPacer.callsPerFrame(), m_unlockPacer.callCostMs(),
+                     m_unlockPacer.backingOff() ? STR(", backing off") : STR(""));
             }
         }
 
@@ -0,0 +1,93 @@
+
+
+
+#pragma once
+#ifndef MORIA_WIDGET_POOL_H
+#define MORIA_WIDGET_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Free list of parked dialog widgets (trash, rename popups), reused on the
+// next open instead of being rebuilt.
+
+namespace MoriaMods
+{
+
+    template <typename T>
+    class WidgetPool
+    {
+      public:
+        explicit WidgetPool(size_t maxIdle = 2) : m_maxIdle(maxIdle > 0 ? maxIdle : 1) {}
+
+        // Most recently parked live instance, or nullopt (caller builds one).
+        template <typename Alive>
+        std::optional<T> acquire(Alive&& alive)
+        {
+            while (!m_idle.empty())
+            {
+                T t = std::move(m_idle.back());
+                m_idle.pop_back();
+                if (alive(t))
+                {
+                    m_hits++;
+                    return t;
+                }
+                m_dropped++;
+            }
+            m_misses++;
+            return std::nullopt;
+        }
+
+        // Park an instance for reuse. False when the pool is full.
+        bool release(T t)
+        {
+            if (m_idle.size() >= m_maxIdle)
+            {
+                m_overflows++;
+                return false;
+            }
+            m_idle.push_back(std::move(t));
+            return true;
+        }
+
+        // Hand every parked instance to `onEach` (to remove it) and empty the pool.
+        template <typename F>
+        void drain(F&& onEach)
+        {
+            for (auto& t : m_idle) onEach(t);
+            m_idle.clear();
+        }
+
+        // Drop parked instances without touching them (their world is gone).
+        void forget() { m_idle.clear(); }
+
+        size_t idle() const { return m_idle.size(); }
+        size_t maxIdle() const { return m_maxIdle; }
+        uint32_t hits() const { return m_hits; }
+        uint32_t misses() const { return m_misses; }
+        uint32_t dropped() const { return m_dropped; }
+        uint32_t overflows() const { return m_overflows; }
+
+        // Percentage of acquires served from the pool (0 before the first).
+        int hitRatePercent() const
+        {
+            uint32_t total = m_hits + m_misses;
+            return total ? int((uint64_t(m_hits) * 100 + total / 2) / total) : 0;
+        }
+
+      private:
+        std::vector<T> m_idle;
+        size_t m_maxIdle;
+        uint32_t m_hits{0};
+        uint32_t m_misses{0};
+        uint32_t m_dropped{0};
+        uint32_t m_overflows{0};
+    };
+
+} // namespace MoriaMods
+
+#endif // MORIA_WIDGET_POOL_H
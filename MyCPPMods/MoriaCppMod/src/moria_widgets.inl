@@ -30,6 +30,141 @@
             m_pendingWidgetRemovals.clear();
         }
 
+        // ── Pooled dialogs (moria_widget_pool.h) ────────────────────────
+        // Dialogs that are opened and closed repeatedly keep their built
+        // instance: closing parks it (Visibility saved, then Collapsed; it
+        // stays in the viewport) and the next open unparks it and rewrites
+        // only its text. If the game removed it from the viewport meanwhile,
+        // it is re-added at its ZOrder; if it was collected, the pool drops
+        // it and the dialog is built again.
+        struct PooledWidget
+        {
+            FWeakObjectPtr widget;
+            uint8_t visibility{0};
+        };
+
+        struct PooledRenamePopup
+        {
+            PooledWidget popup;    // WBP_UI_GenericPopup_C chrome
+            PooledWidget input;    // UserWidget hosting the EditableTextBox
+            FWeakObjectPtr editBox;
+        };
+
+        WidgetPool<PooledWidget> m_trashPopupPool{1};
+        WidgetPool<PooledRenamePopup> m_renamePopupPool{1};
+
+        static bool pooledWidgetAlive(const PooledWidget& p)
+        {
+            UObject* w = p.widget.Get();
+            return w && isObjectAlive(w);
+        }
+
+        // The widget and the Visibility to restore when it is unparked.
+        static PooledWidget pooledWidgetState(UObject* w)
+        {
+            PooledWidget p{FWeakObjectPtr(w), 0};
+            if (auto* vis = w->GetValuePtrByPropertyNameInChain<uint8_t>(STR("Visibility"))) p.visibility = *vis;
+            return p;
+        }
+
+        // `state` may be taken earlier, e.g. before a BP Hide() collapses it.
+        PooledWidget parkPooledWidget(const PooledWidget& state)
+        {
+            if (UObject* w = state.widget.Get()) setWidgetVisibility(w, 1); // Collapsed
+            return state;
+        }
+
+        PooledWidget parkPooledWidget(UObject* w) { return parkPooledWidget(pooledWidgetState(w)); }
+
+        UObject* unparkPooledWidget(const PooledWidget& p, int32_t zOrder)
+        {
+            UObject* w = p.widget.Get();
+            if (!w || !isObjectAlive(w)) return nullptr;
+            if (!isWidgetInViewport(w))
+            {
+                if (auto* fn = w->GetFunctionByNameInChain(STR("AddToViewport")))
+                {
+                    std::vector<uint8_t> b(fn->GetParmsSize(), 0);
+                    if (auto* pZ = findParam(fn, STR("ZOrder"))) *reinterpret_cast<int32_t*>(b.data() + pZ->GetOffset_Internal()) = zOrder;
+                    safeProcessEvent(w, fn, b.data());
+                }
+            }
+            setWidgetVisibility(w, p.visibility);
+            return w;
+        }
+
+        template <typename T>
+        void logWidgetPool(const wchar_t* name, const WidgetPool<T>& pool, bool reused)
+        {
+            VLOG(STR("[MoriaCppMod] [Pool] {} {}: {} hits / {} misses ({}% reused), {} dropped\n"),
+                 name, reused ? STR("reused") : STR("built"), pool.hits(), pool.misses(), pool.hitRatePercent(), pool.dropped());
+        }
+
+        // World teardown: parked widgets go with the world.
+        void forgetWidgetPools()
+        {
+            m_trashPopupPool.forget();
+            m_renamePopupPool.forget();
+        }
+
+        // ── UMG call sites (moria_ui_tree.h) ────────────────────────────
+        // Each umg* setter below resolves its UFunction and value parameter
+        // once per widget class through m_uiCalls, instead of
+        // GetFunctionByNameInChain + findParam on every call.
+        struct UiCallSite
+        {
+            UFunction* fn{nullptr};
+            int parmsSize{0};
+            int off{-1};        // value parameter
+            int retOff{-1};     // ReturnValue, when the function has one
+        };
+
+        UiCallCache<UiCallSite> m_uiCalls;
+
+        const UiCallSite* uiCall(UObject* obj, UiOp op)
+        {
+            UClass* cls = obj->GetClassPrivate();
+            const UiCallSite* site = m_uiCalls.find(cls, op);
+            if (!site)
+            {
+                const UiOpName& name = uiOpName(op);
+                UiCallSite s;
+                s.fn = obj->GetFunctionByNameInChain(name.function);
+                if (s.fn)
+                {
+                    s.parmsSize = s.fn->GetParmsSize();
+                    if (auto* p = findParam(s.fn, name.param)) s.off = p->GetOffset_Internal();
+                    if (auto* p = findParam(s.fn, STR("ReturnValue"))) s.retOff = p->GetOffset_Internal();
+                }
+                site = &m_uiCalls.put(cls, op, s);
+            }
+            return (site->fn && site->off >= 0) ? site : nullptr;
+        }
+
+        // Panel AddChildTo* through the cache; returns the new slot.
+        UObject* uiAddChild(UObject* parent, UiOp op, UObject* child)
+        {
+            if (!parent || !child) return nullptr;
+            auto* c = uiCall(parent, op);
+            if (!c) return nullptr;
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            *reinterpret_cast<UObject**>(buf.data() + c->off) = child;
+            safeProcessEvent(parent, c->fn, buf.data());
+            return c->retOff >= 0 ? *reinterpret_cast<UObject**>(buf.data() + c->retOff) : nullptr;
+        }
+
+        // Write Visibility straight into the UWidget. Only for widgets whose
+        // Slate widget doesn't exist yet (tree not in a viewport): that is
+        // all SetVisibility would do for them. Afterwards use setWidgetVisibility.
+        int m_uiVisibilityOff{-2};
+
+        void presetWidgetVisibility(UObject* w, uint8_t vis)
+        {
+            int off = resolveOffset(w, L"Visibility", m_uiVisibilityOff);
+            if (off >= 0) *(reinterpret_cast<uint8_t*>(w) + off) = vis;
+            else setWidgetVisibility(w, vis);
+        }
+
         void umgSetBrush(UObject* img, UObject* texture, UFunction* setBrushFn)
         {
             if (!img || !isObjectAlive(img) || !setBrushFn) return;
@@ -47,88 +182,70 @@
         void umgSetOpacity(UObject* img, float opacity)
         {
             if (!img || !isObjectAlive(img)) return;
-            auto* fn = img->GetFunctionByNameInChain(STR("SetOpacity"));
-            if (!fn) return;
-            auto* p = findParam(fn, STR("InOpacity"));
-            if (!p) return;
-            int sz = fn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            *reinterpret_cast<float*>(buf.data() + p->GetOffset_Internal()) = opacity;
-            safeProcessEvent(img, fn, buf.data());
+            auto* c = uiCall(img, UiOp::SetOpacity);
+            if (!c) return;
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            *reinterpret_cast<float*>(buf.data() + c->off) = opacity;
+            safeProcessEvent(img, c->fn, buf.data());
         }
 
 
         void umgSetSlotSize(UObject* slot, float value, uint8_t sizeRule)
         {
             if (!slot || !isObjectAlive(slot)) return;
-            auto* fn = slot->GetFunctionByNameInChain(STR("SetSize"));
-            if (!fn) return;
-            auto* p = findParam(fn, STR("InSize"));
-            if (!p) return;
-            int sz = fn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            auto* base = buf.data() + p->GetOffset_Internal();
+            auto* c = uiCall(slot, UiOp::SetSlotSize);
+            if (!c) return;
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            auto* base = buf.data() + c->off;
             *reinterpret_cast<float*>(base + 0) = value;
             *reinterpret_cast<uint8_t*>(base + 4) = sizeRule;
-            safeProcessEvent(slot, fn, buf.data());
+            safeProcessEvent(slot, c->fn, buf.data());
         }
 
 
         void umgSetSlotPadding(UObject* slot, float left, float top, float right, float bottom)
         {
             if (!slot || !isObjectAlive(slot)) return;
-            auto* fn = slot->GetFunctionByNameInChain(STR("SetPadding"));
-            if (!fn) return;
-            auto* p = findParam(fn, STR("InPadding"));
-            if (!p) return;
-            int sz = fn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            auto* m = reinterpret_cast<float*>(buf.data() + p->GetOffset_Internal());
+            auto* c = uiCall(slot, UiOp::SetSlotPadding);
+            if (!c) return;
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            auto* m = reinterpret_cast<float*>(buf.data() + c->off);
             m[0] = left; m[1] = top; m[2] = right; m[3] = bottom;
-            safeProcessEvent(slot, fn, buf.data());
+            safeProcessEvent(slot, c->fn, buf.data());
         }
 
 
         void umgSetHAlign(UObject* slot, uint8_t align)
         {
             if (!slot || !isObjectAlive(slot)) return;
-            auto* fn = slot->GetFunctionByNameInChain(STR("SetHorizontalAlignment"));
-            if (!fn) return;
-            auto* p = findParam(fn, STR("InHorizontalAlignment"));
-            if (!p) return;
-            int sz = fn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            *reinterpret_cast<uint8_t*>(buf.data() + p->GetOffset_Internal()) = align;
-            safeProcessEvent(slot, fn, buf.data());
+            auto* c = uiCall(slot, UiOp::SetHAlign);
+            if (!c) return;
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            *reinterpret_cast<uint8_t*>(buf.data() + c->off) = align;
+            safeProcessEvent(slot, c->fn, buf.data());
         }
 
 
         void umgSetVAlign(UObject* slot, uint8_t align)
         {
             if (!slot || !isObjectAlive(slot)) return;
-            auto* fn = slot->GetFunctionByNameInChain(STR("SetVerticalAlignment"));
-            if (!fn) return;
-            auto* p = findParam(fn, STR("InVerticalAlignment"));
-            if (!p) return;
-            int sz = fn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            *reinterpret_cast<uint8_t*>(buf.data() + p->GetOffset_Internal()) = align;
-            safeProcessEvent(slot, fn, buf.data());
+            auto* c = uiCall(slot, UiOp::SetVAlign);
+            if (!c) return;
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            *reinterpret_cast<uint8_t*>(buf.data() + c->off) = align;
+            safeProcessEvent(slot, c->fn, buf.data());
         }
 
 
         void umgSetRenderScale(UObject* widget, float sx, float sy)
         {
             if (!widget || !isObjectAlive(widget)) return;
-            auto* fn = widget->GetFunctionByNameInChain(STR("SetRenderScale"));
-            if (!fn) return;
-            auto* p = findParam(fn, STR("Scale"));
-            if (!p) return;
-            int sz = fn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            auto* v = reinterpret_cast<float*>(buf.data() + p->GetOffset_Internal());
+            auto* c = uiCall(widget, UiOp::SetRenderScale);
+            if (!c) return;
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            auto* v = reinterpret_cast<float*>(buf.data() + c->off);
             v[0] = sx; v[1] = sy;
-            safeProcessEvent(widget, fn, buf.data());
+            safeProcessEvent(widget, c->fn, buf.data());
         }
 
 
@@ -201,15 +318,12 @@
         void umgSetImageColor(UObject* img, float r, float g, float b, float a)
         {
             if (!img || !isObjectAlive(img)) return;
-            auto* fn = img->GetFunctionByNameInChain(STR("SetColorAndOpacity"));
-            if (!fn) return;
-            auto* p = findParam(fn, STR("InColorAndOpacity"));
-            if (!p) return;
-            int sz = fn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            auto* c = reinterpret_cast<float*>(buf.data() + p->GetOffset_Internal());
-            c[0] = r; c[1] = g; c[2] = b; c[3] = a;
-            safeProcessEvent(img, fn, buf.data());
+            auto* c = uiCall(img, UiOp::SetColorAndOpacity);
+            if (!c) return;
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            auto* col = reinterpret_cast<float*>(buf.data() + c->off);
+            col[0] = r; col[1] = g; col[2] = b; col[3] = a;
+            safeProcessEvent(img, c->fn, buf.data());
         }
 
 
@@ -228,44 +342,42 @@
         void umgSetText(UObject* textBlock, const std::wstring& text)
         {
             if (!textBlock || !isObjectAlive(textBlock)) return;
-            auto* fn = textBlock->GetFunctionByNameInChain(STR("SetText"));
-            if (!fn) return;
-            auto* pInText = findParam(fn, STR("InText"));
-            if (!pInText) return;
+            auto* c = uiCall(textBlock, UiOp::SetText);
+            if (!c) return;
             FText ftext(text.c_str());
-            int sz = fn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            std::memcpy(buf.data() + pInText->GetOffset_Internal(), &ftext, sizeof(FText));
-            safeProcessEvent(textBlock, fn, buf.data());
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            std::memcpy(buf.data() + c->off, &ftext, sizeof(FText));
+            safeProcessEvent(textBlock, c->fn, buf.data());
         }
 
 
         void umgSetTextColor(UObject* textBlock, float r, float g, float b, float a)
         {
             if (!textBlock || !isObjectAlive(textBlock)) return;
-            auto* fn = textBlock->GetFunctionByNameInChain(STR("SetColorAndOpacity"));
-            if (!fn) return;
-            auto* p = findParam(fn, STR("InColorAndOpacity"));
-            if (!p) return;
-            int sz = fn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            auto* color = reinterpret_cast<float*>(buf.data() + p->GetOffset_Internal());
+            auto* c = uiCall(textBlock, UiOp::SetColorAndOpacity);
+            if (!c) return;
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            auto* color = reinterpret_cast<float*>(buf.data() + c->off);
             color[0] = r; color[1] = g; color[2] = b; color[3] = a;
 
-            safeProcessEvent(textBlock, fn, buf.data());
+            safeProcessEvent(textBlock, c->fn, buf.data());
         }
 
 
+        static const RC::Unreal::FName& boldTypefaceName()
+        {
+            static const RC::Unreal::FName name(STR("Bold"), RC::Unreal::FNAME_Add);
+            return name;
+        }
+
         void umgSetBold(UObject* textBlock)
         {
             if (!textBlock || !isObjectAlive(textBlock)) return;
-            auto* setFontFn = textBlock->GetFunctionByNameInChain(STR("SetFont"));
-            if (!setFontFn) return;
+            auto* c = uiCall(textBlock, UiOp::SetFont);
+            if (!c) return;
             int fontOff = resolveOffset(textBlock, L"Font", s_off_font);
             if (fontOff < 0) return;
             probeFontStruct(textBlock);
-            auto* pFontInfo = findParam(setFontFn, STR("InFontInfo"));
-            if (!pFontInfo) return;
 
 
             uint8_t* tbRaw = reinterpret_cast<uint8_t*>(textBlock);
@@ -273,57 +385,49 @@
             std::memcpy(fontBuf, tbRaw + fontOff, FONT_STRUCT_SIZE);
 
 
-            RC::Unreal::FName boldName(STR("Bold"), RC::Unreal::FNAME_Add);
-            std::memcpy(fontBuf + fontTypefaceName(), &boldName, sizeof(RC::Unreal::FName));
+            std::memcpy(fontBuf + fontTypefaceName(), &boldTypefaceName(), sizeof(RC::Unreal::FName));
 
 
-            int sz = setFontFn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            std::memcpy(buf.data() + pFontInfo->GetOffset_Internal(), fontBuf, FONT_STRUCT_SIZE);
-            safeProcessEvent(textBlock, setFontFn, buf.data());
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            std::memcpy(buf.data() + c->off, fontBuf, FONT_STRUCT_SIZE);
+            safeProcessEvent(textBlock, c->fn, buf.data());
         }
 
         void umgSetFontSize(UObject* textBlock, int32_t fontSize)
         {
             if (!textBlock || !isObjectAlive(textBlock)) return;
-            auto* setFontFn = textBlock->GetFunctionByNameInChain(STR("SetFont"));
-            if (!setFontFn) return;
+            auto* c = uiCall(textBlock, UiOp::SetFont);
+            if (!c) return;
             int fontOff = resolveOffset(textBlock, L"Font", s_off_font);
             if (fontOff < 0) return;
-            auto* pFontInfo = findParam(setFontFn, STR("InFontInfo"));
-            if (!pFontInfo) return;
 
             uint8_t* tbRaw = reinterpret_cast<uint8_t*>(textBlock);
             uint8_t fontBuf[FONT_STRUCT_SIZE];
             std::memcpy(fontBuf, tbRaw + fontOff, FONT_STRUCT_SIZE);
             std::memcpy(fontBuf + fontSizeOff(), &fontSize, sizeof(int32_t));
 
-            int sz = setFontFn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            std::memcpy(buf.data() + pFontInfo->GetOffset_Internal(), fontBuf, FONT_STRUCT_SIZE);
-            safeProcessEvent(textBlock, setFontFn, buf.data());
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            std::memcpy(buf.data() + c->off, fontBuf, FONT_STRUCT_SIZE);
+            safeProcessEvent(textBlock, c->fn, buf.data());
         }
 
 
         void umgSetFontAndSize(UObject* textBlock, UObject* fontObj, int32_t fontSize)
         {
             if (!textBlock || !isObjectAlive(textBlock)) return;
-            auto* setFontFn = textBlock->GetFunctionByNameInChain(STR("SetFont"));
-            if (!setFontFn) return;
+            auto* c = uiCall(textBlock, UiOp::SetFont);
+            if (!c) return;
             int fontOff = resolveOffset(textBlock, L"Font", s_off_font);
             if (fontOff < 0) return;
-            auto* pFontInfo = findParam(setFontFn, STR("InFontInfo"));
-            if (!pFontInfo) return;
             probeFontStruct(textBlock);
             uint8_t* raw = reinterpret_cast<uint8_t*>(textBlock);
             uint8_t fontBuf[FONT_STRUCT_SIZE];
             std::memcpy(fontBuf, raw + fontOff, FONT_STRUCT_SIZE);
             if (fontObj) *reinterpret_cast<UObject**>(fontBuf + 0x00) = fontObj;
             std::memcpy(fontBuf + fontSizeOff(), &fontSize, sizeof(int32_t));
-            int sz = setFontFn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            std::memcpy(buf.data() + pFontInfo->GetOffset_Internal(), fontBuf, FONT_STRUCT_SIZE);
-            safeProcessEvent(textBlock, setFontFn, buf.data());
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            std::memcpy(buf.data() + c->off, fontBuf, FONT_STRUCT_SIZE);
+            safeProcessEvent(textBlock, c->fn, buf.data());
         }
 
 
@@ -362,15 +466,12 @@
         void umgSetBrushSize(UObject* img, float w, float h)
         {
             if (!img || !isObjectAlive(img)) return;
-            auto* fn = img->GetFunctionByNameInChain(STR("SetBrushSize"));
-            if (!fn) return;
-            auto* p = findParam(fn, STR("DesiredSize"));
-            if (!p) return;
-            int sz = fn->GetParmsSize();
-            std::vector<uint8_t> buf(sz, 0);
-            auto* v = reinterpret_cast<float*>(buf.data() + p->GetOffset_Internal());
+            auto* c = uiCall(img, UiOp::SetBrushSize);
+            if (!c) return;
+            std::vector<uint8_t> buf(c->parmsSize, 0);
+            auto* v = reinterpret_cast<float*>(buf.data() + c->off);
             v[0] = w; v[1] = h;
-            safeProcessEvent(img, fn, buf.data());
+            safeProcessEvent(img, c->fn, buf.data());
         }
 
 
@@ -390,6 +491,205 @@
         }
 
 
+        // One Texture2D scan for several names: out[i] = the texture named
+        // names[i], or nullptr. Each findTexture2DByName call walks every
+        // Texture2D, so panels that need several should use this instead.
+        void findTexture2DsByName(const wchar_t* const* names, size_t n, UObject** out)
+        {
+            for (size_t i = 0; i < n; i++) out[i] = nullptr;
+            std::vector<UObject*> textures;
+            findAllOfSafe(STR("Texture2D"), textures);
+            size_t left = n;
+            for (auto* t : textures)
+            {
+                if (!t) continue;
+                std::wstring name(t->GetName());
+                for (size_t i = 0; i < n; i++)
+                {
+                    if (out[i] || name != names[i]) continue;
+                    out[i] = t;
+                    if (--left == 0) return;
+                }
+            }
+        }
+
+
+        // ── Declarative subtrees (moria_ui_tree.h) ──────────────────────
+        struct UiBuildContext
+        {
+            UObject* outer{nullptr};
+            UClass* classes[size_t(UiKind::Count)]{};   // indexed by UiKind
+            UObject* const* textures{nullptr};          // indexed by UiStyle::texture / UiNode::needs
+            size_t textureCount{0};
+            UObject* font{nullptr};
+            int widgets{0};                             // constructed, for the build log
+            uint32_t calls{0};                          // ProcessEvent calls the builder made
+            uint32_t legacyCalls{0};                    // uiTreeCost().legacy for the same instances
+        };
+
+        // Per-instance inputs, indexed by UiNode::text / tint / capture. With
+        // a parent, the root is added through parentOp and gets nodes[0].slot.
+        struct UiArgs
+        {
+            const std::wstring* texts{nullptr};
+            const UiColor* tints{nullptr};
+            UObject** captures{nullptr};
+            UObject* parent{nullptr};
+            UiOp parentOp{UiOp::AddChild};
+        };
+
+        // Offset of the property a UiOp's setter stores into, per class
+        // (-1 if the class has none). Cleared with m_uiCalls.
+        UiCallCache<int> m_uiProps;
+
+        uint8_t* uiPropPtr(UObject* obj, UiOp op)
+        {
+            UClass* cls = obj->GetClassPrivate();
+            const int* off = m_uiProps.find(cls, op);
+            if (!off)
+            {
+                int resolved = -2;
+                const wchar_t* name = uiOpName(op).property;
+                if (name) resolveOffset(obj, name, resolved);
+                off = &m_uiProps.put(cls, op, name ? resolved : -1);
+            }
+            return *off >= 0 ? reinterpret_cast<uint8_t*>(obj) + *off : nullptr;
+        }
+
+        // Pre-Slate writes for instantiateUiTree: its widgets have no Slate
+        // widget yet, so the matching umg* setter would only have stored the
+        // same value in the property. Each returns false when the property
+        // can't be located; the builder then calls the setter instead.
+        bool uiPresetColor(UObject* w, const float* rgba)
+        {
+            uint8_t* p = uiPropPtr(w, UiOp::SetColorAndOpacity);
+            if (!p) return false;
+            std::memcpy(p, rgba, 4 * sizeof(float));   // FLinearColor, or FSlateColor::SpecifiedColor
+            return true;
+        }
+
+        bool uiPresetFont(UObject* tb, UObject* fontObj, int32_t fontSize, bool bold)
+        {
+            int fontOff = resolveOffset(tb, L"Font", s_off_font);
+            if (fontOff < 0) return false;
+            probeFontStruct(tb);
+            uint8_t* font = reinterpret_cast<uint8_t*>(tb) + fontOff;
+            if (fontSize > 0)
+            {
+                if (fontObj) *reinterpret_cast<UObject**>(font + 0x00) = fontObj;
+                std::memcpy(font + fontSizeOff(), &fontSize, sizeof(int32_t));
+            }
+            if (bold) std::memcpy(font + fontTypefaceName(), &boldTypefaceName(), sizeof(RC::Unreal::FName));
+            return true;
+        }
+
+        bool uiPresetBrushSize(UObject* img, float w, float h)
+        {
+            ensureBrushOffset(img);
+            if (s_off_brush < 0) return false;
+            auto* v = reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(img) + s_off_brush + brushImageSizeX());
+            v[0] = w; v[1] = h;
+            return true;
+        }
+
+        void applyUiSlot(UiBuildContext& ctx, UObject* slot, const UiSlotSpec& s)
+        {
+            if (s.fill)
+            {
+                if (uint8_t* p = uiPropPtr(slot, UiOp::SetSlotSize))
+                { *reinterpret_cast<float*>(p) = 1.0f; p[4] = 1; }   // FSlateChildSize{Value, SizeRule=Fill}
+                else { umgSetSlotSize(slot, 1.0f, 1); ctx.calls++; }
+            }
+            if (s.padded)
+            {
+                if (uint8_t* p = uiPropPtr(slot, UiOp::SetSlotPadding)) std::memcpy(p, s.pad, 4 * sizeof(float));
+                else { umgSetSlotPadding(slot, s.pad[0], s.pad[1], s.pad[2], s.pad[3]); ctx.calls++; }
+            }
+            if (s.hAlign >= 0)
+            {
+                if (uint8_t* p = uiPropPtr(slot, UiOp::SetHAlign)) *p = uint8_t(s.hAlign);
+                else { umgSetHAlign(slot, uint8_t(s.hAlign)); ctx.calls++; }
+            }
+            if (s.vAlign >= 0)
+            {
+                if (uint8_t* p = uiPropPtr(slot, UiOp::SetVAlign)) *p = uint8_t(s.vAlign);
+                else { umgSetVAlign(slot, uint8_t(s.vAlign)); ctx.calls++; }
+            }
+        }
+
+        // Build one instance of a node table and return its root, or
+        // nullptr. Must run before the tree is added to a viewport (see
+        // the pre-Slate writes above).
+        template <size_t N>
+        UObject* instantiateUiTree(UiBuildContext& ctx, const UiNode (&nodes)[N], const UiStyle* styles, const UiArgs& args = {})
+        {
+            bool skip[N];
+            uiTreeSkips(nodes, N, [&](int t) { return size_t(t) < ctx.textureCount && ctx.textures[t]; }, skip);
+            UObject* built[N]{};
+            for (size_t i = 0; i < N; i++)
+            {
+                const UiNode& nd = nodes[i];
+                if (skip[i] || (nd.parent >= 0 && !built[nd.parent])) continue;
+                UClass* cls = ctx.classes[size_t(nd.kind)];
+                if (!cls) continue;
+                FStaticConstructObjectParameters cp(cls, ctx.outer);
+                UObject* w = UObjectGlobals::StaticConstructObject(cp);
+                if (!w) continue;
+
+                const UiStyle& st = styles[nd.style];
+                if (nd.kind == UiKind::Image)
+                {
+                    UObject* tex = size_t(st.texture) < ctx.textureCount ? ctx.textures[st.texture] : nullptr;
+                    if (auto* c = tex ? uiCall(w, UiOp::SetBrushFromTexture) : nullptr)
+                    {
+                        std::vector<uint8_t> buf(c->parmsSize, 0);   // bMatchSize = false
+                        *reinterpret_cast<UObject**>(buf.data() + c->off) = tex;
+                        safeProcessEvent(w, c->fn, buf.data());
+                        ctx.calls++;
+                    }
+                    if (st.brushW > 0.0f && !uiPresetBrushSize(w, st.brushW, st.brushH))
+                    { umgSetBrushSize(w, st.brushW, st.brushH); ctx.calls++; }
+                    if (st.tint && !uiPresetColor(w, st.color))
+                    { umgSetImageColor(w, st.color[0], st.color[1], st.color[2], st.color[3]); ctx.calls++; }
+                }
+                else if (nd.kind == UiKind::Text)
+                {
+                    if (nd.text >= 0 && args.texts) { umgSetText(w, args.texts[nd.text]); ctx.calls++; }
+                    const float* col = st.color;
+                    if (nd.tint >= 0 && args.tints) col = &args.tints[nd.tint].r;
+                    if (!uiPresetColor(w, col)) { umgSetTextColor(w, col[0], col[1], col[2], col[3]); ctx.calls++; }
+                    if ((st.fontSize > 0 || st.bold) && !uiPresetFont(w, ctx.font, st.fontSize, st.bold))
+                    {
+                        if (st.fontSize > 0)
+                        {
+                            if (ctx.font) umgSetFontAndSize(w, ctx.font, st.fontSize);
+                            else umgSetFontSize(w, st.fontSize);
+                            ctx.calls++;
+                        }
+                        if (st.bold) { umgSetBold(w); ctx.calls++; }
+                    }
+                }
+                ctx.widgets++;
+                built[i] = w;
+                if (nd.capture >= 0 && args.captures) args.captures[nd.capture] = w;
+
+                UObject* parent = nd.parent >= 0 ? built[nd.parent] : args.parent;
+                if (!parent) continue;
+                UiOp op = args.parentOp;
+                if (nd.parent >= 0)
+                {
+                    UiKind pk = nodes[nd.parent].kind;
+                    op = pk == UiKind::HBox ? UiOp::AddToHBox : pk == UiKind::VBox ? UiOp::AddToVBox : UiOp::AddToOverlay;
+                }
+                UObject* slot = uiAddChild(parent, op, w);
+                ctx.calls++;
+                if (slot) applyUiSlot(ctx, slot, nd.slot);
+            }
+            ctx.legacyCalls += uiTreeCost(nodes, N, styles, args.parent != nullptr).legacy;
+            return built[0];
+        }
+
+
         void updateBuildersBar()
         {
             // Refresh NBB icons + active-slot highlight. (Top-of-screen builder bar is the only toolbar.)
@@ -2042,6 +2342,9 @@
                 m_nbbSlotMarker[i] = nullptr;
                 m_nbbSlotButton[i] = nullptr;
             }
+            // Keep the atlas target for the next bar, but redraw it in full.
+            m_nbbAtlasItems.clear();
+            m_uiAtlasSources.clear();
             VLOG(STR("[MoriaCppMod] [NewBuildingBar] removed\n"));
         }
 
@@ -2059,8 +2362,10 @@
 
         // Populate each slot icon from m_recipeSlots[i].textureName
         // — the QuickBuild assignments loaded from the INI. Walks the
-        // global Texture2D set once, then SetBrushFromTexture on each
-        // slot icon image. Slots without an assignment stay invisible.
+        // global Texture2D set once, then redraws the changed icon rects
+        // in the bar's atlas (the slot images were bound to their rects at
+        // creation) or, without an atlas, SetBrushFromTexture on each slot
+        // icon image. Slots without an assignment stay invisible.
         void populateNewBuildingBarIcons()
         {
             if (!m_newBuildingBar || !isObjectAlive(m_newBuildingBar)) return;
@@ -2081,6 +2386,18 @@
                     if (!t) continue;
                     if (t->GetName() == want) { slotTex[i] = t; break; }
                 }
+                // Slots restored from disk may predate the icon store.
+                if (slotTex[i]) queueIconExtraction(want, slotTex[i]);
+            }
+
+            bool viaAtlas = false, rebind = false;
+            if (!m_nbbAtlasItems.empty())
+            {
+                std::vector<UObject*> src = m_nbbAtlasGlyphSrc;
+                for (int i = 0; i < 8; ++i) src.push_back(slotTex[i]);
+                UObject* rtBefore = m_uiAtlasRT;
+                viaAtlas = buildUiAtlas(m_nbbAtlasItems, src);
+                rebind = viaAtlas && m_uiAtlasRT != rtBefore;
             }
 
             // Apply to each slot icon image.
@@ -2096,7 +2413,16 @@
                     setWidgetVisibility(iImg, 1);
                     continue;
                 }
+                if (viaAtlas && (!rebind || umgSetAtlasBrush(iImg, uiAtlasIconKey(i), 128.0f, 128.0f)))
+                {
+                    if (auto* visPtr = iImg->GetValuePtrByPropertyNameInChain<uint8_t>(STR("Visibility")))
+                        *visPtr = 0; // Visible
+                    setWidgetVisibility(iImg, 0);
+                    ++filled;
+                    continue;
+                }
                 umgSetBrush(iImg, slotTex[i], setBrushFn);
+                umgClearBrushUV(iImg);
                 if (s_off_brush >= 0) {
                     uint8_t* base = reinterpret_cast<uint8_t*>(iImg);
                     if (isReadableMemory(base + s_off_brush, 16))
@@ -2546,14 +2872,18 @@
                 FStaticConstructObjectParameters p(imageCls, outer);
                 UObject* img = UObjectGlobals::StaticConstructObject(p);
                 if (!img) return nullptr;
-                umgSetBrush(img, texture, setBrushFn);
-                if (s_off_brush >= 0 && w > 0 && h > 0)
+                bool inAtlas = !m_nbbAtlasItems.empty() && umgSetAtlasBrush(img, uiAtlasGlyphKey(texture, w, h), w, h);
+                if (!inAtlas)
                 {
-                    uint8_t* base = reinterpret_cast<uint8_t*>(img);
-                    if (isReadableMemory(base + s_off_brush, 16))
+                    umgSetBrush(img, texture, setBrushFn);
+                    if (s_off_brush >= 0 && w > 0 && h > 0)
                     {
-                        *reinterpret_cast<float*>(base + s_off_brush + brushImageSizeX()) = w;
-                        *reinterpret_cast<float*>(base + s_off_brush + brushImageSizeY()) = h;
+                        uint8_t* base = reinterpret_cast<uint8_t*>(img);
+                        if (isReadableMemory(base + s_off_brush, 16))
+                        {
+                            *reinterpret_cast<float*>(base + s_off_brush + brushImageSizeX()) = w;
+                            *reinterpret_cast<float*>(base + s_off_brush + brushImageSizeY()) = h;
+                        }
                     }
                 }
                 umgSetOpacity(img, opacity);
@@ -2614,6 +2944,33 @@
                 VLOG(STR("[MoriaCppMod] [NBB] keyBg post-load -> {:p}\n"), (void*)texKeyBg);
             }
 
+            // ── Shared atlas: each glyph at its display size plus one
+            // 128x128 rect per slot icon, drawn into a single render target
+            // (moria_ui_atlas.inl) so the bar's images share one texture.
+            // Icon rects start empty; populateNewBuildingBarIcons fills them.
+            m_nbbAtlasItems.clear();
+            m_nbbAtlasGlyphSrc.clear();
+            {
+                auto addGlyph = [&](UObject* tex, float w, float h) {
+                    if (!tex) return;
+                    std::wstring key = uiAtlasGlyphKey(tex, w, h);
+                    for (auto& it : m_nbbAtlasItems)
+                        if (it.key == key) return;
+                    m_nbbAtlasItems.push_back({key, int(w), int(h)});
+                    m_nbbAtlasGlyphSrc.push_back(tex);
+                };
+                addGlyph(useEmptyTex, slotW, slotH);
+                addGlyph(useFocusTex, slotW, slotH);
+                addGlyph(useFocusCornersTex, slotW, slotH);
+                addGlyph(texKeyBg, 76.0f, 44.0f);
+                for (int i = 0; i < 8; ++i)
+                    addGlyph(a.texSlotMarker[i] ? a.texSlotMarker[i] : a.texSlotMarker[0], markerW, markerH);
+                for (int i = 0; i < 8; ++i) m_nbbAtlasItems.push_back({uiAtlasIconKey(i), 128, 128});
+                std::vector<UObject*> src = m_nbbAtlasGlyphSrc;
+                src.resize(m_nbbAtlasItems.size(), nullptr);
+                if (!buildUiAtlas(m_nbbAtlasItems, src)) m_nbbAtlasItems.clear();
+            }
+
             // Chrome backdrop REMOVED entirely per user request.
             // The Top/Middle/Bottom textures we found ARE the right
             // assets but their layout/scaling looked wrong without the
@@ -2723,6 +3080,7 @@
                         {
                             UObject* is = addToOverlay(slotOv, iImg);
                             if (is) { umgSetHAlign(is, 2); umgSetVAlign(is, 2); }
+                            if (!m_nbbAtlasItems.empty()) umgSetAtlasBrush(iImg, uiAtlasIconKey(i), 128.0f, 128.0f);
                             if (auto* visPtr = iImg->GetValuePtrByPropertyNameInChain<uint8_t>(STR("Visibility")))
                                 *visPtr = 1;
                             setWidgetVisibility(iImg, 1);
@@ -2750,7 +3108,9 @@
                         {
                             if (texKeyBg)
                             {
-                                umgSetBrush(kbImg, texKeyBg, setBrushFn);
+                                if (m_nbbAtlasItems.empty() ||
+                                    !umgSetAtlasBrush(kbImg, uiAtlasGlyphKey(texKeyBg, 76.0f, 44.0f), 76.0f, 44.0f))
+                                    umgSetBrush(kbImg, texKeyBg, setBrushFn);
                                 umgSetOpacity(kbImg, 0.8f);
                             }
                             else
@@ -2888,9 +3248,7 @@
                 m_ftNoCollisionCheckImg = nullptr;
                 m_ftNoCollisionLabel = nullptr;
                 m_ftNoCollisionKeyLabel = nullptr;
-                m_ftRemovalVBox = nullptr;
-                m_ftRemovalHeader = nullptr;
-                m_ftLastRemovalCount = -1;
+                resetFtRemovalList();
                 for (auto& c : m_ftGameModCheckImages) c = nullptr;
                 m_ftGameModEntries.clear();
                 if (s_capturingBind >= 0) { s_capturingBind = -1; }
@@ -2900,15 +3258,29 @@
             }
 
             VLOG(STR("[MoriaCppMod] [Settings] Creating settings panel...\n"));
-
-
-            UObject* texBG = findTexture2DByName(L"T_UI_Pnl_Craft_BG");
-            UObject* texTab = findTexture2DByName(L"T_UI_Btn_P2_Up");
-            UObject* texTabFocused = findTexture2DByName(L"T_UI_Btn_P1_Focused");
-            UObject* texKeyBox = findTexture2DByName(L"T_UI_Btn_P1_Active");
-            UObject* texSectionBg = findTexture2DByName(L"T_UI_Map_LocationName_HUD");
-            UObject* texCB = findTexture2DByName(L"T_UI_Icon_Checkbox_DiamondBG");
-            UObject* texCheck = findTexture2DByName(L"T_UI_Icon_Check");
+            using Clock = std::chrono::steady_clock;
+            auto tBuild = Clock::now();
+            uint32_t callHits0 = m_uiCalls.hits(), callMisses0 = m_uiCalls.misses();
+
+
+            // Every texture the panel uses, in one Texture2D scan. The
+            // separator takes the first of its candidates that exists.
+            const wchar_t* texNames[] = {
+                L"T_UI_Pnl_Craft_BG", L"T_UI_Btn_P2_Up", L"T_UI_Btn_P1_Focused", L"T_UI_Btn_P1_Active",
+                L"T_UI_Map_LocationName_HUD", L"T_UI_Icon_Checkbox_DiamondBG", L"T_UI_Icon_Check",
+                L"T_UI_Shared_Line", L"T_UI_Pnl_Separator", L"T_UI_Line", L"T_UI_Separator",
+                L"T_UI_Shared_Separator", L"T_UI_Pnl_Line", L"T_UI_Shared_LineSeparator", L"T_UI_Shared_VerticalLine",
+            };
+            constexpr size_t kFirstSepTex = 7;
+            UObject* texFound[std::size(texNames)];
+            findTexture2DsByName(texNames, std::size(texNames), texFound);
+            UObject* texBG = texFound[0];
+            UObject* texTab = texFound[1];
+            UObject* texTabFocused = texFound[2];
+            UObject* texKeyBox = texFound[3];
+            UObject* texSectionBg = texFound[4];
+            UObject* texCB = texFound[5];
+            UObject* texCheck = texFound[6];
             if (!texBG) { showErrorBox(L"Settings: BG not found!"); return; }
             if (!texTab) { showErrorBox(L"Settings: Tab texture not found!"); return; }
             if (!texTabFocused) texTabFocused = texTab;
@@ -3039,6 +3411,20 @@
                 return tb;
             };
 
+            // Tabs, section headers and every row family are built from the
+            // node tables in moria_ui_tree.h; only the frame is hand-built.
+            UObject* ftTextures[FtTexCount] = {texCB, texCheck, texKeyBox, texSectionBg, texTab};
+            UiBuildContext ui;
+            ui.outer = outer;
+            ui.classes[size_t(UiKind::HBox)] = hboxClass;
+            ui.classes[size_t(UiKind::VBox)] = vboxClass;
+            ui.classes[size_t(UiKind::Overlay)] = overlayClass;
+            ui.classes[size_t(UiKind::Image)] = imageClass;
+            ui.classes[size_t(UiKind::Text)] = textBlockClass;
+            ui.textures = ftTextures;
+            ui.textureCount = FtTexCount;
+            ui.font = defaultFont;
+
 
             {
                 FStaticConstructObjectParameters vbP(vboxClass, outer);
@@ -3051,56 +3437,23 @@
                     const wchar_t* tabNames[] = { L"Key Bindings", L"Game Options", L"Environment", L"Game Mods", L"Cheats", L"Tweaks" };
                     for (int i = 0; i < CONFIG_TAB_COUNT; i++)
                     {
-                        FStaticConstructObjectParameters olTabP(overlayClass, outer);
-                        UObject* tabOl = UObjectGlobals::StaticConstructObject(olTabP);
-                        if (!tabOl) continue;
-
-
-                        FStaticConstructObjectParameters imgP(imageClass, outer);
-                        UObject* tabImg = UObjectGlobals::StaticConstructObject(imgP);
-                        if (tabImg)
-                        {
-                            UObject* tex = (i == 0) ? texTabFocused : texTab;
-                            umgSetBrushNoMatch(tabImg, tex, setBrushFn);
-                            umgSetBrushSize(tabImg, 512.0f, 128.0f);
-                            addToOverlay(tabOl, tabImg);
-                            m_ftTabImages[i] = tabImg;
-                        }
-
-
-                        UObject* tabLabel = makeTB(tabNames[i],
-                            (i == 0) ? 0.9f : 0.55f,
-                            (i == 0) ? 0.88f : 0.55f,
-                            (i == 0) ? 0.78f : 0.65f,
-                            (i == 0) ? 1.0f : 0.7f, 24);
-                        if (tabLabel)
-                        {
-                            m_ftTabLabels[i] = tabLabel;
-                            UObject* txtSlot = addToOverlay(tabOl, tabLabel);
-                            if (txtSlot)
-                            {
-                                umgSetHAlign(txtSlot, 2);
-                                umgSetVAlign(txtSlot, 2);
-                            }
-                        }
-
-                        UObject* tabSlot = addToVBox(tabVBox, tabOl);
-                        if (tabSlot) umgSetSlotPadding(tabSlot, 0.0f, 2.0f, 0.0f, 2.0f);
+                        ftTextures[FtTexTab] = (i == 0) ? texTabFocused : texTab;
+                        const std::wstring tabText(tabNames[i]);
+                        const UiColor tabTint = (i == 0) ? UiColor{0.9f, 0.88f, 0.78f, 1.0f} : UiColor{0.55f, 0.55f, 0.65f, 0.7f};
+                        UObject* tabOut[2]{};   // button image, label
+                        instantiateUiTree(ui, kFtTab, kFtStyles, {&tabText, &tabTint, tabOut, tabVBox, UiOp::AddToVBox});
+                        m_ftTabImages[i] = tabOut[0];
+                        m_ftTabLabels[i] = tabOut[1];
                     }
+                    ftTextures[FtTexTab] = texTab;
                 }
             }
 
 
             {
 
-                UObject* texSep = findTexture2DByName(L"T_UI_Shared_Line");
-                if (!texSep) texSep = findTexture2DByName(L"T_UI_Pnl_Separator");
-                if (!texSep) texSep = findTexture2DByName(L"T_UI_Line");
-                if (!texSep) texSep = findTexture2DByName(L"T_UI_Separator");
-                if (!texSep) texSep = findTexture2DByName(L"T_UI_Shared_Separator");
-                if (!texSep) texSep = findTexture2DByName(L"T_UI_Pnl_Line");
-                if (!texSep) texSep = findTexture2DByName(L"T_UI_Shared_LineSeparator");
-                if (!texSep) texSep = findTexture2DByName(L"T_UI_Shared_VerticalLine");
+                UObject* texSep = nullptr;
+                for (size_t i = kFirstSepTex; i < std::size(texNames) && !texSep; i++) texSep = texFound[i];
 
                 FStaticConstructObjectParameters sepImgP(imageClass, outer);
                 UObject* sepImg = UObjectGlobals::StaticConstructObject(sepImgP);
@@ -3256,143 +3609,35 @@
                             UObject* t1 = m_ftTabContent[1];
 
 
-                            if (texSectionBg)
                             {
-                                FStaticConstructObjectParameters secOlP(overlayClass, outer);
-                                UObject* secOl = UObjectGlobals::StaticConstructObject(secOlP);
-                                if (secOl)
-                                {
-                                    FStaticConstructObjectParameters secImgP(imageClass, outer);
-                                    UObject* secImg = UObjectGlobals::StaticConstructObject(secImgP);
-                                    if (secImg) { umgSetBrushNoMatch(secImg, texSectionBg, setBrushFn); umgSetBrushSize(secImg, 900.0f, 80.0f); addToOverlay(secOl, secImg); }
-                                    UObject* secLabel = makeTB(Loc::get("ui.options_title"), 0.78f, 0.86f, 1.0f, 1.0f, 28);
-                                    if (secLabel) { umgSetBold(secLabel); UObject* ts = addToOverlay(secOl, secLabel); if (ts) { umgSetHAlign(ts, 2); umgSetVAlign(ts, 2); } }
-                                    addToVBox(t1, secOl);
-                                }
+                                const std::wstring title = Loc::get("ui.options_title");
+                                instantiateUiTree(ui, kFtSectionHeader, kFtStyles, {&title, nullptr, nullptr, t1, UiOp::AddToVBox});
                             }
 
 
                             {
-                                FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                UObject* ncRow = UObjectGlobals::StaticConstructObject(rowP);
-                                if (ncRow)
-                                {
-
-                                    if (texCB)
-                                    {
-                                        FStaticConstructObjectParameters olP(overlayClass, outer);
-                                        UObject* cbOl = UObjectGlobals::StaticConstructObject(olP);
-                                        if (cbOl)
-                                        {
-                                            FStaticConstructObjectParameters imgP(imageClass, outer);
-                                            UObject* cbBg = UObjectGlobals::StaticConstructObject(imgP);
-                                            if (cbBg) { umgSetBrushNoMatch(cbBg, texCB, setBrushFn); umgSetBrushSize(cbBg, 80.0f, 80.0f); addToOverlay(cbOl, cbBg); }
-                                            if (texCheck)
-                                            {
-                                                FStaticConstructObjectParameters chkP(imageClass, outer);
-                                                UObject* chkImg = UObjectGlobals::StaticConstructObject(chkP);
-                                                if (chkImg)
-                                                {
-                                                    umgSetBrushNoMatch(chkImg, texCheck, setBrushFn);
-                                                    umgSetBrushSize(chkImg, 80.0f, 80.0f);
-                                                    addToOverlay(cbOl, chkImg);
-                                                    m_ftNoCollisionCheckImg = chkImg;
-                                                    auto* visFn = chkImg->GetFunctionByNameInChain(STR("SetVisibility"));
-                                                    if (visFn) { uint8_t vp[8]{}; vp[0] = 1; safeProcessEvent(chkImg, visFn, vp); }
-                                                }
-                                            }
-                                            UObject* cbSlot = addToHBox(ncRow, cbOl);
-                                            if (cbSlot) umgSetSlotPadding(cbSlot, 4.0f, 24.0f, 8.0f, 24.0f);
-                                        }
-                                    }
-
-                                    UObject* ncLabel = makeTB(Loc::get("ui.no_collision"), 0.86f, 0.90f, 0.96f, 1.0f, 24);
-                                    m_ftNoCollisionLabel = ncLabel;
-                                    if (ncLabel)
-                                    {
-                                        UObject* ls = addToHBox(ncRow, ncLabel);
-                                        if (ls) { umgSetSlotSize(ls, 1.0f, 1); umgSetSlotPadding(ls, 0.0f, 24.0f, 0.0f, 24.0f); umgSetVAlign(ls, 2); }
-                                    }
-
-                                    if (texKeyBox)
-                                    {
-                                        FStaticConstructObjectParameters kbOlP(overlayClass, outer);
-                                        UObject* kbOl = UObjectGlobals::StaticConstructObject(kbOlP);
-                                        if (kbOl)
-                                        {
-                                            FStaticConstructObjectParameters kbImgP(imageClass, outer);
-                                            UObject* kbImg = UObjectGlobals::StaticConstructObject(kbImgP);
-                                            if (kbImg) { umgSetBrushNoMatch(kbImg, texKeyBox, setBrushFn); umgSetBrushSize(kbImg, 400.0f, 128.0f); addToOverlay(kbOl, kbImg); }
-                                            UObject* kbLabel = makeTB(Loc::get("ui.status_off"), 0.7f, 0.3f, 0.3f, 1.0f, 24);
-                                            if (kbLabel) { umgSetBold(kbLabel); m_ftNoCollisionKeyLabel = kbLabel; UObject* ks = addToOverlay(kbOl, kbLabel); if (ks) { umgSetHAlign(ks, 2); umgSetVAlign(ks, 2); } }
-                                            UObject* kbSlot = addToHBox(ncRow, kbOl);
-                                            if (kbSlot) umgSetSlotPadding(kbSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                        }
-                                    }
-                                    addToVBox(t1, ncRow);
-                                }
+                                const std::wstring ncTexts[] = {Loc::get("ui.no_collision"), Loc::get("ui.status_off")};
+                                const UiColor ncTint{0.7f, 0.3f, 0.3f, 1.0f};
+                                UObject* ncOut[5]{};   // check image, label, button image, button label, checkbox overlay
+                                instantiateUiTree(ui, kFtToggleRow, kFtStyles, {ncTexts, &ncTint, ncOut, t1, UiOp::AddToVBox});
+                                m_ftNoCollisionCheckImg = ncOut[0];
+                                m_ftNoCollisionLabel = ncOut[1];
+                                m_ftNoCollisionKeyLabel = ncOut[3];
+                                if (ncOut[0]) presetWidgetVisibility(ncOut[0], 1); // Collapsed
                             }
 
 
                             {
-                                FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                UObject* rcRow = UObjectGlobals::StaticConstructObject(rowP);
-                                if (rcRow)
-                                {
-                                    UObject* rcLabel = makeTB(Loc::get("ui.rename_character"), 0.86f, 0.90f, 0.96f, 0.85f, 24);
-                                    if (rcLabel)
-                                    {
-                                        UObject* ls = addToHBox(rcRow, rcLabel);
-                                        if (ls) { umgSetSlotSize(ls, 1.0f, 1); umgSetSlotPadding(ls, 92.0f, 24.0f, 0.0f, 24.0f); umgSetVAlign(ls, 2); }
-                                    }
-                                    if (texKeyBox)
-                                    {
-                                        FStaticConstructObjectParameters kbOlP(overlayClass, outer);
-                                        UObject* kbOl = UObjectGlobals::StaticConstructObject(kbOlP);
-                                        if (kbOl)
-                                        {
-                                            FStaticConstructObjectParameters kbImgP(imageClass, outer);
-                                            UObject* kbImg = UObjectGlobals::StaticConstructObject(kbImgP);
-                                            if (kbImg) { umgSetBrushNoMatch(kbImg, texKeyBox, setBrushFn); umgSetBrushSize(kbImg, 400.0f, 128.0f); addToOverlay(kbOl, kbImg); }
-                                            UObject* kbLabel = makeTB(Loc::get("ui.button_rename"), 0.9f, 0.75f, 0.2f, 1.0f, 24);
-                                            if (kbLabel) { umgSetBold(kbLabel); UObject* ks = addToOverlay(kbOl, kbLabel); if (ks) { umgSetHAlign(ks, 2); umgSetVAlign(ks, 2); } }
-                                            UObject* kbSlot = addToHBox(rcRow, kbOl);
-                                            if (kbSlot) umgSetSlotPadding(kbSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                        }
-                                    }
-                                    addToVBox(t1, rcRow);
-                                }
+                                const std::wstring rcTexts[] = {Loc::get("ui.rename_character"), Loc::get("ui.button_rename")};
+                                const UiColor rcTint{0.9f, 0.75f, 0.2f, 1.0f};
+                                instantiateUiTree(ui, kFtButtonRow, kFtStyles, {rcTexts, &rcTint, nullptr, t1, UiOp::AddToVBox});
                             }
 
                             // Save Game button row (same pattern as Rename Character)
                             {
-                                FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                UObject* sgRow = UObjectGlobals::StaticConstructObject(rowP);
-                                if (sgRow)
-                                {
-                                    UObject* sgLabel = makeTB(L"Save Game", 0.86f, 0.90f, 0.96f, 0.85f, 24);
-                                    if (sgLabel)
-                                    {
-                                        UObject* ls = addToHBox(sgRow, sgLabel);
-                                        if (ls) { umgSetSlotSize(ls, 1.0f, 1); umgSetSlotPadding(ls, 92.0f, 24.0f, 0.0f, 24.0f); umgSetVAlign(ls, 2); }
-                                    }
-                                    if (texKeyBox)
-                                    {
-                                        FStaticConstructObjectParameters kbOlP(overlayClass, outer);
-                                        UObject* kbOl = UObjectGlobals::StaticConstructObject(kbOlP);
-                                        if (kbOl)
-                                        {
-                                            FStaticConstructObjectParameters kbImgP(imageClass, outer);
-                                            UObject* kbImg = UObjectGlobals::StaticConstructObject(kbImgP);
-                                            if (kbImg) { umgSetBrushNoMatch(kbImg, texKeyBox, setBrushFn); umgSetBrushSize(kbImg, 400.0f, 128.0f); addToOverlay(kbOl, kbImg); }
-                                            UObject* kbLabel = makeTB(L"SAVE NOW", 0.31f, 0.78f, 0.47f, 1.0f, 24);
-                                            if (kbLabel) { umgSetBold(kbLabel); UObject* ks = addToOverlay(kbOl, kbLabel); if (ks) { umgSetHAlign(ks, 2); umgSetVAlign(ks, 2); } }
-                                            UObject* kbSlot = addToHBox(sgRow, kbOl);
-                                            if (kbSlot) umgSetSlotPadding(kbSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                        }
-                                    }
-                                    addToVBox(t1, sgRow);
-                                }
+                                const std::wstring sgTexts[] = {L"Save Game", L"SAVE NOW"};
+                                const UiColor sgTint{0.31f, 0.78f, 0.47f, 1.0f};
+                                instantiateUiTree(ui, kFtButtonRow, kFtStyles, {sgTexts, &sgTint, nullptr, t1, UiOp::AddToVBox});
                             }
 
                             {
@@ -3407,67 +3652,13 @@
                                 for (auto& gob : gameOptBinds)
                                 {
                                     int bi = gob.bindIdx;
-                                    FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                    UObject* goRow = UObjectGlobals::StaticConstructObject(rowP);
-                                    if (!goRow) continue;
-
-                                    if (texCB)
-                                    {
-                                        FStaticConstructObjectParameters olP(overlayClass, outer);
-                                        UObject* cbOl = UObjectGlobals::StaticConstructObject(olP);
-                                        if (cbOl)
-                                        {
-                                            FStaticConstructObjectParameters imgP(imageClass, outer);
-                                            UObject* cbBg = UObjectGlobals::StaticConstructObject(imgP);
-                                            if (cbBg) { umgSetBrushNoMatch(cbBg, texCB, setBrushFn); umgSetBrushSize(cbBg, 80.0f, 80.0f); addToOverlay(cbOl, cbBg); }
-                                            if (texCheck)
-                                            {
-                                                FStaticConstructObjectParameters chkP(imageClass, outer);
-                                                UObject* chkImg = UObjectGlobals::StaticConstructObject(chkP);
-                                                if (chkImg)
-                                                {
-                                                    umgSetBrushNoMatch(chkImg, texCheck, setBrushFn);
-                                                    umgSetBrushSize(chkImg, 80.0f, 80.0f);
-                                                    addToOverlay(cbOl, chkImg);
-                                                    *gob.checkImgPtr = chkImg;
-
-                                                    auto* visFn = chkImg->GetFunctionByNameInChain(STR("SetVisibility"));
-                                                    if (visFn) { uint8_t vp[8]{}; vp[0] = 1; safeProcessEvent(chkImg, visFn, vp); }
-                                                }
-                                            }
-                                            UObject* cbSlot = addToHBox(goRow, cbOl);
-                                            if (cbSlot) umgSetSlotPadding(cbSlot, 4.0f, 24.0f, 8.0f, 24.0f);
-                                        }
-                                    }
-
-                                    UObject* goLabel = makeTB(s_bindings[bi].label, 0.86f, 0.90f, 0.96f, 0.85f, 24);
-                                    if (goLabel)
-                                    {
-                                        UObject* ls = addToHBox(goRow, goLabel);
-                                        if (ls) { umgSetSlotSize(ls, 1.0f, 1); umgSetSlotPadding(ls, 0.0f, 24.0f, 0.0f, 24.0f); umgSetVAlign(ls, 2); }
-                                    }
-
-                                    if (texKeyBox)
-                                    {
-                                        FStaticConstructObjectParameters kbOlP(overlayClass, outer);
-                                        UObject* kbOl = UObjectGlobals::StaticConstructObject(kbOlP);
-                                        if (kbOl)
-                                        {
-                                            FStaticConstructObjectParameters kbImgP(imageClass, outer);
-                                            UObject* kbImg = UObjectGlobals::StaticConstructObject(kbImgP);
-                                            if (kbImg) { umgSetBrushNoMatch(kbImg, texKeyBox, setBrushFn); umgSetBrushSize(kbImg, 400.0f, 128.0f); addToOverlay(kbOl, kbImg); }
-                                            UObject* kbLabel = makeTB(keyName(s_bindings[bi].key), 1.0f, 1.0f, 1.0f, 1.0f, 24);
-                                            if (kbLabel)
-                                            {
-                                                m_ftKeyBoxLabels[bi] = kbLabel;
-                                                UObject* ks = addToOverlay(kbOl, kbLabel);
-                                                if (ks) { umgSetHAlign(ks, 2); umgSetVAlign(ks, 2); }
-                                            }
-                                            UObject* kbSlot = addToHBox(goRow, kbOl);
-                                            if (kbSlot) umgSetSlotPadding(kbSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                        }
-                                    }
-                                    addToVBox(t1, goRow);
+                                    const std::wstring goTexts[] = {s_bindings[bi].label, keyName(s_bindings[bi].key)};
+                                    UObject* goOut[2]{};   // check image, key label
+                                    instantiateUiTree(ui, kFtBindRow, kFtStyles, {goTexts, nullptr, goOut, t1, UiOp::AddToVBox});
+                                    if (goOut[1]) m_ftKeyBoxLabels[bi] = goOut[1];
+                                    if (!goOut[0]) continue;
+                                    *gob.checkImgPtr = goOut[0];
+                                    presetWidgetVisibility(goOut[0], 1); // Collapsed
                                 }
                             }
                         }
@@ -3484,55 +3675,8 @@
                             if (hdr) { umgSetBold(hdr); addToVBox(t2, hdr); }
                             m_ftRemovalHeader = hdr;
 
-
-                            FStaticConstructObjectParameters rvP(vboxClass, outer);
-                            UObject* remVBox = UObjectGlobals::StaticConstructObject(rvP);
-                            if (remVBox) { m_ftRemovalVBox = remVBox; addToVBox(t2, remVBox); }
-
-
-                            UObject* texDanger = findTexture2DByName(L"T_UI_Icon_Danger");
-                            if (remVBox && s_config.removalCSInit)
-                            {
-                                CriticalSectionLock removalLock(s_config.removalCS);
-                                for (size_t i = 0; i < s_config.removalEntries.size(); i++)
-                                {
-                                    const auto& entry = s_config.removalEntries[i];
-                                    FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                    UObject* rowHBox = UObjectGlobals::StaticConstructObject(rowP);
-                                    if (!rowHBox) continue;
-
-
-                                    if (texDanger && setBrushFn)
-                                    {
-                                        FStaticConstructObjectParameters imgP(imageClass, outer);
-                                        UObject* dangerImg = UObjectGlobals::StaticConstructObject(imgP);
-                                        if (dangerImg)
-                                        {
-                                            umgSetBrushNoMatch(dangerImg, texDanger, setBrushFn);
-                                            umgSetBrushSize(dangerImg, 56.0f, 56.0f);
-                                            UObject* imgSlot = addToHBox(rowHBox, dangerImg);
-                                            if (imgSlot) umgSetSlotPadding(imgSlot, 4.0f, 8.0f, 8.0f, 8.0f);
-                                        }
-                                    }
-
-
-                                    FStaticConstructObjectParameters infoP(vboxClass, outer);
-                                    UObject* infoVBox = UObjectGlobals::StaticConstructObject(infoP);
-                                    if (infoVBox)
-                                    {
-                                        UObject* nameTB = makeTB(entry.friendlyName, 0.3f, 0.85f, 0.3f, 1.0f, 22);
-                                        if (nameTB) { umgSetBold(nameTB); addToVBox(infoVBox, nameTB); }
-                                        std::wstring coordText = entry.isTypeRule ? Loc::get("ui.type_rule") : entry.coordsW;
-                                        UObject* coordsTB = makeTB(coordText, 0.85f, 0.25f, 0.25f, 1.0f, 16);
-                                        if (coordsTB) addToVBox(infoVBox, coordsTB);
-                                        UObject* infoSlot = addToHBox(rowHBox, infoVBox);
-                                        if (infoSlot) umgSetVAlign(infoSlot, 2);
-                                    }
-
-                                    addToVBox(remVBox, rowHBox);
-                                }
-                            }
-                            m_ftLastRemovalCount = remCount;
+                            createFtRemovalList(t2, outer, defaultFont);
+                            rebuildFtRemovalList();
                         }
 
 
@@ -3556,19 +3700,9 @@
                             else
                             {
 
-                                if (texSectionBg)
                                 {
-                                    FStaticConstructObjectParameters secOlP(overlayClass, outer);
-                                    UObject* secOl = UObjectGlobals::StaticConstructObject(secOlP);
-                                    if (secOl)
-                                    {
-                                        FStaticConstructObjectParameters secImgP(imageClass, outer);
-                                        UObject* secImg = UObjectGlobals::StaticConstructObject(secImgP);
-                                        if (secImg) { umgSetBrushNoMatch(secImg, texSectionBg, setBrushFn); umgSetBrushSize(secImg, 900.0f, 80.0f); addToOverlay(secOl, secImg); }
-                                        UObject* secLabel = makeTB(Loc::get("ui.definition_packs_title"), 0.78f, 0.86f, 1.0f, 1.0f, 28);
-                                        if (secLabel) { umgSetBold(secLabel); UObject* ts = addToOverlay(secOl, secLabel); if (ts) { umgSetHAlign(ts, 2); umgSetVAlign(ts, 2); } }
-                                        addToVBox(t3, secOl);
-                                    }
+                                    const std::wstring title = Loc::get("ui.definition_packs_title");
+                                    instantiateUiTree(ui, kFtSectionHeader, kFtStyles, {&title, nullptr, nullptr, t3, UiOp::AddToVBox});
                                 }
 
 
@@ -3576,53 +3710,13 @@
                                 {
                                     auto& gm = m_ftGameModEntries[gi];
 
-                                    FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                    UObject* gmRow = UObjectGlobals::StaticConstructObject(rowP);
-                                    if (!gmRow) continue;
-
-
-                                    if (texCB)
-                                    {
-                                        FStaticConstructObjectParameters olP(overlayClass, outer);
-                                        UObject* cbOl = UObjectGlobals::StaticConstructObject(olP);
-                                        if (cbOl)
-                                        {
-                                            FStaticConstructObjectParameters imgP(imageClass, outer);
-                                            UObject* cbBg = UObjectGlobals::StaticConstructObject(imgP);
-                                            if (cbBg) { umgSetBrushNoMatch(cbBg, texCB, setBrushFn); umgSetBrushSize(cbBg, 80.0f, 80.0f); addToOverlay(cbOl, cbBg); }
-                                            if (texCheck)
-                                            {
-                                                FStaticConstructObjectParameters chkImgP(imageClass, outer);
-                                                UObject* chkImg = UObjectGlobals::StaticConstructObject(chkImgP);
-                                                if (chkImg)
-                                                {
-                                                    umgSetBrushNoMatch(chkImg, texCheck, setBrushFn);
-                                                    umgSetBrushSize(chkImg, 80.0f, 80.0f);
-                                                    addToOverlay(cbOl, chkImg);
-                                                    m_ftGameModCheckImages[gi] = chkImg;
-
-                                                    if (!gm.enabled)
-                                                    {
-                                                        auto* visFn = chkImg->GetFunctionByNameInChain(STR("SetVisibility"));
-                                                        if (visFn) { uint8_t vp[8]{}; vp[0] = 2; safeProcessEvent(chkImg, visFn, vp); }
-                                                    }
-                                                }
-                                            }
-                                            UObject* cbSlot = addToHBox(gmRow, cbOl);
-                                            if (cbSlot) umgSetSlotPadding(cbSlot, 4.0f, 24.0f, 8.0f, 24.0f);
-                                        }
-                                    }
-
-
-                                    FStaticConstructObjectParameters infoP(vboxClass, outer);
-                                    UObject* infoVBox = UObjectGlobals::StaticConstructObject(infoP);
-                                    if (infoVBox)
+                                    const std::wstring wTitle(gm.title.begin(), gm.title.end());
+                                    UObject* gmOut[2]{};   // check image, info VBox
+                                    instantiateUiTree(ui, kFtGameModRow, kFtStyles, {&wTitle, nullptr, gmOut, t3, UiOp::AddToVBox});
+                                    m_ftGameModCheckImages[gi] = gmOut[0];
+                                    if (gmOut[0] && !gm.enabled) presetWidgetVisibility(gmOut[0], 2); // Hidden
+                                    if (UObject* infoVBox = gmOut[1])
                                     {
-                                        std::wstring wTitle(gm.title.begin(), gm.title.end());
-                                        UObject* titleTB = makeTB(wTitle, 0.86f, 0.90f, 0.96f, 0.85f, 24);
-                                        if (titleTB) { umgSetBold(titleTB); addToVBox(infoVBox, titleTB); }
-
-
                                         if (!gm.description.empty())
                                         {
 
@@ -3654,17 +3748,7 @@
                                                 if (descTB) addToVBox(infoVBox, descTB);
                                             }
                                         }
-
-                                        UObject* infoSlot = addToHBox(gmRow, infoVBox);
-                                        if (infoSlot)
-                                        {
-                                            umgSetSlotSize(infoSlot, 1.0f, 1);
-                                            umgSetVAlign(infoSlot, 2);
-                                        }
                                     }
-
-                                    UObject* rowSlot = addToVBox(t3, gmRow);
-                                    if (rowSlot) umgSetSlotPadding(rowSlot, 0.0f, 2.0f, 0.0f, 2.0f);
                                 }
 
 
@@ -3683,10 +3767,8 @@
                         }
 
 
-                        // Cheats tab (index 4). Two action buttons styled exactly like
-                        // the Rename Character / Save Game buttons in the Game Options tab:
-                        //   HBox: [Label stretched, pad L=92 T=24 B=24 VAlign=Center]
-                        //         [ texKeyBox overlay 400x128 with centered bold text, pad R=50 ]
+                        // Cheats tab (index 4). Two action buttons built from kFtButtonRow,
+                        // like the Rename Character / Save Game buttons in the Game Options tab.
                         if (m_ftTabContent[4])
                         {
                             UObject* t4 = m_ftTabContent[4];
@@ -3695,45 +3777,11 @@
                             auto makeCheatRow = [&](const wchar_t* rowLabel, const wchar_t* btnText,
                                                     float btnR, float btnG, float btnB, float btnA,
                                                     UObject*& outBtnImg) {
-                                FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                UObject* row = UObjectGlobals::StaticConstructObject(rowP);
-                                if (!row) return;
-
-                                UObject* label = makeTB(rowLabel, 0.86f, 0.90f, 0.96f, 0.85f, 24);
-                                if (label)
-                                {
-                                    UObject* ls = addToHBox(row, label);
-                                    if (ls) { umgSetSlotSize(ls, 1.0f, 1); umgSetSlotPadding(ls, 92.0f, 24.0f, 0.0f, 24.0f); umgSetVAlign(ls, 2); }
-                                }
-
-                                if (texKeyBox)
-                                {
-                                    FStaticConstructObjectParameters kbOlP(overlayClass, outer);
-                                    UObject* kbOl = UObjectGlobals::StaticConstructObject(kbOlP);
-                                    if (kbOl)
-                                    {
-                                        FStaticConstructObjectParameters kbImgP(imageClass, outer);
-                                        UObject* kbImg = UObjectGlobals::StaticConstructObject(kbImgP);
-                                        if (kbImg)
-                                        {
-                                            umgSetBrushNoMatch(kbImg, texKeyBox, setBrushFn);
-                                            umgSetBrushSize(kbImg, 400.0f, 128.0f);
-                                            addToOverlay(kbOl, kbImg);
-                                            outBtnImg = kbImg;
-                                        }
-                                        UObject* kbLabel = makeTB(btnText, btnR, btnG, btnB, btnA, 24);
-                                        if (kbLabel)
-                                        {
-                                            umgSetBold(kbLabel);
-                                            UObject* ks = addToOverlay(kbOl, kbLabel);
-                                            if (ks) { umgSetHAlign(ks, 2); umgSetVAlign(ks, 2); }
-                                        }
-                                        UObject* kbSlot = addToHBox(row, kbOl);
-                                        if (kbSlot) umgSetSlotPadding(kbSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                    }
-                                }
-
-                                addToVBox(t4, row);
+                                const std::wstring texts[] = {rowLabel, btnText};
+                                const UiColor tint{btnR, btnG, btnB, btnA};
+                                UObject* out[2]{};   // button image, button label
+                                instantiateUiTree(ui, kFtButtonRow, kFtStyles, {texts, &tint, out, t4, UiOp::AddToVBox});
+                                if (out[0]) outBtnImg = out[0];
                             };
 
                             // UNLOCK button colored like RENAME (gold)
@@ -3744,87 +3792,18 @@
                             makeCheatRow(STR("Read All"), STR("READ"),
                                          0.31f, 0.78f, 0.47f, 1.0f, m_ftCheatsReadBtnImg);
 
-                            // Peace Mode toggle row — checkbox on left, label, dynamic PEACE/FIGHT button
+                            // Peace Mode toggle row: PEACE (green) when enabled, FIGHT (red/orange) when disabled
                             {
-                                FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                UObject* pmRow = UObjectGlobals::StaticConstructObject(rowP);
-                                if (pmRow)
-                                {
-                                    // Checkbox overlay (diamond background + optional check mark)
-                                    if (texCB)
-                                    {
-                                        FStaticConstructObjectParameters olP(overlayClass, outer);
-                                        UObject* cbOl = UObjectGlobals::StaticConstructObject(olP);
-                                        if (cbOl)
-                                        {
-                                            FStaticConstructObjectParameters imgP(imageClass, outer);
-                                            UObject* cbBg = UObjectGlobals::StaticConstructObject(imgP);
-                                            if (cbBg) { umgSetBrushNoMatch(cbBg, texCB, setBrushFn); umgSetBrushSize(cbBg, 80.0f, 80.0f); addToOverlay(cbOl, cbBg); }
-                                            if (texCheck)
-                                            {
-                                                FStaticConstructObjectParameters chkP(imageClass, outer);
-                                                UObject* chkImg = UObjectGlobals::StaticConstructObject(chkP);
-                                                if (chkImg)
-                                                {
-                                                    umgSetBrushNoMatch(chkImg, texCheck, setBrushFn);
-                                                    umgSetBrushSize(chkImg, 80.0f, 80.0f);
-                                                    addToOverlay(cbOl, chkImg);
-                                                    m_ftPeaceCheckImg = chkImg;
-                                                    // Start hidden if peace mode is off
-                                                    auto* visFn = chkImg->GetFunctionByNameInChain(STR("SetVisibility"));
-                                                    if (visFn) { uint8_t vp[8]{}; vp[0] = m_peaceModeEnabled ? 0 : 1; safeProcessEvent(chkImg, visFn, vp); }
-                                                }
-                                            }
-                                            m_ftPeaceCheckBoxOl = cbOl;
-                                            UObject* cbSlot = addToHBox(pmRow, cbOl);
-                                            if (cbSlot) umgSetSlotPadding(cbSlot, 4.0f, 24.0f, 8.0f, 24.0f);
-                                        }
-                                    }
-
-                                    // Label
-                                    UObject* pmLabel = makeTB(STR("Peace Mode"), 0.86f, 0.90f, 0.96f, 1.0f, 24);
-                                    if (pmLabel)
-                                    {
-                                        UObject* ls = addToHBox(pmRow, pmLabel);
-                                        if (ls) { umgSetSlotSize(ls, 1.0f, 1); umgSetSlotPadding(ls, 0.0f, 24.0f, 0.0f, 24.0f); umgSetVAlign(ls, 2); }
-                                    }
-
-                                    // Button: PEACE (green) when enabled, FIGHT (red/orange) when disabled
-                                    if (texKeyBox)
-                                    {
-                                        FStaticConstructObjectParameters kbOlP(overlayClass, outer);
-                                        UObject* kbOl = UObjectGlobals::StaticConstructObject(kbOlP);
-                                        if (kbOl)
-                                        {
-                                            FStaticConstructObjectParameters kbImgP(imageClass, outer);
-                                            UObject* kbImg = UObjectGlobals::StaticConstructObject(kbImgP);
-                                            if (kbImg)
-                                            {
-                                                umgSetBrushNoMatch(kbImg, texKeyBox, setBrushFn);
-                                                umgSetBrushSize(kbImg, 400.0f, 128.0f);
-                                                addToOverlay(kbOl, kbImg);
-                                                m_ftPeaceBtnImg = kbImg;
-                                            }
-                                            bool on = m_peaceModeEnabled;
-                                            UObject* kbLabel = makeTB(on ? L"PEACE" : L"FIGHT",
-                                                                       on ? 0.31f : 0.9f,
-                                                                       on ? 0.86f : 0.45f,
-                                                                       on ? 0.47f : 0.25f,
-                                                                       1.0f, 24);
-                                            if (kbLabel)
-                                            {
-                                                umgSetBold(kbLabel);
-                                                m_ftPeaceBtnLabel = kbLabel;
-                                                UObject* ks = addToOverlay(kbOl, kbLabel);
-                                                if (ks) { umgSetHAlign(ks, 2); umgSetVAlign(ks, 2); }
-                                            }
-                                            UObject* kbSlot = addToHBox(pmRow, kbOl);
-                                            if (kbSlot) umgSetSlotPadding(kbSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                        }
-                                    }
-
-                                    addToVBox(t4, pmRow);
-                                }
+                                bool on = m_peaceModeEnabled;
+                                const std::wstring pmTexts[] = {STR("Peace Mode"), on ? STR("PEACE") : STR("FIGHT")};
+                                const UiColor pmTint = on ? UiColor{0.31f, 0.86f, 0.47f, 1.0f} : UiColor{0.9f, 0.45f, 0.25f, 1.0f};
+                                UObject* pmOut[5]{};   // check image, label, button image, button label, checkbox overlay
+                                instantiateUiTree(ui, kFtToggleRow, kFtStyles, {pmTexts, &pmTint, pmOut, t4, UiOp::AddToVBox});
+                                m_ftPeaceCheckImg = pmOut[0];
+                                m_ftPeaceBtnImg = pmOut[2];
+                                m_ftPeaceBtnLabel = pmOut[3];
+                                m_ftPeaceCheckBoxOl = pmOut[4];
+                                if (pmOut[0] && !on) presetWidgetVisibility(pmOut[0], 1); // Collapsed
                             }
 
                             // populate the cheat entries table (Clear All + categories + toggles)
@@ -3854,20 +3833,8 @@
                                     int h = 80;
                                     m_buffRowHeights[i] = h;
 
-                                    FStaticConstructObjectParameters secOlP(overlayClass, outer);
-                                    UObject* secOl = UObjectGlobals::StaticConstructObject(secOlP);
-                                    if (secOl)
-                                    {
-                                        if (texSectionBg)
-                                        {
-                                            FStaticConstructObjectParameters secImgP(imageClass, outer);
-                                            UObject* secImg = UObjectGlobals::StaticConstructObject(secImgP);
-                                            if (secImg) { umgSetBrushNoMatch(secImg, texSectionBg, setBrushFn); umgSetBrushSize(secImg, 900.0f, 80.0f); addToOverlay(secOl, secImg); }
-                                        }
-                                        UObject* secLabel = makeTB(e.label, 0.78f, 0.86f, 1.0f, 1.0f, 28);
-                                        if (secLabel) { umgSetBold(secLabel); UObject* ts = addToOverlay(secOl, secLabel); if (ts) { umgSetHAlign(ts, 2); umgSetVAlign(ts, 2); } }
-                                        addToVBox(t4, secOl);
-                                    }
+                                    const std::wstring title(e.label);
+                                    instantiateUiTree(ui, kFtSectionHeaderPlain, kFtStyles, {&title, nullptr, nullptr, t4, UiOp::AddToVBox});
                                     yCursor += h;
                                 }
                                 else if (e.kind == CheatRowKind::ClearAllBtn)
@@ -3875,33 +3842,9 @@
                                     int h = 128;
                                     m_buffRowHeights[i] = h;
 
-                                    FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                    UObject* row = UObjectGlobals::StaticConstructObject(rowP);
-                                    if (row)
-                                    {
-                                        UObject* lbl = makeTB(e.label, 0.86f, 0.90f, 0.96f, 0.85f, 24);
-                                        if (lbl)
-                                        {
-                                            UObject* ls = addToHBox(row, lbl);
-                                            if (ls) { umgSetSlotSize(ls, 1.0f, 1); umgSetSlotPadding(ls, 92.0f, 24.0f, 0.0f, 24.0f); umgSetVAlign(ls, 2); }
-                                        }
-                                        if (texKeyBox)
-                                        {
-                                            FStaticConstructObjectParameters kbOlP(overlayClass, outer);
-                                            UObject* kbOl = UObjectGlobals::StaticConstructObject(kbOlP);
-                                            if (kbOl)
-                                            {
-                                                FStaticConstructObjectParameters kbImgP(imageClass, outer);
-                                                UObject* kbImg = UObjectGlobals::StaticConstructObject(kbImgP);
-                                                if (kbImg) { umgSetBrushNoMatch(kbImg, texKeyBox, setBrushFn); umgSetBrushSize(kbImg, 400.0f, 128.0f); addToOverlay(kbOl, kbImg); }
-                                                UObject* kbLabel = makeTB(STR("CLEAR"), 0.95f, 0.4f, 0.4f, 1.0f, 24);
-                                                if (kbLabel) { umgSetBold(kbLabel); UObject* ks = addToOverlay(kbOl, kbLabel); if (ks) { umgSetHAlign(ks, 2); umgSetVAlign(ks, 2); } }
-                                                UObject* kbSlot = addToHBox(row, kbOl);
-                                                if (kbSlot) umgSetSlotPadding(kbSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                            }
-                                        }
-                                        addToVBox(t4, row);
-                                    }
+                                    const std::wstring texts[] = {e.label, STR("CLEAR")};
+                                    const UiColor tint{0.95f, 0.4f, 0.4f, 1.0f};
+                                    instantiateUiTree(ui, kFtButtonRow, kFtStyles, {texts, &tint, nullptr, t4, UiOp::AddToVBox});
                                     yCursor += h;
                                 }
                                 else  // BuffToggle — checkbox + label + ON/OFF button
@@ -3909,77 +3852,15 @@
                                     int h = 128;
                                     m_buffRowHeights[i] = h;
 
-                                    FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                    UObject* row = UObjectGlobals::StaticConstructObject(rowP);
-                                    if (row)
-                                    {
-                                        // Checkbox overlay (diamond + optional check mark)
-                                        if (texCB)
-                                        {
-                                            FStaticConstructObjectParameters olP(overlayClass, outer);
-                                            UObject* cbOl = UObjectGlobals::StaticConstructObject(olP);
-                                            if (cbOl)
-                                            {
-                                                FStaticConstructObjectParameters imgP(imageClass, outer);
-                                                UObject* cbBg = UObjectGlobals::StaticConstructObject(imgP);
-                                                if (cbBg) { umgSetBrushNoMatch(cbBg, texCB, setBrushFn); umgSetBrushSize(cbBg, 80.0f, 80.0f); addToOverlay(cbOl, cbBg); }
-                                                if (texCheck)
-                                                {
-                                                    FStaticConstructObjectParameters chkP(imageClass, outer);
-                                                    UObject* chkImg = UObjectGlobals::StaticConstructObject(chkP);
-                                                    if (chkImg)
-                                                    {
-                                                        umgSetBrushNoMatch(chkImg, texCheck, setBrushFn);
-                                                        umgSetBrushSize(chkImg, 80.0f, 80.0f);
-                                                        addToOverlay(cbOl, chkImg);
-                                                        m_ftBuffCheckImgs[i] = chkImg;
-                                                        // Reflect current state (persisted across F12 rebuilds)
-                                                        auto* visFn = chkImg->GetFunctionByNameInChain(STR("SetVisibility"));
-                                                        if (visFn) { uint8_t vp[8]{}; vp[0] = m_buffStates[i] ? 0 : 1; safeProcessEvent(chkImg, visFn, vp); }
-                                                    }
-                                                }
-                                                UObject* cbSlot = addToHBox(row, cbOl);
-                                                if (cbSlot) umgSetSlotPadding(cbSlot, 4.0f, 24.0f, 8.0f, 24.0f);
-                                            }
-                                        }
-
-                                        // Label
-                                        UObject* lbl = makeTB(e.label, 0.86f, 0.90f, 0.96f, 1.0f, 24);
-                                        if (lbl)
-                                        {
-                                            UObject* ls = addToHBox(row, lbl);
-                                            if (ls) { umgSetSlotSize(ls, 1.0f, 1); umgSetSlotPadding(ls, 0.0f, 24.0f, 0.0f, 24.0f); umgSetVAlign(ls, 2); }
-                                        }
-
-                                        // ON/OFF button
-                                        if (texKeyBox)
-                                        {
-                                            FStaticConstructObjectParameters kbOlP(overlayClass, outer);
-                                            UObject* kbOl = UObjectGlobals::StaticConstructObject(kbOlP);
-                                            if (kbOl)
-                                            {
-                                                FStaticConstructObjectParameters kbImgP(imageClass, outer);
-                                                UObject* kbImg = UObjectGlobals::StaticConstructObject(kbImgP);
-                                                if (kbImg) { umgSetBrushNoMatch(kbImg, texKeyBox, setBrushFn); umgSetBrushSize(kbImg, 400.0f, 128.0f); addToOverlay(kbOl, kbImg); }
-                                                bool bOn = m_buffStates[i];
-                                                UObject* kbLabel = makeTB(bOn ? STR("ON") : STR("OFF"),
-                                                                          bOn ? 0.31f : 0.7f,
-                                                                          bOn ? 0.86f : 0.3f,
-                                                                          bOn ? 0.47f : 0.3f, 1.0f, 24);
-                                                if (kbLabel)
-                                                {
-                                                    umgSetBold(kbLabel);
-                                                    m_ftBuffBtnLabels[i] = kbLabel;
-                                                    UObject* ks = addToOverlay(kbOl, kbLabel);
-                                                    if (ks) { umgSetHAlign(ks, 2); umgSetVAlign(ks, 2); }
-                                                }
-                                                UObject* kbSlot = addToHBox(row, kbOl);
-                                                if (kbSlot) umgSetSlotPadding(kbSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                            }
-                                        }
-
-                                        addToVBox(t4, row);
-                                    }
+                                    bool bOn = m_buffStates[i];
+                                    const std::wstring texts[] = {e.label, bOn ? STR("ON") : STR("OFF")};
+                                    const UiColor tint = bOn ? UiColor{0.31f, 0.86f, 0.47f, 1.0f} : UiColor{0.7f, 0.3f, 0.3f, 1.0f};
+                                    UObject* out[5]{};   // check image, label, button image, button label, checkbox overlay
+                                    instantiateUiTree(ui, kFtToggleRow, kFtStyles, {texts, &tint, out, t4, UiOp::AddToVBox});
+                                    m_ftBuffCheckImgs[i] = out[0];
+                                    m_ftBuffBtnLabels[i] = out[3];
+                                    // Reflect current state (persisted across F12 rebuilds)
+                                    if (out[0] && !bOn) presetWidgetVisibility(out[0], 1); // Collapsed
                                     yCursor += h;
                                 }
                             }
@@ -4016,81 +3897,36 @@
                                 {
                                     int h = 80;
                                     m_tweakRowHeights[i] = h;
-                                    FStaticConstructObjectParameters secOlP(overlayClass, outer);
-                                    UObject* secOl = UObjectGlobals::StaticConstructObject(secOlP);
-                                    if (secOl)
-                                    {
-                                        if (texSectionBg)
-                                        {
-                                            FStaticConstructObjectParameters secImgP(imageClass, outer);
-                                            UObject* secImg = UObjectGlobals::StaticConstructObject(secImgP);
-                                            if (secImg) { umgSetBrushNoMatch(secImg, texSectionBg, setBrushFn); umgSetBrushSize(secImg, 900.0f, 80.0f); addToOverlay(secOl, secImg); }
-                                        }
-                                        UObject* secLabel = makeTB(e.label, 0.78f, 0.86f, 1.0f, 1.0f, 28);
-                                        if (secLabel) { umgSetBold(secLabel); UObject* ts = addToOverlay(secOl, secLabel); if (ts) { umgSetHAlign(ts, 2); umgSetVAlign(ts, 2); } }
-                                        addToVBox(t5, secOl);
-                                    }
+                                    const std::wstring title(e.label);
+                                    instantiateUiTree(ui, kFtSectionHeaderPlain, kFtStyles, {&title, nullptr, nullptr, t5, UiOp::AddToVBox});
                                     yCursor += h;
                                 }
                                 else  // TweakRow / SpecialNoCost / SpecialInstantCraft — label + cycling value button
                                 {
                                     int h = 128;
                                     m_tweakRowHeights[i] = h;
-                                    FStaticConstructObjectParameters rowP(hboxClass, outer);
-                                    UObject* row = UObjectGlobals::StaticConstructObject(rowP);
-                                    if (row)
-                                    {
-                                        UObject* lbl = makeTB(e.label, 0.86f, 0.90f, 0.96f, 0.85f, 24);
-                                        if (lbl)
-                                        {
-                                            UObject* ls = addToHBox(row, lbl);
-                                            if (ls) { umgSetSlotSize(ls, 1.0f, 1); umgSetSlotPadding(ls, 92.0f, 24.0f, 0.0f, 24.0f); umgSetVAlign(ls, 2); }
-                                        }
-
-                                        if (texKeyBox)
-                                        {
-                                            FStaticConstructObjectParameters kbOlP(overlayClass, outer);
-                                            UObject* kbOl = UObjectGlobals::StaticConstructObject(kbOlP);
-                                            if (kbOl)
-                                            {
-                                                FStaticConstructObjectParameters kbImgP(imageClass, outer);
-                                                UObject* kbImg = UObjectGlobals::StaticConstructObject(kbImgP);
-                                                if (kbImg) { umgSetBrushNoMatch(kbImg, texKeyBox, setBrushFn); umgSetBrushSize(kbImg, 400.0f, 128.0f); addToOverlay(kbOl, kbImg); }
-
-                                                // Initial button text based on current cycle index.
-                                                // Index 0 = DEFAULT (always). Otherwise format depends on kind.
-                                                int ci = m_tweakCurrentIdx[i];
-                                                if (ci < 0 || ci >= (int)e.cycleValues.size()) ci = 0;
-                                                bool isDef = (ci == 0);
-                                                int initVal = e.cycleValues.empty() ? 0 : e.cycleValues[ci];
-                                                wchar_t textBuf[32];
-                                                if (isDef)
-                                                    swprintf(textBuf, 32, L"DEFAULT");
-                                                else if (e.kind == TweakKind::SpecialNoCost ||
-                                                         e.kind == TweakKind::SpecialInstantCraft)
-                                                    swprintf(textBuf, 32, L"ON");
-                                                else if (e.isMultiplier)
-                                                    swprintf(textBuf, 32, L"%dx", initVal);
-                                                else
-                                                    swprintf(textBuf, 32, L"%d", initVal);
-
-                                                float r = isDef ? 0.7f  : 0.31f;
-                                                float g = isDef ? 0.7f  : 0.86f;
-                                                float b = isDef ? 0.55f : 0.47f;
-                                                UObject* kbLabel = makeTB(textBuf, r, g, b, 1.0f, 24);
-                                                if (kbLabel)
-                                                {
-                                                    umgSetBold(kbLabel);
-                                                    m_ftTweakBtnLabels[i] = kbLabel;
-                                                    UObject* ks = addToOverlay(kbOl, kbLabel);
-                                                    if (ks) { umgSetHAlign(ks, 2); umgSetVAlign(ks, 2); }
-                                                }
-                                                UObject* kbSlot = addToHBox(row, kbOl);
-                                                if (kbSlot) umgSetSlotPadding(kbSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                            }
-                                        }
-                                        addToVBox(t5, row);
-                                    }
+                                    // Initial button text based on current cycle index.
+                                    // Index 0 = DEFAULT (always). Otherwise format depends on kind.
+                                    int ci = m_tweakCurrentIdx[i];
+                                    if (ci < 0 || ci >= (int)e.cycleValues.size()) ci = 0;
+                                    bool isDef = (ci == 0);
+                                    int initVal = e.cycleValues.empty() ? 0 : e.cycleValues[ci];
+                                    wchar_t textBuf[32];
+                                    if (isDef)
+                                        swprintf(textBuf, 32, L"DEFAULT");
+                                    else if (e.kind == TweakKind::SpecialNoCost ||
+                                             e.kind == TweakKind::SpecialInstantCraft)
+                                        swprintf(textBuf, 32, L"ON");
+                                    else if (e.isMultiplier)
+                                        swprintf(textBuf, 32, L"%dx", initVal);
+                                    else
+                                        swprintf(textBuf, 32, L"%d", initVal);
+
+                                    const std::wstring texts[] = {e.label, textBuf};
+                                    const UiColor tint = isDef ? UiColor{0.7f, 0.7f, 0.55f, 1.0f} : UiColor{0.31f, 0.86f, 0.47f, 1.0f};
+                                    UObject* out[2]{};   // button image, button label
+                                    instantiateUiTree(ui, kFtButtonRow, kFtStyles, {texts, &tint, out, t5, UiOp::AddToVBox});
+                                    m_ftTweakBtnLabels[i] = out[1];
                                     yCursor += h;
                                 }
                             }
@@ -4100,7 +3936,7 @@
                         }
 
 
-                        UObject* tab0Content = m_ftTabContent[0];
+                        UObject* tab0Content = m_ftTabContent[0] ? m_ftTabContent[0] : scrollBox;
                         const wchar_t* lastSection = nullptr;
                         for (int b = 0; b < BIND_COUNT; b++)
                         {
@@ -4112,162 +3948,25 @@
                             if (!lastSection || s_bindings[b].section != lastSection)
                             {
                                 lastSection = s_bindings[b].section.c_str();
-                                if (texSectionBg)
-                                {
-                                    FStaticConstructObjectParameters secOlP(overlayClass, outer);
-                                    UObject* secOl = UObjectGlobals::StaticConstructObject(secOlP);
-                                    if (secOl)
-                                    {
-                                        FStaticConstructObjectParameters secImgP(imageClass, outer);
-                                        UObject* secImg = UObjectGlobals::StaticConstructObject(secImgP);
-                                        if (secImg)
-                                        {
-                                            umgSetBrushNoMatch(secImg, texSectionBg, setBrushFn);
-                                            umgSetBrushSize(secImg, 900.0f, 80.0f);
-                                            addToOverlay(secOl, secImg);
-                                        }
-                                        UObject* secLabel = makeTB(lastSection, 0.78f, 0.86f, 1.0f, 1.0f, 28);
-                                        if (secLabel)
-                                        {
-                                            umgSetBold(secLabel);
-                                            UObject* ts = addToOverlay(secOl, secLabel);
-                                            if (ts) { umgSetHAlign(ts, 2); umgSetVAlign(ts, 2); }
-                                        }
-                                        addChildToPanel(tab0Content ? tab0Content : scrollBox, STR("AddChild"), secOl);
-                                    }
-                                }
-                            }
-
-
-                            FStaticConstructObjectParameters rowHbP(hboxClass, outer);
-                            UObject* rowHBox = UObjectGlobals::StaticConstructObject(rowHbP);
-                            if (!rowHBox) continue;
-
-
-                            if (texCB)
-                            {
-                                FStaticConstructObjectParameters cbOlP(overlayClass, outer);
-                                UObject* cbOl = UObjectGlobals::StaticConstructObject(cbOlP);
-                                if (cbOl)
-                                {
-                                    FStaticConstructObjectParameters cbImgP(imageClass, outer);
-                                    UObject* cbBg = UObjectGlobals::StaticConstructObject(cbImgP);
-                                    if (cbBg)
-                                    {
-                                        umgSetBrushNoMatch(cbBg, texCB, setBrushFn);
-                                        umgSetBrushSize(cbBg, 80.0f, 80.0f);
-                                        addToOverlay(cbOl, cbBg);
-                                    }
-                                    if (texCheck)
-                                    {
-                                        FStaticConstructObjectParameters chkImgP(imageClass, outer);
-                                        UObject* chkImg = UObjectGlobals::StaticConstructObject(chkImgP);
-                                        if (chkImg)
-                                        {
-                                            umgSetBrushNoMatch(chkImg, texCheck, setBrushFn);
-                                            umgSetBrushSize(chkImg, 80.0f, 80.0f);
-                                            addToOverlay(cbOl, chkImg);
-                                            m_ftCheckImages[b] = chkImg;
-
-                                            if (!s_bindings[b].enabled)
-                                            {
-                                                auto* visFn = chkImg->GetFunctionByNameInChain(STR("SetVisibility"));
-                                                if (visFn) { uint8_t vp[8]{}; vp[0] = 2; safeProcessEvent(chkImg, visFn, vp); }
-                                            }
-                                        }
-                                    }
-                                    UObject* cbSlot = addToHBox(rowHBox, cbOl);
-                                    if (cbSlot) umgSetSlotPadding(cbSlot, 4.0f, 24.0f, 8.0f, 24.0f);
-                                }
-                            }
-
-
-                            UObject* bindLabel = makeTB(s_bindings[b].label, 0.86f, 0.90f, 0.96f, 0.85f, 24);
-                            if (bindLabel)
-                            {
-                                UObject* lblSlot = addToHBox(rowHBox, bindLabel);
-                                if (lblSlot)
-                                {
-                                    umgSetSlotSize(lblSlot, 1.0f, 1);
-                                    umgSetSlotPadding(lblSlot, 0.0f, 24.0f, 0.0f, 24.0f);
-                                    umgSetVAlign(lblSlot, 2);
-                                }
+                                std::wstring title(lastSection);
+                                instantiateUiTree(ui, kFtSectionHeader, kFtStyles, {&title, nullptr, nullptr, tab0Content, UiOp::AddChild});
                             }
 
 
-                            if (texKeyBox)
-                            {
-                                FStaticConstructObjectParameters kbOlP(overlayClass, outer);
-                                UObject* kbOl = UObjectGlobals::StaticConstructObject(kbOlP);
-                                if (kbOl)
-                                {
-                                    FStaticConstructObjectParameters kbImgP(imageClass, outer);
-                                    UObject* kbImg = UObjectGlobals::StaticConstructObject(kbImgP);
-                                    if (kbImg)
-                                    {
-                                        umgSetBrushNoMatch(kbImg, texKeyBox, setBrushFn);
-                                        umgSetBrushSize(kbImg, 400.0f, 128.0f);
-                                        addToOverlay(kbOl, kbImg);
-                                    }
-                                    UObject* kbLabel = makeTB(keyName(s_bindings[b].key), 1.0f, 1.0f, 1.0f, 1.0f, 24);
-                                    if (kbLabel)
-                                    {
-                                        m_ftKeyBoxLabels[b] = kbLabel;
-                                        UObject* ks = addToOverlay(kbOl, kbLabel);
-                                        if (ks) { umgSetHAlign(ks, 2); umgSetVAlign(ks, 2); }
-                                    }
-                                    UObject* kbSlot = addToHBox(rowHBox, kbOl);
-                                    if (kbSlot) umgSetSlotPadding(kbSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                }
-                            }
-
-                            addChildToPanel(tab0Content ? tab0Content : scrollBox, STR("AddChild"), rowHBox);
+                            const std::wstring rowTexts[] = {s_bindings[b].label, keyName(s_bindings[b].key)};
+                            UObject* rowOut[2]{};   // check image, key label
+                            if (!instantiateUiTree(ui, kFtBindRow, kFtStyles, {rowTexts, nullptr, rowOut, tab0Content, UiOp::AddChild})) continue;
+                            m_ftCheckImages[b] = rowOut[0];
+                            m_ftKeyBoxLabels[b] = rowOut[1];
+                            if (rowOut[0] && !s_bindings[b].enabled) presetWidgetVisibility(rowOut[0], 2); // Hidden
                         }
 
 
                         {
-                            FStaticConstructObjectParameters modHbP(hboxClass, outer);
-                            UObject* modRow = UObjectGlobals::StaticConstructObject(modHbP);
-                            if (modRow)
-                            {
-                                UObject* modLabel = makeTB(Loc::get("ui.set_modifier_key_short"), 0.86f, 0.90f, 0.96f, 0.85f, 24);
-                                if (modLabel)
-                                {
-                                    UObject* ls = addToHBox(modRow, modLabel);
-                                    if (ls)
-                                    {
-                                        umgSetSlotSize(ls, 1.0f, 1);
-                                        umgSetSlotPadding(ls, 92.0f, 24.0f, 0.0f, 24.0f);
-                                        umgSetVAlign(ls, 2);
-                                    }
-                                }
-                                if (texKeyBox)
-                                {
-                                    FStaticConstructObjectParameters mkOlP(overlayClass, outer);
-                                    UObject* mkOl = UObjectGlobals::StaticConstructObject(mkOlP);
-                                    if (mkOl)
-                                    {
-                                        FStaticConstructObjectParameters mkImgP(imageClass, outer);
-                                        UObject* mkImg = UObjectGlobals::StaticConstructObject(mkImgP);
-                                        if (mkImg)
-                                        {
-                                            umgSetBrushNoMatch(mkImg, texKeyBox, setBrushFn);
-                                            umgSetBrushSize(mkImg, 400.0f, 128.0f);
-                                            addToOverlay(mkOl, mkImg);
-                                        }
-                                        UObject* mkLabel = makeTB(std::wstring(modifierName(s_modifierVK)), 1.0f, 1.0f, 1.0f, 1.0f, 24);
-                                        if (mkLabel)
-                                        {
-                                            m_ftModBoxLabel = mkLabel;
-                                            UObject* ms = addToOverlay(mkOl, mkLabel);
-                                            if (ms) { umgSetHAlign(ms, 2); umgSetVAlign(ms, 2); }
-                                        }
-                                        UObject* mkSlot = addToHBox(modRow, mkOl);
-                                        if (mkSlot) umgSetSlotPadding(mkSlot, 0.0f, 0.0f, 50.0f, 0.0f);
-                                    }
-                                }
-                                addChildToPanel(tab0Content ? tab0Content : scrollBox, STR("AddChild"), modRow);
-                            }
+                            const std::wstring modTexts[] = {Loc::get("ui.set_modifier_key_short"), std::wstring(modifierName(s_modifierVK))};
+                            UObject* modOut[1]{};   // key label
+                            instantiateUiTree(ui, kFtKeyValueRow, kFtStyles, {modTexts, nullptr, modOut, tab0Content, UiOp::AddChild});
+                            m_ftModBoxLabel = modOut[0];
                         }
 
                         VLOG(STR("[MoriaCppMod] [Settings] Keybinding rows populated\n"));
@@ -4328,7 +4027,9 @@
             updateFtNoCollision();
             updateFtGameOptCheckboxes();
             showOnScreen(Loc::get("msg.settings_opened"), 3.0f, 0.0f, 1.0f, 0.0f);
-            VLOG(STR("[MoriaCppMod] [Settings] Panel created and displayed\n"));
+            VLOG(STR("[MoriaCppMod] [Settings] Panel created and displayed in {:.1f} ms ({} table widgets, {} ProcessEvent calls vs {} hand-built; call sites {} cached / {} resolved)\n"),
+                 std::chrono::duration<double, std::milli>(Clock::now() - tBuild).count(), ui.widgets, ui.calls, ui.legacyCalls,
+                 m_uiCalls.hits() - callHits0, m_uiCalls.misses() - callMisses0);
         }
 
 
@@ -4676,23 +4377,50 @@
                 return;
             }
 
-            // 2. Spawn the popup chrome.
-            UObject* popup = jw_createGameWidget(popupCls);
-            if (!popup)
+            // 2. Reuse the popup + input pair parked by the last close; its
+            //    text box is cleared, everything else was set up when built.
+            UObject* popup = nullptr;
+            UObject* editBox = nullptr;
+            UObject* inputUW = nullptr;
+            if (auto parked = m_renamePopupPool.acquire([](const PooledRenamePopup& p) {
+                    UObject* eb = p.editBox.Get();
+                    return pooledWidgetAlive(p.popup) && pooledWidgetAlive(p.input) && eb && isObjectAlive(eb);
+                }))
             {
-                VLOG(STR("[MoriaCppMod] [Rename v2] popup spawn failed\n"));
-                showErrorBox(L"Rename: failed to spawn popup widget.");
-                return;
+                popup = unparkPooledWidget(parked->popup, 500);
+                inputUW = unparkPooledWidget(parked->input, 501);
+                editBox = parked->editBox.Get();
+                umgSetText(editBox, L"");
+            }
+            const bool reused = popup && inputUW;
+            logWidgetPool(STR("rename popup"), m_renamePopupPool, reused);
+            if (!reused)   // half a pair at most; rebuild both
+            {
+                if (popup) deferRemoveWidget(popup);
+                if (inputUW) deferRemoveWidget(inputUW);
+                popup = nullptr;
             }
 
-            // 3. AddToViewport at high Z (above pause menu ~100, below our
-            //    input UW which sits at 501).
-            if (auto* fn = popup->GetFunctionByNameInChain(STR("AddToViewport")))
+            // Otherwise spawn the popup chrome.
+            if (!reused)
             {
-                std::vector<uint8_t> bb(fn->GetParmsSize(), 0);
-                if (auto* p = findParam(fn, STR("ZOrder")))
-                    *reinterpret_cast<int32_t*>(bb.data() + p->GetOffset_Internal()) = 500;
-                safeProcessEvent(popup, fn, bb.data());
+                popup = jw_createGameWidget(popupCls);
+                if (!popup)
+                {
+                    VLOG(STR("[MoriaCppMod] [Rename v2] popup spawn failed\n"));
+                    showErrorBox(L"Rename: failed to spawn popup widget.");
+                    return;
+                }
+
+                // 3. AddToViewport at high Z (above pause menu ~100, below our
+                //    input UW which sits at 501).
+                if (auto* fn = popup->GetFunctionByNameInChain(STR("AddToViewport")))
+                {
+                    std::vector<uint8_t> bb(fn->GetParmsSize(), 0);
+                    if (auto* p = findParam(fn, STR("ZOrder")))
+                        *reinterpret_cast<int32_t*>(bb.data() + p->GetOffset_Internal()) = 500;
+                    safeProcessEvent(popup, fn, bb.data());
+                }
             }
 
             // 4. Configure title + buttons via OnShowWithTwoButtons. Pad
@@ -4723,6 +4451,10 @@
                 confirmBtn = *p;
             if (auto* p = popup->GetValuePtrByPropertyNameInChain<UObject*>(STR("CancelButton")))
                 cancelBtn = *p;
+            // A reused popup registered these on an earlier open.
+            std::erase_if(m_gameOptButtons, [](const GameOptButton& g) {
+                return g.kind == GameOptKind::RenameModalConfirm || g.kind == GameOptKind::RenameModalCancel;
+            });
             if (confirmBtn) {
                 GameOptButton g; g.widget = FWeakObjectPtr(confirmBtn);
                 g.kind = GameOptKind::RenameModalConfirm; g.fromPauseMenu = false;
@@ -4737,10 +4469,12 @@
             // 6. Build a tiny dedicated UserWidget that hosts a centered
             //    UEditableTextBox so the user has a real text input. The
             //    UserWidget is added to viewport separately at ZOrder=501
-            //    so it floats over the popup's Message area.
-            UObject* editBox = nullptr;
-            UObject* inputUW = nullptr;
+            //    so it floats over the popup's Message area. (Kept from the
+            //    parked pair when reused.)
+            if (!reused)
             {
+                editBox = nullptr;
+                inputUW = nullptr;
                 auto* userWidgetClass = UObjectGlobals::StaticFindObject<UClass*>(nullptr, nullptr, STR("/Script/UMG.UserWidget"));
                 auto* canvasClass     = UObjectGlobals::StaticFindObject<UClass*>(nullptr, nullptr, STR("/Script/UMG.CanvasPanel"));
                 auto* sizeBoxClass    = UObjectGlobals::StaticFindObject<UClass*>(nullptr, nullptr, STR("/Script/UMG.SizeBox"));
@@ -4952,17 +4686,23 @@
         void hideRenameDialog()
         {
             if (!m_ftRenameVisible) return;
-            if (m_ftRenameWidget)
+            // Park the popup and its input UserWidget (the standalone
+            // EditableTextBox host at ZOrder=501) for the next open; remove
+            // them only if either is gone or the pool is full.
+            UObject* inputUW = m_ftRenameInputUW.Get();
+            bool parked = false;
+            if (m_ftRenameWidget && isObjectAlive(m_ftRenameWidget) && inputUW && isObjectAlive(inputUW) &&
+                m_ftRenameInput && isObjectAlive(m_ftRenameInput))
             {
-                deferRemoveWidget(m_ftRenameWidget);
-                m_ftRenameWidget = nullptr;
+                parked = m_renamePopupPool.release(
+                        {parkPooledWidget(m_ftRenameWidget), parkPooledWidget(inputUW), FWeakObjectPtr(m_ftRenameInput)});
             }
-            // also remove our injected input UserWidget if present
-            // (the standalone EditableTextBox host added at ZOrder=501).
-            if (UObject* inputUW = m_ftRenameInputUW.Get())
+            if (!parked)
             {
-                deferRemoveWidget(inputUW);
+                if (m_ftRenameWidget) deferRemoveWidget(m_ftRenameWidget);
+                if (inputUW) deferRemoveWidget(inputUW);
             }
+            m_ftRenameWidget = nullptr;
             m_ftRenameInputUW = FWeakObjectPtr{};
             m_ftRenameInput = nullptr;
             m_ftRenameConfirmLabel = nullptr;
@@ -4995,7 +4735,7 @@
                 else
                     setInputModeGame();
             }
-            VLOG(STR("[MoriaCppMod] [Rename] Dialog closed (deferred removal)\n"));
+            VLOG(STR("[MoriaCppMod] [Rename] Dialog closed ({})\n"), parked ? STR("parked") : STR("deferred removal"));
         }
 
         void confirmRenameDialog()
@@ -5076,147 +4816,254 @@
         }
 
 
-        void rebuildFtRemovalList()
+        // ── Saved-removals list (F12 Hide Environment tab) ──────────────
+        // A save can hold thousands of removals, so the list is virtualized:
+        // createFtRemovalList() builds FT_REMOVAL_POOL fixed-height rows
+        // between two SizeBox spacers once, when the panel is built.
+        // bindFtRemovalList() points those rows at the window of
+        // m_ftRemovalGroups.rows() under the scroll offset and sizes the
+        // spacers so the scroll box still spans the whole list. Rows are
+        // rebound (text, colour, visibility) only when the window moves or
+        // the data changes; widgets are never created or cleared afterwards.
+        // Grouping by bubble lives in RemovalGroupIndex (moria_removal_list.h),
+        // which updates incrementally when a removal is added or undone.
+
+        void setFtRemovalRowHeight(UObject* sizeBox, float h)
         {
-            if (!m_ftRemovalVBox || !isObjectAlive(m_ftRemovalVBox)) { m_ftRemovalVBox = nullptr; return; }
+            if (!sizeBox || !isObjectAlive(sizeBox)) return;
+            auto* fn = sizeBox->GetFunctionByNameInChain(STR("SetHeightOverride"));
+            if (!fn) return;
+            auto* p = findParam(fn, STR("InHeightOverride"));
+            if (!p) return;
+            std::vector<uint8_t> buf(fn->GetParmsSize(), 0);
+            *reinterpret_cast<float*>(buf.data() + p->GetOffset_Internal()) = h;
+            safeProcessEvent(sizeBox, fn, buf.data());
+        }
+
+        float ftScrollOffset()
+        {
+            if (!m_ftScrollBox || !isObjectAlive(m_ftScrollBox)) return 0.0f;
+            auto* fn = m_ftScrollBox->GetFunctionByNameInChain(STR("GetScrollOffset"));
+            if (!fn) return 0.0f;
+            int sz = fn->GetParmsSize();
+            std::vector<uint8_t> sp(sz, 0);
+            safeProcessEvent(m_ftScrollBox, fn, sp.data());
+            auto* pRV = findParam(fn, STR("ReturnValue"));
+            if (!pRV || pRV->GetOffset_Internal() + (int)sizeof(float) > sz) return 0.0f;
+            return *reinterpret_cast<float*>(sp.data() + pRV->GetOffset_Internal());
+        }
 
+        void resetFtRemovalList()
+        {
+            m_ftRemovalVBox = nullptr;
+            m_ftRemovalHeader = nullptr;
+            m_ftRemovalTopPad = nullptr;
+            m_ftRemovalBottomPad = nullptr;
+            for (auto& row : m_ftRemovalRows) row = FtRemovalRow{};
+            m_ftRemovalFirst = -1;
+            m_ftRemovalBoundVersion = 0;
+            m_ftLastRemovalCount = -1;
+        }
+
+        // Row pool for the saved-removals list, appended to `tab` below its
+        // header. Each row is a SizeBox (FT_REMOVAL_ROW_H) holding
+        // [danger icon][name / coords]; header rows reuse the name text.
+        void createFtRemovalList(UObject* tab, UObject* outer, UObject* defaultFont)
+        {
+            resetFtRemovalList();
             auto* imageClass = UObjectGlobals::StaticFindObject<UClass*>(nullptr, nullptr, STR("/Script/UMG.Image"));
             auto* hboxClass = UObjectGlobals::StaticFindObject<UClass*>(nullptr, nullptr, STR("/Script/UMG.HorizontalBox"));
             auto* vboxClass = UObjectGlobals::StaticFindObject<UClass*>(nullptr, nullptr, STR("/Script/UMG.VerticalBox"));
             auto* textBlockClass = UObjectGlobals::StaticFindObject<UClass*>(nullptr, nullptr, STR("/Script/UMG.TextBlock"));
+            auto* sizeBoxClass = UObjectGlobals::StaticFindObject<UClass*>(nullptr, nullptr, STR("/Script/UMG.SizeBox"));
             auto* setBrushFn = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.Image:SetBrushFromTexture"));
-            if (!imageClass || !hboxClass || !vboxClass || !textBlockClass) return;
+            if (!tab || !imageClass || !hboxClass || !vboxClass || !textBlockClass || !sizeBoxClass) return;
 
-            UObject* outer = m_ftRemovalVBox->GetOuterPrivate();
-            if (!outer) outer = m_ftRemovalVBox;
+            FStaticConstructObjectParameters rvP(vboxClass, outer);
+            UObject* remVBox = UObjectGlobals::StaticConstructObject(rvP);
+            if (!remVBox) return;
+            addToVBox(tab, remVBox);
+            m_ftRemovalVBox = remVBox;
 
-            // Hide before ClearChildren to prevent Slate PaintFastPath crash
-            setWidgetVisibility(m_ftRemovalVBox, 1); // Collapsed
-            auto* clearFn = m_ftRemovalVBox->GetFunctionByNameInChain(STR("ClearChildren"));
-            if (clearFn) safeProcessEvent(m_ftRemovalVBox, clearFn, nullptr);
-
-            int count = s_config.removalCount.load();
-            if (m_ftRemovalHeader)
-            {
-                umgSetText(m_ftRemovalHeader, Loc::get("ui.saved_removals_prefix") + std::to_wstring(count) + Loc::get("ui.saved_removals_suffix"));
-            }
-
-            UObject* texDanger = findTexture2DByName(L"T_UI_Icon_Danger");
-            UObject* defaultFont = nullptr;
-            {
-                std::vector<UObject*> fonts;
-                findAllOfSafe(STR("Font"), fonts);
-                for (auto* f : fonts) { if (f && std::wstring(f->GetName()) == L"DefaultRegularFont") { defaultFont = f; break; } }
-            }
-
-            auto makeTB2 = [&](const std::wstring& text, float r, float g, float b, float a, int32_t size) -> UObject* {
+            auto makeTB = [&](int32_t size) -> UObject* {
                 FStaticConstructObjectParameters tbP(textBlockClass, outer);
                 UObject* tb = UObjectGlobals::StaticConstructObject(tbP);
                 if (!tb) return nullptr;
-                umgSetText(tb, text);
-                umgSetTextColor(tb, r, g, b, a);
                 if (defaultFont) umgSetFontAndSize(tb, defaultFont, size);
                 else umgSetFontSize(tb, size);
                 return tb;
             };
+            // USpacer's Size doesn't render reliably here; SizeBox overrides do.
+            auto makePad = [&]() -> UObject* {
+                FStaticConstructObjectParameters spP(sizeBoxClass, outer);
+                UObject* sp = UObjectGlobals::StaticConstructObject(spP);
+                if (sp) { setFtRemovalRowHeight(sp, 0.0f); addToVBox(remVBox, sp); }
+                return sp;
+            };
 
-            if (s_config.removalCSInit)
+            UObject* texDanger = findTexture2DByName(L"T_UI_Icon_Danger");
+            m_ftRemovalTopPad = makePad();
+            for (auto& row : m_ftRemovalRows)
             {
-                CriticalSectionLock removalLock(s_config.removalCS);
-
-                // Group entries by bubble, current bubble first
-                std::map<std::string, std::vector<size_t>> grouped;
-                std::vector<size_t> typeRuleIndices;
-                for (size_t i = 0; i < s_config.removalEntries.size(); i++)
+                FStaticConstructObjectParameters sbP(sizeBoxClass, outer);
+                UObject* box = UObjectGlobals::StaticConstructObject(sbP);
+                FStaticConstructObjectParameters rowP(hboxClass, outer);
+                UObject* rowHBox = UObjectGlobals::StaticConstructObject(rowP);
+                if (!box || !rowHBox) continue;
+                setFtRemovalRowHeight(box, FT_REMOVAL_ROW_H);
+                jw_setContentEither(box, rowHBox);
+
+                if (texDanger && setBrushFn)
                 {
-                    const auto& entry = s_config.removalEntries[i];
-                    if (entry.isTypeRule)
-                        typeRuleIndices.push_back(i);
-                    else
+                    FStaticConstructObjectParameters imgP(imageClass, outer);
+                    UObject* dangerImg = UObjectGlobals::StaticConstructObject(imgP);
+                    if (dangerImg)
                     {
-                        std::string bId = entry.bubbleId.empty() ? "Unknown" : entry.bubbleId;
-                        grouped[bId].push_back(i);
+                        umgSetBrushNoMatch(dangerImg, texDanger, setBrushFn);
+                        umgSetBrushSize(dangerImg, 56.0f, 56.0f);
+                        UObject* imgSlot = addToHBox(rowHBox, dangerImg);
+                        if (imgSlot) umgSetSlotPadding(imgSlot, 4.0f, 8.0f, 8.0f, 8.0f);
+                        row.icon = dangerImg;
                     }
                 }
 
-                // Build ordered list: current bubble first, then rest alphabetically
-                std::vector<std::string> bubbleOrder;
-                if (!m_currentBubbleId.empty() && grouped.count(m_currentBubbleId))
-                    bubbleOrder.push_back(m_currentBubbleId);
-                for (auto& [bId, _] : grouped)
+                FStaticConstructObjectParameters infoP(vboxClass, outer);
+                UObject* infoVBox = UObjectGlobals::StaticConstructObject(infoP);
+                if (infoVBox)
                 {
-                    if (bId != m_currentBubbleId)
-                        bubbleOrder.push_back(bId);
+                    row.name = makeTB(22);
+                    if (row.name) { umgSetBold(row.name); addToVBox(infoVBox, row.name); }
+                    row.coords = makeTB(16);
+                    if (row.coords) { umgSetTextColor(row.coords, 0.85f, 0.25f, 0.25f, 1.0f); addToVBox(infoVBox, row.coords); }
+                    row.infoSlot = addToHBox(rowHBox, infoVBox);
+                    if (row.infoSlot) umgSetVAlign(row.infoSlot, 2);
                 }
 
-                // Helper to add one entry row
-                auto addEntryRow = [&](size_t i) {
-                    const auto& entry = s_config.removalEntries[i];
-                    FStaticConstructObjectParameters rowP(hboxClass, outer);
-                    UObject* rowHBox = UObjectGlobals::StaticConstructObject(rowP);
-                    if (!rowHBox) return;
+                addToVBox(remVBox, box);
+                setWidgetVisibility(box, 1); // Collapsed until bound
+                row.root = box;
+            }
+            m_ftRemovalBottomPad = makePad();
+        }
 
-                    if (texDanger && setBrushFn)
+        // Point the row pool at the rows under the current scroll offset.
+        // Cheap when nothing moved: one GetScrollOffset call and a compare.
+        void bindFtRemovalList(bool force)
+        {
+            if (!m_ftRemovalVBox || !isObjectAlive(m_ftRemovalVBox)) { m_ftRemovalVBox = nullptr; return; }
+            const auto& rows = m_ftRemovalGroups.rows();
+            uint64_t version = m_ftRemovalGroups.version();
+            auto win = removalListWindow(rows.size(), FT_REMOVAL_POOL, FT_REMOVAL_ROW_H, ftScrollOffset() - FT_REMOVAL_LIST_TOP);
+            if (!force && static_cast<int>(win.first) == m_ftRemovalFirst && version == m_ftRemovalBoundVersion) return;
+
+            // Row styles: 0 type-rule header, 1 current-bubble header,
+            // 2 other bubble header, 3 entry.
+            struct Bound { int style{3}; std::wstring name; std::wstring coords; };
+            Bound bound[FT_REMOVAL_POOL];
+            if (s_config.removalCSInit)
+            {
+                CriticalSectionLock removalLock(s_config.removalCS);
+                const auto& entries = s_config.removalEntries;
+                for (size_t i = 0; i < win.count; i++)
+                {
+                    const RemovalListRow& r = rows[win.first + i];
+                    Bound& b = bound[i];
+                    if (r.kind == RemovalListRow::Kind::TypeRulesHeader)
                     {
-                        FStaticConstructObjectParameters imgP(imageClass, outer);
-                        UObject* dangerImg = UObjectGlobals::StaticConstructObject(imgP);
-                        if (dangerImg)
-                        {
-                            umgSetBrushNoMatch(dangerImg, texDanger, setBrushFn);
-                            umgSetBrushSize(dangerImg, 56.0f, 56.0f);
-                            UObject* imgSlot = addToHBox(rowHBox, dangerImg);
-                            if (imgSlot) umgSetSlotPadding(imgSlot, 4.0f, 8.0f, 8.0f, 8.0f);
-                        }
+                        b.style = 0;
+                        b.name = L"— Type Rules —";
                     }
-
-                    FStaticConstructObjectParameters infoP(vboxClass, outer);
-                    UObject* infoVBox = UObjectGlobals::StaticConstructObject(infoP);
-                    if (infoVBox)
+                    else if (r.kind == RemovalListRow::Kind::BubbleHeader)
                     {
-                        UObject* nameTB = makeTB2(entry.friendlyName, 0.3f, 0.85f, 0.3f, 1.0f, 22);
-                        if (nameTB) { umgSetBold(nameTB); addToVBox(infoVBox, nameTB); }
-                        std::wstring coordText = entry.isTypeRule ? Loc::get("ui.type_rule") : entry.coordsW;
-                        UObject* coordsTB = makeTB2(coordText, 0.85f, 0.25f, 0.25f, 1.0f, 16);
-                        if (coordsTB) addToVBox(infoVBox, coordsTB);
-                        UObject* infoSlot = addToHBox(rowHBox, infoVBox);
-                        if (infoSlot) umgSetVAlign(infoSlot, 2);
+                        const auto& g = m_ftRemovalGroups.groups()[r.group];
+                        bool isCurrent = m_ftRemovalGroups.isCurrent(r.group);
+                        b.style = isCurrent ? 1 : 2;
+                        // Display name from bubble ID (replace _ with space)
+                        b.name = isCurrent ? L"★ " : L"— ";
+                        for (char c : g.bubbleId) b.name += (c == '_') ? L' ' : static_cast<wchar_t>(c);
+                        b.name += L" (" + std::to_wstring(g.entries.size()) + L") —";
                     }
+                    else if (r.entry < entries.size())
+                    {
+                        const auto& entry = entries[r.entry];
+                        b.name = entry.friendlyName;
+                        b.coords = entry.isTypeRule ? Loc::get("ui.type_rule") : entry.coordsW;
+                    }
+                }
+            }
 
-                    addToVBox(m_ftRemovalVBox, rowHBox);
-                };
-
-                // Type rules first
-                if (!typeRuleIndices.empty())
+            setFtRemovalRowHeight(m_ftRemovalTopPad, win.topPad);
+            setFtRemovalRowHeight(m_ftRemovalBottomPad, win.bottomPad);
+            for (int i = 0; i < FT_REMOVAL_POOL; i++)
+            {
+                FtRemovalRow& row = m_ftRemovalRows[i];
+                if (!row.root) continue;
+                if (static_cast<size_t>(i) >= win.count)
                 {
-                    UObject* trHeader = makeTB2(L"— Type Rules —", 1.0f, 0.8f, 0.2f, 1.0f, 24);
-                    if (trHeader) { umgSetBold(trHeader); UObject* hs = addToVBox(m_ftRemovalVBox, trHeader); if (hs) umgSetSlotPadding(hs, 10.0f, 8.0f, 0.0f, 4.0f); }
-                    for (size_t i : typeRuleIndices)
-                        addEntryRow(i);
+                    if (row.row >= 0) setWidgetVisibility(row.root, 1); // Collapsed
+                    row.row = -1;
+                    continue;
                 }
-
-                // Then each bubble group
-                for (const auto& bId : bubbleOrder)
+                int r = static_cast<int>(win.first) + i;
+                if (row.row == r && row.version == version) continue;
+                const Bound& b = bound[i];
+                if (row.style != b.style)
                 {
-                    auto& indices = grouped[bId];
-                    // Make display name from bubble ID (replace _ with space)
-                    std::wstring displayName;
-                    for (char c : bId) displayName += (c == '_') ? L' ' : static_cast<wchar_t>(c);
-
-                    bool isCurrent = (bId == m_currentBubbleId);
-                    float hr = isCurrent ? 0.2f : 0.7f;
-                    float hg = isCurrent ? 0.9f : 0.7f;
-                    float hb = isCurrent ? 1.0f : 0.7f;
-                    std::wstring prefix = isCurrent ? L"★ " : L"— ";
-                    std::wstring suffix = L" (" + std::to_wstring(indices.size()) + L") —";
-
-                    UObject* bubbleHeader = makeTB2(prefix + displayName + suffix, hr, hg, hb, 1.0f, 24);
-                    if (bubbleHeader) { umgSetBold(bubbleHeader); UObject* hs = addToVBox(m_ftRemovalVBox, bubbleHeader); if (hs) umgSetSlotPadding(hs, 10.0f, 12.0f, 0.0f, 4.0f); }
-
-                    for (size_t i : indices)
-                        addEntryRow(i);
+                    static constexpr float kColor[4][3] = {{1.0f, 0.8f, 0.2f}, {0.2f, 0.9f, 1.0f}, {0.7f, 0.7f, 0.7f}, {0.3f, 0.85f, 0.3f}};
+                    bool entry = b.style == 3;
+                    umgSetTextColor(row.name, kColor[b.style][0], kColor[b.style][1], kColor[b.style][2], 1.0f);
+                    if (row.style < 0 || entry != (row.style == 3))
+                    {
+                        umgSetFontSize(row.name, entry ? 22 : 24);
+                        setWidgetVisibility(row.icon, entry ? 0 : 1);
+                        setWidgetVisibility(row.coords, entry ? 0 : 1);
+                        umgSetSlotPadding(row.infoSlot, entry ? 0.0f : 10.0f, 0.0f, 0.0f, 0.0f);
+                    }
+                    row.style = b.style;
                 }
+                umgSetText(row.name, b.name);
+                if (b.style == 3) umgSetText(row.coords, b.coords);
+                if (row.row < 0) setWidgetVisibility(row.root, 0); // Visible
+                row.row = r;
+                row.version = version;
+            }
+            m_ftRemovalFirst = static_cast<int>(win.first);
+            m_ftRemovalBoundVersion = version;
+        }
+
+        // Re-sync the group index with s_config.removalEntries and rebind.
+        // Called when the removal count changes while the tab is shown.
+        void rebuildFtRemovalList()
+        {
+            if (!m_ftRemovalVBox || !isObjectAlive(m_ftRemovalVBox)) { m_ftRemovalVBox = nullptr; return; }
+
+            int count = s_config.removalCount.load();
+            if (m_ftRemovalHeader)
+            {
+                umgSetText(m_ftRemovalHeader, Loc::get("ui.saved_removals_prefix") + std::to_wstring(count) + Loc::get("ui.saved_removals_suffix"));
             }
-            setWidgetVisibility(m_ftRemovalVBox, 0); // Visible — children rebuilt
+            if (s_config.removalCSInit)
+            {
+                CriticalSectionLock removalLock(s_config.removalCS);
+                const auto& entries = s_config.removalEntries;
+                m_ftRemovalGroups.sync(entries.size(), [&](size_t i) {
+                    return std::pair<bool, std::string_view>(entries[i].isTypeRule, entries[i].bubbleId);
+                });
+            }
+            m_ftRemovalGroups.setCurrentBubble(m_currentBubbleId);
+            bindFtRemovalList(true);
             m_ftLastRemovalCount = count;
         }
 
+        // Per-tick while the Hide Environment tab is shown.
+        void tickFtRemovalList()
+        {
+            if (s_config.removalCount.load() != m_ftLastRemovalCount)
+            {
+                rebuildFtRemovalList();
+                return;
+            }
+            m_ftRemovalGroups.setCurrentBubble(m_currentBubbleId);
+            bindFtRemovalList(false);
+        }
+
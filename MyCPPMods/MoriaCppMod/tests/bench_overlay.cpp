@@ -0,0 +1,110 @@
+// Overlay render benchmark (headless compositor, runs on Linux)
+//
+//   MoriaOverlayBench [iterations] [budget-us]
+//
+// Per game height, times three frame kinds the renderer actually produces:
+//   full  - layout change: chrome + all 12 cells
+//   cell  - one dirty cell (rotation counter ticking)
+//   idle  - no change: OverlayFrameTracker::plan() only, nothing drawn
+// and reports microseconds per frame plus pixel writes per frame. With a
+// budget given, exits non-zero if any full frame exceeds it.
+
+#include "moria_overlay_paint.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    constexpr int kSlots = 12;
+    constexpr int kBuild = 8;
+    using Cells = std::array<OverlayCellKey, kSlots>;
+    using Clock = std::chrono::steady_clock;
+
+    Cells scene(const ArgbImage& icon)
+    {
+        Cells c{};
+        for (int i = 0; i < kBuild; i++)
+        {
+            c[i].label = L"F" + std::to_wstring(i + 1);
+            c[i].used = true;
+            c[i].icon = &icon;
+        }
+        c[8] = {false, nullptr, L"TGT", L"", L"NUM0", 0};
+        c[9] = {false, nullptr, L"15\u00B0", L"T90", L"R", 0};
+        c[10] = {false, nullptr, L"C2", L"M5", L"F10", 3};
+        c[11] = {false, nullptr, L"CFG", L"", L"F12", 0};
+        return c;
+    }
+
+    struct Result
+    {
+        double us;
+        double pixels;
+    };
+
+    template <typename F>
+    Result measure(int iterations, Surface& s, F&& frame)
+    {
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        s.resetStats();
+        for (int i = 0; i < iterations; i++)
+        {
+            auto t0 = Clock::now();
+            frame(i);
+            samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+        }
+        // Median: robust against scheduler noise.
+        std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+        return {samples[samples.size() / 2], double(s.pixelsWritten()) / iterations};
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+    double budgetUs = argc > 2 ? std::atof(argv[2]) : 0.0;
+
+    ArgbImage icon{64, 64, std::vector<uint32_t>(64 * 64)};
+    for (int i = 0; i < 64 * 64; i++) icon.pixels[i] = premul(255, uint8_t(i % 64 * 4), uint8_t(i / 64 * 4), 120);
+    Cells cells = scene(icon);
+    auto iconOf = [&](int i) { return static_cast<const ArgbImage*>(cells[i].icon); };
+
+    std::printf("%-6s %-10s %12s %14s\n", "height", "frame", "us/frame", "pixels/frame");
+    bool overBudget = false;
+    for (int h : {720, 1080, 1440, 2160})
+    {
+        OverlayLayout l = OverlayLayout::forClient(h, kSlots, kBuild);
+        Surface s(l.width, l.height);
+        OverlayFonts fonts = OverlayFonts::make(l, builtinOverlayFonts());
+        paintOverlay(s, l, cells, OverlayFrameTracker<kSlots>::kAll, true, fonts, iconOf);   // warm glyph atlases
+
+        Result full = measure(iterations, s, [&](int) {
+            paintOverlay(s, l, cells, OverlayFrameTracker<kSlots>::kAll, true, fonts, iconOf);
+        });
+        Result cell = measure(iterations, s, [&](int i) {
+            cells[9].text2 = L"T" + std::to_wstring(i % 360);
+            paintOverlay(s, l, cells, 1u << 9, false, fonts, iconOf);
+        });
+        OverlayFrameTracker<kSlots> tracker;
+        tracker.plan(l, 0, 0, cells);
+        Result idle = measure(iterations, s, [&](int) {
+            auto p = tracker.plan(l, 0, 0, cells);
+            paintOverlay(s, l, cells, p.dirty, p.rebuild, fonts, iconOf);
+        });
+
+        std::printf("%-6d %-10s %12.1f %14.0f\n", h, "full", full.us, full.pixels);
+        std::printf("%-6d %-10s %12.1f %14.0f\n", h, "cell", cell.us, cell.pixels);
+        std::printf("%-6d %-10s %12.2f %14.0f\n", h, "idle", idle.us, idle.pixels);
+        if (budgetUs > 0 && full.us > budgetUs) overBudget = true;
+    }
+    if (overBudget) std::printf("full frame over budget (%.0f us)\n", budgetUs);
+    return overBudget ? 1 : 0;
+}
@@ -0,0 +1,37 @@
+# ctest driver for the shipped definitions: runs deflint and fails on any
+# error not listed in deflint_known.txt. Known errors that stop showing up
+# are reported so the list can shrink.
+#
+#   cmake -DDEFLINT=<exe> -DDEFS=<definitions-dir> -DKNOWN=<list> -P deflint_check.cmake
+
+cmake_minimum_required(VERSION 3.22)
+
+execute_process(COMMAND ${DEFLINT} -q ${DEFS} OUTPUT_VARIABLE out RESULT_VARIABLE rc)
+if(NOT rc MATCHES "^[01]$")
+    message(FATAL_ERROR "deflint failed to run (${rc}):\n${out}")
+endif()
+
+file(STRINGS ${KNOWN} known REGEX ": error: ")
+string(REPLACE "\n" ";" lines "${out}")
+set(found "")
+set(fresh "")
+foreach(line IN LISTS lines)
+    if(NOT line MATCHES ": error: ")
+        continue()
+    endif()
+    list(APPEND found "${line}")
+    if(NOT line IN_LIST known)
+        list(APPEND fresh "${line}")
+    endif()
+endforeach()
+
+foreach(line IN LISTS known)
+    if(NOT line IN_LIST found)
+        message(STATUS "no longer reported, drop from deflint_known.txt: ${line}")
+    endif()
+endforeach()
+
+if(fresh)
+    list(JOIN fresh "\n" fresh)
+    message(FATAL_ERROR "new deflint errors in the shipped definitions:\n${fresh}")
+endif()
@@ -0,0 +1,55 @@
+// Unit tests for DefArena / CountingResource (definitions-load arena)
+
+#include <gtest/gtest.h>
+#include "moria_arena.h"
+#include "moria_json.h"
+
+#include <string>
+#include <vector>
+
+using namespace MoriaMods;
+
+TEST(CountingResource, TracksLiveAndPeak)
+{
+    CountingResource counter(std::pmr::new_delete_resource());
+    void* a = counter.allocate(100, 8);
+    void* b = counter.allocate(50, 8);
+    EXPECT_EQ(counter.allocations(), 2u);
+    EXPECT_EQ(counter.liveBytes(), 150u);
+    counter.deallocate(a, 100, 8);
+    EXPECT_EQ(counter.liveBytes(), 50u);
+    EXPECT_EQ(counter.peakBytes(), 150u);
+    counter.deallocate(b, 50, 8);
+    EXPECT_EQ(counter.liveBytes(), 0u);
+}
+
+TEST(DefArena, CountsEveryRequest)
+{
+    DefArena arena;
+    std::pmr::vector<std::pmr::string> v(arena.resource());
+    for (int i = 0; i < 10; i++)
+        v.emplace_back(std::string(64, 'x'));
+    EXPECT_GE(arena.allocations(), 10u);
+    EXPECT_GE(arena.peakBytes(), DefArena::INITIAL_BLOCK);
+}
+
+TEST(DefArena, SmallLoadStaysInFirstBlock)
+{
+    DefArena arena;
+    JsonIndex idx(R"({"Name": "DropRate", "Value": 0.0})", arena.resource());
+    ASSERT_TRUE(idx.ok());
+    // One upstream block covers a handful of small allocations.
+    EXPECT_LT(arena.peakBytes(), 2 * DefArena::INITIAL_BLOCK);
+    EXPECT_GE(arena.allocations(), 2u);
+}
+
+TEST(DefArena, PeakSurvivesRelease)
+{
+    DefArena arena;
+    void* p = arena.resource()->allocate(200 * 1024, 8);
+    ASSERT_NE(p, nullptr);
+    size_t peak = arena.peakBytes();
+    EXPECT_GE(peak, 200u * 1024);
+    arena.release();
+    EXPECT_EQ(arena.peakBytes(), peak);
+}
@@ -0,0 +1,134 @@
+// Unit tests for AtlasLayout (UMG icon atlas packing)
+
+#include <gtest/gtest.h>
+#include "moria_atlas_pack.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    // The New Building Bar's contents: slot-state glyphs at display size
+    // plus eight recipe icons.
+    std::vector<AtlasItem> nbbItems()
+    {
+        std::vector<AtlasItem> v = {
+            {L"slotEmpty", 192, 192}, {L"slotFocus", 192, 192}, {L"slotCorners", 192, 192}, {L"keyBg", 76, 44}};
+        for (int i = 0; i < 8; i++) v.push_back({L"marker" + std::to_wstring(i), 128, 40});
+        for (int i = 0; i < 8; i++) v.push_back({L"icon" + std::to_wstring(i), 128, 128});
+        return v;
+    }
+
+    bool isPow2(int v) { return v > 0 && (v & (v - 1)) == 0; }
+
+    void expectValid(const AtlasLayout& a)
+    {
+        ASSERT_TRUE(a.ok());
+        EXPECT_TRUE(isPow2(a.width()));
+        EXPECT_TRUE(isPow2(a.height()));
+        int p = a.padding();
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            const auto& s = a.slot(i);
+            EXPECT_EQ(s.w, a.items()[i].w);
+            EXPECT_EQ(s.h, a.items()[i].h);
+            EXPECT_GE(s.x - p, 0);
+            EXPECT_GE(s.y - p, 0);
+            EXPECT_LE(s.x + s.w + p, a.width());
+            EXPECT_LE(s.y + s.h + p, a.height());
+            for (size_t j = i + 1; j < a.size(); j++)
+            {
+                const auto& t = a.slot(j);
+                // Gutters included: padded rects must not overlap.
+                bool apart = s.x + s.w + p <= t.x - p || t.x + t.w + p <= s.x - p || s.y + s.h + p <= t.y - p ||
+                             t.y + t.h + p <= s.y - p;
+                EXPECT_TRUE(apart) << i << " overlaps " << j;
+            }
+        }
+    }
+}
+
+TEST(AtlasPack, EmptyRequestIsNotOk)
+{
+    auto a = AtlasLayout::pack({});
+    EXPECT_FALSE(a.ok());
+    EXPECT_EQ(a.find(L"x"), nullptr);
+}
+
+TEST(AtlasPack, SingleItemGetsTightPow2AndExactUV)
+{
+    auto a = AtlasLayout::pack({{L"icon", 128, 128}}, 2);
+    expectValid(a);
+    EXPECT_EQ(a.width(), 256);   // 128 + 2 * 2 gutter
+    EXPECT_EQ(a.height(), 256);
+    const AtlasSlot* s = a.find(L"icon");
+    ASSERT_NE(s, nullptr);
+    EXPECT_EQ(s->x, 2);
+    EXPECT_EQ(s->y, 2);
+    EXPECT_FLOAT_EQ(s->u0, 2.0f / 256);
+    EXPECT_FLOAT_EQ(s->v1, 130.0f / 256);
+}
+
+TEST(AtlasPack, NewBuildingBarFitsOneSmallAtlas)
+{
+    auto a = AtlasLayout::pack(nbbItems());
+    expectValid(a);
+    EXPECT_LE(a.width(), 1024);
+    EXPECT_LE(a.height(), 1024);
+    EXPECT_GT(a.occupancy(), 0.4f);
+    for (auto& it : nbbItems()) EXPECT_NE(a.find(it.key), nullptr) << std::string(it.key.begin(), it.key.end());
+}
+
+TEST(AtlasPack, LayoutDoesNotDependOnRequestOrder)
+{
+    auto items = nbbItems();
+    auto a = AtlasLayout::pack(items);
+    std::mt19937 rng(7);
+    std::shuffle(items.begin(), items.end(), rng);
+    auto b = AtlasLayout::pack(items);
+    expectValid(b);
+    EXPECT_EQ(a.width(), b.width());
+    EXPECT_EQ(a.height(), b.height());
+    for (auto& it : items)
+    {
+        EXPECT_EQ(a.find(it.key)->x, b.find(it.key)->x);
+        EXPECT_EQ(a.find(it.key)->y, b.find(it.key)->y);
+    }
+}
+
+TEST(AtlasPack, OversizeItemFails)
+{
+    EXPECT_FALSE(AtlasLayout::pack({{L"huge", 4096, 16}}).ok());
+    EXPECT_FALSE(AtlasLayout::pack({{L"zero", 0, 16}}).ok());
+    // Too many to fit within maxSide in total.
+    std::vector<AtlasItem> many;
+    for (int i = 0; i < 20; i++) many.push_back({std::to_wstring(i), 120, 120});
+    EXPECT_FALSE(AtlasLayout::pack(many, 2, 256).ok());
+    EXPECT_TRUE(AtlasLayout::pack(many, 2, 1024).ok());
+}
+
+TEST(AtlasPack, SameItemsDetectsInPlaceRedraw)
+{
+    auto items = nbbItems();
+    auto a = AtlasLayout::pack(items);
+    EXPECT_TRUE(a.sameItems(items));
+    items[0].w = 100;
+    EXPECT_FALSE(a.sameItems(items));
+    EXPECT_FALSE(AtlasLayout::pack({}).sameItems({}));
+}
+
+TEST(AtlasPack, MixedSizesStayValid)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> d(4, 200);
+    for (int round = 0; round < 20; round++)
+    {
+        std::vector<AtlasItem> items;
+        for (int i = 0; i < 30; i++) items.push_back({std::to_wstring(i), d(rng), d(rng)});
+        expectValid(AtlasLayout::pack(items, 1));
+    }
+}
@@ -0,0 +1,137 @@
+// Unit tests for IncrementalClassIndex (GameplayEffect class lookup)
+
+#include <gtest/gtest.h>
+#include "moria_class_index.h"
+
+#include <string>
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    struct FakeClass
+    {
+        int id;
+    };
+
+    // Stand-in for GUObjectArray: one optional class name per slot.
+    struct FakeArray
+    {
+        std::vector<std::wstring> slots;
+        std::vector<FakeClass> classes;
+        int visits{0};
+
+        FakeArray() { classes.reserve(64); }
+
+        void push(const std::wstring& name)
+        {
+            slots.push_back(name);
+            classes.push_back({static_cast<int>(slots.size()) - 1});
+        }
+
+        int32_t num() const { return static_cast<int32_t>(slots.size()); }
+
+        int scan(IncrementalClassIndex<FakeClass*>& index)
+        {
+            return index.scanTo(num(), [this](int32_t idx, auto&& add) {
+                visits++;
+                if (!slots[idx].empty()) add(slots[idx], &classes[idx]);
+            });
+        }
+    };
+}
+
+TEST(ClassIndex, FirstScanCoversWholeArray)
+{
+    FakeArray arr;
+    arr.push(L"GE_Buff_A");
+    arr.push(L"");
+    arr.push(L"GE_Buff_B");
+    IncrementalClassIndex<FakeClass*> index;
+    EXPECT_EQ(arr.scan(index), 2);
+    EXPECT_EQ(arr.visits, 3);
+    EXPECT_EQ(index.highWater(), 3);
+    ASSERT_NE(index.find(L"GE_Buff_B"), nullptr);
+    EXPECT_EQ(index.find(L"GE_Buff_B")->id, 2);
+    EXPECT_EQ(index.find(L"GE_Missing"), nullptr);
+}
+
+TEST(ClassIndex, RescanVisitsOnlyNewSlots)
+{
+    FakeArray arr;
+    for (int i = 0; i < 100; i++) arr.push(L"");
+    IncrementalClassIndex<FakeClass*> index;
+    arr.scan(index);
+    EXPECT_EQ(arr.visits, 100);
+
+    arr.push(L"GE_Late");
+    arr.visits = 0;
+    EXPECT_EQ(arr.scan(index), 1);
+    EXPECT_EQ(arr.visits, 1);
+    EXPECT_NE(index.find(L"GE_Late"), nullptr);
+
+    arr.visits = 0;
+    EXPECT_EQ(arr.scan(index), 0);
+    EXPECT_EQ(arr.visits, 0);
+}
+
+TEST(ClassIndex, FirstNameWins)
+{
+    FakeArray arr;
+    arr.push(L"GE_Dup");
+    arr.push(L"GE_Dup");
+    IncrementalClassIndex<FakeClass*> index;
+    EXPECT_EQ(arr.scan(index), 1);
+    EXPECT_EQ(index.find(L"GE_Dup")->id, 0);
+}
+
+TEST(ClassIndex, MissCachedUntilArrayGrows)
+{
+    FakeArray arr;
+    arr.push(L"GE_A");
+    IncrementalClassIndex<FakeClass*> index;
+    arr.scan(index);
+    index.recordMiss(L"GE_B");
+    EXPECT_TRUE(index.knownMissing(L"GE_B", arr.num()));
+    EXPECT_FALSE(index.knownMissing(L"GE_C", arr.num()));
+
+    arr.push(L"GE_B");
+    EXPECT_FALSE(index.knownMissing(L"GE_B", arr.num()));
+    arr.scan(index);
+    EXPECT_NE(index.find(L"GE_B"), nullptr);
+}
+
+TEST(ClassIndex, RewindRescansFromZero)
+{
+    FakeArray arr;
+    arr.push(L"");
+    arr.push(L"");
+    IncrementalClassIndex<FakeClass*> index;
+    arr.scan(index);
+    index.recordMiss(L"GE_Reused");
+
+    // A freed slot below the mark gets reused by a newly loaded class.
+    arr.slots[0] = L"GE_Reused";
+    arr.scan(index);
+    EXPECT_EQ(index.find(L"GE_Reused"), nullptr);
+
+    index.rewind();
+    EXPECT_FALSE(index.knownMissing(L"GE_Reused", arr.num()));
+    arr.scan(index);
+    EXPECT_NE(index.find(L"GE_Reused"), nullptr);
+}
+
+TEST(ClassIndex, EraseAndClear)
+{
+    FakeArray arr;
+    arr.push(L"GE_A");
+    IncrementalClassIndex<FakeClass*> index;
+    arr.scan(index);
+    index.erase(L"GE_A");
+    EXPECT_EQ(index.find(L"GE_A"), nullptr);
+    EXPECT_EQ(index.highWater(), 1);
+    index.clear();
+    EXPECT_EQ(index.highWater(), 0);
+    EXPECT_EQ(index.size(), 0u);
+}
@@ -0,0 +1,295 @@
+// Unit tests for the software ARGB32 compositor (headless overlay rendering)
+//
+// Shape goldens are alpha rendered as ASCII, one ramp step per ~28 levels:
+//   " .:-=+*#%@"  (space = transparent, @ = opaque)
+
+#include <gtest/gtest.h>
+#include "moria_compositor.h"
+
+#include <string>
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    const uint32_t kWhite = premul(255, 255, 255, 255);
+
+    std::vector<std::string> alphaArt(const Surface& s)
+    {
+        static const char* kRamp = " .:-=+*#%@";
+        std::vector<std::string> out;
+        for (int y = 0; y < s.height(); y++)
+        {
+            std::string row;
+            for (int x = 0; x < s.width(); x++) row += kRamp[((s.pixel(x, y) >> 24) * 9 + 127) / 255];
+            out.push_back(row);
+        }
+        return out;
+    }
+
+    void expectArt(const Surface& s, const std::vector<std::string>& golden)
+    {
+        auto art = alphaArt(s);
+        ASSERT_EQ(art.size(), golden.size());
+        for (size_t y = 0; y < art.size(); y++) EXPECT_EQ(art[y], golden[y]) << "row " << y;
+    }
+}
+
+// ---- pixel math ----
+
+TEST(Compositor, PremulScalesColourByAlpha)
+{
+    EXPECT_EQ(premul(255, 10, 20, 30), 0xFF0A141Eu);
+    EXPECT_EQ(premul(0, 255, 255, 255), 0u);
+    EXPECT_EQ(premul(128, 255, 0, 255), 0x80800080u);
+}
+
+TEST(Compositor, BlendOverOpaqueAndTransparentShortcuts)
+{
+    EXPECT_EQ(blendOver(0x12345678u, 0xFF000000u), 0xFF000000u);
+    EXPECT_EQ(blendOver(0x12345678u, 0u), 0x12345678u);
+    EXPECT_EQ(blendOver(0x12345678u, 0xFFFFFFFFu, 0), 0x12345678u);
+}
+
+TEST(Compositor, BlendOverHalfOnOpaqueIsMidpoint)
+{
+    uint32_t out = blendOver(0xFF000000u, premul(128, 255, 255, 255));
+    EXPECT_EQ(out >> 24, 255u);
+    EXPECT_NEAR(int((out >> 16) & 0xFF), 128, 1);
+}
+
+TEST(Compositor, BlendOverNeverOverflowsChannels)
+{
+    for (uint32_t a : {1u, 64u, 128u, 200u, 254u})
+        for (uint32_t cov : {1u, 100u, 255u})
+        {
+            uint32_t out = blendOver(0xFFFFFFFFu, premul(uint8_t(a), 255, 255, 255), cov);
+            EXPECT_EQ(out, 0xFFFFFFFFu) << a << " " << cov;
+        }
+}
+
+// ---- rects ----
+
+TEST(Compositor, FillRectClipsAndCounts)
+{
+    Surface s(8, 8);
+    s.fillRect(-2, 6, 20, 20, kWhite);
+    EXPECT_EQ(s.pixelsWritten(), 16u);
+    EXPECT_EQ(s.pixel(0, 6), kWhite);
+    EXPECT_EQ(s.pixel(0, 5), 0u);
+}
+
+TEST(Compositor, CopyModeReplacesInsteadOfBlending)
+{
+    Surface s(4, 4);
+    s.fillRect(0, 0, 4, 4, kWhite);
+    uint32_t half = premul(100, 5, 8, 18);
+    s.fillRect(1, 1, 2, 2, half, Blend::Copy);
+    EXPECT_EQ(s.pixel(1, 1), half);
+    EXPECT_EQ(s.pixel(0, 0), kWhite);
+}
+
+TEST(Compositor, StrokeRectGolden)
+{
+    Surface s(10, 10);
+    s.strokeRect(2, 2, 6, 6, 3, kWhite);
+    expectArt(s, {
+        "          ",
+        " @@@@@@@@@",
+        " @@@@@@@@@",
+        " @@@@@@@@@",
+        " @@@   @@@",
+        " @@@   @@@",
+        " @@@   @@@",
+        " @@@@@@@@@",
+        " @@@@@@@@@",
+        " @@@@@@@@@",
+    });
+}
+
+// ---- anti-aliased shapes ----
+
+TEST(Compositor, RoundRectGolden)
+{
+    Surface s(16, 10);
+    s.fillRoundRect(1, 1, 14, 8, 3, kWhite);
+    expectArt(s, {
+        "                ",
+        "  +%@@@@@@@@%+  ",
+        " +@@@@@@@@@@@@+ ",
+        " %@@@@@@@@@@@@% ",
+        " @@@@@@@@@@@@@@ ",
+        " @@@@@@@@@@@@@@ ",
+        " %@@@@@@@@@@@@% ",
+        " +@@@@@@@@@@@@+ ",
+        "  +%@@@@@@@@%+  ",
+        "                ",
+    });
+}
+
+TEST(Compositor, EllipseGolden)
+{
+    Surface s(12, 12);
+    s.fillEllipse(6, 6, 5, 5, kWhite);
+    expectArt(s, {
+        "            ",
+        "   -#@@#-   ",
+        "  *@@@@@@*  ",
+        " -@@@@@@@@- ",
+        " #@@@@@@@@# ",
+        " @@@@@@@@@@ ",
+        " @@@@@@@@@@ ",
+        " #@@@@@@@@# ",
+        " -@@@@@@@@- ",
+        "  *@@@@@@*  ",
+        "   -#@@#-   ",
+        "            ",
+    });
+}
+
+TEST(Compositor, RingGolden)
+{
+    Surface s(12, 12);
+    s.strokeEllipse(6, 6, 4, 1.5f, kWhite);
+    expectArt(s, {
+        "            ",
+        "   .=##=.   ",
+        "  :%@##@%:  ",
+        " .%#.  .#%. ",
+        " =@.    .@= ",
+        " ##      ## ",
+        " ##      ## ",
+        " =@.    .@= ",
+        " .%#.  .#%. ",
+        "  :%@##@%:  ",
+        "   .=##=.   ",
+        "            ",
+    });
+}
+
+TEST(Compositor, PolygonGolden)
+{
+    Surface s(12, 12);
+    s.fillPolygon({{1, 1}, {11, 1}, {1, 11}}, kWhite);
+    expectArt(s, {
+        "            ",
+        " @@@@@@@@@+ ",
+        " @@@@@@@@+  ",
+        " @@@@@@@+   ",
+        " @@@@@@+    ",
+        " @@@@@+     ",
+        " @@@@+      ",
+        " @@@+       ",
+        " @@+        ",
+        " @+         ",
+        " +          ",
+        "            ",
+    });
+}
+
+TEST(Compositor, OverlappingStrokeQuadsUnionInsteadOfCancelling)
+{
+    Surface s(12, 12);
+    // Closed square outline: corner quads overlap with opposite directions.
+    s.strokePolygon({{2, 2}, {10, 2}, {10, 10}, {2, 10}}, 2.0f, kWhite);
+    EXPECT_EQ(s.pixel(2, 2) >> 24, 255u);
+    EXPECT_EQ(s.pixel(9, 9) >> 24, 255u);
+    EXPECT_EQ(s.pixel(6, 6), 0u);
+}
+
+TEST(Compositor, PolygonCoverageIsExactOnHalfPixelEdge)
+{
+    Surface s(4, 1);
+    s.fillPolygon({{0, 0}, {2.5f, 0}, {2.5f, 1}, {0, 1}}, kWhite);
+    EXPECT_EQ(s.pixel(1, 0) >> 24, 255u);
+    EXPECT_NEAR(int(s.pixel(2, 0) >> 24), 128, 1);
+    EXPECT_EQ(s.pixel(3, 0), 0u);
+}
+
+// ---- blits ----
+
+TEST(Compositor, UnscaledBlitIsSourceOver)
+{
+    ArgbImage img{2, 1, {kWhite, premul(128, 255, 0, 0)}};
+    Surface s(2, 1);
+    s.fillRect(0, 0, 2, 1, premul(255, 0, 0, 255));
+    s.blitImage(img, 0, 0, 2, 1);
+    EXPECT_EQ(s.pixel(0, 0), kWhite);
+    uint32_t p = s.pixel(1, 0);
+    EXPECT_EQ(p >> 24, 255u);
+    EXPECT_NEAR(int((p >> 16) & 0xFF), 128, 1);
+    EXPECT_NEAR(int(p & 0xFF), 127, 1);
+}
+
+TEST(Compositor, ScaledBlitOfSolidImageStaysSolid)
+{
+    ArgbImage img{4, 4, std::vector<uint32_t>(16, premul(200, 10, 200, 90))};
+    Surface s(10, 10);
+    s.blitImage(img, 1, 1, 7, 7);
+    for (int y = 1; y < 8; y++)
+        for (int x = 1; x < 8; x++) EXPECT_EQ(s.pixel(x, y), premul(200, 10, 200, 90)) << x << "," << y;
+    EXPECT_EQ(s.pixel(0, 0), 0u);
+    EXPECT_EQ(s.pixel(8, 8), 0u);
+}
+
+TEST(Compositor, WrapDrawsIntoCallerMemoryWithStride)
+{
+    std::vector<uint32_t> mem(6 * 2, 0xDEADBEEFu);
+    Surface s = Surface::wrap(mem.data(), 4, 2, 6);
+    s.clear(0);
+    s.fillRect(0, 1, 4, 1, kWhite);
+    EXPECT_EQ(mem[6 + 3], kWhite);
+    EXPECT_EQ(mem[4], 0xDEADBEEFu);   // padding untouched
+}
+
+// ---- text ----
+
+TEST(GlyphAtlas, TextGolden)
+{
+    Surface s(16, 11);
+    GlyphAtlas a(builtinGlyphs(9), 9);
+    a.drawText(s, L"F1", 0, 0, 16, 11, kWhite);
+    expectArt(s, {
+        "                ",
+        "  @@@@@   @     ",
+        "  @      @@     ",
+        "  @       @     ",
+        "  @@@@    @     ",
+        "  @       @     ",
+        "  @       @     ",
+        "  @      @@@    ",
+        "                ",
+        "                ",
+        "                ",
+    });
+}
+
+TEST(GlyphAtlas, GlyphsAreRasterizedOnceAndPacked)
+{
+    int calls = 0;
+    auto base = builtinGlyphs(18);
+    GlyphAtlas a([&](wchar_t c, std::vector<uint8_t>& m, int& w, int& h, int& adv) {
+        calls++;
+        return base(c, m, w, h, adv);
+    }, 18, 64);
+    for (int i = 0; i < 3; i++) a.measure(L"C12 M3");
+    EXPECT_EQ(calls, 6);            // C 1 2 space M 3
+    EXPECT_EQ(a.rasterized(), 5u);  // space has no mask
+    EXPECT_EQ(a.measure(L"C12"), 3 * 12);
+    // 64 px page fits five 12 px glyphs per shelf.
+    EXPECT_GE(a.pageHeight(), 18);
+    const auto& g1 = a.glyph(L'1');
+    const auto& g3 = a.glyph(L'3');
+    EXPECT_FALSE(g1.x == g3.x && g1.y == g3.y);
+}
+
+TEST(GlyphAtlas, UnknownCharactersFallBackAndLowerCaseFolds)
+{
+    GlyphAtlas a(builtinGlyphs(9), 9);
+    Surface s1(8, 9), s2(8, 9);
+    a.drawText(s1, L"f", 0, 0, 8, 9, kWhite);
+    a.drawText(s2, L"F", 0, 0, 8, 9, kWhite);
+    EXPECT_EQ(alphaArt(s1), alphaArt(s2));
+    EXPECT_GT(a.measure(L"\u4E00"), 0);
+}
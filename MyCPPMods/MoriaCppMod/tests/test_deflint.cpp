@@ -0,0 +1,148 @@
+// Unit tests for the deflint rules (tools/deflint/deflint.h) and the XML
+// issue reporting in moria_defparse.h
+
+#include <gtest/gtest.h>
+#include "deflint.h"
+
+#include <set>
+#include <string>
+
+using namespace MoriaMods;
+using namespace MoriaMods::DefLint;
+
+namespace
+{
+    size_t count(const std::vector<Finding>& findings, Severity s)
+    {
+        size_t n = 0;
+        for (auto& f : findings)
+            if (f.severity == s) n++;
+        return n;
+    }
+
+    bool has(const std::vector<Finding>& findings, Severity s, size_t line, const std::string& needle)
+    {
+        for (auto& f : findings)
+            if (f.severity == s && f.line == line && f.message.find(needle) != std::string::npos) return true;
+        return false;
+    }
+
+    std::string wrap(const std::string& ops)
+    {
+        return "<definition>\n<mod file=\"Moria/Content/Tech/Data/Items/DT_Items.json\">\n" + ops + "</mod>\n</definition>\n";
+    }
+}
+
+TEST(XmlIssues, WellFormedHasNone)
+{
+    DefArena arena;
+    std::vector<XmlIssue> issues;
+    XmlElement root = xmlParse("<?xml version=\"1.0\"?>\n<a x=\"1\"><b/><!-- c --></a>", arena.resource(), &issues);
+    EXPECT_EQ(root.tag, "a");
+    EXPECT_TRUE(issues.empty());
+}
+
+TEST(XmlIssues, MismatchedAndUnclosed)
+{
+    DefArena arena;
+    std::vector<XmlIssue> issues;
+    xmlParse("<a><b></c>", arena.resource(), &issues);
+    ASSERT_FALSE(issues.empty());
+    EXPECT_NE(issues[0].message.find("closed by"), std::string::npos);
+}
+
+TEST(XmlIssues, UnquotedAttribute)
+{
+    DefArena arena;
+    std::vector<XmlIssue> issues;
+    xmlParse("<a x=1/>", arena.resource(), &issues);
+    ASSERT_FALSE(issues.empty());
+    EXPECT_EQ(issues[0].offset, 5u);
+}
+
+TEST(DefLint, CleanFileHasNoFindings)
+{
+    DefReport r = lintDef(wrap("<change item=\"Pick\" property=\"MaxStackSize\" value=\"99\"/>\n"));
+    EXPECT_TRUE(r.findings.empty());
+    EXPECT_EQ(r.ops, 1u);
+    ASSERT_EQ(r.changes.size(), 1u);
+    EXPECT_EQ(r.changes[0].value, "99");
+    EXPECT_EQ(r.changes[0].line, 3u);
+}
+
+TEST(DefLint, MalformedXmlIsError)
+{
+    DefReport r = lintDef("<definition>\n<mod file=\"DT_X.json\">\n<change item=\"a\" property=\"b\" value=\"1\">\n</mod>\n</definition>\n");
+    EXPECT_GE(count(r.findings, Severity::Error), 1u);
+}
+
+TEST(DefLint, MissingAttributesAndBadPath)
+{
+    DefReport r = lintDef(wrap("<change item=\"Pick\" value=\"1\"/>\n<change item=\"Pick\" property=\"A..B\" value=\"1\"/>\n"));
+    EXPECT_TRUE(has(r.findings, Severity::Error, 3, "no property"));
+    EXPECT_TRUE(has(r.findings, Severity::Error, 4, "malformed property path"));
+}
+
+TEST(DefLint, DuplicateAndConflict)
+{
+    DefReport r = lintDef(wrap(
+        "<change item=\"Pick\" property=\"Durability\" value=\"10\"/>\n"
+        "<change item=\"Pick\" property=\"Durability\" value=\"10\"/>\n"
+        "<change item=\"Pick\" property=\"Durability\" value=\"20\"/>\n"));
+    EXPECT_TRUE(has(r.findings, Severity::Warning, 4, "duplicate"));
+    EXPECT_TRUE(has(r.findings, Severity::Error, 5, "line 3"));
+    EXPECT_EQ(r.changes.size(), 1u);
+}
+
+TEST(DefLint, UnknownOpIsWarningAndNotCounted)
+{
+    DefReport r = lintDef(wrap("<rename item=\"Pick\"/>\n"));
+    EXPECT_TRUE(has(r.findings, Severity::Warning, 3, "unknown op <rename>"));
+    EXPECT_EQ(r.ops, 0u);
+}
+
+TEST(DefLint, AddRowJson)
+{
+    DefReport bad = lintDef(wrap("<add_row name=\"New\"><![CDATA[{\"Value\": [}]]></add_row>\n"));
+    EXPECT_TRUE(has(bad.findings, Severity::Error, 3, "malformed"));
+
+    DefReport noValue = lintDef(wrap("<add_row name=\"New\"><![CDATA[{\"Name\": \"New\"}]]></add_row>\n"));
+    EXPECT_TRUE(has(noValue.findings, Severity::Warning, 3, "no Value array"));
+
+    DefReport noName = lintDef(wrap("<add_row><![CDATA[{\"Value\": []}]]></add_row>\n"));
+    EXPECT_TRUE(has(noName.findings, Severity::Error, 3, "no name"));
+}
+
+TEST(DefLint, ManifestRootIsSkipped)
+{
+    DefReport r = lintDef("<manifest><title>x</title></manifest>");
+    ASSERT_EQ(r.findings.size(), 1u);
+    EXPECT_EQ(r.findings[0].severity, Severity::Note);
+}
+
+TEST(DefLint, PropertyPaths)
+{
+    EXPECT_TRUE(isValidPropertyPath("MaxStackSize"));
+    EXPECT_TRUE(isValidPropertyPath("Stats.Damage"));
+    EXPECT_TRUE(isValidPropertyPath("Ingredients[2].Count"));
+    EXPECT_FALSE(isValidPropertyPath(""));
+    EXPECT_FALSE(isValidPropertyPath("A."));
+    EXPECT_FALSE(isValidPropertyPath("[0]"));
+    EXPECT_FALSE(isValidPropertyPath("A[x]"));
+    EXPECT_FALSE(isValidPropertyPath("A]"));
+}
+
+TEST(DefLint, ManifestPaths)
+{
+    std::set<std::string> present{"items/dt_items.def"};
+    auto exists = [&](const std::string& rel) { return present.count(rel) != 0; };
+    ManifestReport r = lintManifest(
+        "[ModInfo]\nTitle = Test\n\n[Paths]\nitems = true\nitems|dt_items.def = true\nitems|dt_gone.def = true\nitems|dt_off.def = false\nitems|dt_odd.def = maybe\n",
+        exists);
+    EXPECT_EQ(r.title, "Test");
+    ASSERT_EQ(r.defPaths.size(), 1u);
+    EXPECT_EQ(r.defPaths[0], "items/dt_items.def");
+    EXPECT_TRUE(has(r.findings, Severity::Error, 7, "missing .def: items/dt_gone.def"));
+    EXPECT_TRUE(has(r.findings, Severity::Warning, 9, "neither true nor false"));
+    EXPECT_EQ(count(r.findings, Severity::Error), 1u);
+}
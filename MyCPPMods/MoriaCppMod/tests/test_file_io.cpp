@@ -954,3 +954,43 @@ TEST(ParseIniLine, InlineCommentNoSpace)
     ASSERT_NE(kv, nullptr);
     EXPECT_EQ(kv->value, "Value;comment");
 }
+
+// ════════════════════════════════════════════════════════════════════════════
+// Definition dry-run diff formatting
+// ════════════════════════════════════════════════════════════════════════════
+
+TEST(CsvEscape, PlainFieldUnchanged)
+{
+    EXPECT_EQ(csvEscape("MaxStackSize"), "MaxStackSize");
+}
+
+TEST(CsvEscape, CommaAndQuoteAreQuoted)
+{
+    EXPECT_EQ(csvEscape("a,b"), "\"a,b\"");
+    EXPECT_EQ(csvEscape("(TagName=\"X\")"), "\"(TagName=\"\"X\"\")\"");
+}
+
+TEST(FormatDefDiff, CsvHeaderAndRow)
+{
+    std::vector<DefDiffEntry> d{{"Fat Storage", "change", "DT_Storage", "Chest", "Width", "5", "8", "ok"}};
+    EXPECT_EQ(formatDefDiffCsv(d),
+              "pack,op,table,row,property,old,new,status\n"
+              "Fat Storage,change,DT_Storage,Chest,Width,5,8,ok\n");
+}
+
+TEST(FormatDefDiff, CsvEmpty)
+{
+    EXPECT_EQ(formatDefDiffCsv({}), "pack,op,table,row,property,old,new,status\n");
+}
+
+TEST(FormatDefDiff, JsonEscapesAndSeparators)
+{
+    std::vector<DefDiffEntry> d{
+        {"p", "delete", "DT_Items", "Row", "Tags", "(A=\"x\")", "-Tag.A", "ok"},
+        {"p", "change", "DT_Items", "Row2", "Max", "", "1", "row_missing"}};
+    std::string json = formatDefDiffJson(d);
+    EXPECT_EQ(json.front(), '[');
+    EXPECT_NE(json.find("\"old\":\"(A=\\\"x\\\")\""), std::string::npos);
+    EXPECT_NE(json.find("},\n{"), std::string::npos);
+    EXPECT_NE(json.find("\"status\":\"row_missing\"}\n]"), std::string::npos);
+}
@@ -0,0 +1,116 @@
+// Unit tests for clusterOnGrid (stability audit markers)
+
+#include <gtest/gtest.h>
+#include "moria_grid_cluster.h"
+
+#include <random>
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    ClusterPoint pt(float x, float y, float z, bool critical = false, float stab = 40.0f)
+    {
+        return {x, y, z, critical, stab};
+    }
+
+    int total(const GridClusterResult& r)
+    {
+        int n = 0;
+        for (auto& c : r.clusters) n += c.count;
+        return n;
+    }
+}
+
+TEST(GridCluster, EmptyInput)
+{
+    auto r = clusterOnGrid({}, 800.0f, 16);
+    EXPECT_TRUE(r.clusters.empty());
+    EXPECT_EQ(r.merges, 0);
+}
+
+TEST(GridCluster, SameCellMergesToCentroid)
+{
+    std::vector<ClusterPoint> pts = {pt(100, 100, 0), pt(300, 100, 0), pt(200, 400, 0, true, 5.0f)};
+    auto r = clusterOnGrid(pts, 800.0f, 0);
+    ASSERT_EQ(r.clusters.size(), 1u);
+    auto& c = r.clusters[0];
+    EXPECT_EQ(c.count, 3);
+    EXPECT_EQ(c.criticalCount, 1);
+    EXPECT_TRUE(c.critical());
+    EXPECT_FLOAT_EQ(c.x, 200.0f);
+    EXPECT_FLOAT_EQ(c.y, 200.0f);
+    EXPECT_FLOAT_EQ(c.minStability, 5.0f);
+}
+
+TEST(GridCluster, SeparateCellsStaySeparate)
+{
+    std::vector<ClusterPoint> pts = {pt(0, 0, 0), pt(5000, 0, 0), pt(0, 5000, 0), pt(0, 0, 5000)};
+    auto r = clusterOnGrid(pts, 800.0f, 16);
+    EXPECT_EQ(r.clusters.size(), 4u);
+    EXPECT_EQ(r.merges, 0);
+    EXPECT_EQ(r.cellSize, 800.0f);
+}
+
+TEST(GridCluster, GridIsAnchoredAtInputMinimum)
+{
+    // Straddling the world origin doesn't split a group that fits one cell.
+    std::vector<ClusterPoint> pts = {pt(-1, 10, 10), pt(1, 10, 10)};
+    EXPECT_EQ(clusterOnGrid(pts, 800.0f, 0).clusters.size(), 1u);
+    // ...and any scatter collapses to one cluster when asked to.
+    pts = {pt(-9000, -9000, -9000), pt(9000, 9000, 9000), pt(-9000, 9000, 0)};
+    auto r = clusterOnGrid(pts, 800.0f, 1);
+    ASSERT_EQ(r.clusters.size(), 1u);
+    EXPECT_NEAR(r.clusters[0].x, -3000.0f, 0.01f);
+}
+
+TEST(GridCluster, BoundedByDoublingCellSize)
+{
+    // A 40 m x 40 m failing floor, one piece every 2 m: 400 points.
+    std::vector<ClusterPoint> pts;
+    for (int i = 0; i < 20; i++)
+        for (int j = 0; j < 20; j++)
+            pts.push_back(pt(i * 200.0f + 50, j * 200.0f + 50, 0, (i + j) % 7 == 0));
+    auto r = clusterOnGrid(pts, 100.0f, 12);
+    EXPECT_LE(r.clusters.size(), 12u);
+    EXPECT_GT(r.merges, 0);
+    EXPECT_GT(r.cellSize, 100.0f);
+    EXPECT_EQ(total(r), 400);
+}
+
+TEST(GridCluster, CriticalFirstThenLargest)
+{
+    std::vector<ClusterPoint> pts;
+    for (int i = 0; i < 5; i++) pts.push_back(pt(10, 10, 0));               // big marginal
+    pts.push_back(pt(5000, 0, 0, true, 1.0f));                               // small critical
+    for (int i = 0; i < 3; i++) pts.push_back(pt(0, 5000, 0));               // mid marginal
+    auto r = clusterOnGrid(pts, 800.0f, 0);
+    ASSERT_EQ(r.clusters.size(), 3u);
+    EXPECT_TRUE(r.clusters[0].critical());
+    EXPECT_EQ(r.clusters[1].count, 5);
+    EXPECT_EQ(r.clusters[2].count, 3);
+}
+
+TEST(GridCluster, RandomScatterConservesMembers)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> d(-50000.0f, 50000.0f);
+    std::vector<ClusterPoint> pts;
+    int crit = 0;
+    for (int i = 0; i < 3000; i++)
+    {
+        bool c = (rng() % 5) == 0;
+        crit += c;
+        pts.push_back(pt(d(rng), d(rng), d(rng) * 0.05f, c));
+    }
+    for (int cap : {1, 8, 64, 500})
+    {
+        auto r = clusterOnGrid(pts, 800.0f, cap);
+        EXPECT_LE(static_cast<int>(r.clusters.size()), cap);
+        EXPECT_EQ(total(r), 3000);
+        int rc = 0;
+        for (auto& c : r.clusters) rc += c.criticalCount;
+        EXPECT_EQ(rc, crit);
+    }
+}
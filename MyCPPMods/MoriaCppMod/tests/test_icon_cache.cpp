@@ -0,0 +1,176 @@
+// Unit tests for IconCache (shared off-thread overlay icon decoding)
+
+#include <gtest/gtest.h>
+#include "moria_icon_cache.h"
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+
+using namespace MoriaMods;
+
+struct FakeImage
+{
+    std::wstring name;
+};
+
+using Cache = IconCache<FakeImage>;
+
+static Cache::Ptr decodeOk(const std::wstring& n) { return std::make_shared<FakeImage>(FakeImage{n}); }
+static Cache::Ptr decodeFail(const std::wstring&) { return nullptr; }
+
+TEST(IconCache, AcquireQueuesOneDecodePerName)
+{
+    Cache c;
+    c.acquire(L"T_Wall");
+    c.acquire(L"T_Wall");
+    c.acquire(L"T_Floor");
+    EXPECT_EQ(c.queued(), 2u);
+    EXPECT_EQ(c.refs(L"T_Wall"), 2);
+    EXPECT_EQ(c.find(L"T_Wall"), nullptr);
+
+    int calls = 0;
+    c.drain([&](const std::wstring& n) { calls++; return decodeOk(n); });
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(c.decodes(), 2u);
+    ASSERT_NE(c.find(L"T_Wall"), nullptr);
+    EXPECT_EQ(c.find(L"T_Wall")->name, L"T_Wall");
+}
+
+TEST(IconCache, ConsumersShareOneImage)
+{
+    Cache c;
+    c.acquire(L"T_Door");
+    c.drain(decodeOk);
+    c.acquire(L"T_Door");
+    EXPECT_EQ(c.queued(), 0u);
+    EXPECT_EQ(c.find(L"T_Door").get(), c.find(L"T_Door").get());
+    EXPECT_EQ(c.decodes(), 1u);
+}
+
+TEST(IconCache, EmptyNameIsIgnored)
+{
+    Cache c;
+    c.acquire(L"");
+    c.release(L"");
+    EXPECT_EQ(c.entries(), 0u);
+    EXPECT_EQ(c.queued(), 0u);
+}
+
+TEST(IconCache, FailedDecodeIsNotRetriedUntilInvalidated)
+{
+    Cache c;
+    c.acquire(L"T_Missing");
+    c.drain(decodeFail);
+    EXPECT_EQ(c.failures(), 1u);
+    c.release(L"T_Missing");
+    c.acquire(L"T_Missing");
+    EXPECT_EQ(c.queued(), 0u);
+
+    c.invalidate(L"T_Missing");
+    EXPECT_EQ(c.queued(), 1u);
+    c.drain(decodeOk);
+    EXPECT_NE(c.find(L"T_Missing"), nullptr);
+}
+
+TEST(IconCache, InvalidateDuringDecodeDropsTheStaleResult)
+{
+    Cache c;
+    c.acquire(L"T_Beam");
+    int calls = 0;
+    c.drain([&](const std::wstring& n) {
+        if (calls++ == 0) c.invalidate(n); // file replaced mid-decode
+        return decodeOk(n);
+    }, 1);
+    EXPECT_EQ(c.find(L"T_Beam"), nullptr);
+    EXPECT_EQ(c.queued(), 1u);
+    c.drain(decodeOk);
+    EXPECT_NE(c.find(L"T_Beam"), nullptr);
+}
+
+TEST(IconCache, IdleNamesAreEvictedOldestFirstBeyondCap)
+{
+    Cache c(2);
+    for (auto n : {L"A", L"B", L"C"}) c.acquire(n);
+    c.drain(decodeOk);
+    c.release(L"A");
+    c.release(L"B");
+    EXPECT_EQ(c.evictions(), 0u);
+    c.release(L"C");
+    EXPECT_EQ(c.evictions(), 1u);
+    EXPECT_EQ(c.find(L"A"), nullptr);
+    EXPECT_NE(c.find(L"B"), nullptr);
+    EXPECT_NE(c.find(L"C"), nullptr);
+}
+
+TEST(IconCache, ReacquiredIdleNameIsNotEvicted)
+{
+    Cache c(1);
+    for (auto n : {L"A", L"B"}) c.acquire(n);
+    c.drain(decodeOk);
+    c.release(L"A");
+    c.acquire(L"A"); // held again: no longer idle
+    c.release(L"B");
+    EXPECT_EQ(c.evictions(), 0u);
+    EXPECT_NE(c.find(L"A"), nullptr);
+}
+
+TEST(IconCache, HeldSnapshotOutlivesEviction)
+{
+    Cache c(0);
+    c.acquire(L"A");
+    c.drain(decodeOk);
+    auto snap = c.snapshot();
+    c.release(L"A");
+    EXPECT_EQ(c.find(L"A"), nullptr);
+    ASSERT_NE(snap->find(L"A"), nullptr);
+    EXPECT_EQ(snap->find(L"A")->name, L"A");
+}
+
+TEST(IconCache, PublishCallbackFiresPerNewSnapshot)
+{
+    Cache c;
+    int published = 0;
+    c.setOnPublish([&] { published++; });
+    c.acquire(L"A");
+    c.acquire(L"B");
+    uint64_t before = c.snapshot()->version;
+    c.drain(decodeOk);
+    EXPECT_EQ(published, 2);
+    EXPECT_EQ(c.snapshot()->version, before + 2);
+}
+
+TEST(IconCache, WorkerDecodesOffTheCallingThread)
+{
+    Cache c;
+    std::set<std::thread::id> decodeThreads;
+    std::mutex m;
+    c.startWorker([&](const std::wstring& n) {
+        std::lock_guard<std::mutex> lock(m);
+        decodeThreads.insert(std::this_thread::get_id());
+        return decodeOk(n);
+    });
+    for (int i = 0; i < 50; i++) c.acquire(L"T_" + std::to_wstring(i));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (c.snapshot()->ready.size() < 50 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    c.stopWorker();
+
+    EXPECT_EQ(c.snapshot()->ready.size(), 50u);
+    ASSERT_EQ(decodeThreads.size(), 1u);
+    EXPECT_NE(*decodeThreads.begin(), std::this_thread::get_id());
+}
+
+TEST(IconCache, ClearDropsImagesAndQueue)
+{
+    Cache c;
+    c.acquire(L"A");
+    c.drain(decodeOk);
+    c.acquire(L"B");
+    c.clear();
+    EXPECT_EQ(c.entries(), 0u);
+    EXPECT_EQ(c.queued(), 0u);
+    EXPECT_EQ(c.find(L"A"), nullptr);
+}
@@ -0,0 +1,236 @@
+// Unit tests for IconStore (pack file + manifest icon store)
+
+#include <gtest/gtest.h>
+#include "moria_icon_store.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MoriaMods;
+namespace fs = std::filesystem;
+
+namespace
+{
+    std::vector<uint32_t> icon(int w, int h, uint32_t seed)
+    {
+        std::vector<uint32_t> px(size_t(w) * h);
+        for (size_t i = 0; i < px.size(); i++) px[i] = 0xFF000000u | uint32_t(i * 2654435761u + seed);
+        return px;
+    }
+
+    class IconStoreTest : public ::testing::Test
+    {
+      protected:
+        fs::path dir;
+        void SetUp() override
+        {
+            dir = fs::temp_directory_path() /
+                  ("moria_icon_store_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+            fs::remove_all(dir);
+        }
+        void TearDown() override { fs::remove_all(dir); }
+    };
+}
+
+TEST_F(IconStoreTest, OpenCreatesEmptyPack)
+{
+    IconStore s;
+    ASSERT_TRUE(s.open(dir));
+    EXPECT_EQ(s.size(), 0u);
+    EXPECT_EQ(s.packBytes(), sizeof(IconStore::kMagic));
+    EXPECT_TRUE(fs::exists(dir / "icons.pack"));
+}
+
+TEST_F(IconStoreTest, PutThenReadRoundTrips)
+{
+    IconStore s;
+    ASSERT_TRUE(s.open(dir));
+    auto px = icon(128, 128, 1);
+    ASSERT_TRUE(s.put(L"T_UI_Icon_Wall", 128, 128, px.data()));
+    EXPECT_TRUE(s.contains(L"T_UI_Icon_Wall"));
+
+    int w = 0, h = 0;
+    std::vector<uint32_t> out;
+    ASSERT_TRUE(s.read(L"T_UI_Icon_Wall", w, h, out));
+    EXPECT_EQ(w, 128);
+    EXPECT_EQ(h, 128);
+    EXPECT_EQ(out, px);
+    EXPECT_FALSE(s.read(L"T_UI_Icon_Missing", w, h, out));
+}
+
+TEST_F(IconStoreTest, ManifestPersistsAcrossReopen)
+{
+    auto a = icon(128, 128, 1), b = icon(64, 32, 2);
+    {
+        IconStore s;
+        ASSERT_TRUE(s.open(dir));
+        ASSERT_TRUE(s.put(L"T_A", 128, 128, a.data()));
+        ASSERT_TRUE(s.put(L"T_B", 64, 32, b.data()));
+        ASSERT_TRUE(s.saveManifest());
+    }
+    IconStore s;
+    ASSERT_TRUE(s.open(dir));
+    EXPECT_EQ(s.size(), 2u);
+    int w = 0, h = 0;
+    std::vector<uint32_t> out;
+    ASSERT_TRUE(s.read(L"T_B", w, h, out));
+    EXPECT_EQ(w, 64);
+    EXPECT_EQ(h, 32);
+    EXPECT_EQ(out, b);
+}
+
+TEST_F(IconStoreTest, IdenticalPixelsAreStoredOnce)
+{
+    IconStore s;
+    ASSERT_TRUE(s.open(dir));
+    auto px = icon(128, 128, 7);
+    ASSERT_TRUE(s.put(L"T_A", 128, 128, px.data()));
+    uint64_t after = s.packBytes();
+    ASSERT_TRUE(s.put(L"T_A", 128, 128, px.data()));   // same name, same pixels
+    ASSERT_TRUE(s.put(L"T_Alias", 128, 128, px.data())); // other name, same pixels
+    EXPECT_EQ(s.packBytes(), after);
+    EXPECT_EQ(s.size(), 2u);
+
+    auto changed = icon(128, 128, 8);
+    ASSERT_TRUE(s.put(L"T_A", 128, 128, changed.data()));
+    EXPECT_EQ(s.packBytes(), after + 128 * 128 * 4);
+    int w, h;
+    std::vector<uint32_t> out;
+    ASSERT_TRUE(s.read(L"T_A", w, h, out));
+    EXPECT_EQ(out, changed);
+    ASSERT_TRUE(s.read(L"T_Alias", w, h, out));
+    EXPECT_EQ(out, px);
+}
+
+TEST_F(IconStoreTest, RejectsBadInput)
+{
+    IconStore s;
+    auto px = icon(4, 4, 0);
+    EXPECT_FALSE(s.put(L"T_A", 4, 4, px.data())); // not open
+    ASSERT_TRUE(s.open(dir));
+    EXPECT_FALSE(s.put(L"", 4, 4, px.data()));
+    EXPECT_FALSE(s.put(L"bad=name", 4, 4, px.data()));
+    EXPECT_FALSE(s.put(L"T_\u00e9", 4, 4, px.data()));
+    EXPECT_FALSE(s.put(L"T_A", 0, 4, px.data()));
+    EXPECT_FALSE(s.put(L"T_A", 4096, 4, px.data()));
+    EXPECT_EQ(s.size(), 0u);
+}
+
+TEST_F(IconStoreTest, UnsavedAppendIsSkippedAfterReopen)
+{
+    auto a = icon(16, 16, 1), b = icon(16, 16, 2);
+    {
+        IconStore s;
+        ASSERT_TRUE(s.open(dir));
+        ASSERT_TRUE(s.put(L"T_A", 16, 16, a.data()));
+        ASSERT_TRUE(s.saveManifest());
+        ASSERT_TRUE(s.put(L"T_B", 16, 16, b.data())); // "crash" before saving
+    }
+    IconStore s;
+    ASSERT_TRUE(s.open(dir));
+    EXPECT_TRUE(s.contains(L"T_A"));
+    EXPECT_FALSE(s.contains(L"T_B"));
+    // New appends go after the orphaned tail, never over it.
+    uint64_t end = s.packBytes();
+    ASSERT_TRUE(s.put(L"T_B", 16, 16, b.data()));
+    EXPECT_EQ(s.packBytes(), end + 16 * 16 * 4);
+}
+
+TEST_F(IconStoreTest, CorruptRecordIsForgotten)
+{
+    auto a = icon(16, 16, 1);
+    {
+        IconStore s;
+        ASSERT_TRUE(s.open(dir));
+        ASSERT_TRUE(s.put(L"T_A", 16, 16, a.data()));
+        ASSERT_TRUE(s.saveManifest());
+    }
+    {
+        std::fstream f(dir / "icons.pack", std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(sizeof(IconStore::kMagic) + 10);
+        f.put('\x55');
+    }
+    IconStore s;
+    ASSERT_TRUE(s.open(dir));
+    ASSERT_TRUE(s.contains(L"T_A"));
+    int w, h;
+    std::vector<uint32_t> out;
+    EXPECT_FALSE(s.read(L"T_A", w, h, out));
+    EXPECT_FALSE(s.contains(L"T_A"));
+    // Re-extraction stores fresh bytes instead of deduping onto the bad ones.
+    ASSERT_TRUE(s.put(L"T_A", 16, 16, a.data()));
+    ASSERT_TRUE(s.read(L"T_A", w, h, out));
+    EXPECT_EQ(out, a);
+}
+
+TEST_F(IconStoreTest, ForeignPackStartsEmpty)
+{
+    fs::create_directories(dir);
+    std::ofstream(dir / "icons.pack", std::ios::binary) << "not a pack file at all";
+    std::ofstream(dir / "icons.manifest") << "[Store]\nVersion=1\n[Icons]\nT_A=16,16,0x8,0x1\n";
+    IconStore s;
+    ASSERT_TRUE(s.open(dir));
+    EXPECT_EQ(s.size(), 0u);
+    EXPECT_EQ(s.packBytes(), sizeof(IconStore::kMagic));
+}
+
+TEST(IconStoreManifest, SerializeParseRoundTrip)
+{
+    std::unordered_map<std::wstring, IconStoreEntry> idx = {
+        {L"T_B", {64, 32, 0x4008, 0xDEADBEEFCAFEF00Dull}},
+        {L"T_A", {128, 128, 0x8, 0x1234}},
+    };
+    std::string text = IconStore::serializeManifest(idx, 0x6008);
+    EXPECT_LT(text.find("T_A="), text.find("T_B=")); // sorted
+    auto rows = IconStore::parseManifest(text);
+    ASSERT_EQ(rows.size(), 2u);
+    for (auto& [name, e] : rows)
+    {
+        const auto& want = idx.at(name);
+        EXPECT_EQ(e.w, want.w);
+        EXPECT_EQ(e.h, want.h);
+        EXPECT_EQ(e.offset, want.offset);
+        EXPECT_EQ(e.hash, want.hash);
+    }
+}
+
+TEST(IconStoreManifest, IgnoresOtherVersionsAndBadRows)
+{
+    EXPECT_TRUE(IconStore::parseManifest("[Store]\nVersion=2\n[Icons]\nT_A=1,1,0x8,0x1\n").empty());
+    auto rows = IconStore::parseManifest("[Store]\nVersion=1\n[Icons]\nT_A=1,1,0x8,0x1\nT_B=garbage\nT_C=0,1,0x8,0x1\n");
+    ASSERT_EQ(rows.size(), 1u);
+    EXPECT_EQ(rows[0].first, L"T_A");
+}
+
+TEST_F(IconStoreTest, ReaderThreadSeesOnlyCompleteEntries)
+{
+    IconStore s;
+    ASSERT_TRUE(s.open(dir));
+    constexpr int kIcons = 200;
+    std::atomic<bool> done{false};
+    std::atomic<int> bad{0}, hits{0};
+    std::thread reader([&] {
+        std::vector<uint32_t> out;
+        while (!done)
+            for (int i = 0; i < kIcons; i += 17)
+            {
+                int w, h;
+                if (!s.read(L"T_" + std::to_wstring(i), w, h, out)) continue;
+                hits++;
+                if (out != icon(8, 8, uint32_t(i))) bad++;
+            }
+    });
+    for (int i = 0; i < kIcons; i++)
+    {
+        auto px = icon(8, 8, uint32_t(i));
+        ASSERT_TRUE(s.put(L"T_" + std::to_wstring(i), 8, 8, px.data()));
+    }
+    done = true;
+    reader.join();
+    EXPECT_EQ(bad.load(), 0);
+    EXPECT_EQ(s.size(), size_t(kIcons));
+}
@@ -0,0 +1,250 @@
+// Unit tests for InventoryIndex (incremental inventory index)
+
+#include <gtest/gtest.h>
+#include "moria_inventory_index.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    // Stand-in for FItemInstanceArray.List plus the container CDOs.
+    struct FakeInventory
+    {
+        std::vector<InvItem> items;
+        int reads{0};
+        int capacityLookups{0};
+        int bagClass{0}, chestClass{0}, oreClass{0};
+
+        InvItem& add(int32_t id, int32_t slot, int32_t count = 1, int32_t containerStart = 0, const void* cls = nullptr)
+        {
+            items.push_back({id, slot, count, containerStart, cls ? cls : &oreClass});
+            return items.back();
+        }
+
+        int32_t touch(InventoryIndex& idx, int32_t id)
+        {
+            return idx.touch(items.data(), static_cast<int32_t>(items.size()), id,
+                             [this](int32_t i) { reads++; return items[i]; },
+                             [this](const void* cls) { capacityLookups++; return cls == &chestClass ? 40 : 20; });
+        }
+
+        // Base layout: backpack at 100 (20 slots), chest at 200 (40 slots).
+        void base()
+        {
+            add(1, 0, 1, 100, &bagClass);
+            add(2, 0, 1, 200, &chestClass);
+            add(10, 105, 7);
+            add(11, 230, 3);
+            add(12, 119, 1);
+        }
+    };
+}
+
+TEST(InventoryIndex, FirstTouchBuildsAndFinds)
+{
+    FakeInventory inv;
+    inv.base();
+    InventoryIndex idx;
+    EXPECT_EQ(inv.touch(idx, 11), 3);
+    EXPECT_EQ(idx.rebuilds(), 1u);
+    EXPECT_EQ(idx.containerCount(), 2);
+    ASSERT_NE(idx.item(10), nullptr);
+    EXPECT_EQ(idx.item(10)->count, 7);
+    EXPECT_EQ(inv.touch(idx, 999), -1);
+    EXPECT_TRUE(idx.orphans().empty());
+}
+
+TEST(InventoryIndex, MoveRereadsOneEntry)
+{
+    FakeInventory inv;
+    inv.base();
+    InventoryIndex idx;
+    inv.touch(idx, 10);
+    int before = inv.reads;
+
+    inv.items[2].slot = 210;
+    inv.items[2].count = 9;
+    EXPECT_EQ(inv.touch(idx, 10), 2);
+    EXPECT_EQ(inv.reads - before, 1);
+    EXPECT_EQ(idx.rebuilds(), 1u);
+    EXPECT_EQ(idx.refreshes(), 1u);
+    EXPECT_EQ(idx.item(10)->slot, 210);
+    EXPECT_EQ(idx.item(10)->count, 9);
+}
+
+TEST(InventoryIndex, SwapRefreshesThePartner)
+{
+    FakeInventory inv;
+    inv.base();
+    InventoryIndex idx;
+    inv.touch(idx, 10);
+
+    // MoveSwapItem: 10 (backpack) and 11 (chest) trade slots; the hook names only 10.
+    std::swap(inv.items[2].slot, inv.items[3].slot);
+    int before = inv.reads;
+    EXPECT_EQ(inv.touch(idx, 10), 2);
+    EXPECT_EQ(inv.reads - before, 2);
+    EXPECT_EQ(idx.rebuilds(), 1u);
+    EXPECT_EQ(idx.item(10)->slot, 230);
+    EXPECT_EQ(idx.item(11)->slot, 105);
+    EXPECT_EQ(idx.itemsIn(2), (std::vector<int32_t>{10}));
+    EXPECT_EQ(idx.itemsIn(1), (std::vector<int32_t>{11, 12}));
+    EXPECT_TRUE(idx.orphans().empty());
+
+    // Swap with an orphan: the orphan flag follows the item that moved out.
+    inv.items[4].slot = 150;
+    inv.touch(idx, 12);
+    ASSERT_EQ(idx.orphans().size(), 1u);
+    std::swap(inv.items[3].slot, inv.items[4].slot);
+    inv.touch(idx, 12);
+    EXPECT_EQ(idx.item(12)->slot, 105);
+    EXPECT_EQ(idx.item(11)->slot, 150);
+    ASSERT_EQ(idx.orphans().size(), 1u);
+    EXPECT_EQ(idx.orphans()[0], 11);
+}
+
+TEST(InventoryIndex, ResizeOrSwapRemoveRebuilds)
+{
+    FakeInventory inv;
+    inv.base();
+    InventoryIndex idx;
+    inv.touch(idx, 10);
+
+    // FastArray swap-remove of item 10: the last entry takes its place.
+    inv.items[2] = inv.items.back();
+    inv.items.pop_back();
+    EXPECT_EQ(inv.touch(idx, 12), 2);
+    EXPECT_EQ(idx.rebuilds(), 2u);
+    EXPECT_EQ(idx.indexOf(10), -1);
+
+    // Same size, but the cached index now holds another item.
+    std::swap(inv.items[2], inv.items[3]);
+    EXPECT_EQ(inv.touch(idx, 12), 3);
+    EXPECT_EQ(idx.rebuilds(), 3u);
+}
+
+TEST(InventoryIndex, OrphansAreFlaggedAsTheyAppear)
+{
+    FakeInventory inv;
+    inv.base();
+    InventoryIndex idx;
+    inv.touch(idx, 10);
+    EXPECT_TRUE(idx.takeNewOrphans().empty());
+
+    inv.items[4].slot = 150;               // between the bag and the chest
+    inv.touch(idx, 12);
+    EXPECT_EQ(idx.takeNewOrphans(), (std::vector<int32_t>{12}));
+    EXPECT_EQ(idx.orphans(), (std::vector<int32_t>{12}));
+
+    // Still orphaned on the next touch: not reported again.
+    inv.touch(idx, 12);
+    EXPECT_TRUE(idx.takeNewOrphans().empty());
+
+    inv.items[4].slot = 239;
+    inv.touch(idx, 12);
+    EXPECT_TRUE(idx.orphans().empty());
+}
+
+TEST(InventoryIndex, ContainerRangeBoundaries)
+{
+    FakeInventory inv;
+    inv.base();
+    InventoryIndex idx;
+    inv.touch(idx, 1);
+    EXPECT_TRUE(idx.inAnyContainer(100));
+    EXPECT_TRUE(idx.inAnyContainer(119));
+    EXPECT_FALSE(idx.inAnyContainer(120));
+    EXPECT_FALSE(idx.inAnyContainer(99));
+    EXPECT_TRUE(idx.inAnyContainer(239));
+    EXPECT_FALSE(idx.inAnyContainer(240));
+}
+
+TEST(InventoryIndex, MovingAContainerReclassifiesItsContents)
+{
+    FakeInventory inv;
+    inv.base();
+    InventoryIndex idx;
+    inv.touch(idx, 1);
+
+    // The bag's contents slot range moves away from item 10 and 12.
+    inv.items[0].containerStart = 300;
+    inv.touch(idx, 1);
+    EXPECT_EQ(idx.takeNewOrphans(), (std::vector<int32_t>{10, 12}));
+    EXPECT_EQ(idx.rebuilds(), 1u);
+}
+
+TEST(InventoryIndex, CapacityIsCachedPerClass)
+{
+    FakeInventory inv;
+    inv.base();
+    inv.add(3, 0, 1, 400, &inv.bagClass);
+    InventoryIndex idx;
+    inv.touch(idx, 1);
+    EXPECT_EQ(inv.capacityLookups, 2);
+    inv.items.pop_back();
+    inv.touch(idx, 1);
+    EXPECT_EQ(inv.capacityLookups, 2);
+}
+
+TEST(InventoryIndex, EffectEntriesByItem)
+{
+    std::vector<int32_t> onItem = {10, 12, 10, 0, 11};
+    InventoryIndex idx;
+    int reads = 0;
+    auto read = [&](int32_t i) { reads++; return onItem[i]; };
+    idx.syncEffects(onItem.data(), 5, read);
+    EXPECT_EQ(idx.effectEntries(10), (std::vector<int32_t>{0, 2}));
+    EXPECT_EQ(idx.effectEntries(11), (std::vector<int32_t>{4}));
+    EXPECT_TRUE(idx.effectEntries(99).empty());
+
+    idx.syncEffects(onItem.data(), 5, read);
+    EXPECT_EQ(reads, 5);
+
+    onItem[0] = onItem[4];                 // swap-remove entry 0
+    idx.syncEffects(onItem.data(), 4, read);
+    EXPECT_EQ(idx.effectEntries(10), (std::vector<int32_t>{2}));
+    EXPECT_EQ(idx.effectEntries(11), (std::vector<int32_t>{0}));
+
+    idx.invalidateEffects();
+    idx.syncEffects(onItem.data(), 4, read);
+    EXPECT_EQ(reads, 13);
+}
+
+TEST(InventoryIndex, ContainerContents)
+{
+    FakeInventory inv;
+    inv.base();
+    inv.add(13, 215, 2);
+    InventoryIndex idx;
+    inv.touch(idx, 1);
+    EXPECT_EQ(idx.containerAt(105), 1);
+    EXPECT_EQ(idx.containerAt(230), 2);
+    EXPECT_EQ(idx.containerAt(150), 0);
+    EXPECT_EQ(idx.itemsIn(1), (std::vector<int32_t>{10, 12}));
+    EXPECT_EQ(idx.itemsIn(2), (std::vector<int32_t>{11, 13}));
+    EXPECT_TRUE(idx.itemsIn(10).empty());   // not a container
+}
+
+TEST(InventoryIndex, SwapRemoveIfSinglePass)
+{
+    std::vector<int> v = {1, 2, 3, 4, 5, 6, 7, 8};
+    int32_t num = 8;
+    int tests = 0;
+    int32_t removed = swapRemoveIf(num,
+        [&](int32_t i) { tests++; return v[i] % 2 == 0; },
+        [&](int32_t dst, int32_t src) { v[dst] = v[src]; });
+    EXPECT_EQ(removed, 4);
+    EXPECT_EQ(num, 4);
+    EXPECT_EQ(tests, 8);
+    std::vector<int> kept(v.begin(), v.begin() + num);
+    std::sort(kept.begin(), kept.end());
+    EXPECT_EQ(kept, (std::vector<int>{1, 3, 5, 7}));
+
+    num = 3;
+    v = {2, 4, 6};
+    EXPECT_EQ(swapRemoveIf(num, [&](int32_t i) { return v[i] > 0; }, [&](int32_t d, int32_t s) { v[d] = v[s]; }), 3);
+    EXPECT_EQ(num, 0);
+}
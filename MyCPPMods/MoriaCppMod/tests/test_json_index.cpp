@@ -0,0 +1,275 @@
+// Unit tests for JsonIndex (add-row JSON tokenizer) and its parity with the
+// text-scanning extractor it replaced
+
+#include <gtest/gtest.h>
+#include "moria_json.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace MoriaMods;
+
+// ════════════════════════════════════════════════════════════════════════════
+// Reference scanner — the pre-index jsonExtractString / jsonArrayObjects,
+// kept verbatim as the parity oracle
+// ════════════════════════════════════════════════════════════════════════════
+
+static std::string refExtractString(const std::string& json, size_t start, size_t end, const std::string& key)
+{
+    std::string needle = "\"" + key + "\"";
+    size_t pos = json.find(needle, start);
+    if (pos == std::string::npos || pos >= end) return "";
+    pos += needle.size();
+
+    while (pos < end && (json[pos] == ' ' || json[pos] == ':' || json[pos] == '\t')) ++pos;
+    if (pos >= end) return "";
+
+    if (json[pos] == '"')
+    {
+        ++pos;
+        size_t valEnd = pos;
+        while (valEnd < end && json[valEnd] != '"') {
+            if (json[valEnd] == '\\') valEnd++;
+            valEnd++;
+        }
+        return json.substr(pos, valEnd - pos);
+    }
+    else if (json[pos] == '{' || json[pos] == '[')
+    {
+        char open = json[pos], close = (open == '{') ? '}' : ']';
+        int depth = 1;
+        size_t blockStart = pos;
+        ++pos;
+        while (pos < end && depth > 0) {
+            if (json[pos] == '"') { ++pos; while (pos < end && json[pos] != '"') { if (json[pos] == '\\') ++pos; ++pos; } }
+            else if (json[pos] == open) depth++;
+            else if (json[pos] == close) depth--;
+            ++pos;
+        }
+        return json.substr(blockStart, pos - blockStart);
+    }
+    else
+    {
+        size_t valStart = pos;
+        while (pos < end && json[pos] != ',' && json[pos] != '}' && json[pos] != ']'
+               && json[pos] != '\r' && json[pos] != '\n') ++pos;
+        std::string val = json.substr(valStart, pos - valStart);
+        while (!val.empty() && (val.back() == ' ' || val.back() == '\t')) val.pop_back();
+        return val;
+    }
+}
+
+static std::vector<std::pair<size_t, size_t>> refArrayObjects(const std::string& json, size_t arrStart, size_t arrEnd)
+{
+    std::vector<std::pair<size_t, size_t>> objects;
+    size_t pos = arrStart;
+    while (pos < arrEnd)
+    {
+        while (pos < arrEnd && json[pos] != '{') ++pos;
+        if (pos >= arrEnd) break;
+        size_t objStart = pos;
+        int depth = 1;
+        ++pos;
+        while (pos < arrEnd && depth > 0) {
+            if (json[pos] == '"') { ++pos; while (pos < arrEnd && json[pos] != '"') { if (json[pos] == '\\') ++pos; ++pos; } }
+            else if (json[pos] == '{') depth++;
+            else if (json[pos] == '}') depth--;
+            ++pos;
+        }
+        objects.push_back({objStart, pos});
+    }
+    return objects;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// JsonIndex basics
+// ════════════════════════════════════════════════════════════════════════════
+
+TEST(JsonIndex, ScalarMembers)
+{
+    JsonIndex idx(R"({"Name": "DropRate", "Value": 0.5, "IsZero": false, "Other": null})");
+    ASSERT_TRUE(idx.ok());
+    int root = idx.root();
+    EXPECT_EQ(idx.kind(root), JsonIndex::Kind::Object);
+    EXPECT_EQ(idx.str(root, "Name"), "DropRate");
+    EXPECT_EQ(idx.str(root, "Value"), "0.5");
+    EXPECT_EQ(idx.str(root, "IsZero"), "false");
+    EXPECT_EQ(idx.kind(idx.member(root, "IsZero")), JsonIndex::Kind::Bool);
+    EXPECT_EQ(idx.kind(idx.member(root, "Other")), JsonIndex::Kind::Null);
+    EXPECT_EQ(idx.str(root, "Missing"), "");
+    EXPECT_EQ(idx.member(root, "Missing"), JsonIndex::npos);
+}
+
+TEST(JsonIndex, NonStandardScalarKeptVerbatim)
+{
+    // UAssetAPI writes signed zero as a bare +0.
+    JsonIndex idx(R"({"Value": +0})");
+    ASSERT_TRUE(idx.ok());
+    EXPECT_EQ(idx.str(idx.root(), "Value"), "+0");
+}
+
+TEST(JsonIndex, StringEscapesStayRaw)
+{
+    JsonIndex idx(R"({"Value": "a\"b\\c"})");
+    ASSERT_TRUE(idx.ok());
+    EXPECT_EQ(idx.str(idx.root(), "Value"), R"(a\"b\\c)");
+}
+
+TEST(JsonIndex, ContainerSpanIncludesBrackets)
+{
+    JsonIndex idx(R"({"Value": [ {"A": 1}, "s", {"B": [2]} ]})");
+    ASSERT_TRUE(idx.ok());
+    int arr = idx.member(idx.root(), "Value");
+    EXPECT_EQ(idx.kind(arr), JsonIndex::Kind::Array);
+    EXPECT_EQ(idx.view(arr), R"([ {"A": 1}, "s", {"B": [2]} ])");
+    auto objs = idx.objects(arr);
+    ASSERT_EQ(objs.size(), 2u);
+    EXPECT_EQ(idx.str(objs[0], "A"), "1");
+    EXPECT_EQ(idx.str(objs[1], "B"), "[2]");
+}
+
+TEST(JsonIndex, MemberIsDirectOnly)
+{
+    // The old scanner returned the first "Name" anywhere in the range; the
+    // index only answers for the object's own members.
+    JsonIndex idx(R"({"Value": {"Name": "inner"}, "Name": "outer"})");
+    ASSERT_TRUE(idx.ok());
+    EXPECT_EQ(idx.str(idx.root(), "Name"), "outer");
+    EXPECT_EQ(idx.str(idx.member(idx.root(), "Value"), "Name"), "inner");
+}
+
+TEST(JsonIndex, EmptyContainers)
+{
+    JsonIndex idx(R"({"A": [], "B": {}, "C": [ ]})");
+    ASSERT_TRUE(idx.ok());
+    EXPECT_EQ(idx.firstChild(idx.member(idx.root(), "A")), JsonIndex::npos);
+    EXPECT_EQ(idx.firstChild(idx.member(idx.root(), "B")), JsonIndex::npos);
+    EXPECT_EQ(idx.view(idx.member(idx.root(), "C")), "[ ]");
+    EXPECT_TRUE(idx.objects(idx.member(idx.root(), "A")).empty());
+}
+
+TEST(JsonIndex, Malformed)
+{
+    EXPECT_FALSE(JsonIndex(R"({"A": 1)").ok());
+    EXPECT_FALSE(JsonIndex(R"({"A" 1})").ok());
+    EXPECT_FALSE(JsonIndex(R"({"A": "unterminated})").ok());
+    EXPECT_FALSE(JsonIndex(R"({"A": 1} trailing)").ok());
+    EXPECT_FALSE(JsonIndex("").ok());
+}
+
+TEST(JsonIndex, ErrorOffsetPointsAtProblem)
+{
+    JsonIndex idx(R"({"A": 1 "B": 2})");
+    EXPECT_FALSE(idx.ok());
+    EXPECT_EQ(idx.errorOffset(), 8u);
+}
+
+TEST(JsonIndex, DeepNestingRejected)
+{
+    std::string deep(300, '[');
+    deep += std::string(300, ']');
+    EXPECT_FALSE(JsonIndex(deep).ok());
+}
+
+TEST(JsonIndex, CrlfWhitespace)
+{
+    JsonIndex idx("{\r\n  \"Name\": \"X\",\r\n  \"Value\": 3\r\n}");
+    ASSERT_TRUE(idx.ok());
+    EXPECT_EQ(idx.str(idx.root(), "Value"), "3");
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Parity with the old scanner on the shipped definitions/ samples
+// ════════════════════════════════════════════════════════════════════════════
+
+#ifdef MORIA_DEFINITIONS_DIR
+
+// Every CDATA JSON body under definitions/ (add_row and add_property).
+static std::vector<std::string> loadDefinitionJsonSamples()
+{
+    std::vector<std::string> samples;
+    std::error_code ec;
+    for (auto& entry : std::filesystem::recursive_directory_iterator(MORIA_DEFINITIONS_DIR, ec))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".def") continue;
+        std::ifstream in(entry.path(), std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        std::string text = ss.str();
+        size_t pos = 0;
+        while ((pos = text.find("<![CDATA[", pos)) != std::string::npos)
+        {
+            pos += 9;
+            size_t end = text.find("]]>", pos);
+            if (end == std::string::npos) break;
+            size_t first = text.find_first_not_of(" \t\r\n", pos);
+            if (first < end && text[first] == '{')
+                samples.push_back(text.substr(first, end - first));
+            pos = end + 3;
+        }
+    }
+    return samples;
+}
+
+// The keys writeJsonPropertyToField reads for a given $type.
+static std::vector<std::string> keysReadFor(const std::string& type)
+{
+    std::vector<std::string> keys = {"$type", "Name", "IsZero", "Value"};
+    if (type.find("StructPropertyData") != std::string::npos) keys.push_back("StructType");
+    if (type.find("ArrayPropertyData") != std::string::npos) keys.push_back("ArrayType");
+    return keys;
+}
+
+static size_t offsetOf(const JsonIndex& idx, int node)
+{
+    return static_cast<size_t>(idx.view(node).data() - idx.text().data());
+}
+
+// Walk every property object the writer would visit and compare both APIs.
+static void checkParity(const JsonIndex& idx, int node, int& compared)
+{
+    if (node == JsonIndex::npos) return;
+    std::string text(idx.text());
+    if (idx.kind(node) == JsonIndex::Kind::Object && idx.member(node, "$type") != JsonIndex::npos)
+    {
+        size_t b = offsetOf(idx, node), e = b + idx.view(node).size();
+        for (auto& key : keysReadFor(idx.str(node, "$type")))
+        {
+            EXPECT_EQ(idx.str(node, key), refExtractString(text, b, e, key))
+                << "key " << key << " in " << idx.view(node).substr(0, 120);
+            compared++;
+        }
+    }
+    if (idx.kind(node) == JsonIndex::Kind::Array)
+    {
+        size_t b = offsetOf(idx, node), e = b + idx.view(node).size();
+        auto ref = refArrayObjects(text, b, e);
+        auto got = idx.objects(node);
+        ASSERT_EQ(got.size(), ref.size());
+        for (size_t i = 0; i < got.size(); i++)
+        {
+            EXPECT_EQ(offsetOf(idx, got[i]), ref[i].first);
+            EXPECT_EQ(offsetOf(idx, got[i]) + idx.view(got[i]).size(), ref[i].second);
+        }
+    }
+    for (int c = idx.firstChild(node); c != JsonIndex::npos; c = idx.next(c))
+        checkParity(idx, c, compared);
+}
+
+TEST(JsonIndexParity, DefinitionSamples)
+{
+    auto samples = loadDefinitionJsonSamples();
+    if (samples.empty()) GTEST_SKIP() << "no definitions/ samples at " << MORIA_DEFINITIONS_DIR;
+
+    int compared = 0;
+    for (auto& s : samples)
+    {
+        JsonIndex idx(s);
+        ASSERT_TRUE(idx.ok()) << "parse failed at byte " << idx.errorOffset() << " in " << s.substr(0, 120);
+        checkParity(idx, idx.root(), compared);
+    }
+    EXPECT_GT(compared, static_cast<int>(samples.size()));
+}
+
+#endif
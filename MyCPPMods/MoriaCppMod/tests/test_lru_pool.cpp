@@ -0,0 +1,125 @@
+// Unit tests for LruSlotPool (pooled stability audit markers)
+
+#include <gtest/gtest.h>
+#include "moria_lru_pool.h"
+
+#include <vector>
+
+using namespace MoriaMods;
+
+TEST(LruSlotPool, GrowsToCapacityWithFreshSlots)
+{
+    LruSlotPool p(3);
+    for (int i = 0; i < 3; i++)
+    {
+        auto l = p.acquire();
+        EXPECT_EQ(l.slot, i);
+        EXPECT_EQ(l.source, LruSlotPool::Source::Fresh);
+    }
+    EXPECT_EQ(p.size(), 3);
+    EXPECT_EQ(p.activeCount(), 3);
+    EXPECT_EQ(p.spawns(), 3u);
+}
+
+TEST(LruSlotPool, ReleasedSlotsAreReusedBeforeGrowing)
+{
+    LruSlotPool p(8);
+    p.acquire();
+    p.acquire();
+    p.release(0);
+    auto l = p.acquire();
+    EXPECT_EQ(l.slot, 0);
+    EXPECT_EQ(l.source, LruSlotPool::Source::Idle);
+    EXPECT_EQ(p.size(), 2);
+    EXPECT_EQ(p.reuses(), 1u);
+}
+
+TEST(LruSlotPool, EvictsLeastRecentlyUsedAtCap)
+{
+    LruSlotPool p(3);
+    p.acquire();                       // 0
+    p.acquire();                       // 1
+    p.acquire();                       // 2
+    p.release(0);
+    EXPECT_EQ(p.acquire().slot, 0);    // 0 is now the newest
+    auto l = p.acquire();
+    EXPECT_EQ(l.source, LruSlotPool::Source::Evicted);
+    EXPECT_EQ(l.slot, 1);
+    EXPECT_EQ(p.acquire().slot, 2);
+    EXPECT_EQ(p.acquire().slot, 0);
+    EXPECT_EQ(p.evictions(), 3u);
+    EXPECT_EQ(p.activeCount(), 3);
+}
+
+TEST(LruSlotPool, ReleaseAllVisitsOldestFirst)
+{
+    LruSlotPool p(4);
+    for (int i = 0; i < 4; i++) p.acquire();
+    p.release(1);
+    p.acquire();                       // slot 1 becomes newest
+    std::vector<int32_t> seen;
+    p.releaseAll([&](int32_t s) { seen.push_back(s); });
+    EXPECT_EQ(seen, (std::vector<int32_t>{0, 2, 3, 1}));
+    EXPECT_EQ(p.activeCount(), 0);
+    EXPECT_EQ(p.idleCount(), 4);
+    p.releaseAll([&](int32_t) { FAIL(); });
+}
+
+TEST(LruSlotPool, RepeatedAuditsStayFlat)
+{
+    // Spamming the key: each audit places 24 markers, then they're released.
+    LruSlotPool p(32);
+    for (int press = 0; press < 50; press++)
+    {
+        for (int i = 0; i < 24; i++) p.acquire();
+        p.releaseAll([](int32_t) {});
+    }
+    EXPECT_EQ(p.size(), 24);
+    EXPECT_EQ(p.spawns(), 24u);
+    EXPECT_EQ(p.reuses(), 49u * 24u);
+    EXPECT_EQ(p.evictions(), 0u);
+}
+
+TEST(LruSlotPool, DoubleReleaseIsIgnored)
+{
+    LruSlotPool p(2);
+    p.acquire();
+    p.release(0);
+    p.release(0);
+    p.release(7);
+    EXPECT_EQ(p.idleCount(), 1);
+    EXPECT_EQ(p.acquire().slot, 0);
+    EXPECT_EQ(p.acquire().source, LruSlotPool::Source::Fresh);
+}
+
+TEST(LruSlotPool, ShrinkRetiresSlotsPastCap)
+{
+    LruSlotPool p(6);
+    for (int i = 0; i < 6; i++) p.acquire();
+    p.release(4);
+    p.release(1);
+    std::vector<int32_t> retired;
+    p.setCapacity(3, [&](int32_t s) { retired.push_back(s); });
+    EXPECT_EQ(retired, (std::vector<int32_t>{3, 4, 5}));
+    EXPECT_EQ(p.size(), 3);
+    EXPECT_EQ(p.activeCount(), 2);
+    EXPECT_EQ(p.idleCount(), 1);
+    EXPECT_EQ(p.acquire().slot, 1);
+    EXPECT_EQ(p.acquire().source, LruSlotPool::Source::Evicted);
+
+    p.setCapacity(10, [&](int32_t) { FAIL(); });
+    EXPECT_EQ(p.acquire().source, LruSlotPool::Source::Fresh);
+}
+
+TEST(LruSlotPool, ClearForgetsEverything)
+{
+    LruSlotPool p(4);
+    p.acquire();
+    p.acquire();
+    p.release(0);
+    p.clear();
+    EXPECT_EQ(p.size(), 0);
+    EXPECT_EQ(p.activeCount(), 0);
+    EXPECT_EQ(p.acquire().slot, 0);
+    EXPECT_EQ(p.capacity(), 4);
+}
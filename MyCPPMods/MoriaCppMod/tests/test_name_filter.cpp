@@ -0,0 +1,166 @@
+// Unit tests for NameKeySet / HiddenPrefixIndex (recipe unlock filtering)
+
+#include <gtest/gtest.h>
+#include "moria_name_filter.h"
+
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+using namespace MoriaMods;
+
+namespace
+{
+    // Stand-in for the FName pool: sparse indices -> base strings.
+    struct FakePool
+    {
+        std::map<uint32_t, std::wstring> names;
+        int lookups{0};
+
+        std::wstring resolve(uint32_t idx)
+        {
+            lookups++;
+            return names.at(idx);
+        }
+
+        bool hidden(HiddenPrefixIndex& index, uint32_t idx, uint32_t number = 0)
+        {
+            return index.isHidden(idx, number, [this](uint32_t i) { return resolve(i); });
+        }
+    };
+}
+
+// ============================================================================
+// NameKeySet
+// ============================================================================
+
+TEST(NameKeySet, InsertAndContains)
+{
+    NameKeySet set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(nameKey(1, 0)));
+
+    EXPECT_TRUE(set.insert(nameKey(1, 0)));
+    EXPECT_FALSE(set.insert(nameKey(1, 0)));
+    EXPECT_TRUE(set.contains(nameKey(1, 0)));
+    EXPECT_EQ(set.size(), 1u);
+
+    // Same base string, different Number, is a different name.
+    EXPECT_FALSE(set.contains(nameKey(1, 3)));
+    EXPECT_TRUE(set.insert(nameKey(1, 3)));
+    EXPECT_EQ(set.size(), 2u);
+
+    // "None" (index 0, number 0) is a valid key.
+    EXPECT_TRUE(set.insert(nameKey(0, 0)));
+    EXPECT_TRUE(set.contains(nameKey(0, 0)));
+}
+
+TEST(NameKeySet, ReservedKeyIsRejected)
+{
+    NameKeySet set;
+    EXPECT_FALSE(set.insert(NameKeyMap<uint8_t>::kEmpty));
+    EXPECT_FALSE(set.contains(NameKeyMap<uint8_t>::kEmpty));
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(NameKeySet, MatchesStdSetAcrossRehashes)
+{
+    // Pool handles look like (block << 16 | offset): sparse and clustered.
+    std::mt19937 rng(42);
+    NameKeySet set;
+    std::set<uint64_t> ref;
+    for (int i = 0; i < 5000; i++)
+    {
+        uint32_t idx = ((rng() % 64) << 16) | (rng() % 4096) * 2;
+        uint64_t key = nameKey(idx, rng() % 3);
+        EXPECT_EQ(set.insert(key), ref.insert(key).second);
+    }
+    EXPECT_EQ(set.size(), ref.size());
+    for (int i = 0; i < 5000; i++)
+    {
+        uint64_t key = nameKey(((rng() % 64) << 16) | (rng() % 4096) * 2, rng() % 3);
+        EXPECT_EQ(set.contains(key), ref.count(key) != 0);
+    }
+}
+
+TEST(NameKeySet, ReserveKeepsContents)
+{
+    NameKeySet set;
+    set.insert(nameKey(7, 0));
+    set.reserve(1000);
+    EXPECT_TRUE(set.contains(nameKey(7, 0)));
+    set.clear();
+    EXPECT_FALSE(set.contains(nameKey(7, 0)));
+    EXPECT_TRUE(set.insert(nameKey(7, 0)));
+}
+
+// ============================================================================
+// Hidden prefixes
+// ============================================================================
+
+TEST(HiddenRowPrefix, MatchesListedPrefixesCaseSensitively)
+{
+    EXPECT_TRUE(hasHiddenRowPrefix(L"DEV_Hammer"));
+    EXPECT_TRUE(hasHiddenRowPrefix(L"playtest_Forge"));
+    EXPECT_TRUE(hasHiddenRowPrefix(L"_DEPRECATED_Wall"));
+    EXPECT_FALSE(hasHiddenRowPrefix(L"Dev_Hammer"));
+    EXPECT_FALSE(hasHiddenRowPrefix(L"Hammer_DEV_"));
+    EXPECT_FALSE(hasHiddenRowPrefix(L"DEV"));
+    EXPECT_FALSE(hasHiddenRowPrefix(L""));
+}
+
+TEST(HiddenPrefixIndex, ResolvesEachIndexOnce)
+{
+    FakePool pool;
+    pool.names = {{0x10002, L"Test_Item"}, {0x20004, L"Iron_Ingot"}};
+    HiddenPrefixIndex index;
+
+    for (int pass = 0; pass < 3; pass++)
+    {
+        EXPECT_TRUE(pool.hidden(index, 0x10002));
+        EXPECT_TRUE(pool.hidden(index, 0x10002, 4));
+        EXPECT_FALSE(pool.hidden(index, 0x20004));
+        EXPECT_FALSE(pool.hidden(index, 0x20004, 2));
+    }
+    EXPECT_EQ(pool.lookups, 2);
+    EXPECT_EQ(index.resolvedCount(), 2u);
+
+    index.clear();
+    EXPECT_FALSE(pool.hidden(index, 0x20004));
+    EXPECT_EQ(pool.lookups, 3);
+}
+
+TEST(HiddenPrefixIndex, NumberSuffixCompletesBarePrefix)
+{
+    // FName("DEV", 1) prints as "DEV_0", which the string filter hid.
+    FakePool pool;
+    pool.names = {{5, L"DEV"}, {6, L"WIP"}, {7, L"Test"}};
+    HiddenPrefixIndex index;
+    EXPECT_FALSE(pool.hidden(index, 5, 0));
+    EXPECT_TRUE(pool.hidden(index, 5, 1));
+    EXPECT_TRUE(pool.hidden(index, 6, 9));
+    EXPECT_TRUE(pool.hidden(index, 7, 1));
+    EXPECT_EQ(pool.lookups, 3);
+}
+
+TEST(HiddenPrefixIndex, AgreesWithStringFilter)
+{
+    // The verdict for (index, number) must equal hasHiddenRowPrefix on the
+    // printed name, base + ("_" + (number - 1) when number > 0).
+    FakePool pool;
+    const wchar_t* bases[] = {L"DEV", L"DEV_Axe", L"Dev_Axe", L"Cheat", L"cheat_x", L"Iron", L"_DEPRECATED", L"WIP_"};
+    uint32_t idx = 0x30000;
+    for (auto* b : bases) pool.names[idx++] = b;
+
+    HiddenPrefixIndex index;
+    for (auto& [i, base] : pool.names)
+    {
+        for (uint32_t number : {0u, 1u, 5u})
+        {
+            std::wstring printed = base;
+            if (number > 0) printed += L"_" + std::to_wstring(number - 1);
+            EXPECT_EQ(pool.hidden(index, i, number), hasHiddenRowPrefix(printed)) << printed;
+        }
+    }
+}
@@ -0,0 +1,217 @@
+// Unit tests for the persisted offset cache (moria_offset_cache.h)
+
+#include <gtest/gtest.h>
+#include "moria_offset_cache.h"
+
+#include <sstream>
+#include <string>
+
+using namespace MoriaMods;
+
+namespace
+{
+    class OffsetCache : public ::testing::Test
+    {
+      protected:
+        int probeA{-2};
+        int probeB{-2};
+        OffsetProbeSlot slots[2]{{"s_off_a", &probeA, "TextBlock", "Font"},
+                                 {"s_off_b", &probeB, "TextBlock", "Font.Size"}};
+        OffsetCacheKey key{0x5F00AA11, 0x0123456789ABCDEFull};
+
+        void SetUp() override { forget(); }
+        void TearDown() override { forget(); }
+
+        void forget()
+        {
+            resetOffsets();
+            s_probeSlotsCached.clear();
+            s_probeGroupsPending.clear();
+        }
+
+        // Resolve FFGKUITab with DisplayName shifted to 0x10.
+        void resolveShiftedTab()
+        {
+            resolveStruct(OffStruct::UITab, 0xF0, [](auto&& visit) {
+                visit(std::wstring_view(L"Name"), 0x00, 8);
+                visit(std::wstring_view(L"DisplayName"), 0x10, 0x18);
+                visit(std::wstring_view(L"WidgetClass"), 0x28, 0x28);
+                visit(std::wstring_view(L"TabConfig"), 0x50, 0x10);
+            });
+        }
+
+        std::string saved()
+        {
+            return serializeOffsetCache(key, slots);
+        }
+
+        void relaunch()
+        {
+            forget();
+            probeA = -2;
+            probeB = -2;
+        }
+    };
+}
+
+TEST_F(OffsetCache, RoundTripMarksStructCached)
+{
+    resolveShiftedTab();
+    probeA = 0x2A8;
+    probeB = -1;  // failed lookups are never persisted
+    std::string text = saved();
+    EXPECT_NE(text.find("FFGKUITab.DisplayName=0x10"), std::string::npos);
+    EXPECT_EQ(text.find("s_off_b"), std::string::npos);
+
+    relaunch();
+    std::istringstream in(text);
+    EXPECT_EQ(loadOffsetCacheStream(in, key, slots), 6);
+    EXPECT_TRUE(offsetsCached(OffStruct::UITab));
+    EXPECT_FALSE(offsetsResolved(OffStruct::UITab));
+    EXPECT_EQ(off(Off::UitDisplayName), 0x10);
+    EXPECT_EQ(off(Off::UitStride), 0xF0);
+    EXPECT_EQ(probeA, 0x2A8);
+    EXPECT_EQ(probeB, -2);
+}
+
+TEST_F(OffsetCache, OtherBuildIsRejected)
+{
+    resolveShiftedTab();
+    std::string text = saved();
+    relaunch();
+
+    OffsetCacheKey patched = key;
+    patched.buildId++;
+    std::istringstream in(text);
+    EXPECT_EQ(loadOffsetCacheStream(in, patched, slots), -1);
+    EXPECT_FALSE(offsetsCached(OffStruct::UITab));
+    EXPECT_EQ(off(Off::UitDisplayName), 0x08);
+
+    OffsetCacheKey rehashed = key;
+    rehashed.moduleHash ^= 1;
+    std::istringstream in2(text);
+    EXPECT_EQ(loadOffsetCacheStream(in2, rehashed, slots), -1);
+}
+
+TEST_F(OffsetCache, ChangedProbeListIsRejected)
+{
+    probeA = 0x10;
+    std::string text = saved();
+    relaunch();
+    int other = -2;
+    OffsetProbeSlot renamed[]{{"s_off_c", &other, "TextBlock", "Font"}};
+    std::istringstream in(text);
+    EXPECT_EQ(loadOffsetCacheStream(in, key, renamed), -1);
+}
+
+TEST_F(OffsetCache, IncompleteStructIsSkipped)
+{
+    resolveShiftedTab();
+    std::string text = saved();
+    size_t at = text.find("FFGKUITab.TabConfig=");
+    ASSERT_NE(at, std::string::npos);
+    text.erase(at, text.find('\n', at) - at + 1);
+    relaunch();
+    std::istringstream in(text);
+    EXPECT_EQ(loadOffsetCacheStream(in, key, slots), 0);
+    EXPECT_FALSE(offsetsCached(OffStruct::UITab));
+}
+
+TEST_F(OffsetCache, SpotCheckAcceptsMatchingLayout)
+{
+    resolveShiftedTab();
+    std::istringstream in(saved());
+    relaunch();
+    loadOffsetCacheStream(in, key, slots);
+
+    int lookups = 0;
+    EXPECT_TRUE(spotCheckCached(OffStruct::UITab, 0xF0, [&](std::wstring_view name) {
+        lookups++;
+        return name == L"Name" ? 0x00 : -1;
+    }));
+    EXPECT_EQ(lookups, 1);
+    EXPECT_TRUE(offsetsResolved(OffStruct::UITab));
+    EXPECT_EQ(off(Off::UitDisplayName), 0x10);
+}
+
+TEST_F(OffsetCache, SpotCheckRejectsResizedStruct)
+{
+    resolveShiftedTab();
+    std::istringstream in(saved());
+    relaunch();
+    loadOffsetCacheStream(in, key, slots);
+
+    EXPECT_FALSE(spotCheckCached(OffStruct::UITab, 0x100, [](std::wstring_view) { return 0; }));
+    EXPECT_FALSE(offsetsResolved(OffStruct::UITab));
+    EXPECT_FALSE(offsetsCached(OffStruct::UITab));
+    EXPECT_EQ(off(Off::UitDisplayName), 0x08);
+}
+
+TEST_F(OffsetCache, CachedStructsSurviveResave)
+{
+    // A save before the cached struct is first used must not drop it.
+    resolveShiftedTab();
+    std::string first = saved();
+    relaunch();
+    std::istringstream in(first);
+    loadOffsetCacheStream(in, key, slots);
+    EXPECT_EQ(saved(), first);
+}
+
+TEST_F(OffsetCache, ResolvedProbesAreNotOverwritten)
+{
+    probeA = 0x40;
+    std::string text = saved();
+    probeA = 0x48;
+    std::istringstream in(text);
+    loadOffsetCacheStream(in, key, slots);
+    EXPECT_EQ(probeA, 0x48);
+}
+
+TEST_F(OffsetCache, ProbeSpotCheckConfirmsOneSlotPerStruct)
+{
+    probeA = 0x2A8;
+    probeB = 0x48;
+    std::string text = saved();
+    relaunch();
+    std::istringstream in(text);
+    loadOffsetCacheStream(in, key, slots);
+    EXPECT_EQ(s_probeGroupsPending.size(), 2u);  // TextBlock itself, and Font
+
+    int lookups = 0;
+    auto live = [&](std::string_view path) {
+        lookups++;
+        return path == "Font" ? 0x2A8 : path == "Font.Size" ? 0x48 : -1;
+    };
+    EXPECT_TRUE(spotCheckCachedProbes(slots, "Image", live));
+    EXPECT_EQ(lookups, 0);
+    EXPECT_TRUE(spotCheckCachedProbes(slots, "TextBlock", live));
+    EXPECT_EQ(lookups, 2);
+    EXPECT_TRUE(s_probeGroupsPending.empty());
+    // Confirmed once; later calls don't look again.
+    EXPECT_TRUE(spotCheckCachedProbes(slots, "TextBlock", live));
+    EXPECT_EQ(lookups, 2);
+    EXPECT_EQ(probeA, 0x2A8);
+}
+
+TEST_F(OffsetCache, ProbeMismatchDropsWholeCache)
+{
+    resolveShiftedTab();
+    probeA = 0x2A8;
+    probeB = 0x48;
+    std::string text = saved();
+    relaunch();
+    std::istringstream in(text);
+    loadOffsetCacheStream(in, key, slots);
+    ASSERT_TRUE(offsetsCached(OffStruct::UITab));
+
+    // The font field moved, yet the key matched: trust nothing from the file.
+    EXPECT_FALSE(spotCheckCachedProbes(slots, "TextBlock", [](std::string_view path) {
+        return path == "Font" ? 0x2B0 : 0x48;
+    }));
+    EXPECT_EQ(probeA, -2);
+    EXPECT_EQ(probeB, -2);
+    EXPECT_FALSE(offsetsCached(OffStruct::UITab));
+    EXPECT_EQ(off(Off::UitDisplayName), 0x08);
+    EXPECT_TRUE(s_probeGroupsPending.empty());
+}
@@ -0,0 +1,138 @@
+// Unit tests for the declarative struct-offset registry (moria_offsets.h)
+
+#include <gtest/gtest.h>
+#include "moria_offsets.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    using Prop = std::tuple<std::wstring, int, int>;
+
+    // Stand-in for the UE property-chain walk; counts passes.
+    struct FakeChain
+    {
+        std::vector<Prop> props;
+        int walks{0};
+
+        auto walker()
+        {
+            return [this](auto&& visit) {
+                walks++;
+                for (auto& [name, offset, size] : props) visit(std::wstring_view(name), offset, size);
+            };
+        }
+    };
+
+    class OffsetRegistry : public ::testing::Test
+    {
+      protected:
+        void SetUp() override { resetOffsets(); }
+        void TearDown() override { resetOffsets(); }
+    };
+
+    FakeChain historicConnectionHistoryItem()
+    {
+        return {{
+            {L"WorldName", 0x00, 0x10},
+            {L"ConnectionType", 0x10, 1},
+            {L"InviteString", 0x18, 0x10},
+            {L"UniqueInviteCode", 0x28, 0x10},
+            {L"OptionalPassword", 0x38, 0x10},
+            {L"bIsDedicatedServer", 0x48, 1},
+            {L"CreationDateTime", 0x50, 8},
+        }};
+    }
+}
+
+TEST_F(OffsetRegistry, SeededWithFallbacks)
+{
+    EXPECT_EQ(off(Off::ChiStride), 0x58);
+    EXPECT_EQ(off(Off::UitDisplayName), 0x08);
+    EXPECT_EQ(off(Off::IiaList), 0x110);
+    EXPECT_FALSE(offsetsResolved(OffStruct::ConnectionHistoryItem));
+}
+
+TEST_F(OffsetRegistry, OneWalkResolvesWholeStruct)
+{
+    FakeChain chain = historicConnectionHistoryItem();
+    EXPECT_EQ(resolveStruct(OffStruct::ConnectionHistoryItem, 0x58, chain.walker()), 0u);
+    EXPECT_EQ(chain.walks, 1);
+    EXPECT_TRUE(offsetsResolved(OffStruct::ConnectionHistoryItem));
+    EXPECT_TRUE(offsetMismatchSummary().empty());
+
+    // Idempotent: no second walk.
+    resolveStruct(OffStruct::ConnectionHistoryItem, 0x58, chain.walker());
+    EXPECT_EQ(chain.walks, 1);
+}
+
+TEST_F(OffsetRegistry, ShiftedLayoutIsAdoptedAndReported)
+{
+    FakeChain chain{{
+        {L"Padding", 0x00, 0x0C},
+        {L"OnItem", 0x14, 4},
+        {L"Effect", 0x18, 8},
+    }};
+    EXPECT_EQ(resolveStruct(OffStruct::ActiveItemEffect, 0x38, chain.walker()), 3u);
+    EXPECT_EQ(off(Off::AieOnItem), 0x14);
+    EXPECT_EQ(off(Off::AieEffect), 0x18);
+    EXPECT_EQ(off(Off::AieStride), 0x38);
+
+    std::wstring summary = offsetMismatchSummary();
+    EXPECT_NE(summary.find(L"FActiveItemEffect.OnItem offset 0x0C -> 0x14"), std::wstring::npos);
+    EXPECT_NE(summary.find(L"FActiveItemEffect size 0x30 -> 0x38"), std::wstring::npos);
+}
+
+TEST_F(OffsetRegistry, MissingFieldKeepsFallback)
+{
+    FakeChain chain{{{L"Name", 0x00, 8}}};
+    EXPECT_EQ(resolveStruct(OffStruct::UITab, 0xE8, chain.walker()), 3u);
+    EXPECT_EQ(off(Off::UitDisplayName), 0x08);
+    EXPECT_NE(offsetMismatchSummary().find(L"FFGKUITab.DisplayName not found, using 0x08"), std::wstring::npos);
+}
+
+TEST_F(OffsetRegistry, SizeMismatchIsReported)
+{
+    FakeChain chain = historicConnectionHistoryItem();
+    std::get<2>(chain.props[1]) = 4;  // ConnectionType widened to int32
+    EXPECT_EQ(resolveStruct(OffStruct::ConnectionHistoryItem, 0x58, chain.walker()), 1u);
+    EXPECT_EQ(off(Off::ChiConnType), 0x10);
+    EXPECT_NE(offsetMismatchSummary().find(L"ConnectionType size 0x01 -> 0x04"), std::wstring::npos);
+}
+
+TEST_F(OffsetRegistry, StructNotFoundSkipsWalk)
+{
+    FakeChain chain = historicConnectionHistoryItem();
+    resolveStruct(OffStruct::ItemInstance, 0, chain.walker());
+    EXPECT_EQ(chain.walks, 0);
+    EXPECT_TRUE(offsetsResolved(OffStruct::ItemInstance));
+    EXPECT_EQ(off(Off::IiStride), 0x30);
+    EXPECT_EQ(off(Off::IiDur), 0x24);
+}
+
+TEST_F(OffsetRegistry, OnlyOwnRowsAreTouched)
+{
+    // A UITab walk that happens to contain a "List" property must not
+    // write FItemInstanceArray.List.
+    FakeChain chain{{{L"List", 0x40, 0x10}, {L"Name", 0x00, 8}}};
+    resolveStruct(OffStruct::UITab, 0xE8, chain.walker());
+    EXPECT_EQ(off(Off::IiaList), 0x110);
+    EXPECT_FALSE(offsetsResolved(OffStruct::ItemInstanceArray));
+}
+
+TEST_F(OffsetRegistry, SummarySinceIndex)
+{
+    FakeChain bad{{}};
+    resolveStruct(OffStruct::ItemInstanceArray, 0x120, bad.walker());
+    size_t from = s_offsetMismatches.size();
+    FakeChain chain = historicConnectionHistoryItem();
+    std::get<1>(chain.props[0]) = 0x08;
+    resolveStruct(OffStruct::ConnectionHistoryItem, 0x58, chain.walker());
+    std::wstring tail = offsetMismatchSummary(from);
+    EXPECT_EQ(tail.find(L"FItemInstanceArray"), std::wstring::npos);
+    EXPECT_NE(tail.find(L"WorldName offset 0x00 -> 0x08"), std::wstring::npos);
+}
@@ -0,0 +1,159 @@
+// Unit tests for OverlayLayout / OverlayFrameTracker (retained overlay renderer)
+
+#include <gtest/gtest.h>
+#include "moria_overlay_frame.h"
+
+using namespace MoriaMods;
+
+namespace
+{
+    using Tracker = OverlayFrameTracker<12>;
+
+    Tracker::Cells baseCells()
+    {
+        Tracker::Cells c{};
+        for (int i = 0; i < 12; i++) c[i].label = L"F" + std::to_wstring(i + 1);
+        return c;
+    }
+}
+
+TEST(OverlayLayout, MatchesLegacyGeometryAt1080p)
+{
+    auto l = OverlayLayout::forClient(1080, 12, 8);
+    EXPECT_EQ(l.slotSize, 48);
+    EXPECT_EQ(l.gap, 4);
+    EXPECT_EQ(l.padding, 6);
+    EXPECT_EQ(l.width, 6 * 2 + 12 * 48 + 11 * 4 + 8);
+    EXPECT_EQ(l.height, 6 * 2 + 48 + 14);
+    EXPECT_EQ(l.slotX(7), 6 + 7 * 52);
+    EXPECT_EQ(l.slotX(8), 6 + 8 * 52 + 8);
+}
+
+TEST(OverlayLayout, ScaleIsClampedForTinyWindows)
+{
+    auto l = OverlayLayout::forClient(200, 12, 8);
+    EXPECT_FLOAT_EQ(l.scale, 0.5f);
+    EXPECT_EQ(l.slotSize, 24);
+}
+
+TEST(OverlayLayout, CellsDoNotOverlapEachOtherOrSeparator)
+{
+    for (int h : {1080, 1200, 1440, 2160})
+    {
+        auto l = OverlayLayout::forClient(h, 12, 8);
+        ASSERT_TRUE(l.cellsIsolated()) << "h=" << h;
+        for (int i = 0; i + 1 < 12; i++)
+        {
+            auto a = l.cell(i), b = l.cell(i + 1);
+            EXPECT_LE(a.x + a.w, b.x) << "h=" << h << " slot " << i;
+        }
+        auto left = l.cell(7), right = l.cell(8);
+        EXPECT_LT(left.x + left.w, l.separatorX() + 1) << "h=" << h;
+        EXPECT_GT(right.x, l.separatorX()) << "h=" << h;
+        auto last = l.cell(11);
+        EXPECT_GE(l.cell(0).x, 0);
+        EXPECT_LE(last.x + last.w, l.width);
+        EXPECT_LE(last.y + last.h, l.height);
+    }
+}
+
+TEST(OverlayFrameTracker, SubNativeScaleRedrawsAllSlotsOnAnyChange)
+{
+    Tracker t;
+    auto l = OverlayLayout::forClient(720, 12, 8);
+    ASSERT_FALSE(l.cellsIsolated());
+    auto cells = baseCells();
+    t.plan(l, 0, 0, cells);
+    EXPECT_EQ(t.plan(l, 0, 0, cells).dirty, 0u);
+    cells[3].text = L"X";
+    EXPECT_EQ(t.plan(l, 0, 0, cells).dirty, Tracker::kAll);
+}
+
+TEST(OverlayFrameTracker, FirstFrameRebuildsEverything)
+{
+    Tracker t;
+    auto p = t.plan(OverlayLayout::forClient(1080, 12, 8), 100, 4, baseCells());
+    EXPECT_TRUE(p.rebuild);
+    EXPECT_TRUE(p.present);
+    EXPECT_EQ(p.dirty, Tracker::kAll);
+}
+
+TEST(OverlayFrameTracker, IdleTickPresentsNothing)
+{
+    Tracker t;
+    auto l = OverlayLayout::forClient(1080, 12, 8);
+    t.plan(l, 100, 4, baseCells());
+    for (int i = 0; i < 50; i++)
+    {
+        auto p = t.plan(l, 100, 4, baseCells());
+        EXPECT_FALSE(p.rebuild);
+        EXPECT_FALSE(p.present);
+        EXPECT_EQ(p.dirty, 0u);
+    }
+    EXPECT_EQ(t.presents(), 1u);
+    EXPECT_EQ(t.frames(), 51u);
+}
+
+TEST(OverlayFrameTracker, OnlyChangedSlotsAreDirty)
+{
+    Tracker t;
+    auto l = OverlayLayout::forClient(1080, 12, 8);
+    auto cells = baseCells();
+    t.plan(l, 0, 0, cells);
+
+    cells[9].text = L"15\nT30";
+    int icon = 0;
+    cells[2].used = true;
+    cells[2].icon = &icon;
+    auto p = t.plan(l, 0, 0, cells);
+    EXPECT_FALSE(p.rebuild);
+    EXPECT_TRUE(p.present);
+    EXPECT_EQ(p.dirty, (1u << 2) | (1u << 9));
+
+    // Same content again: clean.
+    EXPECT_EQ(t.plan(l, 0, 0, cells).dirty, 0u);
+}
+
+TEST(OverlayFrameTracker, LabelAndStyleChangesAreDirty)
+{
+    Tracker t;
+    auto l = OverlayLayout::forClient(1080, 12, 8);
+    auto cells = baseCells();
+    t.plan(l, 0, 0, cells);
+    cells[0].label = L"Num1";
+    cells[10].style = 1;
+    EXPECT_EQ(t.plan(l, 0, 0, cells).dirty, (1u << 0) | (1u << 10));
+}
+
+TEST(OverlayFrameTracker, MoveAloneRepresentsWithoutRedraw)
+{
+    Tracker t;
+    auto l = OverlayLayout::forClient(1080, 12, 8);
+    t.plan(l, 0, 0, baseCells());
+    auto p = t.plan(l, 40, 10, baseCells());
+    EXPECT_FALSE(p.rebuild);
+    EXPECT_TRUE(p.present);
+    EXPECT_EQ(p.dirty, 0u);
+}
+
+TEST(OverlayFrameTracker, ResizeRebuilds)
+{
+    Tracker t;
+    t.plan(OverlayLayout::forClient(1080, 12, 8), 0, 0, baseCells());
+    auto p = t.plan(OverlayLayout::forClient(1440, 12, 8), 0, 0, baseCells());
+    EXPECT_TRUE(p.rebuild);
+    EXPECT_EQ(p.dirty, Tracker::kAll);
+    EXPECT_EQ(t.rebuilds(), 2u);
+}
+
+TEST(OverlayFrameTracker, InvalidateForcesFullFrame)
+{
+    Tracker t;
+    auto l = OverlayLayout::forClient(1080, 12, 8);
+    t.plan(l, 0, 0, baseCells());
+    t.invalidate();
+    auto p = t.plan(l, 0, 0, baseCells());
+    EXPECT_TRUE(p.rebuild);
+    EXPECT_TRUE(p.present);
+    EXPECT_EQ(t.cellsDrawn(), 24u);
+}
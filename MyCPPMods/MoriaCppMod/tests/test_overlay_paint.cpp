@@ -0,0 +1,208 @@
+// Golden-image tests for the headless overlay painter
+//
+// The full-frame golden (golden/overlay_1080p.txt) is the alpha channel as
+// ASCII, ramp " .:-=+*#%@"; a pixel may differ by one ramp step (float
+// rounding across compilers). Regenerate after an intended visual change
+// with MORIA_UPDATE_GOLDEN=1 and review the diff.
+
+#include <gtest/gtest.h>
+#include "moria_overlay_paint.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    constexpr int kSlots = 12;
+    constexpr int kBuild = 8;
+    using Cells = std::array<OverlayCellKey, kSlots>;
+
+    ArgbImage gradientIcon(int n)
+    {
+        ArgbImage img{n, n, std::vector<uint32_t>(size_t(n) * n)};
+        for (int y = 0; y < n; y++)
+            for (int x = 0; x < n; x++)
+            {
+                bool inDisc = (x - n / 2) * (x - n / 2) + (y - n / 2) * (y - n / 2) < (n / 2) * (n / 2);
+                img.pixels[size_t(y) * n + x] = inDisc ? premul(255, uint8_t(x * 255 / n), uint8_t(y * 255 / n), 120) : 0;
+            }
+        return img;
+    }
+
+    // A busy hotbar: icons, a letter fallback, empty slots, every utility cell.
+    Cells sceneCells(const ArgbImage& icon)
+    {
+        Cells c{};
+        for (int i = 0; i < kBuild; i++) c[i].label = L"F" + std::to_wstring(i + 1);
+        for (int i = 0; i < 3; i++)
+        {
+            c[i].used = true;
+            c[i].icon = &icon;
+        }
+        c[3].used = true;
+        c[3].text = L"W";
+        c[8] = {false, nullptr, L"TGT", L"", L"NUM0", 0};
+        c[9] = {false, nullptr, L"15\u00B0", L"T90", L"R", 0};
+        c[10] = {false, nullptr, L"C2", L"M0", L"F10", 1};
+        c[11] = {false, nullptr, L"CFG", L"", L"F12", 0};
+        return c;
+    }
+
+    struct Frame
+    {
+        OverlayLayout layout;
+        Surface surface;
+        OverlayFonts fonts;
+
+        explicit Frame(int clientH)
+            : layout(OverlayLayout::forClient(clientH, kSlots, kBuild)), surface(layout.width, layout.height),
+              fonts(OverlayFonts::make(layout, builtinOverlayFonts()))
+        {
+        }
+
+        void paint(const Cells& cells, uint32_t dirty, bool rebuild)
+        {
+            paintOverlay(surface, layout, cells, dirty, rebuild, fonts,
+                         [&](int i) { return static_cast<const ArgbImage*>(cells[i].icon); });
+        }
+    };
+
+    std::vector<std::string> alphaArt(const Surface& s)
+    {
+        static const char* kRamp = " .:-=+*#%@";
+        std::vector<std::string> out;
+        for (int y = 0; y < s.height(); y++)
+        {
+            std::string row;
+            for (int x = 0; x < s.width(); x++) row += kRamp[((s.pixel(x, y) >> 24) * 9 + 127) / 255];
+            out.push_back(row);
+        }
+        return out;
+    }
+
+    int rampIndex(char c) { return int(std::string(" .:-=+*#%@").find(c)); }
+}
+
+TEST(OverlayPaint, FullFrameMatchesGolden)
+{
+    ArgbImage icon = gradientIcon(64);
+    Frame f(1080);
+    f.paint(sceneCells(icon), OverlayFrameTracker<kSlots>::kAll, true);
+    auto art = alphaArt(f.surface);
+
+    std::string path = std::string(MORIA_GOLDEN_DIR) + "/overlay_1080p.txt";
+    if (std::getenv("MORIA_UPDATE_GOLDEN"))
+    {
+        std::ofstream out(path);
+        for (auto& row : art) out << row << "\n";
+        GTEST_SKIP() << "golden rewritten: " << path;
+    }
+
+    std::ifstream in(path);
+    ASSERT_TRUE(in.good()) << "missing golden " << path;
+    std::vector<std::string> golden;
+    for (std::string line; std::getline(in, line);) golden.push_back(line);
+    ASSERT_EQ(golden.size(), art.size());
+
+    int off = 0;
+    for (size_t y = 0; y < art.size(); y++)
+    {
+        ASSERT_EQ(golden[y].size(), art[y].size()) << "row " << y;
+        for (size_t x = 0; x < art[y].size(); x++)
+            if (std::abs(rampIndex(art[y][x]) - rampIndex(golden[y][x])) > 1)
+            {
+                if (off++ < 10) ADD_FAILURE() << "pixel " << x << "," << y << " '" << art[y][x] << "' vs '" << golden[y][x] << "'";
+            }
+    }
+    EXPECT_EQ(off, 0);
+}
+
+TEST(OverlayPaint, FrameColoursMatchThePalette)
+{
+    ArgbImage icon = gradientIcon(64);
+    Frame f(1080);
+    f.paint(sceneCells(icon), OverlayFrameTracker<kSlots>::kAll, true);
+    const auto& l = f.layout;
+
+    // Rounded corners are transparent, the padding is plain background.
+    EXPECT_EQ(f.surface.pixel(0, 0), 0u);
+    EXPECT_EQ(f.surface.pixel(l.width / 2, 1), OverlayPalette::Background);
+    // Empty slot interior: fill over background.
+    EXPECT_EQ(f.surface.pixel(l.slotX(6) + 10, l.slotY() + 10), blendOver(OverlayPalette::Background, OverlayPalette::EmptyFill));
+    // Used slot border differs from an empty one.
+    EXPECT_NE(f.surface.pixel(l.slotX(0), l.slotY() + 20), f.surface.pixel(l.slotX(6), l.slotY() + 20));
+    // Icon centre is opaque.
+    EXPECT_EQ(f.surface.pixel(l.slotX(0) + l.slotSize / 2, l.slotY() + l.slotSize / 2) >> 24, 255u);
+    // Separator drawn between the build and utility groups.
+    EXPECT_NE(f.surface.pixel(l.separatorX(), l.slotY() + l.slotSize / 2), OverlayPalette::Background);
+}
+
+TEST(OverlayPaint, DirtyCellRedrawMatchesFullRedraw)
+{
+    ArgbImage icon = gradientIcon(64);
+    Cells before = sceneCells(icon);
+    Cells after = before;
+    after[1].icon = nullptr;
+    after[1].text = L"B";
+    after[9].text = L"30\u00B0";
+    after[9].text2 = L"T120";
+    after[10].text.clear();
+    after[10].text2.clear();
+    after[10].style = 0;
+
+    OverlayFrameTracker<kSlots> tracker;
+    Frame incremental(1080);
+    auto p = tracker.plan(incremental.layout, 0, 0, before);
+    incremental.paint(before, p.dirty, p.rebuild);
+    p = tracker.plan(incremental.layout, 0, 0, after);
+    ASSERT_FALSE(p.rebuild);
+    EXPECT_EQ(p.dirty, (1u << 1) | (1u << 9) | (1u << 10));
+    incremental.paint(after, p.dirty, p.rebuild);
+
+    Frame full(1080);
+    full.paint(after, OverlayFrameTracker<kSlots>::kAll, true);
+
+    for (int y = 0; y < full.layout.height; y++)
+        for (int x = 0; x < full.layout.width; x++)
+            ASSERT_EQ(incremental.surface.pixel(x, y), full.surface.pixel(x, y)) << x << "," << y;
+}
+
+TEST(OverlayPaint, RenderWorkIsBounded)
+{
+    // Pixel writes, not wall time: deterministic on every machine.
+    ArgbImage icon = gradientIcon(64);
+    Cells cells = sceneCells(icon);
+    for (int h : {720, 1080, 1440, 2160})
+    {
+        Frame f(h);
+        uint64_t area = uint64_t(f.layout.width) * f.layout.height;
+        f.paint(cells, OverlayFrameTracker<kSlots>::kAll, true);
+        EXPECT_LE(f.surface.pixelsWritten(), area * 5) << "full frame at " << h;
+
+        f.surface.resetStats();
+        f.paint(cells, 1u << 9, false);
+        auto c = f.layout.cell(9);
+        EXPECT_LE(f.surface.pixelsWritten(), uint64_t(c.w) * c.h * 4) << "one cell at " << h;
+        EXPECT_LT(f.surface.pixelsWritten(), area / 4) << "one cell at " << h;
+    }
+}
+
+TEST(OverlayPaint, StabilityCellIsBlankWhileMonitorIsOff)
+{
+    Cells on{}, off{};
+    on[10] = {false, nullptr, L"C9", L"M9", L"", 3};
+    Frame a(1080), b(1080);
+    a.paint(on, 1u << 10, true);
+    b.paint(off, 1u << 10, true);
+    const auto& l = a.layout;
+    int diff = 0;
+    for (int y = l.slotY(); y < l.slotY() + l.slotSize; y++)
+        for (int x = l.slotX(10); x < l.slotX(10) + l.slotSize; x++) diff += a.surface.pixel(x, y) != b.surface.pixel(x, y);
+    EXPECT_GT(diff, 0);
+    EXPECT_EQ(b.surface.pixel(l.slotX(10) + l.slotSize / 2, l.slotY() + l.slotSize / 4),
+              blendOver(OverlayPalette::Background, OverlayPalette::EmptyFill));
+}
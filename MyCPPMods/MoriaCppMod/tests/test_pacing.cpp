@@ -0,0 +1,172 @@
+// Unit tests for AdaptivePacer (recipe unlock drain pacing)
+
+#include <gtest/gtest.h>
+#include "moria_pacing.h"
+
+#include <functional>
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    struct FrameLog
+    {
+        int calls;
+        double workMs;
+        double frameMs;
+    };
+
+    // Drain `total` calls. costOf(i) is the cost of the i-th call; baseOf(f)
+    // the game's own frame time for frame f (our work is added on top).
+    std::vector<FrameLog> replay(AdaptivePacer& pacer, int total,
+                                 const std::function<double(int)>& costOf,
+                                 const std::function<double(int)>& baseOf = [](int) { return 16.0; })
+    {
+        std::vector<FrameLog> log;
+        double lastFrame = 0;
+        int done = 0;
+        for (int f = 0; done < total && f < 100000; f++)
+        {
+            int n = std::min(pacer.beginFrame(lastFrame), total - done);
+            double work = 0;
+            for (int i = 0; i < n; i++) work += costOf(done + i);
+            pacer.endFrame(n, work);
+            done += n;
+            lastFrame = baseOf(f) + work;
+            log.push_back({n, work, lastFrame});
+        }
+        return log;
+    }
+}
+
+TEST(AdaptivePacer, ProbesThenFillsBudget)
+{
+    AdaptivePacer pacer;  // 2 ms budget
+    auto log = replay(pacer, 1000, [](int) { return 0.0625; });
+    ASSERT_GT(log.size(), 2u);
+    EXPECT_EQ(log[0].calls, 4);
+    // 2 ms / 0.0625 ms = 32 calls per frame once the cost is known.
+    EXPECT_EQ(log[2].calls, 32);
+    for (size_t i = 1; i < log.size(); i++)
+        EXPECT_LE(log[i].workMs, 2.0 + 1e-9);
+    EXPECT_DOUBLE_EQ(pacer.callCostMs(), 0.0625);
+    EXPECT_EQ(pacer.totalCalls(), 1000u);
+}
+
+TEST(AdaptivePacer, ExpensiveCallsShrinkBatches)
+{
+    // Server-side: each call replicates and costs 0.5 ms.
+    AdaptivePacer pacer;
+    auto log = replay(pacer, 200, [](int) { return 0.5; });
+    for (size_t i = 1; i < log.size(); i++)
+        EXPECT_LE(log[i].calls, 4);
+    EXPECT_EQ(log[3].calls, 4);
+}
+
+TEST(AdaptivePacer, ClampsToMinAndMax)
+{
+    PacerConfig cfg;
+    cfg.maxBatch = 50;
+    AdaptivePacer cheap(cfg);
+    auto log = replay(cheap, 500, [](int) { return 0.001; });
+    EXPECT_EQ(log[3].calls, 50);
+
+    AdaptivePacer slow;
+    log = replay(slow, 20, [](int) { return 10.0; });
+    for (auto& l : log) EXPECT_GE(l.calls, 1);
+    EXPECT_EQ(log[3].calls, 1);
+}
+
+TEST(AdaptivePacer, TracksCostChanges)
+{
+    // Cost jumps 10x halfway through (e.g. a client joined).
+    AdaptivePacer pacer;
+    auto log = replay(pacer, 4000, [](int i) { return i < 2000 ? 0.02 : 0.2; });
+    EXPECT_NEAR(pacer.callCostMs(), 0.2, 0.01);
+    // Early batches were ~100 calls; once the EMA settles they fit the
+    // budget again (2 ms / 0.2 ms = 10).
+    EXPECT_GE(log[5].calls, 90);
+    EXPECT_LE(log[log.size() - 2].calls, 10);
+}
+
+TEST(AdaptivePacer, BacksOffOnFrameSpike)
+{
+    PacerConfig cfg;
+    cfg.backoffFrames = 5;
+    AdaptivePacer pacer(cfg);
+    // Steady 16 ms, then a 60 ms hitch on frame 20.
+    auto log = replay(pacer, 3000, [](int) { return 0.0625; },
+                      [](int f) { return f == 20 ? 60.0 : 16.0; });
+    ASSERT_GT(log.size(), 30u);
+    EXPECT_EQ(pacer.spikes(), 1);
+    EXPECT_EQ(log[20].calls, 32);          // frame 20's spike is seen by frame 21
+    for (int f = 21; f <= 25; f++) EXPECT_EQ(log[f].calls, 1) << f;
+    EXPECT_EQ(log[26].calls, 32);
+    // The hitch is kept out of the baseline.
+    EXPECT_LT(pacer.frameMs(), 20.0);
+    EXPECT_EQ(pacer.rebases(), 0);
+}
+
+TEST(AdaptivePacer, SustainedSlowdownBecomesNewBaseline)
+{
+    PacerConfig cfg;
+    cfg.rebaseAfter = 5;
+    AdaptivePacer pacer(cfg);   // 30 backoff frames
+    // 16 ms frames, then the game settles at 50 ms for good.
+    auto log = replay(pacer, 5000, [](int) { return 0.0625; },
+                      [](int f) { return f < 20 ? 16.0 : 50.0; });
+    ASSERT_GT(log.size(), 40u);
+    for (int f = 21; f <= 24; f++) EXPECT_EQ(log[f].calls, 1) << f;
+    // The 5th spike in a row is adopted as the baseline: full batches again.
+    EXPECT_EQ(log[25].calls, 32);
+    EXPECT_EQ(log[log.size() - 2].calls, 32);
+    EXPECT_EQ(pacer.spikes(), 5);
+    EXPECT_EQ(pacer.rebases(), 1);
+    EXPECT_FALSE(pacer.backingOff());
+    EXPECT_NEAR(pacer.frameMs(), 50.0, 0.5);
+}
+
+TEST(AdaptivePacer, OwnWorkIsNotASpike)
+{
+    // A 20 ms budget on 16 ms frames: the interval more than doubles once
+    // batches fill the budget, but that is our own work, not the game.
+    PacerConfig cfg;
+    cfg.budgetMs = 20.0;
+    cfg.maxBatch = 400;
+    AdaptivePacer pacer(cfg);
+    auto log = replay(pacer, 5000, [](int) { return 0.0625; });
+    EXPECT_EQ(pacer.spikes(), 0);
+    EXPECT_EQ(log[5].calls, 320);
+    EXPECT_NEAR(pacer.frameMs(), 16.0, 1e-6);
+}
+
+TEST(AdaptivePacer, EtaFollowsRate)
+{
+    AdaptivePacer pacer;
+    EXPECT_LT(pacer.etaSeconds(100), 0);
+    for (int f = 0; f < 50; f++)
+    {
+        pacer.beginFrame(f == 0 ? 0 : 16.0);
+        pacer.endFrame(20, 1.0);
+    }
+    // 1000 calls at 20/frame = 50 frames of 16 ms.
+    EXPECT_NEAR(pacer.etaSeconds(1000), 0.8, 0.01);
+    EXPECT_NEAR(pacer.callsPerFrame(), 20.0, 1e-9);
+}
+
+TEST(AdaptivePacer, ResetKeepsConfig)
+{
+    PacerConfig cfg;
+    cfg.budgetMs = 4.0;
+    AdaptivePacer pacer(cfg);
+    pacer.beginFrame(16.0);
+    pacer.endFrame(4, 1.0);
+    pacer.reset();
+    EXPECT_EQ(pacer.callCostMs(), 0);
+    EXPECT_EQ(pacer.beginFrame(0), cfg.probeBatch);
+    EXPECT_EQ(pacer.config().budgetMs, 4.0);
+
+    pacer.setBudgetMs(0);
+    EXPECT_GT(pacer.config().budgetMs, 0);
+}
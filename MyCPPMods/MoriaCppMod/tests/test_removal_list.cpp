@@ -0,0 +1,167 @@
+// Unit tests for RemovalGroupIndex / removalListWindow (F12 saved-removals list)
+
+#include <gtest/gtest.h>
+#include "moria_removal_list.h"
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace MoriaMods;
+using Kind = RemovalListRow::Kind;
+
+namespace
+{
+    struct Key
+    {
+        bool typeRule;
+        std::string bubble;
+    };
+
+    bool syncTo(RemovalGroupIndex& idx, const std::vector<Key>& keys)
+    {
+        return idx.sync(keys.size(), [&](size_t i) { return std::pair<bool, std::string_view>(keys[i].typeRule, keys[i].bubble); });
+    }
+
+    // Rows as readable strings: "T" / "H:<bubble>" headers, entry indices.
+    std::vector<std::string> render(RemovalGroupIndex& idx)
+    {
+        std::vector<std::string> out;
+        for (auto& r : idx.rows())
+        {
+            if (r.kind == Kind::TypeRulesHeader) out.push_back("T");
+            else if (r.kind == Kind::BubbleHeader) out.push_back("H:" + idx.groups()[r.group].bubbleId);
+            else out.push_back(std::to_string(r.entry));
+        }
+        return out;
+    }
+
+    std::vector<Key> randomKeys(std::mt19937& rng, size_t n)
+    {
+        const char* bubbles[] = {"Hollin_01", "Dwarrowdelf", "", "Mines_02", "Elven_Ruins"};
+        std::vector<Key> keys;
+        for (size_t i = 0; i < n; i++)
+        {
+            bool tr = rng() % 8 == 0;
+            keys.push_back({tr, tr ? "" : bubbles[rng() % 5]});
+        }
+        return keys;
+    }
+}
+
+TEST(RemovalGroupIndex, GroupsTypeRulesFirstThenCurrentThenAlphabetical)
+{
+    RemovalGroupIndex idx;
+    std::vector<Key> keys = {{false, "Mines_02"}, {true, ""}, {false, "Hollin_01"}, {false, ""}, {false, "Mines_02"}};
+    EXPECT_TRUE(syncTo(idx, keys));
+    EXPECT_EQ(render(idx), (std::vector<std::string>{"T", "1", "H:Hollin_01", "2", "H:Mines_02", "0", "4", "H:Unknown", "3"}));
+
+    EXPECT_TRUE(idx.setCurrentBubble("Mines_02"));
+    EXPECT_FALSE(idx.setCurrentBubble("Mines_02"));
+    EXPECT_EQ(render(idx), (std::vector<std::string>{"T", "1", "H:Mines_02", "0", "4", "H:Hollin_01", "2", "H:Unknown", "3"}));
+    EXPECT_TRUE(idx.isCurrent(1));
+
+    // A current bubble with no removals changes nothing visible.
+    idx.setCurrentBubble("Nowhere");
+    EXPECT_EQ(render(idx)[2], "H:Hollin_01");
+}
+
+TEST(RemovalGroupIndex, UnchangedSyncIsNoOp)
+{
+    RemovalGroupIndex idx;
+    std::vector<Key> keys = {{false, "A"}, {false, "B"}};
+    syncTo(idx, keys);
+    uint64_t v = idx.version();
+    const auto* rows = &idx.rows();
+    EXPECT_FALSE(syncTo(idx, keys));
+    EXPECT_EQ(idx.version(), v);
+    EXPECT_EQ(&idx.rows(), rows);
+}
+
+TEST(RemovalGroupIndex, AppendAndUndoShiftIndices)
+{
+    RemovalGroupIndex idx;
+    std::vector<Key> keys = {{false, "A"}, {false, "B"}, {false, "A"}};
+    syncTo(idx, keys);
+
+    keys.push_back({false, "C"});   // new removal
+    EXPECT_TRUE(syncTo(idx, keys));
+    EXPECT_EQ(render(idx), (std::vector<std::string>{"H:A", "0", "2", "H:B", "1", "H:C", "3"}));
+
+    keys.erase(keys.begin() + 1);   // undo entry 1: B's group disappears
+    EXPECT_TRUE(syncTo(idx, keys));
+    EXPECT_EQ(render(idx), (std::vector<std::string>{"H:A", "0", "1", "H:C", "2"}));
+    EXPECT_EQ(idx.groups().size(), 2u);
+}
+
+TEST(RemovalGroupIndex, IncrementalEditsMatchFreshIndex)
+{
+    std::mt19937 rng(11);
+    RemovalGroupIndex live;
+    std::vector<Key> keys = randomKeys(rng, 300);
+    syncTo(live, keys);
+    live.setCurrentBubble("Mines_02");
+    for (int step = 0; step < 400; step++)
+    {
+        size_t pos = keys.empty() ? 0 : rng() % (keys.size() + 1);
+        if (rng() % 2 && !keys.empty())
+            keys.erase(keys.begin() + std::min(pos, keys.size() - 1));
+        else
+            keys.insert(keys.begin() + pos, randomKeys(rng, 1)[0]);
+        syncTo(live, keys);
+
+        RemovalGroupIndex fresh;
+        syncTo(fresh, keys);
+        fresh.setCurrentBubble("Mines_02");
+        ASSERT_EQ(render(live), render(fresh)) << "step " << step;
+    }
+}
+
+TEST(RemovalGroupIndex, LargeDiffRegroupsFully)
+{
+    std::mt19937 rng(3);
+    RemovalGroupIndex live;
+    syncTo(live, randomKeys(rng, 500));
+    auto other = randomKeys(rng, 450);   // a different save file
+    EXPECT_TRUE(syncTo(live, other));
+    RemovalGroupIndex fresh;
+    syncTo(fresh, other);
+    EXPECT_EQ(render(live), render(fresh));
+    EXPECT_EQ(live.entryCount(), 450u);
+}
+
+TEST(RemovalListWindow, WindowCoversViewportAndKeepsHeight)
+{
+    const float rowH = 72.0f;
+    const size_t pool = 14, rows = 5000;
+    for (float scroll : {0.0f, 10.0f, 72.0f, 1000.5f, 359000.0f, 1e9f})
+    {
+        auto w = removalListWindow(rows, pool, rowH, scroll);
+        EXPECT_EQ(w.count, pool);
+        EXPECT_FLOAT_EQ(w.topPad + w.count * rowH + w.bottomPad, rows * rowH);
+        if (scroll < (rows - pool) * rowH)
+        {
+            EXPECT_LE(w.topPad, scroll);                      // first bound row starts at or above the viewport
+            EXPECT_GT(w.topPad + rowH, scroll);
+        }
+        else
+            EXPECT_EQ(w.first, rows - pool);                  // clamped at the end
+    }
+}
+
+TEST(RemovalListWindow, ShortListsAndHitTest)
+{
+    auto w = removalListWindow(5, 14, 72.0f, 500.0f);
+    EXPECT_EQ(w.first, 0u);
+    EXPECT_EQ(w.count, 5u);
+    EXPECT_EQ(w.topPad, 0.0f);
+    EXPECT_EQ(w.bottomPad, 0.0f);
+    EXPECT_EQ(removalListWindow(0, 14, 72.0f, 0.0f).count, 0u);
+    EXPECT_EQ(removalListWindow(5, 14, 72.0f, -30.0f).first, 0u);
+
+    EXPECT_EQ(removalListRowAt(-1.0f, 72.0f, 5), -1);
+    EXPECT_EQ(removalListRowAt(0.0f, 72.0f, 5), 0);
+    EXPECT_EQ(removalListRowAt(143.9f, 72.0f, 5), 1);
+    EXPECT_EQ(removalListRowAt(360.0f, 72.0f, 5), -1);
+}
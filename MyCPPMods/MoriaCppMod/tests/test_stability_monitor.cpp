@@ -0,0 +1,202 @@
+// Unit tests for StabilityMonitor (continuous stability mode)
+
+#include <gtest/gtest.h>
+#include "moria_stability_monitor.h"
+
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    // Stand-in for AllStabilityComponents.
+    struct FakeComponents
+    {
+        std::vector<uint64_t> ids;
+        std::vector<StabBand> bands;
+        int probes{0};
+
+        void add(StabBand b)
+        {
+            ids.push_back(1000 + ids.size());
+            bands.push_back(b);
+        }
+
+        int32_t num() const { return static_cast<int32_t>(ids.size()); }
+
+        int step(StabilityMonitor& m, int maxItems, std::vector<StabilityMonitor::Crossing>& out,
+                 int budgetItems = 1 << 30)
+        {
+            int seen = 0;
+            return m.step(num(), maxItems,
+                [&](int32_t i) { probes++; seen++; return StabilitySample{ids[i], bands[i], 0.0f}; },
+                [&] { return seen >= budgetItems; }, out);
+        }
+    };
+}
+
+TEST(StabilityMonitor, FirstSweepIsBaselineOnly)
+{
+    FakeComponents c;
+    c.add(StabBand::Stable);
+    c.add(StabBand::Critical);
+    c.add(StabBand::Marginal);
+    StabilityMonitor m;
+    std::vector<StabilityMonitor::Crossing> out;
+    EXPECT_EQ(c.step(m, 100, out), 3);
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(m.count(StabBand::Stable), 1);
+    EXPECT_EQ(m.count(StabBand::Marginal), 1);
+    EXPECT_EQ(m.count(StabBand::Critical), 1);
+    EXPECT_EQ(m.count(StabBand::Unknown), 0);
+    EXPECT_EQ(m.sweeps(), 1u);
+}
+
+TEST(StabilityMonitor, SlicesRotateAcrossFrames)
+{
+    FakeComponents c;
+    for (int i = 0; i < 10; i++) c.add(StabBand::Stable);
+    StabilityMonitor m;
+    std::vector<StabilityMonitor::Crossing> out;
+    EXPECT_EQ(c.step(m, 4, out), 4);
+    EXPECT_EQ(m.cursor(), 4);
+    EXPECT_EQ(m.count(StabBand::Unknown), 6);
+    c.step(m, 4, out);
+    c.step(m, 4, out);
+    EXPECT_EQ(m.cursor(), 2);
+    EXPECT_EQ(m.sweeps(), 1u);
+    EXPECT_EQ(m.count(StabBand::Stable), 10);
+    EXPECT_EQ(c.probes, 12);
+}
+
+TEST(StabilityMonitor, ReportsThresholdCrossings)
+{
+    FakeComponents c;
+    for (int i = 0; i < 5; i++) c.add(StabBand::Stable);
+    StabilityMonitor m;
+    std::vector<StabilityMonitor::Crossing> out;
+    c.step(m, 100, out);
+
+    c.bands[1] = StabBand::Marginal;
+    c.bands[3] = StabBand::Critical;
+    c.step(m, 100, out);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0].index, 1);
+    EXPECT_EQ(out[0].to, StabBand::Marginal);
+    EXPECT_TRUE(out[0].worsened());
+    EXPECT_EQ(out[1].index, 3);
+    EXPECT_TRUE(out[1].worsened());
+
+    // Unchanged sweep: nothing new.
+    out.clear();
+    c.step(m, 100, out);
+    EXPECT_TRUE(out.empty());
+
+    // Marginal -> critical worsens; critical -> stable is a recovery.
+    c.bands[1] = StabBand::Critical;
+    c.bands[3] = StabBand::Stable;
+    c.step(m, 100, out);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_TRUE(out[0].worsened());
+    EXPECT_FALSE(out[1].worsened());
+    EXPECT_EQ(m.count(StabBand::Critical), 1);
+    EXPECT_EQ(m.count(StabBand::Marginal), 0);
+    EXPECT_EQ(m.count(StabBand::Stable), 4);
+}
+
+TEST(StabilityMonitor, NewlyPlacedPieceSettlingIsBaseline)
+{
+    FakeComponents c;
+    c.add(StabBand::Stable);
+    c.add(StabBand::Ignored);       // Initializing
+    c.add(StabBand::Provisional);
+    StabilityMonitor m;
+    std::vector<StabilityMonitor::Crossing> out;
+    c.step(m, 100, out);
+
+    // Both new pieces settle; one straight into marginal. Not a crossing.
+    c.bands[1] = StabBand::Provisional;
+    c.bands[2] = StabBand::Marginal;
+    c.step(m, 100, out);
+    c.bands[1] = StabBand::Critical;
+    c.step(m, 100, out);
+    for (auto& x : out) EXPECT_FALSE(x.worsened()) << x.index;
+    EXPECT_EQ(m.count(StabBand::Marginal), 1);
+    EXPECT_EQ(m.count(StabBand::Critical), 1);
+
+    // Once settled, stable -> marginal and marginal -> critical are reported.
+    out.clear();
+    c.bands[0] = StabBand::Marginal;
+    c.bands[2] = StabBand::Critical;
+    c.step(m, 100, out);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0].from, StabBand::Stable);
+    EXPECT_TRUE(out[0].worsened());
+    EXPECT_EQ(out[1].from, StabBand::Marginal);
+    EXPECT_TRUE(out[1].worsened());
+    EXPECT_STREQ(stabBandName(out[1].from), L"MARGINAL");
+}
+
+TEST(StabilityMonitor, NewOccupantIsBaseline)
+{
+    FakeComponents c;
+    c.add(StabBand::Stable);
+    c.add(StabBand::Stable);
+    StabilityMonitor m;
+    std::vector<StabilityMonitor::Crossing> out;
+    c.step(m, 100, out);
+
+    c.ids[0] = 9999;               // slot 0 now holds another component
+    c.bands[0] = StabBand::Critical;
+    c.step(m, 100, out);
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(m.count(StabBand::Critical), 1);
+}
+
+TEST(StabilityMonitor, ArrayShrinkAndGrowKeepCountsConsistent)
+{
+    FakeComponents c;
+    for (int i = 0; i < 6; i++) c.add(i < 3 ? StabBand::Critical : StabBand::Stable);
+    StabilityMonitor m;
+    std::vector<StabilityMonitor::Crossing> out;
+    c.step(m, 4, out);                 // cursor at 4
+    c.step(m, 100, out);               // full sweep
+
+    c.ids.resize(2);
+    c.bands.resize(2);
+    c.step(m, 1, out);
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.count(StabBand::Critical), 2);
+    EXPECT_EQ(m.count(StabBand::Stable), 0);
+
+    c.add(StabBand::Marginal);
+    c.step(m, 100, out);
+    EXPECT_EQ(m.count(StabBand::Marginal), 1);
+    EXPECT_EQ(m.count(StabBand::Unknown), 0);
+    EXPECT_TRUE(out.empty());
+}
+
+TEST(StabilityMonitor, TimeBudgetEndsStepEarly)
+{
+    FakeComponents c;
+    for (int i = 0; i < 500; i++) c.add(StabBand::Stable);
+    StabilityMonitor m;
+    std::vector<StabilityMonitor::Crossing> out;
+    // Budget "spent" after 40 probes: checked at the next multiple of 32.
+    EXPECT_EQ(c.step(m, 500, out, 40), 64);
+    EXPECT_EQ(m.cursor(), 64);
+}
+
+TEST(StabilityMonitor, EmptySlotsAndEmptyArray)
+{
+    StabilityMonitor m;
+    std::vector<StabilityMonitor::Crossing> out;
+    EXPECT_EQ(m.step(0, 10, [](int32_t) { return StabilitySample{}; }, [] { return false; }, out), 0);
+
+    FakeComponents c;
+    c.add(StabBand::Critical);
+    c.ids[0] = 0;                      // null component pointer
+    c.step(m, 10, out);
+    EXPECT_EQ(m.count(StabBand::Critical), 0);
+    EXPECT_EQ(m.count(StabBand::Unknown), 1);
+}
@@ -0,0 +1,155 @@
+// Unit tests for UiCallCache / UiNode tables (declarative F12 subtrees)
+
+#include <gtest/gtest.h>
+#include "moria_ui_tree.h"
+
+#include <cwchar>
+#include <set>
+#include <string>
+#include <utility>
+
+using namespace MoriaMods;
+
+namespace
+{
+    struct Site
+    {
+        int fn;
+        int off;
+    };
+
+    template <size_t N>
+    bool valid(const UiNode (&nodes)[N], size_t texts, size_t captures, size_t tints = 0)
+    {
+        return uiTreeValid(nodes, N, FtStyleCount, texts, captures, tints);
+    }
+
+    template <size_t N>
+    UiBuildCost cost(const UiNode (&nodes)[N])
+    {
+        return uiTreeCost(nodes, N, kFtStyles, true);
+    }
+}
+
+TEST(UiCallCache, ResolvesOncePerClassAndOp)
+{
+    UiCallCache<Site> cache;
+    int textBlock = 0, image = 0;   // stand-ins for two UClass*
+    int resolves = 0;
+    auto call = [&](const void* cls, UiOp op) {
+        if (auto* s = cache.find(cls, op)) return *s;
+        resolves++;
+        return cache.put(cls, op, Site{int(op), 8});
+    };
+    for (int i = 0; i < 50; i++)
+    {
+        call(&textBlock, UiOp::SetText);
+        call(&textBlock, UiOp::SetColorAndOpacity);
+        call(&image, UiOp::SetColorAndOpacity);
+    }
+    EXPECT_EQ(resolves, 3);
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_EQ(cache.misses(), 3u);
+    EXPECT_EQ(cache.hits(), 147u);
+    EXPECT_EQ(call(&image, UiOp::SetColorAndOpacity).fn, int(UiOp::SetColorAndOpacity));
+
+    cache.clear();
+    EXPECT_EQ(cache.find(&textBlock, UiOp::SetText), nullptr);
+}
+
+TEST(UiCallCache, FailedLookupIsCachedToo)
+{
+    UiCallCache<Site> cache;
+    int cls = 0;
+    cache.put(&cls, UiOp::SetFont, Site{0, -1});
+    const Site* s = cache.find(&cls, UiOp::SetFont);
+    ASSERT_NE(s, nullptr);
+    EXPECT_EQ(s->off, -1);
+}
+
+TEST(UiOpName, EveryOpHasDistinctFunction)
+{
+    std::set<std::wstring> names;
+    for (size_t i = 0; i < size_t(UiOp::Count); i++)
+    {
+        const UiOpName& n = uiOpName(UiOp(i));
+        ASSERT_NE(n.function, nullptr);
+        ASSERT_NE(n.param, nullptr);
+        EXPECT_GT(std::wcslen(n.param), 0u);
+        names.insert(n.function);
+    }
+    EXPECT_EQ(names.size(), size_t(UiOp::Count));
+    EXPECT_STREQ(uiOpName(UiOp::SetSlotPadding).function, L"SetPadding");
+}
+
+TEST(UiTree, PanelTablesAreValid)
+{
+    EXPECT_TRUE(valid(kFtSectionHeader, 1, 0));
+    EXPECT_TRUE(valid(kFtSectionHeaderPlain, 1, 0));
+    EXPECT_TRUE(valid(kFtBindRow, 2, 2));
+    EXPECT_FALSE(valid(kFtBindRow, 1, 2));   // key-name text out of range
+    EXPECT_TRUE(valid(kFtToggleRow, 2, 5, 1));
+    EXPECT_FALSE(valid(kFtToggleRow, 2, 5, 0));   // button tint out of range
+    EXPECT_TRUE(valid(kFtButtonRow, 2, 2, 1));
+    EXPECT_TRUE(valid(kFtKeyValueRow, 2, 1));
+    EXPECT_TRUE(valid(kFtGameModRow, 1, 2));
+    EXPECT_TRUE(valid(kFtTab, 1, 2, 1));
+}
+
+TEST(UiTree, TintOnlyOnText)
+{
+    const UiNode tintedImage[] = {{UiKind::Overlay, -1}, {UiKind::Image, 0, 0, {}, -1, -1, -1, 0}};
+    EXPECT_FALSE(uiTreeValid(tintedImage, 2, 1, 0, 0, 1));
+}
+
+TEST(UiTree, CostModelCountsBothPaths)
+{
+    // uiTreeCost is a per-table count, not a measurement: the in-game
+    // build log reports the real ProcessEvent calls next to it.
+    // Bind row: 8 AddChild + 3 brushes + 2 texts (table) vs. those plus
+    // 3 brush sizes, 2 colours, 2 fonts and 7 slot fields.
+    EXPECT_EQ(cost(kFtBindRow).table, 13u);
+    EXPECT_EQ(cost(kFtBindRow).legacy, 27u);
+
+    // Unattached root: no AddChild for node 0 on either path.
+    UiBuildCost loose = uiTreeCost(kFtBindRow, std::size(kFtBindRow), kFtStyles, false);
+    EXPECT_EQ(loose.table, 12u);
+    EXPECT_EQ(loose.legacy, 26u);
+}
+
+TEST(UiTree, RejectsBadParents)
+{
+    const UiNode forward[] = {{UiKind::HBox, -1}, {UiKind::Text, 2}, {UiKind::Overlay, 0}};
+    EXPECT_FALSE(uiTreeValid(forward, 3, 1, 0, 0));
+    const UiNode leafParent[] = {{UiKind::HBox, -1}, {UiKind::Image, 0}, {UiKind::Text, 1}};
+    EXPECT_FALSE(uiTreeValid(leafParent, 3, 1, 0, 0));
+    const UiNode twoRoots[] = {{UiKind::HBox, -1}, {UiKind::VBox, -1}};
+    EXPECT_FALSE(uiTreeValid(twoRoots, 2, 1, 0, 0));
+    const UiNode textOnImage[] = {{UiKind::Image, -1, 0, {}, -1, 0}};
+    EXPECT_FALSE(uiTreeValid(textOnImage, 1, 1, 1, 0));
+}
+
+TEST(UiTree, MissingTextureSkipsSubtree)
+{
+    constexpr size_t n = std::size(kFtBindRow);
+    bool skip[n];
+    std::set<int> loaded = {FtTexCheckBox, FtTexCheck, FtTexKeyBox};
+    auto have = [&](int t) { return loaded.count(t) > 0; };
+
+    uiTreeSkips(kFtBindRow, n, have, skip);
+    for (size_t i = 0; i < n; i++) EXPECT_FALSE(skip[i]) << i;
+
+    loaded.erase(FtTexCheckBox);   // checkbox overlay and both its images go
+    uiTreeSkips(kFtBindRow, n, have, skip);
+    EXPECT_TRUE(skip[1] && skip[2] && skip[3]);
+    EXPECT_FALSE(skip[0] || skip[4] || skip[5] || skip[6] || skip[7]);
+
+    loaded = {FtTexCheckBox, FtTexKeyBox};   // only the check mark goes
+    uiTreeSkips(kFtBindRow, n, have, skip);
+    EXPECT_TRUE(skip[3]);
+    EXPECT_FALSE(skip[1] || skip[2]);
+
+    bool hdr[std::size(kFtSectionHeader)];
+    uiTreeSkips(kFtSectionHeader, std::size(kFtSectionHeader), have, hdr);
+    EXPECT_TRUE(hdr[0] && hdr[1] && hdr[2]);   // no banner texture: no header
+}
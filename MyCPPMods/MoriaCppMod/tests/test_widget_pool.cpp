@@ -0,0 +1,89 @@
+// Unit tests for WidgetPool (parked dialog instances)
+
+#include <gtest/gtest.h>
+#include "moria_widget_pool.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace MoriaMods;
+
+namespace
+{
+    struct Dialog
+    {
+        int id;
+        int input;   // second widget of a two-widget dialog
+    };
+}
+
+TEST(WidgetPool, FirstOpenMissesThenReuses)
+{
+    WidgetPool<int> pool;
+    auto alive = [](int) { return true; };
+    EXPECT_FALSE(pool.acquire(alive).has_value());
+    EXPECT_TRUE(pool.release(7));
+    for (int i = 0; i < 9; i++)
+    {
+        auto got = pool.acquire(alive);
+        ASSERT_TRUE(got.has_value());
+        EXPECT_EQ(*got, 7);
+        EXPECT_TRUE(pool.release(*got));
+    }
+    EXPECT_EQ(pool.hits(), 9u);
+    EXPECT_EQ(pool.misses(), 1u);
+    EXPECT_EQ(pool.hitRatePercent(), 90);
+}
+
+TEST(WidgetPool, DeadInstancesAreDroppedNotReturned)
+{
+    WidgetPool<int> pool(4);
+    std::set<int> dead = {1, 3};
+    for (int i = 1; i <= 3; i++) pool.release(i);
+    auto alive = [&](int v) { return !dead.count(v); };
+    auto got = pool.acquire(alive);   // 3 is on top but dead
+    ASSERT_TRUE(got.has_value());
+    EXPECT_EQ(*got, 2);
+    EXPECT_EQ(pool.dropped(), 1u);
+    EXPECT_FALSE(pool.acquire(alive).has_value());   // 1 dead too
+    EXPECT_EQ(pool.dropped(), 2u);
+    EXPECT_EQ(pool.idle(), 0u);
+    EXPECT_EQ(pool.hits(), 1u);
+    EXPECT_EQ(pool.misses(), 1u);
+}
+
+TEST(WidgetPool, ReleaseRefusesPastCap)
+{
+    WidgetPool<Dialog> pool(1);
+    EXPECT_TRUE(pool.release({1, 10}));
+    EXPECT_FALSE(pool.release({2, 20}));
+    EXPECT_EQ(pool.overflows(), 1u);
+    auto got = pool.acquire([](const Dialog&) { return true; });
+    ASSERT_TRUE(got.has_value());
+    EXPECT_EQ(got->input, 10);
+    EXPECT_EQ(WidgetPool<int>(0).maxIdle(), 1u);
+}
+
+TEST(WidgetPool, DrainAndForgetEmptyThePool)
+{
+    WidgetPool<int> pool(4);
+    pool.release(1);
+    pool.release(2);
+    std::vector<int> removed;
+    pool.drain([&](int v) { removed.push_back(v); });
+    EXPECT_EQ(removed, (std::vector<int>{1, 2}));
+    EXPECT_EQ(pool.idle(), 0u);
+
+    pool.release(3);
+    pool.forget();
+    EXPECT_EQ(pool.idle(), 0u);
+    EXPECT_FALSE(pool.acquire([](int) { return true; }).has_value());
+    EXPECT_EQ(pool.dropped(), 0u);   // forgotten, not counted as dead on acquire
+}
+
+TEST(WidgetPool, HitRateBeforeAnyAcquireIsZero)
+{
+    WidgetPool<int> pool;
+    EXPECT_EQ(pool.hitRatePercent(), 0);
+}
@@ -0,0 +1,330 @@
+
+
+
+#pragma once
+#ifndef MORIA_DEFLINT_H
+#define MORIA_DEFLINT_H
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "moria_arena.h"
+#include "moria_defparse.h"
+
+// Lint rules for definition packs. Pure functions over file text so the
+// CLI (main.cpp) owns all I/O, threading and timing, and the rules can be
+// unit-tested from tests/test_deflint.cpp.
+
+namespace MoriaMods
+{
+    namespace DefLint
+    {
+        enum class Severity { Note, Warning, Error };
+
+        inline const char* severityName(Severity s)
+        {
+            switch (s)
+            {
+            case Severity::Note: return "note";
+            case Severity::Warning: return "warning";
+            default: return "error";
+            }
+        }
+
+        struct Finding
+        {
+            Severity severity;
+            size_t line;
+            std::string message;
+        };
+
+        // One <change> as seen by the cross-file conflict check.
+        struct ChangeOp
+        {
+            std::string key;        // table \x1f row \x1f property
+            std::string value;
+            size_t line;
+        };
+
+        struct DefReport
+        {
+            size_t ops{0};
+            std::vector<Finding> findings;
+            std::vector<ChangeOp> changes;
+        };
+
+        struct ManifestReport
+        {
+            std::string title;
+            std::vector<std::string> defPaths;     // enabled, relative, '/'-separated
+            std::vector<Finding> findings;
+        };
+
+        // Byte offset -> 1-based line, by binary search over line starts.
+        class LineIndex
+        {
+          public:
+            explicit LineIndex(std::string_view text)
+            {
+                m_starts.push_back(0);
+                for (size_t i = 0; i < text.size(); i++)
+                    if (text[i] == '\n') m_starts.push_back(i + 1);
+            }
+
+            size_t lineOf(size_t offset) const
+            {
+                return static_cast<size_t>(std::upper_bound(m_starts.begin(), m_starts.end(), offset) - m_starts.begin());
+            }
+
+          private:
+            std::vector<size_t> m_starts;
+        };
+
+        inline bool hasAttr(const XmlElement& e, std::string_view name)
+        {
+            for (auto& a : e.attrs)
+                if (a.name == name) return true;
+            return false;
+        }
+
+        // "Field", "Outer.Inner", "Arr[2].Field" — what resolveNestedProperty accepts.
+        inline bool isValidPropertyPath(std::string_view path)
+        {
+            if (path.empty()) return false;
+            size_t segStart = 0;
+            for (size_t i = 0; i <= path.size(); i++)
+            {
+                if (i < path.size() && path[i] != '.') continue;
+                std::string_view seg = path.substr(segStart, i - segStart);
+                if (seg.empty()) return false;
+                size_t open = seg.find('[');
+                if (open != std::string_view::npos)
+                {
+                    if (open == 0 || seg.back() != ']' || seg.size() - open < 3) return false;
+                    for (char c : seg.substr(open + 1, seg.size() - open - 2))
+                        if (c < '0' || c > '9') return false;
+                }
+                else if (seg.find(']') != std::string_view::npos)
+                {
+                    return false;
+                }
+                segStart = i + 1;
+            }
+            return true;
+        }
+
+        inline std::string changeKey(std::string_view table, std::string_view row, std::string_view property)
+        {
+            std::string key(table);
+            key += '\x1f';
+            key += row;
+            key += '\x1f';
+            key += property;
+            return key;
+        }
+
+        // Structural JSON check; findings point at the element's line since
+        // JsonIndex offsets are relative to the CDATA body.
+        inline bool lintJson(const JsonIndex& json, size_t line, const char* what, DefReport& report)
+        {
+            if (!json.ok())
+            {
+                report.findings.push_back({Severity::Error, line,
+                    std::string(what) + " JSON is malformed near byte " + std::to_string(json.errorOffset()) + " of its body"});
+                return false;
+            }
+            if (json.kind(json.root()) != JsonIndex::Kind::Object)
+            {
+                report.findings.push_back({Severity::Error, line, std::string(what) + " JSON must be an object"});
+                return false;
+            }
+            return true;
+        }
+
+        // Lint one .def file's text.
+        inline DefReport lintDef(std::string_view xml)
+        {
+            DefReport report;
+            DefArena arena;
+            std::vector<XmlIssue> issues;
+            XmlElement root = xmlParse(xml, arena.resource(), &issues);
+            LineIndex lines(xml);
+            auto lineOf = [&](size_t offset) { return lines.lineOf(offset); };
+            for (auto& issue : issues)
+                report.findings.push_back({Severity::Error, lineOf(issue.offset), issue.message});
+
+            if (root.tag == "manifest")
+            {
+                report.findings.push_back({Severity::Note, lineOf(root.offset), "<manifest> file is skipped by the loader"});
+                return report;
+            }
+            if (root.tag != "definition")
+            {
+                if (!root.tag.empty())
+                    report.findings.push_back({Severity::Error, lineOf(root.offset),
+                        "root element is <" + std::string(root.tag) + ">, expected <definition>"});
+                return report;
+            }
+
+            // First sighting of each change key in this file, for duplicate checks.
+            std::unordered_map<std::string, size_t> seen;
+
+            for (auto& child : root.children)
+            {
+                size_t childLine = lineOf(child.offset);
+                if (child.tag == "title" || child.tag == "author" || child.tag == "description") continue;
+                if (child.tag != "mod")
+                {
+                    report.findings.push_back({Severity::Warning, childLine, "unknown element <" + std::string(child.tag) + "> is ignored"});
+                    continue;
+                }
+
+                std::string_view file = xmlGetAttr(child, "file");
+                std::string table;
+                if (file.empty())
+                    report.findings.push_back({Severity::Error, childLine, "<mod> has no file attribute"});
+                else
+                {
+                    table = extractDataTableName(file);
+                    if (!strEndsWithCI(file, ".json"))
+                        report.findings.push_back({Severity::Warning, childLine, "<mod file> does not end in .json"});
+                }
+                if (child.children.empty())
+                    report.findings.push_back({Severity::Warning, childLine, "<mod> has no operations"});
+
+                for (auto& op : child.children)
+                {
+                    size_t line = lineOf(op.offset);
+                    report.ops++;
+                    if (op.tag == "change")
+                    {
+                        if (!hasAttr(op, "item")) report.findings.push_back({Severity::Error, line, "<change> has no item attribute"});
+                        if (!hasAttr(op, "property")) report.findings.push_back({Severity::Error, line, "<change> has no property attribute"});
+                        if (!hasAttr(op, "value")) report.findings.push_back({Severity::Error, line, "<change> has no value attribute"});
+                        std::string_view property = xmlGetAttr(op, "property");
+                        if (hasAttr(op, "property") && !isValidPropertyPath(property))
+                            report.findings.push_back({Severity::Error, line, "malformed property path '" + std::string(property) + "'"});
+
+                        for (auto& nested : op.children)
+                        {
+                            if (nested.tag == "add_property")
+                            {
+                                lintJson(JsonIndex(nested.text), lineOf(nested.offset), "<add_property>", report);
+                                if (xmlGetAttr(op, "value").empty())
+                                    report.findings.push_back({Severity::Note, lineOf(nested.offset),
+                                        "<add_property> is ignored by the loader; value=\"\" clears the field"});
+                            }
+                            else
+                                report.findings.push_back({Severity::Warning, lineOf(nested.offset),
+                                    "unknown element <" + std::string(nested.tag) + "> inside <change> is ignored"});
+                        }
+
+                        if (table.empty() || !hasAttr(op, "item") || !hasAttr(op, "property")) continue;
+                        std::string key = changeKey(table, xmlGetAttr(op, "item"), property);
+                        std::string value(xmlGetAttr(op, "value"));
+                        auto [it, inserted] = seen.emplace(key, report.changes.size());
+                        if (!inserted)
+                        {
+                            const ChangeOp& first = report.changes[it->second];
+                            if (first.value == value)
+                                report.findings.push_back({Severity::Warning, line,
+                                    "duplicate change (same value as line " + std::to_string(first.line) + ")"});
+                            else
+                                report.findings.push_back({Severity::Error, line,
+                                    "conflicting change: line " + std::to_string(first.line) + " sets '" + first.value + "'"});
+                            continue;
+                        }
+                        report.changes.push_back({std::move(key), std::move(value), line});
+                    }
+                    else if (op.tag == "delete")
+                    {
+                        for (const char* attr : {"item", "property", "value"})
+                            if (!hasAttr(op, attr) || xmlGetAttr(op, attr).empty())
+                                report.findings.push_back({Severity::Error, line, std::string("<delete> needs a non-empty ") + attr + " attribute"});
+                    }
+                    else if (op.tag == "add_row")
+                    {
+                        if (xmlGetAttr(op, "name").empty())
+                            report.findings.push_back({Severity::Error, line, "<add_row> has no name attribute"});
+                        if (op.text.empty())
+                        {
+                            report.findings.push_back({Severity::Error, line, "<add_row> has no JSON body"});
+                            continue;
+                        }
+                        JsonIndex json(op.text);
+                        if (!lintJson(json, line, "<add_row>", report)) continue;
+                        int value = json.member(json.root(), "Value");
+                        if (value == JsonIndex::npos || json.kind(value) != JsonIndex::Kind::Array)
+                            report.findings.push_back({Severity::Warning, line, "<add_row> JSON has no Value array; the row is added empty"});
+                    }
+                    else
+                    {
+                        report.ops--;
+                        report.findings.push_back({Severity::Warning, line, "unknown op <" + std::string(op.tag) + "> is ignored"});
+                    }
+                }
+            }
+            return report;
+        }
+
+        // Lint a manifest .ini. `defExists` answers for a relative
+        // '/'-separated path (case-insensitive, as on Windows).
+        template <typename Exists>
+        ManifestReport lintManifest(std::string_view text, Exists&& defExists)
+        {
+            ManifestReport report;
+            std::istringstream in{std::string(text)};
+            std::string section, line;
+            size_t lineNo = 0;
+            bool anyPath = false;
+            while (std::getline(in, line))
+            {
+                lineNo++;
+                auto parsed = parseIniLine(line);
+                if (auto* sec = std::get_if<ParsedIniSection>(&parsed))
+                {
+                    section = sec->name;
+                    continue;
+                }
+                auto* kv = std::get_if<ParsedIniKeyValue>(&parsed);
+                if (!kv) continue;
+
+                if (strEqualCI(section, "ModInfo") && strEqualCI(kv->key, "Title"))
+                    report.title = kv->value;
+                if (!strEqualCI(section, "Paths")) continue;
+
+                std::string rel = kv->key;
+                for (auto& c : rel) { if (c == '|' || c == '\\') c = '/'; }
+                if (!strEndsWithCI(rel, ".def"))
+                {
+                    // Bare folder keys ("loot = true") are the mod manager's
+                    // tree state, not files; only flag things that look like files.
+                    if (rel.find('.') == std::string::npos) continue;
+                    report.findings.push_back({Severity::Warning, lineNo, "[Paths] entry '" + kv->key + "' is not a .def and is ignored"});
+                    continue;
+                }
+                if (!strEqualCI(kv->value, "true") && !strEqualCI(kv->value, "false"))
+                    report.findings.push_back({Severity::Warning, lineNo, "[Paths] value '" + kv->value + "' is neither true nor false; treated as false"});
+                if (!strEqualCI(kv->value, "true")) continue;
+
+                anyPath = true;
+                if (!defExists(rel))
+                    report.findings.push_back({Severity::Error, lineNo, "missing .def: " + rel});
+                else
+                    report.defPaths.push_back(rel);
+            }
+            if (report.title.empty())
+                report.findings.push_back({Severity::Note, 1, "no [ModInfo] Title; the pack shows under its file name"});
+            if (!anyPath)
+                report.findings.push_back({Severity::Warning, 1, "no enabled .def entries under [Paths]"});
+            return report;
+        }
+
+    } // namespace DefLint
+} // namespace MoriaMods
+
+#endif // MORIA_DEFLINT_H
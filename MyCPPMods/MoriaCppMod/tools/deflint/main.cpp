@@ -0,0 +1,196 @@
+// deflint — lint a definitions/ tree (manifests + .def packs) outside the game.
+//
+//   deflint [-j N] [-q] <definitions-dir>
+//
+// Lints every .def in parallel, then checks manifests for missing paths and
+// packs for cross-file conflicts. Prints per-file timing (unless -q) and
+// findings as "path:line: severity: message". Exit code 1 when any error.
+
+#include "deflint.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <thread>
+
+namespace fs = std::filesystem;
+using namespace MoriaMods;
+using namespace MoriaMods::DefLint;
+
+namespace
+{
+    struct DefFile
+    {
+        std::string rel;            // '/'-separated, relative to the root
+        fs::path path;
+        DefReport report;
+        double ms{0};
+    };
+
+    std::string lower(std::string s)
+    {
+        for (auto& c : s) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        return s;
+    }
+
+    std::string readFile(const fs::path& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    struct Totals
+    {
+        size_t errors{0};
+        size_t warnings{0};
+        size_t notes{0};
+    };
+
+    void print(Totals& totals, const std::string& file, const Finding& f)
+    {
+        if (f.severity == Severity::Error) totals.errors++;
+        else if (f.severity == Severity::Warning) totals.warnings++;
+        else totals.notes++;
+        std::printf("%s:%zu: %s: %s\n", file.c_str(), f.line, severityName(f.severity), f.message.c_str());
+    }
+
+    int usage()
+    {
+        std::fprintf(stderr, "usage: deflint [-j N] [-q] <definitions-dir>\n");
+        return 2;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    bool quiet = false;
+    fs::path root;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "-q") quiet = true;
+        else if (arg == "-j" && i + 1 < argc) jobs = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        else if (!arg.empty() && arg[0] == '-') return usage();
+        else root = arg;
+    }
+    if (root.empty()) return usage();
+    if (!fs::is_directory(root))
+    {
+        std::fprintf(stderr, "deflint: '%s' is not a directory\n", root.string().c_str());
+        return 2;
+    }
+
+    auto wallStart = std::chrono::steady_clock::now();
+
+    // Discover files. Manifests live at the top level; .def files anywhere.
+    std::vector<DefFile> defs;
+    std::vector<fs::path> manifests;
+    std::map<std::string, size_t> defByLowerRel;     // Windows resolves manifest paths case-insensitively
+    for (auto& entry : fs::recursive_directory_iterator(root))
+    {
+        if (!entry.is_regular_file()) continue;
+        std::string ext = lower(entry.path().extension().string());
+        if (ext == ".def")
+        {
+            std::string rel = fs::relative(entry.path(), root).generic_string();
+            defByLowerRel[lower(rel)] = defs.size();
+            defs.push_back({rel, entry.path(), {}, 0});
+        }
+        else if (ext == ".ini" && entry.path().parent_path() == root)
+        {
+            manifests.push_back(entry.path());
+        }
+    }
+    std::sort(manifests.begin(), manifests.end());
+
+    // Lint .def files in parallel; each worker pulls the next index.
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < std::min<size_t>(jobs, defs.size()); t++)
+    {
+        workers.emplace_back([&] {
+            for (size_t i = next++; i < defs.size(); i = next++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                std::string text = readFile(defs[i].path);
+                defs[i].report = lintDef(text);
+                defs[i].ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    std::vector<std::pair<DefFile*, size_t>> ordered;
+    for (auto& d : defs) ordered.push_back({&d, 0});
+    std::sort(ordered.begin(), ordered.end(), [](auto& a, auto& b) { return a.first->rel < b.first->rel; });
+
+    Totals totals;
+    double cpuMs = 0;
+    for (auto& [d, unused] : ordered)
+    {
+        cpuMs += d->ms;
+        if (!quiet)
+            std::printf("%8.2f ms  %s  (%zu ops)\n", d->ms, d->rel.c_str(), d->report.ops);
+        for (auto& f : d->report.findings) print(totals, d->rel, f);
+    }
+
+    // Manifests: missing paths, then conflicts between .defs of the same pack
+    // (error) and between packs (warning — GameMods.ini order decides).
+    struct Writer
+    {
+        std::string pack;
+        const DefFile* def;
+        const ChangeOp* op;
+    };
+    std::map<std::string, std::vector<Writer>> writers;
+    std::set<size_t> referenced;
+    for (auto& manifest : manifests)
+    {
+        std::string name = manifest.stem().string();
+        std::string rel = fs::relative(manifest, root).generic_string();
+        ManifestReport report = lintManifest(readFile(manifest), [&](const std::string& defRel) {
+            return defByLowerRel.count(lower(defRel)) != 0;
+        });
+        if (!quiet)
+            std::printf("          %s  (%zu defs)\n", rel.c_str(), report.defPaths.size());
+        for (auto& f : report.findings) print(totals, rel, f);
+
+        for (auto& defRel : report.defPaths)
+        {
+            size_t idx = defByLowerRel[lower(defRel)];
+            referenced.insert(idx);
+            for (auto& op : defs[idx].report.changes)
+                writers[op.key].push_back({name, &defs[idx], &op});
+        }
+    }
+
+    for (auto& [key, list] : writers)
+    {
+        for (size_t i = 1; i < list.size(); i++)
+        {
+            const Writer& a = list[0];
+            const Writer& b = list[i];
+            if (a.def == b.def || a.op->value == b.op->value) continue;
+            bool samePack = (a.pack == b.pack);
+            Finding f{samePack ? Severity::Error : Severity::Warning, b.op->line,
+                      "conflicts with " + a.def->rel + ":" + std::to_string(a.op->line) + " ('" + a.op->value + "')" +
+                      (samePack ? " in the same pack" : " in pack '" + a.pack + "'; load order decides")};
+            print(totals, b.def->rel, f);
+        }
+    }
+
+    for (size_t i = 0; i < defs.size(); i++)
+        if (!referenced.count(i) && !manifests.empty())
+            print(totals, defs[i].rel, {Severity::Note, 1, "not referenced by any manifest"});
+
+    double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+    std::printf("\n%zu defs, %zu manifests: %zu errors, %zu warnings, %zu notes  (%.1f ms wall, %.1f ms summed, %u jobs)\n",
+                defs.size(), manifests.size(), totals.errors, totals.warnings, totals.notes, wallMs, cpuMs, jobs);
+    return totals.errors ? 1 : 0;
+}